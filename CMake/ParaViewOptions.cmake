@@ -37,6 +37,9 @@ set_property(CACHE PARAVIEW_BUILD_TESTING
 
 cmake_dependent_option(PARAVIEW_BUILD_VTK_TESTING "Enable VTK testing" OFF
   "PARAVIEW_BUILD_TESTING" OFF)
+cmake_dependent_option(PARAVIEW_BUILD_BENCHMARKS "Add the benchmarks to the tests" OFF
+  "PARAVIEW_BUILD_TESTING" OFF)
+mark_as_advanced(PARAVIEW_BUILD_BENCHMARKS)
 option(PARAVIEW_BUILD_DEVELOPER_DOCUMENTATION "Generate ParaView C++/Python docs" "${doc_default}")
 
 set(PARAVIEW_BUILD_EDITION "CANONICAL"
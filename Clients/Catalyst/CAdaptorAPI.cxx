@@ -16,6 +16,8 @@
 
 #include "vtkCPAdaptorAPI.h"
 
+#include <string>
+
 // call at the start of the simulation
 void coprocessorinitialize()
 {
@@ -43,6 +45,72 @@ void needtocreategrid(int* needGrid)
   vtkCPAdaptorAPI::NeedToCreateGrid(needGrid);
 }
 
+// wrap simulation arrays as fields of the grid without copying them.
+void coprocessoraddfieldaos(char* name, int* nameLength, int* association, double* data,
+  long long* numberOfTuples, int* numberOfComponents)
+{
+  std::string arrayName(name, *nameLength);
+  vtkCPAdaptorAPI::AddFieldAOS(arrayName.c_str(), *association, data,
+    static_cast<vtkIdType>(*numberOfTuples), *numberOfComponents);
+}
+
+void coprocessoraddfloatfieldaos(char* name, int* nameLength, int* association, float* data,
+  long long* numberOfTuples, int* numberOfComponents)
+{
+  std::string arrayName(name, *nameLength);
+  vtkCPAdaptorAPI::AddFieldAOS(arrayName.c_str(), *association, data,
+    static_cast<vtkIdType>(*numberOfTuples), *numberOfComponents);
+}
+
+void coprocessoraddfieldsoa(char* name, int* nameLength, int* association, double* data,
+  long long* numberOfTuples, int* numberOfComponents, long long* componentStride)
+{
+  std::string arrayName(name, *nameLength);
+  vtkCPAdaptorAPI::AddFieldSOA(arrayName.c_str(), *association, data,
+    static_cast<vtkIdType>(*numberOfTuples), *numberOfComponents,
+    static_cast<vtkIdType>(*componentStride));
+}
+
+void coprocessoraddfloatfieldsoa(char* name, int* nameLength, int* association, float* data,
+  long long* numberOfTuples, int* numberOfComponents, long long* componentStride)
+{
+  std::string arrayName(name, *nameLength);
+  vtkCPAdaptorAPI::AddFieldSOA(arrayName.c_str(), *association, data,
+    static_cast<vtkIdType>(*numberOfTuples), *numberOfComponents,
+    static_cast<vtkIdType>(*componentStride));
+}
+
+// wrap simulation arrays as the point coordinates of the grid without
+// copying them.
+void coprocessorsetpointsaos(double* data, long long* numberOfPoints)
+{
+  vtkCPAdaptorAPI::SetPointsAOS(data, static_cast<vtkIdType>(*numberOfPoints));
+}
+
+void coprocessorsetfloatpointsaos(float* data, long long* numberOfPoints)
+{
+  vtkCPAdaptorAPI::SetPointsAOS(data, static_cast<vtkIdType>(*numberOfPoints));
+}
+
+void coprocessorsetpointssoa(double* data, long long* numberOfPoints, long long* componentStride)
+{
+  vtkCPAdaptorAPI::SetPointsSOA(
+    data, static_cast<vtkIdType>(*numberOfPoints), static_cast<vtkIdType>(*componentStride));
+}
+
+void coprocessorsetfloatpointssoa(
+  float* data, long long* numberOfPoints, long long* componentStride)
+{
+  vtkCPAdaptorAPI::SetPointsSOA(
+    data, static_cast<vtkIdType>(*numberOfPoints), static_cast<vtkIdType>(*componentStride));
+}
+
+// configures asynchronous coprocessing.
+void coprocessorsetasynchronous(int* asynchronous, int* maximumQueueDepth, int* backPressurePolicy)
+{
+  vtkCPAdaptorAPI::SetAsynchronousCoProcessing(asynchronous, maximumQueueDepth, backPressurePolicy);
+}
+
 // do the actual coprocessing.  it is assumed that the vtkCPDataDescription
 // has been filled in elsewhere.
 void coprocess()
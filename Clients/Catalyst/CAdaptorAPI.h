@@ -43,6 +43,44 @@ void VTKPVCATALYST_EXPORT requestdatadescription(
 // check if the grid is modified or needs to be updated
 void VTKPVCATALYST_EXPORT needtocreategrid(int* needGrid);
 
+// wrap simulation arrays as fields of the grid without copying them.
+// association is 0 for point data, 1 for cell data and 2 for field data.
+// the aos functions take interleaved tuples, e.g. a Fortran
+// array(numberOfComponents, numberOfTuples). the soa functions take one block
+// of numberOfTuples values per component, the blocks being componentStride
+// values apart, e.g. numberOfTuples for a Fortran
+// array(numberOfTuples, numberOfComponents). the arrays must stay valid until
+// coprocess returns, after which they are removed from the grid.
+void VTKPVCATALYST_EXPORT coprocessoraddfieldaos(char* name, int* nameLength, int* association,
+  double* data, long long* numberOfTuples, int* numberOfComponents);
+void VTKPVCATALYST_EXPORT coprocessoraddfloatfieldaos(char* name, int* nameLength,
+  int* association, float* data, long long* numberOfTuples, int* numberOfComponents);
+void VTKPVCATALYST_EXPORT coprocessoraddfieldsoa(char* name, int* nameLength, int* association,
+  double* data, long long* numberOfTuples, int* numberOfComponents, long long* componentStride);
+void VTKPVCATALYST_EXPORT coprocessoraddfloatfieldsoa(char* name, int* nameLength,
+  int* association, float* data, long long* numberOfTuples, int* numberOfComponents,
+  long long* componentStride);
+
+// wrap simulation arrays as the point coordinates of the grid without copying
+// them, with the same layouts as the field functions. the coordinates stay
+// attached to the grid so the arrays must stay valid until the coordinates are
+// set again or until coprocessorfinalize is called.
+void VTKPVCATALYST_EXPORT coprocessorsetpointsaos(double* data, long long* numberOfPoints);
+void VTKPVCATALYST_EXPORT coprocessorsetfloatpointsaos(float* data, long long* numberOfPoints);
+void VTKPVCATALYST_EXPORT coprocessorsetpointssoa(
+  double* data, long long* numberOfPoints, long long* componentStride);
+void VTKPVCATALYST_EXPORT coprocessorsetfloatpointssoa(
+  float* data, long long* numberOfPoints, long long* componentStride);
+
+// configures asynchronous coprocessing. when asynchronous is 1, coprocess
+// copies the grid and returns right away while the pipelines run on a
+// separate thread. maximumQueueDepth is the number of time steps that can
+// wait to be processed and backPressurePolicy tells what to do when that
+// number is reached: 0 waits, 1 drops the oldest waiting time step and 2
+// skips the new one.
+void VTKPVCATALYST_EXPORT coprocessorsetasynchronous(
+  int* asynchronous, int* maximumQueueDepth, int* backPressurePolicy);
+
 // do the actual coprocessing.  it is assumed that the vtkCPDataDescription
 // has been filled in elsewhere.
 void VTKPVCATALYST_EXPORT coprocess();
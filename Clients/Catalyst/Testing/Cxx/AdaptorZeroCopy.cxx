@@ -0,0 +1,192 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    AdaptorZeroCopy.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the C adaptor API wraps simulation arrays without copying them,
+// reuses the same array objects at every time step and marks them modified so
+// that ranges and bounds follow the values of the current step.
+
+#include "CAdaptorAPI.h"
+#include "vtkAOSDataArrayTemplate.h"
+#include "vtkCPAdaptorAPI.h"
+#include "vtkCPDataDescription.h"
+#include "vtkCPInputDataDescription.h"
+#include "vtkCPPipeline.h"
+#include "vtkCPProcessor.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+const long long NumberOfPoints = 100;
+
+// Simulation data: interleaved coordinates, a velocity stored as a Fortran
+// array(NumberOfPoints, 3) and a single precision pressure.
+std::vector<double> Coordinates(3 * NumberOfPoints);
+std::vector<double> Velocity(3 * NumberOfPoints);
+std::vector<float> Pressure(NumberOfPoints);
+
+// Checks that the arrays it is given point to the simulation memory and
+// records them.
+class vtkZeroCopyPipeline : public vtkCPPipeline
+{
+public:
+  static vtkZeroCopyPipeline* New();
+  vtkTypeMacro(vtkZeroCopyPipeline, vtkCPPipeline);
+
+  int RequestDataDescription(vtkCPDataDescription* dataDescription) override
+  {
+    dataDescription->GetInputDescription(0)->AllFieldsOn();
+    dataDescription->GetInputDescription(0)->GenerateMeshOn();
+    return 1;
+  }
+
+  int CoProcess(vtkCPDataDescription* dataDescription) override
+  {
+    vtkUnstructuredGrid* grid =
+      vtkUnstructuredGrid::SafeDownCast(dataDescription->GetInputDescription(0)->GetGrid());
+    if (!grid || !grid->GetPoints())
+    {
+      return 0;
+    }
+    auto points = vtkAOSDataArrayTemplate<double>::SafeDownCast(grid->GetPoints()->GetData());
+    auto velocity =
+      vtkSOADataArrayTemplate<double>::SafeDownCast(grid->GetPointData()->GetArray("velocity"));
+    auto pressure =
+      vtkAOSDataArrayTemplate<float>::SafeDownCast(grid->GetPointData()->GetArray("pressure"));
+    if (!points || !velocity || !pressure || points->GetPointer(0) != Coordinates.data() ||
+      pressure->GetPointer(0) != Pressure.data() ||
+      velocity->GetNumberOfTuples() != NumberOfPoints)
+    {
+      return 0;
+    }
+    for (int cc = 0; cc < 3; ++cc)
+    {
+      if (velocity->GetComponentArrayPointer(cc) != Velocity.data() + cc * NumberOfPoints ||
+        velocity->GetTypedComponent(7, cc) != Velocity[cc * NumberOfPoints + 7])
+      {
+        return 0;
+      }
+    }
+    // The ranges are cached by the arrays, so these fail from the second time
+    // step on if the adaptor does not mark the repointed arrays modified.
+    const double step = static_cast<double>(dataDescription->GetTimeStep());
+    const double last = static_cast<double>(NumberOfPoints - 1);
+    double range[2];
+    pressure->GetRange(range, 0);
+    if (range[0] != 0 || range[1] != last * step)
+    {
+      cerr << "Stale pressure range at time step " << step << "." << endl;
+      return 0;
+    }
+    velocity->GetRange(range, 0);
+    if (range[0] != step || range[1] != step)
+    {
+      cerr << "Stale velocity range at time step " << step << "." << endl;
+      return 0;
+    }
+    double bounds[6];
+    grid->GetBounds(bounds);
+    if (bounds[0] != step || bounds[1] != last + step)
+    {
+      cerr << "Stale bounds at time step " << step << "." << endl;
+      return 0;
+    }
+    this->Arrays.push_back(points);
+    this->Arrays.push_back(velocity);
+    this->Arrays.push_back(pressure);
+    return 1;
+  }
+
+  std::vector<vtkDataArray*> Arrays;
+};
+vtkStandardNewMacro(vtkZeroCopyPipeline);
+}
+
+int AdaptorZeroCopy(int, char* [])
+{
+  coprocessorinitialize();
+  vtkNew<vtkZeroCopyPipeline> pipeline;
+  vtkCPAdaptorAPI::GetCoProcessor()->AddPipeline(pipeline);
+  vtkNew<vtkUnstructuredGrid> grid;
+  vtkCPAdaptorAPI::GetCoProcessorData()->GetInputDescriptionByName("input")->SetGrid(grid);
+
+  const int numberOfSteps = 3;
+  for (int step = 0; step < numberOfSteps; ++step)
+  {
+    for (long long cc = 0; cc < NumberOfPoints; ++cc)
+    {
+      Coordinates[3 * cc] = cc + step;
+      Coordinates[3 * cc + 1] = Coordinates[3 * cc + 2] = 0;
+      Velocity[cc] = step;
+      Velocity[NumberOfPoints + cc] = cc;
+      Velocity[2 * NumberOfPoints + cc] = -cc;
+      Pressure[cc] = static_cast<float>(cc * step);
+    }
+
+    double time = 0.1 * step;
+    int coprocessThisTimeStep = 0;
+    requestdatadescription(&step, &time, &coprocessThisTimeStep);
+    if (!coprocessThisTimeStep)
+    {
+      cerr << "No co-processing requested." << endl;
+      return EXIT_FAILURE;
+    }
+
+    char velocityName[] = "velocity";
+    char pressureName[] = "pressure";
+    int velocityNameLength = 8;
+    int pressureNameLength = 8;
+    int pointData = vtkDataObject::POINT;
+    long long numberOfPoints = NumberOfPoints;
+    int three = 3;
+    int one = 1;
+    coprocessorsetpointsaos(Coordinates.data(), &numberOfPoints);
+    coprocessoraddfieldsoa(velocityName, &velocityNameLength, &pointData, Velocity.data(),
+      &numberOfPoints, &three, &numberOfPoints);
+    coprocessoraddfloatfieldaos(
+      pressureName, &pressureNameLength, &pointData, Pressure.data(), &numberOfPoints, &one);
+    coprocess();
+
+    if (grid->GetPointData()->GetNumberOfArrays() != 0)
+    {
+      cerr << "Simulation arrays are still referenced after coprocess." << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // 3 arrays per time step, which must be the same objects at every step.
+  if (pipeline->Arrays.size() != 3 * numberOfSteps)
+  {
+    cerr << "Pipeline was not given the simulation memory." << endl;
+    return EXIT_FAILURE;
+  }
+  for (size_t cc = 3; cc < pipeline->Arrays.size(); ++cc)
+  {
+    if (pipeline->Arrays[cc] != pipeline->Arrays[cc % 3])
+    {
+      cerr << "Arrays were allocated again at time step " << cc / 3 << "." << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  coprocessorfinalize();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,176 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    AsynchronousCoProcessing.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that asynchronous co-processing works on snapshots of the grids and
+// applies the back-pressure policies.
+
+#include "vtkCPDataDescription.h"
+#include "vtkCPInputDataDescription.h"
+#include "vtkCPPipeline.h"
+#include "vtkCPProcessor.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Records the value of the "step" array for each processed time step.
+class vtkRecordingPipeline : public vtkCPPipeline
+{
+public:
+  static vtkRecordingPipeline* New();
+  vtkTypeMacro(vtkRecordingPipeline, vtkCPPipeline);
+
+  int RequestDataDescription(vtkCPDataDescription* dataDescription) override
+  {
+    dataDescription->GetInputDescription(0)->AllFieldsOn();
+    dataDescription->GetInputDescription(0)->GenerateMeshOn();
+    return 1;
+  }
+
+  int CoProcess(vtkCPDataDescription* dataDescription) override
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(this->Delay));
+    vtkImageData* grid =
+      vtkImageData::SafeDownCast(dataDescription->GetInputDescription(0)->GetGrid());
+    vtkDataArray* step = grid ? grid->GetPointData()->GetArray("step") : nullptr;
+    if (!step)
+    {
+      return 0;
+    }
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Steps.push_back(step->GetTuple1(0));
+    this->Times.push_back(dataDescription->GetTime());
+    return 1;
+  }
+
+  std::vector<double> GetSteps()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return this->Steps;
+  }
+
+  std::vector<double> GetTimes()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return this->Times;
+  }
+
+  int Delay = 0;
+
+private:
+  std::mutex Mutex;
+  std::vector<double> Steps;
+  std::vector<double> Times;
+};
+vtkStandardNewMacro(vtkRecordingPipeline);
+
+// Runs the given number of time steps, changing the grid right after each
+// CoProcess() call as a simulation would.
+void Simulate(vtkCPProcessor* processor, int numberOfSteps)
+{
+  vtkNew<vtkImageData> grid;
+  grid->SetDimensions(8, 8, 8);
+  vtkNew<vtkDoubleArray> step;
+  step->SetName("step");
+  step->SetNumberOfTuples(grid->GetNumberOfPoints());
+  grid->GetPointData()->AddArray(step);
+
+  vtkNew<vtkCPDataDescription> dataDescription;
+  dataDescription->AddInput("input");
+  for (int cc = 0; cc < numberOfSteps; ++cc)
+  {
+    dataDescription->SetTimeData(0.5 * cc, cc);
+    if (processor->RequestDataDescription(dataDescription))
+    {
+      step->FillComponent(0, cc);
+      dataDescription->GetInputDescriptionByName("input")->SetGrid(grid);
+      processor->CoProcess(dataDescription);
+      step->FillComponent(0, -1);
+    }
+  }
+}
+}
+
+int AsynchronousCoProcessing(int, char* [])
+{
+  vtkNew<vtkCPProcessor> processor;
+  processor->Initialize();
+
+  // Every time step is processed, on the values it had when submitted.
+  vtkNew<vtkRecordingPipeline> pipeline;
+  pipeline->Delay = 5;
+  processor->AddPipeline(pipeline);
+  processor->AsynchronousOn();
+  processor->SetMaximumQueueDepth(2);
+  processor->SetBackPressurePolicy(vtkCPProcessor::BLOCK_WHEN_FULL);
+  Simulate(processor, 10);
+  if (!processor->WaitForAsynchronousCoProcessing())
+  {
+    cerr << "Asynchronous co-processing failed." << endl;
+    return EXIT_FAILURE;
+  }
+  std::vector<double> steps = pipeline->GetSteps();
+  std::vector<double> times = pipeline->GetTimes();
+  if (steps.size() != 10)
+  {
+    cerr << "Expected 10 processed time steps, got " << steps.size() << "." << endl;
+    return EXIT_FAILURE;
+  }
+  for (size_t cc = 0; cc < steps.size(); ++cc)
+  {
+    if (steps[cc] != cc || times[cc] != 0.5 * cc)
+    {
+      cerr << "Time step " << cc << " was not processed on a snapshot of its data." << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // A slow pipeline with a single queued time step has to skip some of them.
+  processor->RemoveAllPipelines();
+  vtkNew<vtkRecordingPipeline> slowPipeline;
+  slowPipeline->Delay = 50;
+  processor->AddPipeline(slowPipeline);
+  processor->SetMaximumQueueDepth(1);
+  processor->SetBackPressurePolicy(vtkCPProcessor::SKIP_NEWEST);
+  Simulate(processor, 10);
+  processor->WaitForAsynchronousCoProcessing();
+  steps = slowPipeline->GetSteps();
+  const int discarded = processor->GetNumberOfDiscardedTimeSteps();
+  if (discarded == 0 || static_cast<int>(steps.size()) + discarded != 10)
+  {
+    cerr << "Unexpected number of skipped time steps: " << discarded << " skipped, "
+         << steps.size() << " processed." << endl;
+    return EXIT_FAILURE;
+  }
+  for (size_t cc = 1; cc < steps.size(); ++cc)
+  {
+    if (steps[cc] <= steps[cc - 1])
+    {
+      cerr << "Time steps were not processed in order." << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  processor->Finalize();
+  return EXIT_SUCCESS;
+}
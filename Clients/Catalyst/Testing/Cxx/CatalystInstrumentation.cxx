@@ -0,0 +1,123 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    CatalystInstrumentation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkCPProcessor writes a record per executed pipeline and a
+// total per time step to its instrumentation file.
+
+#include "vtkCPDataDescription.h"
+#include "vtkCPInputDataDescription.h"
+#include "vtkCPPipeline.h"
+#include "vtkCPProcessor.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkTestUtilities.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Runs at every other time step when Skip is set.
+class vtkIdlePipeline : public vtkCPPipeline
+{
+public:
+  static vtkIdlePipeline* New();
+  vtkTypeMacro(vtkIdlePipeline, vtkCPPipeline);
+
+  int RequestDataDescription(vtkCPDataDescription* dataDescription) override
+  {
+    if (this->Skip && dataDescription->GetTimeStep() % 2 == 1)
+    {
+      return 0;
+    }
+    dataDescription->GetInputDescription(0)->AllFieldsOn();
+    dataDescription->GetInputDescription(0)->GenerateMeshOn();
+    return 1;
+  }
+
+  int CoProcess(vtkCPDataDescription*) override { return 1; }
+
+  bool Skip = false;
+};
+vtkStandardNewMacro(vtkIdlePipeline);
+}
+
+int CatalystInstrumentation(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string fileName = std::string(tempDir) + "/CatalystInstrumentation.csv";
+  delete[] tempDir;
+  {
+    vtkNew<vtkCPProcessor> processor;
+    processor->Initialize();
+    processor->SetInstrumentationFileName(fileName.c_str());
+    processor->SetInstrumentationFormat(vtkCPProcessor::CSV_INSTRUMENTATION);
+
+    vtkNew<vtkIdlePipeline> pipelines[2];
+    pipelines[1]->Skip = true;
+    for (auto& pipeline : pipelines)
+    {
+      processor->AddPipeline(pipeline);
+    }
+
+    vtkNew<vtkImageData> grid;
+    grid->SetDimensions(4, 4, 4);
+    vtkNew<vtkCPDataDescription> dataDescription;
+    dataDescription->AddInput("input");
+    for (int timeStep = 0; timeStep < 2; ++timeStep)
+    {
+      dataDescription->SetTimeData(timeStep * 0.5, timeStep);
+      if (!processor->RequestDataDescription(dataDescription))
+      {
+        cerr << "No co-processing requested." << endl;
+        return EXIT_FAILURE;
+      }
+      dataDescription->GetInputDescriptionByName("input")->SetGrid(grid);
+      processor->CoProcess(dataDescription);
+    }
+    processor->Finalize();
+  }
+
+  std::ifstream input(fileName.c_str());
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(input, line))
+  {
+    lines.push_back(line);
+  }
+  input.close();
+  std::remove(fileName.c_str());
+
+  // the header, 2 pipelines and the total at the first time step, then 1
+  // pipeline and the total at the second one.
+  if (lines.size() != 6 || lines[0].compare(0, 19, "time_step,time,pipe") != 0)
+  {
+    cerr << "Unexpected instrumentation file with " << lines.size() << " lines." << endl;
+    return EXIT_FAILURE;
+  }
+  if (lines[1].compare(0, 8, "0,0,\"0 v") != 0 || lines[2].compare(0, 8, "0,0,\"1 v") != 0 ||
+    lines[3].compare(0, 15, "0,0,\"CoProcess\"") != 0 ||
+    lines[4].compare(0, 10, "1,0.5,\"0 v") != 0 ||
+    lines[5].compare(0, 17, "1,0.5,\"CoProcess\"") != 0)
+  {
+    cerr << "Unexpected instrumentation records." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
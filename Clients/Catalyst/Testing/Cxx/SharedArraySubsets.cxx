@@ -0,0 +1,112 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    SharedArraySubsets.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that pipelines requesting the same fields at a time step are given
+// the same subset of the input grid.
+
+#include "vtkCPDataDescription.h"
+#include "vtkCPInputDataDescription.h"
+#include "vtkCPPipeline.h"
+#include "vtkCPProcessor.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+// Requests a single point field and records the grid it is given. The grid is
+// kept alive so that its address cannot be reused by another subset.
+class vtkFieldPipeline : public vtkCPPipeline
+{
+public:
+  static vtkFieldPipeline* New();
+  vtkTypeMacro(vtkFieldPipeline, vtkCPPipeline);
+
+  int RequestDataDescription(vtkCPDataDescription* dataDescription) override
+  {
+    dataDescription->GetInputDescription(0)->AddField(
+      this->FieldName.c_str(), vtkDataObject::POINT);
+    return 1;
+  }
+
+  int CoProcess(vtkCPDataDescription* dataDescription) override
+  {
+    this->Grid = dataDescription->GetInputDescription(0)->GetGrid();
+    vtkImageData* grid = vtkImageData::SafeDownCast(this->Grid);
+    return grid && grid->GetPointData()->GetNumberOfArrays() == 1 &&
+      grid->GetPointData()->GetArray(this->FieldName.c_str()) != nullptr;
+  }
+
+  std::string FieldName;
+  vtkSmartPointer<vtkDataObject> Grid;
+};
+vtkStandardNewMacro(vtkFieldPipeline);
+}
+
+int SharedArraySubsets(int, char* [])
+{
+  vtkNew<vtkCPProcessor> processor;
+  processor->Initialize();
+
+  vtkNew<vtkFieldPipeline> pipelines[3];
+  pipelines[0]->FieldName = "pressure";
+  pipelines[1]->FieldName = "pressure";
+  pipelines[2]->FieldName = "temperature";
+  for (auto& pipeline : pipelines)
+  {
+    processor->AddPipeline(pipeline);
+  }
+
+  vtkNew<vtkImageData> grid;
+  grid->SetDimensions(4, 4, 4);
+  for (const char* name : { "pressure", "temperature", "velocity" })
+  {
+    vtkNew<vtkDoubleArray> array;
+    array->SetName(name);
+    array->SetNumberOfTuples(grid->GetNumberOfPoints());
+    array->FillComponent(0, 1.0);
+    grid->GetPointData()->AddArray(array);
+  }
+
+  vtkNew<vtkCPDataDescription> dataDescription;
+  dataDescription->AddInput("input");
+  dataDescription->SetTimeData(0, 0);
+  if (!processor->RequestDataDescription(dataDescription))
+  {
+    cerr << "No co-processing requested." << endl;
+    return EXIT_FAILURE;
+  }
+  dataDescription->GetInputDescriptionByName("input")->SetGrid(grid);
+  if (!processor->CoProcess(dataDescription))
+  {
+    cerr << "Pipelines were not given the fields they requested." << endl;
+    return EXIT_FAILURE;
+  }
+
+  if (pipelines[0]->Grid != pipelines[1]->Grid || pipelines[0]->Grid == pipelines[2]->Grid ||
+    pipelines[0]->Grid == grid.GetPointer())
+  {
+    cerr << "Subsets were not shared between pipelines requesting the same fields." << endl;
+    return EXIT_FAILURE;
+  }
+
+  processor->Finalize();
+  return EXIT_SUCCESS;
+}
@@ -16,14 +16,25 @@
 
 #include "vtkCPDataDescription.h"
 #include "vtkCPInputDataDescription.h"
+#include "vtkAOSDataArrayTemplate.h"
 #include "vtkCPProcessor.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkDataSet.h"
+#include "vtkFieldData.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkSmartPointer.h"
 
 #include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 // This code is meant as an API for Fortran and C simulation codes.
 namespace ParaViewCoProcessing
@@ -40,6 +51,126 @@ void ClearFieldDataFromGrid(vtkDataSet* grid)
     grid->GetFieldData()->Initialize();
   }
 }
+
+// Arrays wrapping simulation memory, reused from one time step to the next.
+std::map<std::string, vtkSmartPointer<vtkDataArray> > AdoptedArrays;
+vtkSmartPointer<vtkPoints> AdoptedPoints;
+// Fields added to the grid for the current time step.
+std::vector<std::pair<int, std::string> > AdoptedFields;
+
+vtkDataSet* GetInputGrid(const char* caller)
+{
+  vtkCPDataDescription* dataDescription = vtkCPAdaptorAPI::GetCoProcessorData();
+  vtkDataSet* grid = dataDescription
+    ? vtkDataSet::SafeDownCast(dataDescription->GetInputDescriptionByName("input")->GetGrid())
+    : nullptr;
+  if (!grid)
+  {
+    vtkGenericWarningMacro("Problem in " << caller << ". Need a vtkDataSet grid.");
+  }
+  return grid;
+}
+
+std::string GetArrayKey(const char* name, int association, const char* layout, int dataType)
+{
+  std::ostringstream key;
+  key << association << ':' << layout << ':' << dataType << ':' << name;
+  return key.str();
+}
+
+template <typename ValueType>
+vtkDataArray* AdoptAOS(
+  const std::string& key, ValueType* data, vtkIdType numberOfTuples, int numberOfComponents)
+{
+  vtkSmartPointer<vtkDataArray>& array = AdoptedArrays[key];
+  auto aos = vtkAOSDataArrayTemplate<ValueType>::SafeDownCast(array);
+  if (!aos)
+  {
+    aos = vtkAOSDataArrayTemplate<ValueType>::New();
+    array.TakeReference(aos);
+  }
+  if (aos->GetNumberOfComponents() != numberOfComponents)
+  {
+    aos->SetNumberOfComponents(numberOfComponents);
+  }
+  aos->SetArray(data, numberOfTuples * numberOfComponents, /*save=*/1);
+  // SetArray() does not bump the MTime; without this the cached range and
+  // downstream pipelines would keep the values of the previous time step.
+  aos->Modified();
+  return aos;
+}
+
+template <typename ValueType>
+vtkDataArray* AdoptSOA(const std::string& key, ValueType* data, vtkIdType numberOfTuples,
+  int numberOfComponents, vtkIdType componentStride)
+{
+  vtkSmartPointer<vtkDataArray>& array = AdoptedArrays[key];
+  auto soa = vtkSOADataArrayTemplate<ValueType>::SafeDownCast(array);
+  if (!soa)
+  {
+    soa = vtkSOADataArrayTemplate<ValueType>::New();
+    array.TakeReference(soa);
+  }
+  if (soa->GetNumberOfComponents() != numberOfComponents)
+  {
+    soa->SetNumberOfComponents(numberOfComponents);
+  }
+  for (int cc = 0; cc < numberOfComponents; ++cc)
+  {
+    soa->SetArray(cc, data + cc * componentStride, numberOfTuples, /*updateMaxId=*/true,
+      /*save=*/true);
+  }
+  soa->Modified();
+  return soa;
+}
+
+void AddField(const char* name, int association, vtkDataArray* array)
+{
+  vtkDataSet* grid = GetInputGrid("AddField");
+  vtkFieldData* fieldData = grid ? grid->GetAttributesAsFieldData(association) : nullptr;
+  if (!fieldData)
+  {
+    return;
+  }
+  array->SetName(name);
+  fieldData->AddArray(array);
+  AdoptedFields.push_back(std::make_pair(association, std::string(name)));
+}
+
+void SetPoints(vtkDataArray* array)
+{
+  vtkPointSet* grid = vtkPointSet::SafeDownCast(GetInputGrid("SetPoints"));
+  if (!grid)
+  {
+    return;
+  }
+  if (!AdoptedPoints)
+  {
+    AdoptedPoints = vtkSmartPointer<vtkPoints>::New();
+  }
+  AdoptedPoints->SetData(array);
+  // Re-setting the same array is a no-op in vtkPoints, so mark the points
+  // modified explicitly to invalidate the cached bounds.
+  AdoptedPoints->Modified();
+  grid->SetPoints(AdoptedPoints);
+}
+
+// Removes the fields wrapping simulation memory from the grid.
+void RemoveAdoptedFields()
+{
+  vtkCPDataDescription* dataDescription = vtkCPAdaptorAPI::GetCoProcessorData();
+  vtkDataSet* grid = dataDescription
+    ? vtkDataSet::SafeDownCast(dataDescription->GetInputDescriptionByName("input")->GetGrid())
+    : nullptr;
+  for (const auto& field : AdoptedFields)
+  {
+    if (vtkFieldData* fieldData = grid ? grid->GetAttributesAsFieldData(field.first) : nullptr)
+    {
+      fieldData->RemoveArray(field.second.c_str());
+    }
+  }
+  AdoptedFields.clear();
+}
 } // end namespace
 
 vtkCPDataDescription* vtkCPAdaptorAPI::CoProcessorData = NULL;
@@ -78,6 +209,10 @@ void vtkCPAdaptorAPI::CoProcessorFinalize()
     vtkCPAdaptorAPI::CoProcessorData->Delete();
     vtkCPAdaptorAPI::CoProcessorData = 0;
   }
+
+  ParaViewCoProcessing::AdoptedFields.clear();
+  ParaViewCoProcessing::AdoptedArrays.clear();
+  ParaViewCoProcessing::AdoptedPoints = nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -150,6 +285,21 @@ void vtkCPAdaptorAPI::NeedToCreateGrid(int* needGrid)
   }
 }
 
+//-----------------------------------------------------------------------------
+void vtkCPAdaptorAPI::SetAsynchronousCoProcessing(
+  int* asynchronous, int* maximumQueueDepth, int* backPressurePolicy)
+{
+  if (!vtkCPAdaptorAPI::CoProcessor)
+  {
+    vtkGenericWarningMacro("Problem in coprocessorsetasynchronous."
+      << "Probably need to initialize.");
+    return;
+  }
+  vtkCPAdaptorAPI::CoProcessor->SetMaximumQueueDepth(*maximumQueueDepth);
+  vtkCPAdaptorAPI::CoProcessor->SetBackPressurePolicy(*backPressurePolicy);
+  vtkCPAdaptorAPI::CoProcessor->SetAsynchronous(*asynchronous != 0);
+}
+
 //-----------------------------------------------------------------------------
 void vtkCPAdaptorAPI::CoProcess()
 {
@@ -161,6 +311,81 @@ void vtkCPAdaptorAPI::CoProcess()
   {
     vtkCPAdaptorAPI::CoProcessor->CoProcess(vtkCPAdaptorAPI::CoProcessorData);
   }
+  // The simulation may release or reuse the memory of the fields once we
+  // return.
+  ParaViewCoProcessing::RemoveAdoptedFields();
   // Reset time data.
   vtkCPAdaptorAPI::IsTimeDataSet = false;
 }
+
+//-----------------------------------------------------------------------------
+void vtkCPAdaptorAPI::AddFieldAOS(const char* name, int association, double* data,
+  vtkIdType numberOfTuples, int numberOfComponents)
+{
+  ParaViewCoProcessing::AddField(name, association,
+    ParaViewCoProcessing::AdoptAOS(
+      ParaViewCoProcessing::GetArrayKey(name, association, "aos", VTK_DOUBLE), data,
+      numberOfTuples, numberOfComponents));
+}
+
+//-----------------------------------------------------------------------------
+void vtkCPAdaptorAPI::AddFieldAOS(const char* name, int association, float* data,
+  vtkIdType numberOfTuples, int numberOfComponents)
+{
+  ParaViewCoProcessing::AddField(name, association,
+    ParaViewCoProcessing::AdoptAOS(
+      ParaViewCoProcessing::GetArrayKey(name, association, "aos", VTK_FLOAT), data,
+      numberOfTuples, numberOfComponents));
+}
+
+//-----------------------------------------------------------------------------
+void vtkCPAdaptorAPI::AddFieldSOA(const char* name, int association, double* data,
+  vtkIdType numberOfTuples, int numberOfComponents, vtkIdType componentStride)
+{
+  ParaViewCoProcessing::AddField(name, association,
+    ParaViewCoProcessing::AdoptSOA(
+      ParaViewCoProcessing::GetArrayKey(name, association, "soa", VTK_DOUBLE), data,
+      numberOfTuples, numberOfComponents, componentStride));
+}
+
+//-----------------------------------------------------------------------------
+void vtkCPAdaptorAPI::AddFieldSOA(const char* name, int association, float* data,
+  vtkIdType numberOfTuples, int numberOfComponents, vtkIdType componentStride)
+{
+  ParaViewCoProcessing::AddField(name, association,
+    ParaViewCoProcessing::AdoptSOA(
+      ParaViewCoProcessing::GetArrayKey(name, association, "soa", VTK_FLOAT), data,
+      numberOfTuples, numberOfComponents, componentStride));
+}
+
+//-----------------------------------------------------------------------------
+void vtkCPAdaptorAPI::SetPointsAOS(double* data, vtkIdType numberOfPoints)
+{
+  ParaViewCoProcessing::SetPoints(ParaViewCoProcessing::AdoptAOS(
+    ParaViewCoProcessing::GetArrayKey("Points", -1, "aos", VTK_DOUBLE), data, numberOfPoints, 3));
+}
+
+//-----------------------------------------------------------------------------
+void vtkCPAdaptorAPI::SetPointsAOS(float* data, vtkIdType numberOfPoints)
+{
+  ParaViewCoProcessing::SetPoints(ParaViewCoProcessing::AdoptAOS(
+    ParaViewCoProcessing::GetArrayKey("Points", -1, "aos", VTK_FLOAT), data, numberOfPoints, 3));
+}
+
+//-----------------------------------------------------------------------------
+void vtkCPAdaptorAPI::SetPointsSOA(
+  double* data, vtkIdType numberOfPoints, vtkIdType componentStride)
+{
+  ParaViewCoProcessing::SetPoints(ParaViewCoProcessing::AdoptSOA(
+    ParaViewCoProcessing::GetArrayKey("Points", -1, "soa", VTK_DOUBLE), data, numberOfPoints, 3,
+    componentStride));
+}
+
+//-----------------------------------------------------------------------------
+void vtkCPAdaptorAPI::SetPointsSOA(
+  float* data, vtkIdType numberOfPoints, vtkIdType componentStride)
+{
+  ParaViewCoProcessing::SetPoints(ParaViewCoProcessing::AdoptSOA(
+    ParaViewCoProcessing::GetArrayKey("Points", -1, "soa", VTK_FLOAT), data, numberOfPoints, 3,
+    componentStride));
+}
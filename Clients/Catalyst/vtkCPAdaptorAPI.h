@@ -48,6 +48,39 @@ public:
   /// has been filled in elsewhere.
   static void CoProcess();
 
+  /// wrap simulation memory as an array of the grid of the "input" channel,
+  /// without copying it. association is vtkDataObject::POINT, CELL or FIELD.
+  /// The AOS variants take interleaved tuples (x0 y0 z0 x1 y1 z1 ...). The SOA
+  /// variants take one block of numberOfTuples values per component, the
+  /// components being componentStride values apart, e.g. numberOfTuples for a
+  /// Fortran array(numberOfTuples, numberOfComponents). The memory must stay
+  /// valid until CoProcess() returns. The arrays are removed from the grid
+  /// when CoProcess() returns and the array objects are reused at the next
+  /// time step so that no allocation happens.
+  static void AddFieldAOS(const char* name, int association, double* data,
+    vtkIdType numberOfTuples, int numberOfComponents);
+  static void AddFieldAOS(const char* name, int association, float* data,
+    vtkIdType numberOfTuples, int numberOfComponents);
+  static void AddFieldSOA(const char* name, int association, double* data,
+    vtkIdType numberOfTuples, int numberOfComponents, vtkIdType componentStride);
+  static void AddFieldSOA(const char* name, int association, float* data,
+    vtkIdType numberOfTuples, int numberOfComponents, vtkIdType componentStride);
+
+  /// wrap simulation memory as the point coordinates of the grid of the
+  /// "input" channel, which must be a vtkPointSet, without copying it. Unlike
+  /// fields, the coordinates stay attached to the grid after CoProcess()
+  /// returns, so the memory must stay valid until they are set again or until
+  /// CoProcessorFinalize() is called.
+  static void SetPointsAOS(double* data, vtkIdType numberOfPoints);
+  static void SetPointsAOS(float* data, vtkIdType numberOfPoints);
+  static void SetPointsSOA(double* data, vtkIdType numberOfPoints, vtkIdType componentStride);
+  static void SetPointsSOA(float* data, vtkIdType numberOfPoints, vtkIdType componentStride);
+
+  /// configures asynchronous co-processing, see vtkCPProcessor::SetAsynchronous().
+  /// backPressurePolicy is one of vtkCPProcessor::BackPressurePolicies.
+  static void SetAsynchronousCoProcessing(
+    int* asynchronous, int* maximumQueueDepth, int* backPressurePolicy);
+
   /// provides access to the vtkCPDataDescription instance.
   static vtkCPDataDescription* GetCoProcessorData() { return vtkCPAdaptorAPI::CoProcessorData; }
 
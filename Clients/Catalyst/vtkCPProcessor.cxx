@@ -30,6 +30,7 @@
 #include "vtkMPIController.h"
 #endif
 #include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPassArrays.h"
@@ -41,10 +42,24 @@
 #include "vtkSmartPointer.h"
 #include "vtkStringArray.h"
 #include "vtkTemporalDataSetCache.h"
+#include "vtkTimerLog.h"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <limits>
 #include <list>
 #include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
+#include <vtksys/SystemInformation.hxx>
 #include <vtksys/SystemTools.hxx>
 
 struct vtkCPProcessorInternals
@@ -56,8 +71,196 @@ struct vtkCPProcessorInternals
   typedef std::map<std::string, vtkSmartPointer<vtkSMSourceProxy> > CacheList;
   typedef CacheList::iterator CacheListIterator;
   CacheList TemporalCaches;
+
+  // Asynchronous co-processing. Jobs are identified by the number of
+  // submitted time steps, which is the same on all processes.
+  struct Job
+  {
+    long long Id;
+    vtkSmartPointer<vtkCPDataDescription> DataDescription;
+  };
+  std::deque<Job> Queue;
+  std::thread Worker;
+  std::mutex QueueMutex;
+  // Notifies the co-processing thread that a job was queued or that it must
+  // stop.
+  std::condition_variable QueueChanged;
+  // Notifies the simulation thread that a job was started or completed.
+  std::condition_variable JobProgressed;
+  bool Processing = false;
+  bool Stopping = false;
+  bool Failed = false;
+  long long NextJobId = 0;
+  int NumberOfDiscardedTimeSteps = 0;
+  // Used by the simulation thread to agree on back-pressure decisions without
+  // interfering with the communication of the pipelines.
+  vtkSmartPointer<vtkMultiProcessController> DecisionController;
+
+  // Instrumentation records of the current time step, negative values are not
+  // available.
+  struct Measure
+  {
+    std::string Pipeline;
+    std::string Filter;
+    double WallTime;
+    double PeakMemory;
+    double BytesWritten;
+  };
+  std::vector<Measure> Measures;
+  bool InstrumentationHeaderWritten = false;
+};
+
+namespace
+{
+// Samples the resident memory of the process while a pipeline executes.
+class vtkCPMemorySampler
+{
+public:
+  void Start()
+  {
+    this->Peak = this->SystemInformation.GetProcMemoryUsed();
+    this->Stopping = false;
+    this->Thread = std::thread([this]() {
+      std::unique_lock<std::mutex> lock(this->Mutex);
+      while (!this->Stopped.wait_for(
+        lock, std::chrono::milliseconds(10), [this]() { return this->Stopping; }))
+      {
+        this->Peak = std::max(this->Peak, this->SystemInformation.GetProcMemoryUsed());
+      }
+    });
+  }
+
+  // Returns the peak resident memory in KiB.
+  double Stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Stopping = true;
+    }
+    this->Stopped.notify_all();
+    this->Thread.join();
+    this->Peak = std::max(this->Peak, this->SystemInformation.GetProcMemoryUsed());
+    return static_cast<double>(this->Peak);
+  }
+
+private:
+  vtksys::SystemInformation SystemInformation;
+  std::thread Thread;
+  std::mutex Mutex;
+  std::condition_variable Stopped;
+  bool Stopping = false;
+  long long Peak = 0;
+};
+
+// Returns the number of bytes written by the process so far, -1 if not
+// available.
+double GetBytesWritten()
+{
+#if defined(__linux__)
+  std::ifstream io("/proc/self/io");
+  std::string key;
+  long long value;
+  while (io >> key >> value)
+  {
+    if (key == "wchar:")
+    {
+      return static_cast<double>(value);
+    }
+  }
+#endif
+  return -1;
+}
+
+// Sums the execution time of each filter from the timer log events marked by
+// vtkSISourceProxy since firstEvent.
+std::vector<std::pair<std::string, double> > GetFilterWallTimes(int firstEvent)
+{
+  std::vector<std::pair<std::string, double> > wallTimes;
+  std::map<std::string, size_t> indices;
+  std::map<std::string, double> starts;
+  const std::string prefix = "Execute ";
+  for (int cc = firstEvent, max = vtkTimerLog::GetNumberOfEvents(); cc < max; ++cc)
+  {
+    const char* event = vtkTimerLog::GetEventString(cc);
+    if (!event || strncmp(event, prefix.c_str(), prefix.size()) != 0)
+    {
+      continue;
+    }
+    const std::string name = event + prefix.size();
+    switch (vtkTimerLog::GetEventType(cc))
+    {
+      case vtkTimerLogEntry::START:
+        starts[name] = vtkTimerLog::GetEventWallTime(cc);
+        break;
+      case vtkTimerLogEntry::END:
+      {
+        auto start = starts.find(name);
+        if (start == starts.end())
+        {
+          break;
+        }
+        auto index = indices.find(name);
+        if (index == indices.end())
+        {
+          index = indices.insert(std::make_pair(name, wallTimes.size())).first;
+          wallTimes.push_back(std::make_pair(name, 0.0));
+        }
+        wallTimes[index->second].second += vtkTimerLog::GetEventWallTime(cc) - start->second;
+        starts.erase(start);
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  return wallTimes;
+}
+
+// Minimum, maximum and average of a value over the processes.
+struct vtkCPStatistic
+{
+  double Min = VTK_DOUBLE_MAX;
+  double Max = -VTK_DOUBLE_MAX;
+  double Sum = 0;
+  int Count = 0;
+
+  void Add(double value)
+  {
+    if (value >= 0)
+    {
+      this->Min = std::min(this->Min, value);
+      this->Max = std::max(this->Max, value);
+      this->Sum += value;
+      this->Count++;
+    }
+  }
 };
 
+std::string QuoteCSV(const std::string& value)
+{
+  std::string quoted = "\"";
+  for (char c : value)
+  {
+    quoted += (c == '"') ? "\"\"" : std::string(1, c);
+  }
+  return quoted + "\"";
+}
+
+std::string QuoteJSON(const std::string& value)
+{
+  std::string quoted = "\"";
+  for (char c : value)
+  {
+    if (c == '"' || c == '\\')
+    {
+      quoted += '\\';
+    }
+    quoted += c;
+  }
+  return quoted + "\"";
+}
+}
+
 vtkStandardNewMacro(vtkCPProcessor);
 vtkMultiProcessController* vtkCPProcessor::Controller = nullptr;
 //----------------------------------------------------------------------------
@@ -72,6 +275,7 @@ vtkCPProcessor::vtkCPProcessor()
 //----------------------------------------------------------------------------
 vtkCPProcessor::~vtkCPProcessor()
 {
+  this->StopAsynchronousCoProcessing();
   if (this->Internal)
   {
     delete this->Internal;
@@ -84,6 +288,7 @@ vtkCPProcessor::~vtkCPProcessor()
     this->InitializationHelper = nullptr;
   }
   this->SetWorkingDirectory(nullptr);
+  this->SetInstrumentationFileName(nullptr);
 }
 
 //----------------------------------------------------------------------------
@@ -244,6 +449,35 @@ int vtkCPProcessor::CoProcess(vtkCPDataDescription* dataDescription)
     vtkWarningMacro("DataDescription is NULL.");
     return 0;
   }
+
+  int success;
+  if (this->Asynchronous && this->StartAsynchronousCoProcessing())
+  {
+    success = this->SubmitAsynchronousCoProcessing(dataDescription);
+  }
+  else
+  {
+    success = this->CoProcessPipelines(dataDescription);
+  }
+  // we want to reset everything here to make sure that new information
+  // is properly passed in the next time.
+  dataDescription->ResetAll();
+  return success;
+}
+
+//----------------------------------------------------------------------------
+int vtkCPProcessor::CoProcessPipelines(vtkCPDataDescription* dataDescription)
+{
+  const bool instrument = this->InstrumentationFileName != nullptr;
+  const bool timerLogging = vtkTimerLog::GetLogging() != 0;
+  const double startTime = vtkTimerLog::GetUniversalTime();
+  if (instrument)
+  {
+    this->Internal->Measures.clear();
+    // the filters record their execution in the timer log.
+    vtkTimerLog::LoggingOn();
+  }
+
   int success = 1;
   // We need to add in information like channel name and time value here to the
   // field data. The channel name is used to automatically keep track of which
@@ -290,8 +524,12 @@ int vtkCPProcessor::CoProcess(vtkCPDataDescription* dataDescription)
     originalWorkingDirectory = vtksys::SystemTools::GetCurrentWorkingDirectory();
     vtksys::SystemTools::ChangeDirectory(this->WorkingDirectory);
   }
+  // Subsets of the input grids for this time step, keyed on the input index and
+  // the requested fields.
+  std::map<std::string, vtkSmartPointer<vtkDataObject> > subsets;
+  int pipelineIndex = 0;
   for (vtkCPProcessorInternals::PipelineListIterator iter = this->Internal->Pipelines.begin();
-       iter != this->Internal->Pipelines.end(); iter++)
+       iter != this->Internal->Pipelines.end(); iter++, pipelineIndex++)
   {
     // Reset dataDescription so that we can check each pipeline again
     // before calling CoProcess to make sure which pipelines should
@@ -302,6 +540,23 @@ int vtkCPProcessor::CoProcess(vtkCPDataDescription* dataDescription)
     }
     if (iter->GetPointer()->RequestDataDescription(dataDescription))
     {
+      vtkCPMemorySampler memorySampler;
+      double pipelineStartTime = 0;
+      double bytesWritten = 0;
+      int firstEvent = 0;
+      if (instrument)
+      {
+        if (!timerLogging)
+        {
+          // we own the timer log, keep it from wrapping around.
+          vtkTimerLog::ResetLog();
+        }
+        firstEvent = vtkTimerLog::GetNumberOfEvents();
+        bytesWritten = GetBytesWritten();
+        memorySampler.Start();
+        pipelineStartTime = vtkTimerLog::GetUniversalTime();
+      }
+
       // now we need to filter out arrays that are not needed by this pipeline
       // but were requested by other pipelines at this time step
       vtkSmartPointer<vtkCPDataDescription> dataDescriptionCopy = dataDescription;
@@ -316,19 +571,36 @@ int vtkCPProcessor::CoProcess(vtkCPDataDescription* dataDescription)
           vtkCPInputDataDescription* idd = dataDescriptionCopy->GetInputDescription(i);
           if (idd->GetIfGridIsNecessary() == true && idd->GetAllFields() == false)
           {
-            vtkNew<vtkPassArrays> passArrays;
-            passArrays->UseFieldTypesOn();
-            passArrays->AddFieldType(vtkDataObject::FIELD);
-            passArrays->AddFieldType(vtkDataObject::POINT);
-            passArrays->AddFieldType(vtkDataObject::CELL);
-            passArrays->SetInputData(idd->GetGrid());
+            // pipelines requesting the same fields share the same subset.
+            std::set<std::pair<int, std::string> > fields;
             for (unsigned int j = 0; j < idd->GetNumberOfFields(); j++)
             {
-              int type = idd->GetFieldType(j);
-              passArrays->AddArray(type, idd->GetFieldName(j));
+              fields.insert(std::make_pair(idd->GetFieldType(j), idd->GetFieldName(j)));
+            }
+            std::ostringstream key;
+            key << i;
+            for (const auto& field : fields)
+            {
+              key << '\n' << field.first << ':' << field.second;
+            }
+
+            vtkSmartPointer<vtkDataObject>& subset = subsets[key.str()];
+            if (!subset)
+            {
+              vtkNew<vtkPassArrays> passArrays;
+              passArrays->UseFieldTypesOn();
+              passArrays->AddFieldType(vtkDataObject::FIELD);
+              passArrays->AddFieldType(vtkDataObject::POINT);
+              passArrays->AddFieldType(vtkDataObject::CELL);
+              passArrays->SetInputData(idd->GetGrid());
+              for (unsigned int j = 0; j < idd->GetNumberOfFields(); j++)
+              {
+                passArrays->AddArray(idd->GetFieldType(j), idd->GetFieldName(j));
+              }
+              passArrays->Update();
+              subset = passArrays->GetOutputDataObject(0);
             }
-            passArrays->Update();
-            idd->SetGrid(passArrays->GetOutput());
+            idd->SetGrid(subset);
           }
         }
       }
@@ -336,21 +608,395 @@ int vtkCPProcessor::CoProcess(vtkCPDataDescription* dataDescription)
       {
         success = 0;
       }
+
+      if (instrument)
+      {
+        std::ostringstream pipelineName;
+        pipelineName << pipelineIndex << " " << iter->GetPointer()->GetClassName();
+        vtkCPProcessorInternals::Measure measure;
+        measure.Pipeline = pipelineName.str();
+        measure.WallTime = vtkTimerLog::GetUniversalTime() - pipelineStartTime;
+        measure.PeakMemory = memorySampler.Stop();
+        const double bytesWrittenAfter = GetBytesWritten();
+        measure.BytesWritten = bytesWritten >= 0 ? bytesWrittenAfter - bytesWritten : -1;
+        this->Internal->Measures.push_back(measure);
+
+        // when the timer log is full, the events of this pipeline cannot be
+        // told apart.
+        if (vtkTimerLog::GetNumberOfEvents() < vtkTimerLog::GetMaxEntries())
+        {
+          for (const auto& filter : GetFilterWallTimes(firstEvent))
+          {
+            measure.Filter = filter.first;
+            measure.WallTime = filter.second;
+            measure.PeakMemory = measure.BytesWritten = -1;
+            this->Internal->Measures.push_back(measure);
+          }
+        }
+      }
     }
   }
   if (originalWorkingDirectory.empty() == false)
   {
     vtksys::SystemTools::ChangeDirectory(originalWorkingDirectory);
   }
-  // we want to reset everything here to make sure that new information
-  // is properly passed in the next time.
-  dataDescription->ResetAll();
+
+  if (instrument)
+  {
+    if (!timerLogging)
+    {
+      vtkTimerLog::ResetLog();
+      vtkTimerLog::LoggingOff();
+    }
+    vtkCPProcessorInternals::Measure total;
+    total.Pipeline = "CoProcess";
+    total.WallTime = vtkTimerLog::GetUniversalTime() - startTime;
+    total.PeakMemory = total.BytesWritten = -1;
+    this->Internal->Measures.push_back(total);
+    this->WriteInstrumentation(dataDescription);
+  }
+  return success;
+}
+
+//----------------------------------------------------------------------------
+void vtkCPProcessor::WriteInstrumentation(vtkCPDataDescription* dataDescription)
+{
+  vtkCPProcessorInternals& internals = *this->Internal;
+  vtkMultiProcessStream stream;
+  stream << static_cast<unsigned int>(internals.Measures.size());
+  for (const auto& measure : internals.Measures)
+  {
+    stream << measure.Pipeline << measure.Filter << measure.WallTime << measure.PeakMemory
+           << measure.BytesWritten;
+  }
+
+  std::vector<vtkMultiProcessStream> streams;
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  if (controller && controller->GetNumberOfProcesses() > 1)
+  {
+    controller->Gather(stream, streams, 0);
+    if (controller->GetLocalProcessId() != 0)
+    {
+      return;
+    }
+  }
+  else
+  {
+    streams.push_back(stream);
+  }
+
+  // reduce the records over the processes, in the order they are first seen.
+  struct Record
+  {
+    std::string Pipeline;
+    std::string Filter;
+    vtkCPStatistic WallTime;
+    vtkCPStatistic PeakMemory;
+    vtkCPStatistic BytesWritten;
+  };
+  std::vector<Record> records;
+  std::map<std::pair<std::string, std::string>, size_t> indices;
+  for (auto& processStream : streams)
+  {
+    unsigned int numberOfMeasures = 0;
+    processStream >> numberOfMeasures;
+    for (unsigned int cc = 0; cc < numberOfMeasures; ++cc)
+    {
+      vtkCPProcessorInternals::Measure measure;
+      processStream >> measure.Pipeline >> measure.Filter >> measure.WallTime >>
+        measure.PeakMemory >> measure.BytesWritten;
+      auto key = std::make_pair(measure.Pipeline, measure.Filter);
+      auto index = indices.find(key);
+      if (index == indices.end())
+      {
+        index = indices.insert(std::make_pair(key, records.size())).first;
+        records.push_back(Record());
+        records.back().Pipeline = measure.Pipeline;
+        records.back().Filter = measure.Filter;
+      }
+      Record& record = records[index->second];
+      record.WallTime.Add(measure.WallTime);
+      record.PeakMemory.Add(measure.PeakMemory);
+      record.BytesWritten.Add(measure.BytesWritten);
+    }
+  }
+
+  // the file is overwritten by the first time step.
+  std::ofstream output(this->InstrumentationFileName,
+    internals.InstrumentationHeaderWritten ? std::ios::app : std::ios::trunc);
+  if (!output)
+  {
+    vtkErrorMacro("Cannot write instrumentation to " << this->InstrumentationFileName);
+    return;
+  }
+  output.precision(9);
+
+  if (this->InstrumentationFormat == JSON_INSTRUMENTATION)
+  {
+    auto writeStatistic = [&output](const char* name, const vtkCPStatistic& statistic) {
+      if (statistic.Count > 0)
+      {
+        output << ", \"" << name << "\": {\"min\": " << statistic.Min
+               << ", \"max\": " << statistic.Max
+               << ", \"avg\": " << statistic.Sum / statistic.Count << "}";
+      }
+    };
+    output << "{\"time_step\": " << dataDescription->GetTimeStep()
+           << ", \"time\": " << dataDescription->GetTime() << ", \"records\": [";
+    for (size_t cc = 0; cc < records.size(); ++cc)
+    {
+      output << (cc > 0 ? ", " : "") << "{\"pipeline\": " << QuoteJSON(records[cc].Pipeline);
+      if (!records[cc].Filter.empty())
+      {
+        output << ", \"filter\": " << QuoteJSON(records[cc].Filter);
+      }
+      writeStatistic("wall_time", records[cc].WallTime);
+      writeStatistic("peak_memory", records[cc].PeakMemory);
+      writeStatistic("bytes_written", records[cc].BytesWritten);
+      output << "}";
+    }
+    output << "]}\n";
+  }
+  else
+  {
+    if (!internals.InstrumentationHeaderWritten)
+    {
+      output << "time_step,time,pipeline,filter,"
+             << "wall_time_min,wall_time_max,wall_time_avg,"
+             << "peak_memory_min,peak_memory_max,peak_memory_avg,"
+             << "bytes_written_min,bytes_written_max,bytes_written_avg\n";
+    }
+    auto writeStatistic = [&output](const vtkCPStatistic& statistic) {
+      if (statistic.Count > 0)
+      {
+        output << "," << statistic.Min << "," << statistic.Max << ","
+               << statistic.Sum / statistic.Count;
+      }
+      else
+      {
+        output << ",,,";
+      }
+    };
+    for (const auto& record : records)
+    {
+      output << dataDescription->GetTimeStep() << "," << dataDescription->GetTime() << ","
+             << QuoteCSV(record.Pipeline) << "," << QuoteCSV(record.Filter);
+      writeStatistic(record.WallTime);
+      writeStatistic(record.PeakMemory);
+      writeStatistic(record.BytesWritten);
+      output << "\n";
+    }
+  }
+  internals.InstrumentationHeaderWritten = true;
+}
+
+//----------------------------------------------------------------------------
+void vtkCPProcessor::SetAsynchronous(bool asynchronous)
+{
+  if (this->Asynchronous == asynchronous)
+  {
+    return;
+  }
+  if (!asynchronous)
+  {
+    this->StopAsynchronousCoProcessing();
+  }
+  this->Asynchronous = asynchronous;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkCPProcessor::StartAsynchronousCoProcessing()
+{
+  vtkCPProcessorInternals& internals = *this->Internal;
+  if (internals.Worker.joinable())
+  {
+    return true;
+  }
+
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  if (controller && controller->GetNumberOfProcesses() > 1)
+  {
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+    int provided = MPI_THREAD_SINGLE;
+    MPI_Query_thread(&provided);
+    if (provided < MPI_THREAD_MULTIPLE)
+    {
+      vtkWarningMacro("Asynchronous co-processing requires MPI_THREAD_MULTIPLE. "
+                      "Co-processing stays synchronous.");
+      this->Asynchronous = false;
+      return false;
+    }
+#endif
+    // This is collective, it must happen before the co-processing thread starts
+    // communicating.
+    internals.DecisionController.TakeReference(
+      controller->PartitionController(0, controller->GetLocalProcessId()));
+  }
+
+  internals.Stopping = false;
+  internals.Failed = false;
+  internals.Worker = std::thread(&vtkCPProcessor::ProcessQueue, this);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkCPProcessor::StopAsynchronousCoProcessing()
+{
+  vtkCPProcessorInternals& internals = *this->Internal;
+  if (!internals.Worker.joinable())
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(internals.QueueMutex);
+    internals.Stopping = true;
+  }
+  internals.QueueChanged.notify_all();
+  internals.Worker.join();
+  internals.DecisionController = nullptr;
+}
+
+//----------------------------------------------------------------------------
+void vtkCPProcessor::ProcessQueue()
+{
+  vtkCPProcessorInternals& internals = *this->Internal;
+  while (true)
+  {
+    vtkSmartPointer<vtkCPDataDescription> dataDescription;
+    {
+      std::unique_lock<std::mutex> lock(internals.QueueMutex);
+      internals.QueueChanged.wait(
+        lock, [&internals]() { return internals.Stopping || !internals.Queue.empty(); });
+      if (internals.Queue.empty())
+      {
+        // stopping, and every queued time step was processed.
+        return;
+      }
+      dataDescription = internals.Queue.front().DataDescription;
+      internals.Queue.pop_front();
+      internals.Processing = true;
+    }
+    internals.JobProgressed.notify_all();
+
+    const int success = this->CoProcessPipelines(dataDescription);
+    dataDescription = nullptr;
+
+    {
+      std::lock_guard<std::mutex> lock(internals.QueueMutex);
+      internals.Processing = false;
+      internals.Failed = internals.Failed || !success;
+    }
+    internals.JobProgressed.notify_all();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkCPProcessor::SubmitAsynchronousCoProcessing(vtkCPDataDescription* dataDescription)
+{
+  vtkCPProcessorInternals& internals = *this->Internal;
+  const size_t depth = static_cast<size_t>(this->MaximumQueueDepth);
+  const long long jobId = internals.NextJobId++;
+
+  std::unique_lock<std::mutex> lock(internals.QueueMutex);
+  bool skip = false;
+  if (this->BackPressurePolicy == BLOCK_WHEN_FULL)
+  {
+    // every process queues every time step, no need to agree on anything.
+    internals.JobProgressed.wait(
+      lock, [&internals, depth]() { return internals.Queue.size() < depth; });
+  }
+  else
+  {
+    // The lock is held while agreeing so that no queued time step starts
+    // being processed meanwhile. The co-processing thread may have to wait
+    // for it, but the simulation threads of all processes get here
+    // independently of the co-processing threads so this cannot deadlock.
+    const long long none = std::numeric_limits<long long>::max();
+    long long local[2] = { internals.Queue.size() >= depth ? 1 : 0,
+      internals.Queue.empty() ? none : internals.Queue.front().Id };
+    long long global[2] = { local[0], local[1] };
+    if (internals.DecisionController)
+    {
+      internals.DecisionController->AllReduce(local, global, 2, vtkCommunicator::MAX_OP);
+    }
+
+    if (global[0] != 0)
+    {
+      // global[1] is the oldest waiting time step on the process that is the
+      // furthest ahead, so it is still waiting on all processes. If one
+      // process has nothing waiting, skip the new time step instead.
+      skip = (this->BackPressurePolicy == SKIP_NEWEST || global[1] == none);
+      if (!skip)
+      {
+        const long long dropId = global[1];
+        internals.Queue.erase(std::remove_if(internals.Queue.begin(), internals.Queue.end(),
+                                [dropId](const vtkCPProcessorInternals::Job& job) {
+                                  return job.Id == dropId;
+                                }),
+          internals.Queue.end());
+      }
+      internals.NumberOfDiscardedTimeSteps++;
+    }
+  }
+
+  const int success = internals.Failed ? 0 : 1;
+  internals.Failed = false;
+  if (skip)
+  {
+    return success;
+  }
+  lock.unlock();
+
+  // Snapshot the inputs since the simulation may change them as soon as we
+  // return.
+  vtkCPProcessorInternals::Job job;
+  job.Id = jobId;
+  job.DataDescription = vtkSmartPointer<vtkCPDataDescription>::New();
+  job.DataDescription->Copy(dataDescription);
+  for (unsigned int i = 0; i < job.DataDescription->GetNumberOfInputDescriptions(); i++)
+  {
+    vtkCPInputDataDescription* idd = job.DataDescription->GetInputDescription(i);
+    if (vtkDataObject* grid = idd->GetGrid())
+    {
+      vtkSmartPointer<vtkDataObject> snapshot;
+      snapshot.TakeReference(grid->NewInstance());
+      snapshot->DeepCopy(grid);
+      idd->SetGrid(snapshot);
+    }
+  }
+
+  lock.lock();
+  internals.Queue.push_back(job);
+  lock.unlock();
+  internals.QueueChanged.notify_one();
+  return success;
+}
+
+//----------------------------------------------------------------------------
+int vtkCPProcessor::WaitForAsynchronousCoProcessing()
+{
+  vtkCPProcessorInternals& internals = *this->Internal;
+  std::unique_lock<std::mutex> lock(internals.QueueMutex);
+  internals.JobProgressed.wait(
+    lock, [&internals]() { return internals.Queue.empty() && !internals.Processing; });
+  const int success = internals.Failed ? 0 : 1;
+  internals.Failed = false;
   return success;
 }
 
+//----------------------------------------------------------------------------
+int vtkCPProcessor::GetNumberOfDiscardedTimeSteps()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->QueueMutex);
+  return this->Internal->NumberOfDiscardedTimeSteps;
+}
+
 //----------------------------------------------------------------------------
 int vtkCPProcessor::Finalize()
 {
+  this->StopAsynchronousCoProcessing();
+
   if (this->Controller)
   {
     this->Controller->SetGlobalController(nullptr);
@@ -375,6 +1021,12 @@ int vtkCPProcessor::Finalize()
 void vtkCPProcessor::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "Asynchronous: " << this->Asynchronous << "\n";
+  os << indent << "MaximumQueueDepth: " << this->MaximumQueueDepth << "\n";
+  os << indent << "BackPressurePolicy: " << this->BackPressurePolicy << "\n";
+  os << indent << "InstrumentationFileName: "
+     << (this->InstrumentationFileName ? this->InstrumentationFileName : "(none)") << "\n";
+  os << indent << "InstrumentationFormat: " << this->InstrumentationFormat << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -123,6 +123,78 @@ public:
   /// implementation an opportunity to clean up, before it is destroyed.
   virtual int Finalize();
 
+  /// When set, CoProcess() records the wall time, the peak resident memory
+  /// and the number of bytes written by the process while each pipeline
+  /// executes, as well as the wall time of each filter, and appends them to
+  /// this file on process 0 after each time step. The values are reduced over
+  /// all processes (minimum, maximum and average). Memory is in KiB. Bytes
+  /// written are only available on Linux, and include everything the process
+  /// writes. Default is nullptr, which disables the instrumentation.
+  vtkSetStringMacro(InstrumentationFileName);
+  vtkGetStringMacro(InstrumentationFileName);
+
+  enum InstrumentationFormats
+  {
+    /// One line per pipeline and per filter.
+    CSV_INSTRUMENTATION = 0,
+    /// One JSON object per time step and per line.
+    JSON_INSTRUMENTATION = 1
+  };
+
+  /// Format of the instrumentation file. Default is CSV_INSTRUMENTATION.
+  vtkSetClampMacro(InstrumentationFormat, int, CSV_INSTRUMENTATION, JSON_INSTRUMENTATION);
+  vtkGetMacro(InstrumentationFormat, int);
+
+  /// Policies applied when CoProcess() is called in asynchronous mode while
+  /// MaximumQueueDepth time steps are already waiting to be processed.
+  enum BackPressurePolicies
+  {
+    /// Wait until the oldest waiting time step starts being processed.
+    BLOCK_WHEN_FULL = 0,
+    /// Discard the oldest waiting time step to make room for the new one.
+    DROP_OLDEST = 1,
+    /// Discard the new time step.
+    SKIP_NEWEST = 2
+  };
+
+  /// When Asynchronous is on, CoProcess() takes a snapshot (deep copy) of the
+  /// input grids and returns right away while the pipelines execute on a
+  /// dedicated co-processing thread, so that the simulation can proceed with
+  /// the next time steps. Default is off.
+  ///
+  /// The pipelines are then executed concurrently with RequestDataDescription()
+  /// which must be safe to call while a time step is being processed. Python
+  /// pipelines require VTK to be built with VTK_PYTHON_FULL_THREADSAFE. With
+  /// more than one process, MPI must provide MPI_THREAD_MULTIPLE and the
+  /// simulation should not use the communicator given to Catalyst while it
+  /// runs, otherwise co-processing stays synchronous. Note that the working
+  /// directory of the process changes while a time step is processed if
+  /// WorkingDirectory is set.
+  virtual void SetAsynchronous(bool);
+  vtkGetMacro(Asynchronous, bool);
+  vtkBooleanMacro(Asynchronous, bool);
+
+  /// Maximum number of time steps waiting to be processed in asynchronous mode,
+  /// not counting the one being processed. Default is 1.
+  vtkSetClampMacro(MaximumQueueDepth, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumQueueDepth, int);
+
+  /// Policy applied when the queue is full in asynchronous mode. With more
+  /// than one process, all processes make the same decision so that every
+  /// process executes the pipelines for the same time steps. Default is
+  /// BLOCK_WHEN_FULL.
+  vtkSetClampMacro(BackPressurePolicy, int, BLOCK_WHEN_FULL, SKIP_NEWEST);
+  vtkGetMacro(BackPressurePolicy, int);
+
+  /// Waits until all the time steps queued in asynchronous mode are processed.
+  /// Returns 0 if processing any of them failed since the last call to
+  /// CoProcess() or WaitForAsynchronousCoProcessing(), and 1 otherwise.
+  virtual int WaitForAsynchronousCoProcessing();
+
+  /// Returns the number of time steps discarded by the DROP_OLDEST and
+  /// SKIP_NEWEST policies.
+  int GetNumberOfDiscardedTimeSteps();
+
   /// Get the current working directory for outputting Catalyst files.
   /// If not set then Catalyst output files will be relative to the
   /// current working directory. This will not affect where Catalyst
@@ -137,6 +209,11 @@ protected:
   /// Create a new instance of the InitializationHelper.
   virtual vtkObject* NewInitializationHelper();
 
+  /// Executes the pipelines for the given data description. CoProcess() calls
+  /// it directly in synchronous mode and the co-processing thread calls it
+  /// with a snapshot of the data description in asynchronous mode.
+  virtual int CoProcessPipelines(vtkCPDataDescription* dataDescription);
+
   /// Set the current working directory for outputting Catalyst files.
   /// This is a protected method since simulation code adaptors should
   /// set this through the *Initialize()* methods.
@@ -146,11 +223,33 @@ private:
   vtkCPProcessor(const vtkCPProcessor&) = delete;
   void operator=(const vtkCPProcessor&) = delete;
 
+  /// Starts the co-processing thread if needed. Returns false if co-processing
+  /// cannot be asynchronous.
+  bool StartAsynchronousCoProcessing();
+
+  /// Processes the queued time steps then stops the co-processing thread.
+  void StopAsynchronousCoProcessing();
+
+  /// Queues a snapshot of dataDescription according to BackPressurePolicy.
+  int SubmitAsynchronousCoProcessing(vtkCPDataDescription* dataDescription);
+
+  /// Body of the co-processing thread.
+  void ProcessQueue();
+
+  /// Reduces the instrumentation records of the time step over all processes
+  /// and writes them to InstrumentationFileName.
+  void WriteInstrumentation(vtkCPDataDescription* dataDescription);
+
   vtkCPProcessorInternals* Internal;
   vtkObject* InitializationHelper;
   static vtkMultiProcessController* Controller;
   char* WorkingDirectory;
+  char* InstrumentationFileName = nullptr;
+  int InstrumentationFormat = CSV_INSTRUMENTATION;
   int TemporalCacheSize = 0;
+  bool Asynchronous = false;
+  int MaximumQueueDepth = 1;
+  int BackPressurePolicy = BLOCK_WHEN_FULL;
 };
 
 #endif
@@ -52,6 +52,7 @@
 #include "vtkInformationStringKey.h"
 #include "vtkInformationVector.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkUnstructuredGrid.h"
@@ -61,7 +62,10 @@
 #include "cdi.h"
 #include "vtk_netcdf.h"
 
+#include <atomic>
+#include <mutex>
 #include <sstream>
+#include <vector>
 
 using namespace std;
 
@@ -107,6 +111,7 @@ public:
       this->CellVarIDs[i] = -1;
       this->DomainVars[i] = std::string("");
     }
+    this->ProjectedMode = -1;
   }
   ~Internal() = default;
 
@@ -123,6 +128,21 @@ public:
   vtkSmartPointer<vtkIdTypeArray> PointsToSendToProcesses;
   vtkSmartPointer<vtkIdTypeArray> PointsToSendToProcessesLengths;
   vtkSmartPointer<vtkIdTypeArray> PointsToSendToProcessesOffsets;
+
+  // The deduplicated vertex coordinates of the local cells and the partition
+  // and grid they were read for. The connectivity and vertex ids stay in
+  // OrigConnections and VertexIds.
+  std::vector<double> VertexLon;
+  std::vector<double> VertexLat;
+  std::vector<int> GridKey;
+
+  // The projection PointX/Y/Z were computed with, -1 if none.
+  int ProjectedMode;
+
+  // Points, cells, coordinate and mask arrays of the output and the settings
+  // they were built with, shared by every time step.
+  vtkSmartPointer<vtkUnstructuredGrid> Geometry;
+  std::vector<int> GeometryKey;
 };
 
 namespace
@@ -130,6 +150,10 @@ namespace
 //----------------------------------------------------------------------------
 //  CDI helper functions
 //----------------------------------------------------------------------------
+// Neither the CDI library nor netCDF are thread safe, the variables loaded
+// concurrently read the file one after the other.
+std::mutex CDIMutex;
+
 void cdi_set_cur(CDIVar* cdiVar, int Timestep, int level)
 {
   cdiVar->Timestep = Timestep;
@@ -141,6 +165,7 @@ void cdi_get_part(CDIVar* cdiVar, int start, size_t size, T* buffer, int nlevels
 {
   size_t nmiss;
   int memtype = 0;
+  std::lock_guard<std::mutex> lock(CDIMutex);
   int nrecs = streamInqTimestep(cdiVar->StreamID, cdiVar->Timestep);
   if (nrecs > 0)
   {
@@ -499,6 +524,15 @@ vtkCDIReader::~vtkCDIReader()
   delete[] this->DomainVarDataArray;
   this->DomainVarDataArray = nullptr;
 
+  vtkDebugMacro("Destructing grid geometry..." << endl);
+  delete[] this->PointX;
+  delete[] this->PointY;
+  delete[] this->PointZ;
+  delete[] this->DepthVar;
+  delete[] this->VertexIds;
+  delete[] this->OrigConnections;
+  delete[] this->ModConnections;
+
   vtkDebugMacro("Destructing other stuff..." << endl);
   if (this->PointDataArraySelection)
   {
@@ -826,23 +860,9 @@ int vtkCDIReader::RequestData(vtkInformation* vtkNotUsed(reqInfo),
   vtkDebugMacro("dTimeTemp: " << dTimeTemp << endl);
   this->DTime = dTimeTemp;
 
-  for (int var = 0; var < this->NumberOfCellVars; var++)
-  {
-    if (this->GetCellArrayStatus(this->Internals->CellVars[var].Name))
-    {
-      vtkDebugMacro("Loading Cell Variable: " << this->Internals->CellVars[var].Name << endl);
-      this->LoadCellVarData(var, this->DTime);
-      output->GetCellData()->AddArray(this->CellVarDataArray[var]);
-    }
-  }
-  for (int var = 0; var < this->NumberOfPointVars; var++)
+  if (!this->LoadSelectedVarData())
   {
-    if (this->GetPointArrayStatus(this->Internals->PointVars[var].Name))
-    {
-      vtkDebugMacro("Loading Point Variable: " << var << endl);
-      this->LoadPointVarData(var, this->DTime);
-      output->GetPointData()->AddArray(this->PointVarDataArray[var]);
-    }
+    return 0;
   }
 
   for (int var = 0; var < this->NumberOfDomainVars; var++)
@@ -955,23 +975,9 @@ int vtkCDIReader::RegenerateGeometry()
   output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), dTimeTemp);
   this->DTime = dTimeTemp;
 
-  for (int var = 0; var < this->NumberOfCellVars; var++)
-  {
-    if (this->GetCellArrayStatus(this->Internals->CellVars[var].Name))
-    {
-      vtkDebugMacro("Loading Cell Variable: " << this->Internals->CellVars[var].Name << endl);
-      this->LoadCellVarData(var, this->DTime);
-      output->GetCellData()->AddArray(this->CellVarDataArray[var]);
-    }
-  }
-  for (int var = 0; var < this->NumberOfPointVars; var++)
+  if (!this->LoadSelectedVarData())
   {
-    if (this->GetPointArrayStatus(this->Internals->PointVars[var].Name))
-    {
-      vtkDebugMacro("Loading Point Variable: " << var << endl);
-      this->LoadPointVarData(var, this->DTime);
-      output->GetPointData()->AddArray(this->PointVarDataArray[var]);
-    }
+    return 0;
   }
 
   for (int var = 0; var < this->NumberOfDomainVars; var++)
@@ -1030,10 +1036,15 @@ void vtkCDIReader::SetDefaults()
   this->InvertedTopography = false;
   this->IncludeTopography = false;
   this->Decomposition = false;
+  this->LoadVariablesConcurrently = false;
 
   this->PointX = nullptr;
   this->PointY = nullptr;
   this->PointZ = nullptr;
+  this->CLonVertices = nullptr;
+  this->CLatVertices = nullptr;
+  this->DepthVar = nullptr;
+  this->VertexIds = nullptr;
   this->OrigConnections = nullptr;
   this->ModConnections = nullptr;
   this->CLon = nullptr;
@@ -1546,6 +1557,20 @@ int vtkCDIReader::ReadAndOutputGrid(bool init)
 {
   vtkDebugMacro("In vtkCDIReader::ReadAndOutputGrid" << endl);
 
+  // The geometry does not depend on the time step, only rebuild it when one of
+  // the settings it is built with changes.
+  const std::vector<int> geometryKey = { this->Piece, this->NumPieces, this->NumberOfCells,
+    this->PointsPerCell, this->MaximumNVertLevels, this->ProjectionMode, this->ShowMultilayerView,
+    this->LayerThickness, this->VerticalLevelSelected, this->InvertZAxis, this->IncludeTopography,
+    static_cast<int>(this->MaskingValue) };
+  if (this->Internals->Geometry && !this->ReconstructNew &&
+    this->Internals->GeometryKey == geometryKey)
+  {
+    vtkDebugMacro("Reusing the grid geometry" << endl);
+    this->Output->ShallowCopy(this->Internals->Geometry);
+    return 1;
+  }
+
   if (this->ProjectionMode == 0)
   {
     if (!this->AllocSphereGeometry())
@@ -1576,8 +1601,12 @@ int vtkCDIReader::ReadAndOutputGrid(bool init)
     }
   }
 
-  this->OutputPoints(init);
-  this->OutputCells(init);
+  vtkSmartPointer<vtkUnstructuredGrid> geometry = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  this->OutputPoints(geometry, init);
+  this->OutputCells(geometry, init);
+  this->Internals->Geometry = geometry;
+  this->Internals->GeometryKey = geometryKey;
+  this->Output->ShallowCopy(geometry);
 
   // Allocate the data arrays which will hold the NetCDF var data
   vtkDebugMacro("pointVarData: Alloc " << this->MaximumPoints << " doubles" << endl);
@@ -1687,6 +1716,9 @@ int vtkCDIReader::ConstructGridGeometry()
   vtkDebugMacro("Starting grid reconstruction ..." << endl);
   int size = this->NumberLocalCells * this->PointsPerCell;
   int size2 = this->NumberAllCells * this->PointsPerCell;
+  delete[] this->DepthVar;
+  delete[] this->OrigConnections;
+  delete[] this->VertexIds;
   this->CLonVertices = new double[size];
   this->CLatVertices = new double[size];
   this->DepthVar = new double[this->MaximumNVertLevels];
@@ -1702,7 +1734,7 @@ int vtkCDIReader::ConstructGridGeometry()
   char units[CDI_MAX_NAME];
   this->OrigConnections = new int[size];
   CHECK_NEW(this->OrigConnections);
-  int* new_cells = new int[2];
+  int new_cells[2];
 
   if (this->ProjectionMode != 4)
   {
@@ -1730,27 +1762,12 @@ int vtkCDIReader::ConstructGridGeometry()
   this->NumberLocalCells = floor(new_cells[0] / 3.0);
   this->NumberLocalPoints = new_cells[1];
 
-  this->PointX = new double[this->NumberLocalPoints];
-  this->PointY = new double[this->NumberLocalPoints];
-  this->PointZ = new double[this->NumberLocalPoints];
-  CHECK_NEW(this->PointX);
-  CHECK_NEW(this->PointY);
-  CHECK_NEW(this->PointZ);
-
-  // now get the individual coordinates out of the clon/clat vertices
-  for (int i = 0; i < this->NumberLocalPoints; i++)
-  {
-    ::LLtoXYZ(this->CLonVertices[i], this->CLatVertices[i], &PointX[i], &PointY[i], &PointZ[i],
-      this->ProjectionMode);
-  }
-
-  // mirror the mesh if needed
-  if (ProjectionMode == 0)
-  {
-    this->MirrorMesh();
-  }
-  this->GridReconstructed = true;
-  this->ReconstructNew = false;
+  // keep the unique vertices, they are projected again when the projection
+  // changes
+  this->Internals->VertexLon.assign(
+    this->CLonVertices, this->CLonVertices + this->NumberLocalPoints);
+  this->Internals->VertexLat.assign(
+    this->CLatVertices, this->CLatVertices + this->NumberLocalPoints);
 
   // if we run with data decomposition, we need to know the mapping of points
   this->VertexIds = new int[size];
@@ -1762,7 +1779,7 @@ int vtkCDIReader::ConstructGridGeometry()
   {
     if (this->Piece == 0)
     {
-      int* new_cells2 = new int[2];
+      int new_cells2[2];
       double* clon_vert2 = new double[size2];
       double* clat_vert2 = new double[size2];
       CHECK_NEW(clon_vert2);
@@ -1821,6 +1838,70 @@ int vtkCDIReader::ConstructGridGeometry()
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// Read the grid once per partition and only project its vertices again when
+// the projection changes.
+//----------------------------------------------------------------------------
+int vtkCDIReader::UpdateGridGeometry()
+{
+  // the vertices are kept in degrees for the Catalyst projection
+  const std::vector<int> gridKey = { this->Piece, this->NumPieces, this->NumberOfCells,
+    this->PointsPerCell, this->MaximumNVertLevels, this->ProjectionMode == 4 };
+  if (!this->GridReconstructed || this->Internals->GridKey != gridKey)
+  {
+    if (!this->ConstructGridGeometry())
+    {
+      return 0;
+    }
+    this->Internals->GridKey = gridKey;
+    this->Internals->ProjectedMode = -1;
+  }
+
+  if (this->Internals->ProjectedMode != this->ProjectionMode || this->ReconstructNew)
+  {
+    if (!this->ProjectGridPoints())
+    {
+      return 0;
+    }
+  }
+
+  this->GridReconstructed = true;
+  this->ReconstructNew = false;
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// Project the vertices of the grid
+//----------------------------------------------------------------------------
+int vtkCDIReader::ProjectGridPoints()
+{
+  vtkDebugMacro("Projecting grid points ..." << endl);
+  delete[] this->PointX;
+  delete[] this->PointY;
+  delete[] this->PointZ;
+  this->PointX = new double[this->NumberLocalPoints];
+  this->PointY = new double[this->NumberLocalPoints];
+  this->PointZ = new double[this->NumberLocalPoints];
+  CHECK_NEW(this->PointX);
+  CHECK_NEW(this->PointY);
+  CHECK_NEW(this->PointZ);
+
+  // now get the individual coordinates out of the clon/clat vertices
+  for (int i = 0; i < this->NumberLocalPoints; i++)
+  {
+    ::LLtoXYZ(this->Internals->VertexLon[i], this->Internals->VertexLat[i], &PointX[i],
+      &PointY[i], &PointZ[i], this->ProjectionMode);
+  }
+
+  // mirror the mesh if needed
+  if (ProjectionMode == 0)
+  {
+    this->MirrorMesh();
+  }
+  this->Internals->ProjectedMode = this->ProjectionMode;
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 // Allocate into sphere view of geometry
 // This is work in progress, but as almost all variables are cell based, it
@@ -1846,9 +1927,9 @@ int vtkCDIReader::AllocSphereGeometry()
 {
   vtkDebugMacro("In AllocSphereGeometry..." << endl);
 
-  if (!GridReconstructed || this->ReconstructNew)
+  if (!this->UpdateGridGeometry())
   {
-    this->ConstructGridGeometry();
+    return 0;
   }
 
   if (this->ShowMultilayerView)
@@ -1875,11 +1956,12 @@ int vtkCDIReader::AllocLatLonGeometry()
 {
   vtkDebugMacro("In AllocLatLonGeometry..." << endl);
 
-  if (!GridReconstructed || this->ReconstructNew)
+  if (!this->UpdateGridGeometry())
   {
-    this->ConstructGridGeometry();
+    return 0;
   }
 
+  delete[] this->ModConnections;
   this->ModConnections = new int[this->NumberLocalCells * this->PointsPerCell];
   CHECK_NEW(this->ModConnections);
 
@@ -2173,11 +2255,10 @@ int vtkCDIReader::EliminateXWrap()
 //----------------------------------------------------------------------------
 //  Add points to vtk data structures
 //----------------------------------------------------------------------------
-void vtkCDIReader::OutputPoints(bool init)
+void vtkCDIReader::OutputPoints(vtkUnstructuredGrid* output, bool init)
 {
   vtkDebugMacro("In OutputPoints..." << endl);
   float layerThicknessScaleFactor = 5000.0;
-  vtkUnstructuredGrid* output = this->Output;
   vtkSmartPointer<vtkPoints> points;
   float adjustedLayerThickness = (this->LayerThickness / layerThicknessScaleFactor);
 
@@ -2301,16 +2382,6 @@ void vtkCDIReader::OutputPoints(bool init)
       }
     }
   }
-
-  if (this->ReconstructNew)
-  {
-    delete[] this->PointX;
-    this->PointX = nullptr;
-    delete[] this->PointY;
-    this->PointY = nullptr;
-    delete[] this->PointZ;
-    this->PointZ = nullptr;
-  }
   vtkDebugMacro("Leaving OutputPoints..." << endl);
 }
 
@@ -2336,10 +2407,9 @@ unsigned char vtkCDIReader::GetCellType()
 //----------------------------------------------------------------------------
 //  Add cells to vtk data structures
 //----------------------------------------------------------------------------
-void vtkCDIReader::OutputCells(bool init)
+void vtkCDIReader::OutputCells(vtkUnstructuredGrid* output, bool init)
 {
   vtkDebugMacro("In OutputCells..." << endl);
-  vtkUnstructuredGrid* output = this->Output;
 
   if (init)
   {
@@ -2447,15 +2517,77 @@ void vtkCDIReader::OutputCells(bool init)
     output->GetCellData()->AddArray(mask);
   }
 
-  if (this->ReconstructNew)
+  vtkDebugMacro("Leaving OutputCells..." << endl);
+}
+
+//----------------------------------------------------------------------------
+//  Load the selected cell and Point variables of the current time step,
+//  concurrently if LoadVariablesConcurrently is on, and add them to the output.
+//----------------------------------------------------------------------------
+int vtkCDIReader::LoadSelectedVarData()
+{
+  vtkUnstructuredGrid* output = this->Output;
+
+  // cell variables are stored as their index, Point variables as -(index + 1)
+  std::vector<int> selected;
+  for (int var = 0; var < this->NumberOfCellVars; var++)
+  {
+    if (this->GetCellArrayStatus(this->Internals->CellVars[var].Name))
+    {
+      vtkDebugMacro("Loading Cell Variable: " << this->Internals->CellVars[var].Name << endl);
+      selected.push_back(var);
+    }
+  }
+  for (int var = 0; var < this->NumberOfPointVars; var++)
   {
-    delete[] this->ModConnections;
-    this->ModConnections = nullptr;
-    delete[] this->OrigConnections;
-    this->OrigConnections = nullptr;
+    if (this->GetPointArrayStatus(this->Internals->PointVars[var].Name))
+    {
+      vtkDebugMacro("Loading Point Variable: " << var << endl);
+      selected.push_back(-(var + 1));
+    }
   }
 
-  vtkDebugMacro("Leaving OutputCells..." << endl);
+  // The reads themselves are serialized by the CDI lock.
+  std::atomic<bool> failed(false);
+  auto loadVars = [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end && !failed; ++i)
+    {
+      const int var = selected[i];
+      if (!(var >= 0 ? this->LoadCellVarData(var, this->DTime)
+                     : this->LoadPointVarData(-(var + 1), this->DTime)))
+      {
+        failed = true;
+      }
+    }
+  };
+  const vtkIdType numSelected = static_cast<vtkIdType>(selected.size());
+  if (this->LoadVariablesConcurrently)
+  {
+    vtkSMPTools::For(0, numSelected, 1, loadVars);
+  }
+  else
+  {
+    loadVars(0, numSelected);
+  }
+  if (failed)
+  {
+    vtkErrorMacro("Failed to load the selected variables" << endl);
+    return 0;
+  }
+
+  for (int var : selected)
+  {
+    if (var >= 0)
+    {
+      output->GetCellData()->AddArray(this->CellVarDataArray[var]);
+    }
+    else
+    {
+      output->GetPointData()->AddArray(this->PointVarDataArray[-(var + 1)]);
+    }
+  }
+
+  return 1;
 }
 
 //----------------------------------------------------------------------------
@@ -2463,8 +2595,6 @@ void vtkCDIReader::OutputCells(bool init)
 //----------------------------------------------------------------------------
 int vtkCDIReader::LoadPointVarData(int variableIndex, double dTimeStep)
 {
-  this->PointDataSelected = variableIndex;
-
   vtkDataArray* dataArray = this->PointVarDataArray[variableIndex];
 
   // Allocate data array for this variable
@@ -2502,8 +2632,6 @@ int vtkCDIReader::LoadPointVarData(int variableIndex, double dTimeStep)
 //----------------------------------------------------------------------------
 int vtkCDIReader::LoadCellVarData(int variableIndex, double dTimeStep)
 {
-  this->CellDataSelected = variableIndex;
-
   vtkDataArray* dataArray = this->CellVarDataArray[variableIndex];
   // Allocate data array for this variable
   if (dataArray == nullptr)
@@ -3264,6 +3392,7 @@ void vtkCDIReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Projection: " << this->ProjectionMode << endl;
   os << indent << "DoublePrecision: " << (this->DoublePrecision ? "ON" : "OFF") << endl;
   os << indent << "ShowMultilayerView: " << (this->ShowMultilayerView ? "ON" : "OFF") << endl;
+  os << indent << "LoadVariablesConcurrently: " << this->LoadVariablesConcurrently << endl;
   os << indent << "InvertZ: " << (this->InvertZAxis ? "ON" : "OFF") << endl;
   os << indent << "UseTopography: " << (this->IncludeTopography ? "ON" : "OFF") << endl;
   os << indent << "SetInvertTopography: " << (this->InvertedTopography ? "ON" : "OFF") << endl;
@@ -145,6 +145,13 @@ public:
   void SetShowMultilayerView(bool val);
   vtkGetMacro(ShowMultilayerView, bool);
 
+  // Load the selected variables of a time step concurrently with vtkSMPTools,
+  // off by default. The CDI library is not thread safe, so the file reads are
+  // serialized and only the reordering of the values runs concurrently.
+  vtkSetMacro(LoadVariablesConcurrently, bool);
+  vtkGetMacro(LoadVariablesConcurrently, bool);
+  vtkBooleanMacro(LoadVariablesConcurrently, bool);
+
 #ifdef PARAVIEW_USE_MPI
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   virtual void SetController(vtkMultiProcessController*);
@@ -166,15 +173,18 @@ protected:
   int AllocLatLonGeometry();
   int EliminateXWrap();
   int EliminateYWrap();
-  void OutputPoints(bool init);
-  void OutputCells(bool init);
+  void OutputPoints(vtkUnstructuredGrid* output, bool init);
+  void OutputCells(vtkUnstructuredGrid* output, bool init);
   unsigned char GetCellType();
   void LoadGeometryData(int var, double dTime);
   int LoadPointVarData(int variable, double dTime);
   int LoadCellVarData(int variable, double dTime);
   int LoadDomainVarData(int variable);
+  int LoadSelectedVarData();
   int RegenerateGeometry();
+  int UpdateGridGeometry();
   int ConstructGridGeometry();
+  int ProjectGridPoints();
   int LoadClonClatVars();
   int MirrorMesh();
   bool BuildDomainCellVars();
@@ -254,6 +264,7 @@ protected:
   bool DoublePrecision;
   bool ShowMultilayerView;
   bool IncludeTopography;
+  bool LoadVariablesConcurrently;
   bool HaveDomainData;
   bool HaveDomainVariable;
   bool BuildDomainArrays;
@@ -42,13 +42,20 @@ static const int NO_COMPRESSION = 0;
 static const int LZ4_COMPRESSION = 1;
 static const int SQUIRT_COMPRESSION = 2;
 static const int ZLIB_COMPRESSION = 3;
-static const int NVPIPE_COMPRESSION = 4;
+static const int TILED_LZ4_COMPRESSION = 4;
+static const int DELTA_LZ4_COMPRESSION = 5;
+static const int NVPIPE_COMPRESSION = 6;
 //-----------------------------------------------------------------------------
 
 class pqImageCompressorWidget::pqInternals
 {
 public:
   Ui::ImageCompressorWidget Ui;
+  // Number of tiles for vtkTiledImageCompressor, not exposed in the UI.
+  int NumberOfTiles = 0;
+  // Key frame interval and tile size for vtkDeltaImageCompressor, not exposed
+  // in the UI.
+  QString DeltaOptions;
 };
 
 //-----------------------------------------------------------------------------
@@ -122,6 +129,20 @@ void pqImageCompressorWidget::setCompressorConfig(const QString& value)
                     "\\s+"     // space
                     "([0-9]+)" // num-of-bits.
                     "$");
+  QRegExp tiledLZ4RegExp("^vtkTiledImageCompressor"
+                         "\\s+"          // space
+                         "0"             // 0
+                         "\\s+"          // space
+                         "([0-9]+)"      // num-of-bits.
+                         "(\\s+[0-9]+)?" // optional number of tiles.
+                         "$");
+  QRegExp deltaLZ4RegExp("^vtkDeltaImageCompressor"
+                         "\\s+"               // space
+                         "0"                  // 0
+                         "\\s+"               // space
+                         "([0-9]+)"           // num-of-bits.
+                         "((\\s+[0-9]+){0,2})" // optional key frame interval and tile size.
+                         "$");
   QRegExp nvpipeRegExp("^vtkNvPipeCompressor"
                        "\\s+"     // space
                        "0"        // 0
@@ -151,6 +172,20 @@ void pqImageCompressorWidget::setCompressorConfig(const QString& value)
     ui.zlibColorSpace->setValue(numBits);
     ui.zlibStripAlpha->setCheckState(stripAlpha ? Qt::Checked : Qt::Unchecked);
   }
+  else if (tiledLZ4RegExp.exactMatch(value))
+  {
+    int numBits = tiledLZ4RegExp.cap(1).toInt();
+    this->Internals->NumberOfTiles = tiledLZ4RegExp.cap(2).trimmed().toInt();
+    ui.compressionType->setCurrentIndex(TILED_LZ4_COMPRESSION);
+    ui.squirtColorSpace->setValue(numBits);
+  }
+  else if (deltaLZ4RegExp.exactMatch(value))
+  {
+    int numBits = deltaLZ4RegExp.cap(1).toInt();
+    this->Internals->DeltaOptions = deltaLZ4RegExp.cap(2);
+    ui.compressionType->setCurrentIndex(DELTA_LZ4_COMPRESSION);
+    ui.squirtColorSpace->setValue(numBits);
+  }
   else if (nvpipeRegExp.exactMatch(value))
   {
     int level = nvpipeRegExp.cap(1).toInt();
@@ -181,6 +216,16 @@ QString pqImageCompressorWidget::compressorConfig() const
         .arg(ui.zlibColorSpace->value())
         .arg(ui.zlibStripAlpha->isChecked() ? 1 : 0);
 
+    case TILED_LZ4_COMPRESSION: // lz4, compressed in tiles concurrently
+      return QString("vtkTiledImageCompressor 0 %1 %2")
+        .arg(ui.squirtColorSpace->value())
+        .arg(this->Internals->NumberOfTiles);
+
+    case DELTA_LZ4_COMPRESSION: // lz4, changed tiles only
+      return QString("vtkDeltaImageCompressor 0 %1%2")
+        .arg(ui.squirtColorSpace->value())
+        .arg(this->Internals->DeltaOptions);
+
     case NVPIPE_COMPRESSION: // nvpipe
       return QString("vtkNvPipeCompressor 0 %1").arg(ui.nvpLevel->value());
   }
@@ -192,8 +237,10 @@ QString pqImageCompressorWidget::compressorConfig() const
 void pqImageCompressorWidget::currentIndexChanged(int index)
 {
   Ui::ImageCompressorWidget& ui = this->Internals->Ui;
-  ui.squirtLabel->setVisible(index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION);
-  ui.squirtColorSpace->setVisible(index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION);
+  const bool useColorSpace = index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION ||
+    index == TILED_LZ4_COMPRESSION || index == DELTA_LZ4_COMPRESSION;
+  ui.squirtLabel->setVisible(useColorSpace);
+  ui.squirtColorSpace->setVisible(useColorSpace);
 
   ui.zlibLabel1->setVisible(index == ZLIB_COMPRESSION);
   ui.zlibLabel2->setVisible(index == ZLIB_COMPRESSION);
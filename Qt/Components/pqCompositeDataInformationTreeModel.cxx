@@ -35,6 +35,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "vtkPVCompositeDataInformation.h"
 #include "vtkPVDataInformation.h"
 #include "vtkPVLogger.h"
+#include "vtkSMOutputPort.h"
+#include "vtkWeakPointer.h"
 
 #include <QList>
 #include <QSet>
@@ -62,6 +64,7 @@ class CNode
   int NumberOfPieces;
   CNode* Parent;
   std::vector<CNode> Children;
+  bool Pending; // true for a block of a summary whose information is not fetched yet.
 
   std::pair<Qt::CheckState, bool> CheckState; // bool is true if value was explicitly set,
                                               // false, if value is inherited.
@@ -147,6 +150,7 @@ public:
     , DataType(0)
     , NumberOfPieces(-1)
     , Parent(nullptr)
+    , Pending(false)
     , CheckState(Qt::Unchecked, false)
     , ForceSetState(Qt::Unchecked)
     , CustomColumnState()
@@ -190,6 +194,7 @@ public:
   }
 
   inline unsigned int flatIndex() const { return this->Index; }
+  inline bool pending() const { return this->Pending; }
   inline unsigned int leafIndex() const { return this->LeafIndex; }
   inline const QString& name() const { return this->Name; }
   QString dataTypeAsString() const
@@ -368,7 +373,11 @@ public:
       this->Name = info != nullptr ? info->GetPrettyDataTypeString() : "(empty)";
       this->DataType = info != nullptr ? info->GetDataSetType() : -1;
       this->CustomColumnState.resize(custom_column_count);
-      this->LeafIndex = leaf_index++;
+      this->LeafIndex = leaf_index;
+      if (leaf_index != VTK_UNSIGNED_INT_MAX)
+      {
+        leaf_index++;
+      }
       return false;
     }
 
@@ -377,6 +386,26 @@ public:
     this->CustomColumnState.resize(custom_column_count);
 
     vtkPVCompositeDataInformation* cinfo = info->GetCompositeDataInformation();
+    if (cinfo->GetIsSummary())
+    {
+      // per-block information was not gathered, add a placeholder for each
+      // block. Its information is fetched when it is expanded, see fetch().
+      this->Children.resize(cinfo->GetNumberOfChildren());
+      for (unsigned int cc = 0, max = cinfo->GetNumberOfChildren(); cc < max; ++cc)
+      {
+        CNode& childNode = this->Children[cc];
+        childNode.Index = this->Index + cinfo->GetSummarizedChildOffset(cc);
+        lookupMap[childNode.Index] = &childNode;
+        childNode.Parent = this;
+        childNode.Pending = true;
+        childNode.DataType = -1;
+        childNode.CustomColumnState.resize(custom_column_count);
+        const char* name = cinfo->GetName(cc);
+        childNode.Name = (name && name[0]) ? QString(name) : QString("Block %1").arg(cc);
+      }
+      index = this->Index + cinfo->GetSummarizedChildOffset(cinfo->GetNumberOfChildren());
+      return true;
+    }
 
     bool is_amr = (this->DataType == VTK_HIERARCHICAL_DATA_SET ||
       this->DataType == VTK_HIERARCHICAL_BOX_DATA_SET || this->DataType == VTK_UNIFORM_GRID_AMR ||
@@ -414,10 +443,71 @@ public:
       this->LeafIndex = leaf_index;
       // move leaf_index forward by however many pieces this multipiece dataset
       // has.
-      leaf_index += cinfo->GetNumberOfChildren();
+      if (leaf_index != VTK_UNSIGNED_INT_MAX)
+      {
+        leaf_index += cinfo->GetNumberOfChildren();
+      }
     }
     return true;
   }
+
+  // Builds the subtree of a placeholder node from the information fetched for
+  // its block. The leaves of that subtree have no leaf index since the blocks
+  // of the summary are not counted.
+  void fetch(vtkPVDataInformation* info, bool expand_multi_piece, int custom_column_count,
+    std::unordered_map<unsigned int, CNode*>& lookupMap,
+    pqCompositeDataInformationTreeModel* dmodel)
+  {
+    if (!this->Pending)
+    {
+      return;
+    }
+
+    int count = 0;
+    if (info && info->GetCompositeDataClassName())
+    {
+      vtkPVCompositeDataInformation* cinfo = info->GetCompositeDataInformation();
+      if (!cinfo->GetDataIsMultiPiece() || expand_multi_piece)
+      {
+        count = static_cast<int>(cinfo->GetNumberOfChildren());
+      }
+    }
+
+    // build() resets the node, keep what the placeholder was given.
+    CNode* parentNode = this->Parent;
+    const QString name = this->Name;
+    const auto checkState = this->CheckState;
+    const Qt::CheckState forceSetState = this->ForceSetState;
+    const auto customColumnState = this->CustomColumnState;
+
+    const QModelIndex idx = this->createIndex(dmodel);
+    if (count > 0)
+    {
+      dmodel->beginInsertRows(idx, 0, count - 1);
+    }
+    unsigned int index = this->Index;
+    unsigned int leaf_index = VTK_UNSIGNED_INT_MAX;
+    this->build(info, expand_multi_piece, index, leaf_index, custom_column_count, lookupMap);
+    this->Parent = parentNode;
+    this->Name = name;
+    this->CheckState = checkState;
+    this->ForceSetState = forceSetState;
+    this->CustomColumnState = customColumnState;
+    if (count > 0)
+    {
+      dmodel->endInsertRows();
+    }
+
+    // the blocks inherit the check state and the custom column values.
+    this->setChildrenCheckState(this->CheckState.first, false, dmodel);
+    for (int col = 0; col < custom_column_count; ++col)
+    {
+      const bool explicitlySet = this->CustomColumnState[col].second;
+      this->setCustomColumnState(col, this->CustomColumnState[col].first, false, dmodel);
+      this->CustomColumnState[col].second = explicitlySet;
+    }
+    dmodel->dataChanged(idx, idx);
+  }
 };
 }
 
@@ -467,6 +557,17 @@ public:
 
   CNode& rootNode() { return this->Root; }
 
+  void fetch(CNode& node, bool expand_multi_piece, pqCompositeDataInformationTreeModel* dmodel)
+  {
+    if (node.pending() && this->OutputPort)
+    {
+      node.fetch(this->OutputPort->GetSubsetDataInformation(node.flatIndex()), expand_multi_piece,
+        this->CustomColumns.size(), this->CNodeMap, dmodel);
+    }
+  }
+
+  vtkWeakPointer<vtkSMOutputPort> OutputPort;
+
   void clearCheckState(pqCompositeDataInformationTreeModel* dmodel)
   {
     this->Root.setChecked(dmodel->defaultCheckState(), true, dmodel);
@@ -526,6 +627,36 @@ int pqCompositeDataInformationTreeModel::rowCount(const QModelIndex& parentIdx)
   return node.childrenCount();
 }
 
+//-----------------------------------------------------------------------------
+bool pqCompositeDataInformationTreeModel::hasChildren(const QModelIndex& parentIdx) const
+{
+  pqInternals& internals = (*this->Internals);
+  if (parentIdx.isValid() && parentIdx.column() == 0 && internals.OutputPort &&
+    internals.find(parentIdx).pending())
+  {
+    return true;
+  }
+  return this->Superclass::hasChildren(parentIdx);
+}
+
+//-----------------------------------------------------------------------------
+bool pqCompositeDataInformationTreeModel::canFetchMore(const QModelIndex& parentIdx) const
+{
+  pqInternals& internals = (*this->Internals);
+  return parentIdx.isValid() && internals.OutputPort && internals.find(parentIdx).pending();
+}
+
+//-----------------------------------------------------------------------------
+void pqCompositeDataInformationTreeModel::fetchMore(const QModelIndex& parentIdx)
+{
+  if (!parentIdx.isValid())
+  {
+    return;
+  }
+  pqInternals& internals = (*this->Internals);
+  internals.fetch(internals.find(parentIdx), this->ExpandMultiPiece, this);
+}
+
 //-----------------------------------------------------------------------------
 QModelIndex pqCompositeDataInformationTreeModel::index(
   int row, int column, const QModelIndex& parentIdx) const
@@ -736,6 +867,20 @@ bool pqCompositeDataInformationTreeModel::reset(vtkPVDataInformation* info)
   return retVal;
 }
 
+//-----------------------------------------------------------------------------
+void pqCompositeDataInformationTreeModel::setOutputPort(vtkSMOutputPort* port)
+{
+  pqInternals& internals = (*this->Internals);
+  internals.OutputPort = port;
+}
+
+//-----------------------------------------------------------------------------
+vtkSMOutputPort* pqCompositeDataInformationTreeModel::outputPort() const
+{
+  pqInternals& internals = (*this->Internals);
+  return internals.OutputPort;
+}
+
 //-----------------------------------------------------------------------------
 void pqCompositeDataInformationTreeModel::setChecked(const QList<unsigned int>& indices)
 {
@@ -38,6 +38,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <QScopedPointer> // for ivar.
 
 class vtkPVDataInformation;
+class vtkSMOutputPort;
 
 namespace pqCompositeDataInformationTreeModelNS
 {
@@ -74,6 +75,13 @@ class CNode;
  * pqTreeViewExpandState to attempt to preserve expand state on QTreeView nodes
  * across model resets.
  *
+ * When the data information only summarizes a composite dataset, see
+ * vtkPVCompositeDataInformation::GetIsSummary(), the model shows a placeholder
+ * node for each block. If the output port the information comes from was set
+ * with `setOutputPort`, the information for a placeholder is fetched with
+ * vtkSMOutputPort::GetSubsetDataInformation() when the node is expanded, i.e.
+ * on `fetchMore`, and its subtree is added to the model.
+ *
  * There are few properties on this model that should be set prior to calling
  * reset that determine how the model behaves. To allow the user to check/uncheck nodes
  * on the tree, set **userCheckable** to true (default: false). To expand datasets in a
@@ -176,6 +184,20 @@ public:
     int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
   bool setHeaderData(int section, Qt::Orientation orientation, const QVariant& value,
     int role = Qt::DisplayRole) override;
+  bool hasChildren(const QModelIndex& parent = QModelIndex()) const override;
+  bool canFetchMore(const QModelIndex& parent) const override;
+  void fetchMore(const QModelIndex& parent) override;
+  //@}
+
+  //@{
+  /**
+   * Set the output port the data information passed to `reset` comes from.
+   * It is used to fetch the information for the blocks of a summarized
+   * composite dataset on demand. Without it, these blocks cannot be expanded.
+   * The model does not keep a reference to the port.
+   */
+  void setOutputPort(vtkSMOutputPort* port);
+  vtkSMOutputPort* outputPort() const;
   //@}
 
   //@{
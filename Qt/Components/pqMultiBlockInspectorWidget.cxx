@@ -46,6 +46,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "pqTreeViewExpandState.h"
 #include "pqUndoStack.h"
 #include "pqView.h"
+#include "vtkPVCompositeDataInformation.h"
+#include "vtkPVDataInformation.h"
 #include "vtkPVLogger.h"
 #include "vtkSMDoubleMapProperty.h"
 #include "vtkSMDoubleMapPropertyIterator.h"
@@ -726,8 +728,9 @@ public:
       this->HasOpacities = false;
     }
     this->updateRootLabel();
-    bool is_composite =
-      this->CDTModel->reset(port != nullptr ? port->getDataInformation() : nullptr);
+    vtkPVDataInformation* dataInfo = port != nullptr ? port->getDataInformation() : nullptr;
+    this->CDTModel->setOutputPort(port != nullptr ? port->getOutputPortProxy() : nullptr);
+    bool is_composite = this->CDTModel->reset(dataInfo);
     if (!is_composite)
     {
       this->ProxyModel->setSourceModel(nullptr);
@@ -735,7 +738,10 @@ public:
     else
     {
       this->ProxyModel->setSourceModel(this->CDTModel);
-      this->Ui.treeView->expandToDepth(1);
+      // expanding the blocks of a summary would fetch the information for all
+      // of them.
+      const bool isSummary = dataInfo->GetCompositeDataInformation()->GetIsSummary();
+      this->Ui.treeView->expandToDepth(isSummary ? 0 : 1);
 
       QHeaderView* header = this->Ui.treeView->header();
       if (header->count() == 3 && header->logicalIndex(2) != 0)
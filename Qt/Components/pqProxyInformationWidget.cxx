@@ -164,6 +164,7 @@ pqOutputPort* pqProxyInformationWidget::getOutputPort()
 //-----------------------------------------------------------------------------
 void pqProxyInformationWidget::updateInformation()
 {
+  this->Ui->compositeTreeModel->setOutputPort(nullptr);
   this->Ui->compositeTreeModel->reset(nullptr);
   this->Ui->hierarchyTabWidget->setVisible(false);
   this->Ui->filename->setText(tr("NA"));
@@ -196,10 +197,14 @@ void pqProxyInformationWidget::updateInformation()
   vtkVLogScopeF(PARAVIEW_LOG_APPLICATION_VERBOSITY(), "update-information-panel for `%s`",
     source->getProxy()->GetLogNameOrDefault());
 
+  this->Ui->compositeTreeModel->setOutputPort(this->OutputPort->getOutputPortProxy());
   if (this->Ui->compositeTreeModel->reset(dataInformation))
   {
     this->Ui->hierarchyTabWidget->setVisible(true);
-    this->Ui->compositeTree->expandToDepth(1);
+    // expanding the blocks of a summary would fetch the information for all of
+    // them.
+    const bool isSummary = dataInformation->GetCompositeDataInformation()->GetIsSummary();
+    this->Ui->compositeTree->expandToDepth(isSummary ? 0 : 1);
     this->Ui->compositeTree->selectionModel()->setCurrentIndex(
       this->Ui->compositeTreeModel->rootIndex(), QItemSelectionModel::ClearAndSelect);
     this->Ui->assemblyTreeModel->setDataAssembly(assembly);
@@ -529,13 +534,11 @@ void pqProxyInformationWidget::fillDataInformation(vtkPVDataInformation* dataInf
 //-----------------------------------------------------------------------------
 void pqProxyInformationWidget::onCurrentChanged(const QModelIndex& idx)
 {
-  vtkPVDataInformation* dataInformation =
-    this->OutputPort ? this->OutputPort->getDataInformation() : nullptr;
-  if (dataInformation && idx.isValid())
+  vtkSMOutputPort* port = this->OutputPort ? this->OutputPort->getOutputPortProxy() : nullptr;
+  if (port && idx.isValid())
   {
     unsigned int cid = this->Ui->compositeTreeModel->compositeIndex(idx);
-    vtkPVDataInformation* info = dataInformation->GetDataInformationForCompositeIndex(cid);
-    this->fillDataInformation(info);
+    this->fillDataInformation(port->GetSubsetDataInformation(cid));
   }
 }
 
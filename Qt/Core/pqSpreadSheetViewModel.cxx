@@ -47,6 +47,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "vtkSMCoreUtilities.h"
 #include "vtkSMInputProperty.h"
 #include "vtkSMIntVectorProperty.h"
+#include "vtkSMOutputPort.h"
 #include "vtkSMPropertyHelper.h"
 #include "vtkSMSourceProxy.h"
 #include "vtkSMStringVectorProperty.h"
@@ -580,7 +581,9 @@ void pqSpreadSheetViewModel::resetCompositeDataSetIndex()
     return;
   }
 
-  vtkPVDataInformation* blockInfo = mbInfo->GetDataInformationForCompositeIndex(cur_index);
+  vtkSMOutputPort* extractPort = extractSelection->GetOutputPort(0u);
+  vtkPVDataInformation* blockInfo =
+    extractPort->GetSubsetDataInformation(static_cast<unsigned int>(cur_index));
   if (blockInfo && blockInfo->GetNumberOfPoints() > 0)
   {
     return;
@@ -0,0 +1,115 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    BenchmarkClientServerStream.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Measures how many messages per second can be parsed and interpreted
+// from a stream similar to what a state file load sends to the server.
+
+#include "vtkClientServerInterpreter.h"
+#include "vtkClientServerStream.h"
+#include "vtkNew.h"
+#include "vtkObject.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+int NumberOfCalls = 0;
+
+// Command function standing in for the wrapper of a class.
+int BenchmarkCommand(vtkClientServerInterpreter*, vtkObjectBase*, const char* method,
+  const vtkClientServerStream& msg, vtkClientServerStream& result, void*)
+{
+  int index;
+  double values[3];
+  if (strcmp(method, "SetValues") == 0 && msg.GetNumberOfArguments(0) == 4 &&
+    msg.GetArgument(0, 2, &index) && msg.GetArgument(0, 3, values, 3) && values[0] == index)
+  {
+    ++NumberOfCalls;
+    return 1;
+  }
+  result << vtkClientServerStream::Error << "Unexpected call." << vtkClientServerStream::End;
+  return 0;
+}
+}
+
+int BenchmarkClientServerStream(int, char* [])
+{
+  const int numberOfMessages = 50000;
+  const int numberOfIterations = 5;
+
+  vtkNew<vtkClientServerInterpreter> interp;
+  interp->AddCommandFunction("vtkObject", BenchmarkCommand);
+
+  vtkNew<vtkObject> object;
+  vtkClientServerID id(1);
+  vtkClientServerStream assign;
+  assign << vtkClientServerStream::Assign << id << object.GetPointer()
+         << vtkClientServerStream::End;
+  if (!interp->ProcessStream(assign))
+  {
+    cerr << "ERROR: Could not assign the target object." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Build the stream the way a client would send it.
+  vtkClientServerStream stream;
+  for (int i = 0; i < numberOfMessages; ++i)
+  {
+    double values[3] = { static_cast<double>(i), i + 1.0, i + 2.0 };
+    stream << vtkClientServerStream::Invoke << id << "SetValues" << i
+           << vtkClientServerStream::InsertArray(values, 3) << vtkClientServerStream::End;
+  }
+  const unsigned char* data;
+  size_t length;
+  stream.GetData(&data, &length);
+
+  double parseTime = 0.0;
+  double interpretTime = 0.0;
+  for (int iteration = 0; iteration < numberOfIterations; ++iteration)
+  {
+    // Parsing happens in place on the received buffer.
+    std::vector<unsigned char> buffer(data, data + length);
+    auto start = std::chrono::steady_clock::now();
+    vtkClientServerStream received;
+    if (!received.SetDataInPlace(&buffer[0], buffer.size()) ||
+      received.GetNumberOfMessages() != numberOfMessages)
+    {
+      cerr << "ERROR: Could not parse the stream." << endl;
+      return EXIT_FAILURE;
+    }
+    auto parsed = std::chrono::steady_clock::now();
+
+    NumberOfCalls = 0;
+    if (!interp->ProcessStream(received) || NumberOfCalls != numberOfMessages)
+    {
+      cerr << "ERROR: Only " << NumberOfCalls << " of " << numberOfMessages
+           << " messages were interpreted." << endl;
+      return EXIT_FAILURE;
+    }
+    auto interpreted = std::chrono::steady_clock::now();
+
+    parseTime += std::chrono::duration<double>(parsed - start).count();
+    interpretTime += std::chrono::duration<double>(interpreted - parsed).count();
+  }
+
+  double total = static_cast<double>(numberOfMessages) * numberOfIterations;
+  cout << "Stream size: " << length << " bytes, " << numberOfMessages << " messages" << endl;
+  cout << "Parse:      " << total / parseTime << " messages/sec" << endl;
+  cout << "Interpret:  " << total / interpretTime << " messages/sec" << endl;
+  cout << "Total:      " << total / (parseTime + interpretTime) << " messages/sec" << endl;
+  return EXIT_SUCCESS;
+}
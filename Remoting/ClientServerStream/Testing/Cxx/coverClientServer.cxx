@@ -4,6 +4,8 @@
 #include "vtkStringArray.h"
 #include "vtkVariantArray.h"
 
+#include <vector>
+
 static double dblIni[] = { 904., 906., 917. };
 static const char* strIni[] = { "901", "Turbo", "Targa" };
 
@@ -340,7 +342,48 @@ bool do_test()
   return true;
 }
 
+// Parse the data of a stream in place and read its arrays back.
+bool do_test_in_place()
+{
+  std::vector<double> values(2048);
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = static_cast<double>(i);
+  }
+  int small[3] = { 1, 2, 3 };
+
+  vtkClientServerStream css;
+  css << vtkClientServerStream::Reply << "array"
+      << vtkClientServerStream::InsertArray(&values[0], static_cast<int>(values.size()))
+      << vtkClientServerStream::InsertArray(small, 3) << vtkClientServerStream::End;
+  const unsigned char* data;
+  size_t length;
+  if (!css.GetData(&data, &length))
+  {
+    cerr << "FAILED: GetData failed." << endl;
+    return false;
+  }
+
+  std::vector<unsigned char> buffer(data, data + length);
+  vtkClientServerStream received;
+  if (!received.SetDataInPlace(&buffer[0], buffer.size()))
+  {
+    cerr << "FAILED: SetDataInPlace failed." << endl;
+    return false;
+  }
+
+  std::vector<double> result(values.size());
+  int smallResult[3];
+  if (!received.GetArgument(0, 1, &result[0], static_cast<vtkTypeUInt32>(result.size())) ||
+    result != values || !received.GetArgument(0, 2, smallResult, 3) || smallResult[2] != 3)
+  {
+    cerr << "FAILED: Arrays did not round-trip." << endl;
+    return false;
+  }
+  return true;
+}
+
 int coverClientServer(int, char* [])
 {
-  return do_test() ? 0 : 1;
+  return (do_test() && do_test_in_place()) ? 0 : 1;
 }
@@ -76,6 +76,31 @@ public:
   NewInstanceFunctionsType NewInstanceFunctions;
   ClassToFunctionMapType ClassToFunctionMap;
   IDToMessageMapType IDToMessageMap;
+
+  // Most recently used command function.  Consecutive messages usually
+  // target objects of the same class.
+  std::string LastCommandClass;
+  const CommandFunction* LastCommandFunction = nullptr;
+
+  const CommandFunction* FindCommandFunction(const char* cname)
+  {
+    if (!cname)
+    {
+      return nullptr;
+    }
+    if (this->LastCommandFunction && this->LastCommandClass == cname)
+    {
+      return this->LastCommandFunction;
+    }
+    ClassToFunctionMapType::const_iterator f = this->ClassToFunctionMap.find(cname);
+    if (f == this->ClassToFunctionMap.end())
+    {
+      return nullptr;
+    }
+    this->LastCommandClass = cname;
+    this->LastCommandFunction = f->second;
+    return f->second;
+  }
 };
 
 //----------------------------------------------------------------------------
@@ -392,9 +417,13 @@ int vtkClientServerInterpreter::ProcessCommandNew(const vtkClientServerStream& c
 //----------------------------------------------------------------------------
 int vtkClientServerInterpreter::ProcessCommandInvoke(const vtkClientServerStream& css, int midx)
 {
-  // Create a message with all known id_value arguments expanded.
+  // Create a message with all known id_value arguments expanded.  When
+  // only the target object needs to be looked up, the message is used
+  // in place instead.  The log always shows the expanded form.
   vtkClientServerStream msg;
-  if (!this->ExpandMessage(css, midx, 0, msg))
+  vtkObjectBase* obj = nullptr;
+  bool referenced = !this->LogStream && this->ReferenceInvokeMessage(css, midx, msg, &obj);
+  if (!referenced && !this->ExpandMessage(css, midx, 0, msg))
   {
     // ExpandMessage left an error in the LastResultMessage for us.
     return 0;
@@ -405,9 +434,8 @@ int vtkClientServerInterpreter::ProcessCommandInvoke(const vtkClientServerStream
   this->LastResultMessage->Reset();
 
   // Get the object and method to be invoked.
-  vtkObjectBase* obj;
   const char* method;
-  if (msg.GetNumberOfArguments(0) >= 2 && msg.GetArgument(0, 0, &obj) &&
+  if (msg.GetNumberOfArguments(0) >= 2 && (referenced || msg.GetArgument(0, 0, &obj)) &&
     msg.GetArgument(0, 1, &method))
   {
     // Log the expanded form of the message.
@@ -419,10 +447,12 @@ int vtkClientServerInterpreter::ProcessCommandInvoke(const vtkClientServerStream
     }
 
     // Find the command function for this object's type.
-    if (obj && this->HasCommandFunction(obj->GetClassName()))
+    const vtkClientServerInterpreterInternals::CommandFunction* n =
+      obj ? this->Internal->FindCommandFunction(obj->GetClassName()) : nullptr;
+    if (n)
     {
-      if (this->CallCommandFunction(
-            obj->GetClassName(), obj, method, msg, *this->LastResultMessage))
+      void* ctx = n->Context ? n->Context->Context : 0;
+      if (n->Function(this, obj, method, msg, *this->LastResultMessage, ctx))
       {
         return 1;
       }
@@ -610,9 +640,11 @@ int vtkClientServerInterpreter::ExpandMessage(
   }
 
   // Expand id_value for remaining arguments.
-  for (a = startArgument; a < in.GetNumberOfArguments(inIndex); ++a)
+  int numArgs = in.GetNumberOfArguments(inIndex);
+  for (a = startArgument; a < numArgs; ++a)
   {
-    if (in.GetArgumentType(inIndex, a) == vtkClientServerStream::id_value)
+    vtkClientServerStream::Types type = in.GetArgumentType(inIndex, a);
+    if (type == vtkClientServerStream::id_value)
     {
       vtkClientServerID id;
       in.GetArgument(inIndex, a, &id);
@@ -630,7 +662,7 @@ int vtkClientServerInterpreter::ExpandMessage(
         out << in.GetArgument(inIndex, a);
       }
     }
-    else if (in.GetArgumentType(inIndex, a) == vtkClientServerStream::LastResult)
+    else if (type == vtkClientServerStream::LastResult)
     {
       // Insert the last result value.
       for (int b = 0; b < this->LastResultMessage->GetNumberOfArguments(0); ++b)
@@ -638,7 +670,7 @@ int vtkClientServerInterpreter::ExpandMessage(
         out << this->LastResultMessage->GetArgument(0, b);
       }
     }
-    else if (in.GetArgumentType(inIndex, a) == vtkClientServerStream::stream_value)
+    else if (type == vtkClientServerStream::stream_value)
     {
       // Evaluate the expression and insert the result.
       vtkClientServerStream* lastResult = this->LastResultMessage;
@@ -670,6 +702,60 @@ int vtkClientServerInterpreter::ExpandMessage(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkClientServerInterpreter::ReferenceInvokeMessage(
+  const vtkClientServerStream& in, int inIndex, vtkClientServerStream& out, vtkObjectBase** obj)
+{
+  // The last result is reset before the message is invoked.
+  int numArgs = in.GetNumberOfArguments(inIndex);
+  if (numArgs < 2 || &in == this->LastResultMessage)
+  {
+    return 0;
+  }
+
+  // Look up the target object.
+  switch (in.GetArgumentType(inIndex, 0))
+  {
+    case vtkClientServerStream::vtk_object_pointer:
+      if (!in.GetArgument(inIndex, 0, obj))
+      {
+        return 0;
+      }
+      break;
+    case vtkClientServerStream::id_value:
+    {
+      vtkClientServerID id;
+      const vtkClientServerStream* tmp = nullptr;
+      if (!in.GetArgument(inIndex, 0, &id) || !(tmp = this->GetMessageFromID(id)) ||
+        tmp->GetNumberOfArguments(0) != 1 || !tmp->GetArgument(0, 0, obj))
+      {
+        return 0;
+      }
+    }
+    break;
+    default:
+      return 0;
+  }
+
+  // All other arguments must be usable without expansion.
+  for (int a = 1; a < numArgs; ++a)
+  {
+    switch (in.GetArgumentType(inIndex, a))
+    {
+      case vtkClientServerStream::id_value:
+      case vtkClientServerStream::LastResult:
+      case vtkClientServerStream::stream_value:
+        return 0;
+      default:
+        break;
+    }
+  }
+
+  // Command functions skip the object and method arguments, so they can
+  // be given the message as it is.
+  return out.ReferenceMessage(in, inIndex);
+}
+
 //----------------------------------------------------------------------------
 const vtkClientServerStream* vtkClientServerInterpreter::GetMessageFromID(vtkClientServerID id)
 {
@@ -793,17 +879,15 @@ bool vtkClientServerInterpreter::HasCommandFunction(const char* cname)
 int vtkClientServerInterpreter::CallCommandFunction(const char* cname, vtkObjectBase* ptr,
   const char* method, const vtkClientServerStream& msg, vtkClientServerStream& result)
 {
-  vtkClientServerInterpreterInternals::ClassToFunctionMapType::const_iterator f =
-    this->Internal->ClassToFunctionMap.find(cname);
+  const vtkClientServerInterpreterInternals::CommandFunction* n =
+    this->Internal->FindCommandFunction(cname);
 
-  if (f == this->Internal->ClassToFunctionMap.end())
+  if (!n)
   {
     vtkErrorMacro("Cannot find command function for \"" << cname << "\".");
     return 1;
   }
 
-  const vtkClientServerInterpreterInternals::CommandFunction* n = f->second;
-
   vtkClientServerCommandFunction function = n->Function;
   void* ctx = n->Context ? n->Context->Context : 0;
   return function(this, ptr, method, msg, result, ctx);
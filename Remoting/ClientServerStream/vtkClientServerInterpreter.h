@@ -209,6 +209,12 @@ protected:
   int ExpandMessage(
     const vtkClientServerStream& in, int inIndex, int startArgument, vtkClientServerStream& out);
 
+  // Make the out stream reference an Invoke message in place when only
+  // its target object needs to be looked up.  Returns 0 when the message
+  // must be expanded with ExpandMessage instead.
+  int ReferenceInvokeMessage(const vtkClientServerStream& in, int inIndex,
+    vtkClientServerStream& out, vtkObjectBase** obj);
+
   // Load a module dynamically given the full path to it.
   int LoadInternal(const char* moduleName, const char* fullPath);
 
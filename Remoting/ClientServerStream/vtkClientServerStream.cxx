@@ -134,12 +134,19 @@ class vtkClientServerStreamInternals
 {
 public:
   vtkClientServerStreamInternals(vtkObjectBase* owner)
-    : Objects(owner)
+    : AliasData(nullptr)
+    , AliasLength(0)
+    , AliasIsView(false)
+    , Objects(owner)
   {
   }
   vtkClientServerStreamInternals(const vtkClientServerStreamInternals& r, vtkObjectBase* owner)
     : Data(r.Data)
+    , AliasData(r.AliasData)
+    , AliasLength(r.AliasLength)
+    , AliasIsView(r.AliasIsView)
     , ValueOffsets(r.ValueOffsets)
+    , ValueTypes(r.ValueTypes)
     , MessageIndexes(r.MessageIndexes)
     , Objects(r.Objects, owner)
     , StartIndex(r.StartIndex)
@@ -152,10 +159,67 @@ public:
   typedef std::vector<unsigned char> DataType;
   DataType Data;
 
+  // Caller-owned buffer given to SetDataInPlace, or the part of another
+  // stream's buffer given to ReferenceMessage.  When set, it replaces
+  // Data as the storage of the stream.  A message view does not start
+  // with the byte order marker.
+  unsigned char* AliasData;
+  size_t AliasLength;
+  bool AliasIsView;
+
+  // Storage currently holding the stream data.
+  unsigned char* GetBuffer()
+  {
+    if (this->AliasData)
+    {
+      return this->AliasData;
+    }
+    return this->Data.empty() ? nullptr : &*this->Data.begin();
+  }
+  size_t GetBufferLength() const
+  {
+    return this->AliasData ? this->AliasLength : this->Data.size();
+  }
+
+  // Copy a buffer given to SetDataInPlace or ReferenceMessage into Data.
+  void Unalias()
+  {
+    if (this->AliasData)
+    {
+      this->Data.assign(this->AliasData, this->AliasData + this->AliasLength);
+      if (this->AliasIsView)
+      {
+        // Values in a view are already in the native representation.
+#ifdef VTK_WORDS_BIGENDIAN
+        this->Data[0] = vtkClientServerStream::BigEndian;
+#else
+        this->Data[0] = vtkClientServerStream::LittleEndian;
+#endif
+      }
+      this->AliasData = nullptr;
+      this->AliasLength = 0;
+      this->AliasIsView = false;
+    }
+  }
+
+  // Offset in the complete stream at which the next value will be written.
+  DataType::difference_type GetWriteOffset()
+  {
+    this->Unalias();
+    return static_cast<DataType::difference_type>(this->Data.size());
+  }
+
   // Offset to each value stored in the stream.
   typedef std::vector<DataType::difference_type> ValueOffsetsType;
   ValueOffsetsType ValueOffsets;
 
+  // Command or type identifier of each value stored in the stream,
+  // parallel to ValueOffsets.  Together with the offset of the next
+  // value this gives the type and size of any argument without
+  // reading the stream data.
+  typedef std::vector<vtkTypeUInt32> ValueTypesType;
+  ValueTypesType ValueTypes;
+
   // Index into ValueOffsets of the first value corresponding to each
   // message.
   typedef std::vector<ValueOffsetsType::size_type> MessageIndexesType;
@@ -270,14 +334,20 @@ vtkClientServerStream::~vtkClientServerStream()
 //----------------------------------------------------------------------------
 vtkClientServerStream::vtkClientServerStream(const vtkClientServerStream& r, vtkObjectBase* owner)
 {
-  // Allocate and copy the internal representation of the stream.
+  // Allocate and copy the internal representation of the stream.  The
+  // copy owns its data, so buffers used in place are copied.
   this->Internal = new vtkClientServerStreamInternals(*r.Internal, owner);
+  this->Internal->Unalias();
 }
 
 //----------------------------------------------------------------------------
 vtkClientServerStream& vtkClientServerStream::operator=(const vtkClientServerStream& that)
 {
-  *this->Internal = *that.Internal;
+  if (this != &that)
+  {
+    *this->Internal = *that.Internal;
+    this->Internal->Unalias();
+  }
   return *this;
 }
 
@@ -302,6 +372,7 @@ vtkClientServerStream& vtkClientServerStream::Write(const void* data, size_t len
   }
 
   // Copy the value into the data.
+  this->Internal->Unalias();
   this->Internal->Data.resize(this->Internal->Data.size() + length);
   memcpy(&*(this->Internal->Data.end() - length), data, length);
   return *this;
@@ -318,9 +389,14 @@ void vtkClientServerStream::Reset()
 {
   // Empty the entire stream.
   vtkClientServerStreamInternals::DataType().swap(this->Internal->Data);
+  this->Internal->AliasData = nullptr;
+  this->Internal->AliasLength = 0;
+  this->Internal->AliasIsView = false;
 
   this->Internal->ValueOffsets.erase(
     this->Internal->ValueOffsets.begin(), this->Internal->ValueOffsets.end());
+  this->Internal->ValueTypes.erase(
+    this->Internal->ValueTypes.begin(), this->Internal->ValueTypes.end());
   this->Internal->MessageIndexes.erase(
     this->Internal->MessageIndexes.begin(), this->Internal->MessageIndexes.end());
   this->Internal->Objects.Clear();
@@ -354,10 +430,11 @@ vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::
   this->Internal->StartIndex = this->Internal->ValueOffsets.size();
 
   // The command counts as the first value in the message.
-  this->Internal->ValueOffsets.push_back(this->Internal->Data.end() - this->Internal->Data.begin());
+  this->Internal->ValueOffsets.push_back(this->Internal->GetWriteOffset());
 
   // Store the command in the stream.
   vtkTypeUInt32 data = static_cast<vtkTypeUInt32>(t);
+  this->Internal->ValueTypes.push_back(data);
   return this->Write(&data, sizeof(data));
 }
 
@@ -385,10 +462,11 @@ vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::
 
   // All values write their type first.  Mark the start of this type
   // and optional value.
-  this->Internal->ValueOffsets.push_back(this->Internal->Data.end() - this->Internal->Data.begin());
+  this->Internal->ValueOffsets.push_back(this->Internal->GetWriteOffset());
 
   // Store the type in the stream.
   vtkTypeUInt32 data = static_cast<vtkTypeUInt32>(t);
+  this->Internal->ValueTypes.push_back(data);
   return this->Write(&data, sizeof(data));
 }
 
@@ -398,13 +476,13 @@ vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::
   if (a.Data && a.Size)
   {
     // Mark the start of this type and optional value.
-    this->Internal->ValueOffsets.push_back(
-      this->Internal->Data.end() - this->Internal->Data.begin());
+    this->Internal->ValueOffsets.push_back(this->Internal->GetWriteOffset());
 
     // If the argument is a vtk_object_pointer, we need to store a
     // reference to the object.
     vtkTypeUInt32 tp;
     memcpy(&tp, a.Data, sizeof(tp));
+    this->Internal->ValueTypes.push_back(tp);
     if (tp == vtkClientServerStream::vtk_object_pointer)
     {
       vtkObjectBase* obj;
@@ -438,15 +516,27 @@ vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::
 //----------------------------------------------------------------------------
 vtkClientServerStream& vtkClientServerStream::operator<<(const vtkClientServerStream& css)
 {
-  const unsigned char* data;
-  size_t length;
+  vtkClientServerStreamInternals* src = css.Internal;
   // Do not allow object pointers to be passed in binary form.
-  if (this != &css && css.Internal->Objects.empty() && css.GetData(&data, &length))
+  if (this != &css && src->Objects.empty() && !src->Invalid)
   {
     // Store the stream_value type, then length, then data.
+    const unsigned char* data = src->GetBuffer();
+    vtkTypeUInt32 size = static_cast<vtkTypeUInt32>(src->GetBufferLength());
     *this << vtkClientServerStream::stream_value;
-    vtkTypeUInt32 size = static_cast<vtkTypeUInt32>(length);
     this->Write(&size, sizeof(size));
+    if (src->AliasIsView && size > 0)
+    {
+      // A message view starts one byte before its message, which is not
+      // the byte order marker; its values are in the native representation.
+#ifdef VTK_WORDS_BIGENDIAN
+      const unsigned char order = vtkClientServerStream::BigEndian;
+#else
+      const unsigned char order = vtkClientServerStream::LittleEndian;
+#endif
+      this->Write(&order, 1);
+      return this->Write(data + 1, size - 1);
+    }
     return this->Write(data, size);
   }
   else
@@ -1476,17 +1566,18 @@ int vtkClientServerStream::GetArgumentObject(
 //----------------------------------------------------------------------------
 int vtkClientServerStream::GetData(const unsigned char** data, size_t* length) const
 {
-  // Do not return data unless stream is valid.
-  if (!this->Internal->Invalid)
+  // Do not return data unless stream is valid and contiguous.  A message
+  // view has no buffer holding the whole stream.
+  if (!this->Internal->Invalid && !this->Internal->AliasIsView)
   {
     if (data)
     {
-      *data = &*this->Internal->Data.begin();
+      *data = this->Internal->GetBuffer();
     }
 
     if (length)
     {
-      *length = this->Internal->Data.size();
+      *length = this->Internal->GetBufferLength();
     }
     return 1;
   }
@@ -1538,19 +1629,91 @@ int vtkClientServerStream::SetData(const unsigned char* data, size_t length)
   }
 }
 
+//----------------------------------------------------------------------------
+int vtkClientServerStream::SetDataInPlace(unsigned char* data, size_t length)
+{
+  // Reset and remove the byte order entry from the stream.
+  this->Reset();
+  this->Internal->Data.erase(this->Internal->Data.begin(), this->Internal->Data.end());
+
+  // Use the given buffer as the stream storage.
+  if (data && length)
+  {
+    this->Internal->AliasData = data;
+    this->Internal->AliasLength = length;
+  }
+
+  // Parse the stream in place.
+  if (this->ParseData())
+  {
+// Data have been byte-swapped to the native representation.
+#ifdef VTK_WORDS_BIGENDIAN
+    this->Internal->AliasData[0] = vtkClientServerStream::BigEndian;
+#else
+    this->Internal->AliasData[0] = vtkClientServerStream::LittleEndian;
+#endif
+    return 1;
+  }
+  else
+  {
+    // Data are invalid.  Reset the stream and report failure.
+    this->Reset();
+    return 0;
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkClientServerStream::ReferenceMessage(const vtkClientServerStream& source, int message)
+{
+  if (this == &source)
+  {
+    return 0;
+  }
+  this->Reset();
+  int numValues = source.GetNumberOfValues(message);
+  if (numValues <= 0)
+  {
+    return 0;
+  }
+
+  vtkClientServerStreamInternals* src = source.Internal;
+
+  // The view starts one byte before the message, where a stream stores
+  // its byte order, so that the message is its first message.
+  vtkClientServerStreamInternals::ValueOffsetsType::size_type first =
+    src->MessageIndexes[message];
+  vtkClientServerStreamInternals::ValueOffsetsType::size_type last = first + numValues - 1;
+  vtkClientServerStreamInternals::DataType::difference_type base = src->ValueOffsets[first] - 1;
+  vtkClientServerStreamInternals::DataType::difference_type end =
+    src->ValueOffsets[last] + static_cast<int>(sizeof(vtkTypeUInt32));
+
+  this->Internal->Data.erase(this->Internal->Data.begin(), this->Internal->Data.end());
+  this->Internal->AliasData = src->GetBuffer() + base;
+  this->Internal->AliasLength = static_cast<size_t>(end - base);
+  this->Internal->AliasIsView = true;
+  for (vtkClientServerStreamInternals::ValueOffsetsType::size_type i = first; i <= last; ++i)
+  {
+    this->Internal->ValueOffsets.push_back(src->ValueOffsets[i] - base);
+  }
+  this->Internal->ValueTypes.assign(
+    src->ValueTypes.begin() + first, src->ValueTypes.begin() + last + 1);
+  this->Internal->MessageIndexes.push_back(0);
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkClientServerStream::ParseData()
 {
   // Make sure we have at least one byte.
-  if (this->Internal->Data.empty())
+  if (this->Internal->GetBufferLength() == 0)
   {
     return 0;
   }
 
-  // We are not modifying the vector size.  It is safe to use pointers
+  // We are not modifying the buffer size.  It is safe to use pointers
   // into it.
-  unsigned char* begin = &*this->Internal->Data.begin();
-  unsigned char* end = begin + this->Internal->Data.size();
+  unsigned char* begin = this->Internal->GetBuffer();
+  unsigned char* end = begin + this->Internal->GetBufferLength();
 
   // Save the byte order.
   int order = *begin;
@@ -1653,11 +1816,14 @@ unsigned char* vtkClientServerStream::ParseCommand(
     return 0;
   }
   this->PerformByteSwap(order, data, 1, sizeof(vtkTypeUInt32));
+  vtkTypeUInt32 cmd;
+  memcpy(&cmd, data, sizeof(cmd));
 
   // Mark the start of the command.
   this->Internal->StartIndex =
     this->Internal->ValueOffsets.end() - this->Internal->ValueOffsets.begin();
   this->Internal->ValueOffsets.push_back(data - begin);
+  this->Internal->ValueTypes.push_back(cmd);
 
   // Return the position after the command identifier.
   return data + sizeof(vtkTypeUInt32);
@@ -1688,6 +1854,7 @@ unsigned char* vtkClientServerStream::ParseType(int order, unsigned char* data,
 
   // Record the start of this type and optional value.
   this->Internal->ValueOffsets.push_back(data - begin);
+  this->Internal->ValueTypes.push_back(tp);
 
   // Return the position after the type identifier.
   return data + sizeof(vtkTypeUInt32);
@@ -1867,7 +2034,7 @@ const unsigned char* vtkClientServerStream::GetValue(int message, int value) con
       this->Internal->MessageIndexes[message];
 
     // Return a pointer to the value-th value in the message.
-    const unsigned char* data = &*this->Internal->Data.begin();
+    const unsigned char* data = this->Internal->GetBuffer();
     return data + this->Internal->ValueOffsets[index + value];
   }
   else
@@ -1877,21 +2044,6 @@ const unsigned char* vtkClientServerStream::GetValue(int message, int value) con
 }
 
 //----------------------------------------------------------------------------
-// Templates to find argument size within a stream.
-template <class T>
-size_t vtkClientServerStreamValueSize(T*)
-{
-  return sizeof(T);
-}
-template <class T>
-size_t vtkClientServerStreamArraySize(const unsigned char* data, T*)
-{
-  // Get the length of the value in the stream.
-  vtkTypeUInt32 len;
-  memcpy(&len, data, sizeof(len));
-  return sizeof(len) + len * sizeof(T);
-}
-
 vtkClientServerStream::Argument vtkClientServerStream::GetArgument(int message, int argument) const
 {
   // Prepare a return value.
@@ -1900,53 +2052,16 @@ vtkClientServerStream::Argument vtkClientServerStream::GetArgument(int message,
   // Get a pointer to the type/value pair in the stream.
   if (const unsigned char* data = this->GetValue(message, 1 + argument))
   {
-    // Store the starting location of the value.
-    result.Data = data;
-
-    // Get the type of the value in the stream.
-    vtkTypeUInt32 tp;
-    memcpy(&tp, data, sizeof(tp));
-    data += sizeof(tp);
-
-    // Find the length of the argument's data based on its type.
-    switch (tp)
+    // The End marker of a message always follows its last argument, so
+    // the size of the argument is the distance to the next value.
+    vtkClientServerStreamInternals::ValueOffsetsType::size_type index =
+      this->Internal->MessageIndexes[message] + 1 + argument;
+    vtkTypeUInt32 tp = this->Internal->ValueTypes[index];
+    if (tp < vtkClientServerStream::End)
     {
-      VTK_CSS_TEMPLATE_MACRO(value, result.Size = sizeof(tp) + vtkClientServerStreamValueSize(T));
-      VTK_CSS_TEMPLATE_MACRO(
-        array, result.Size = sizeof(tp) + vtkClientServerStreamArraySize(data, T));
-      case vtkClientServerStream::id_value:
-      {
-        result.Size = sizeof(tp) + sizeof(vtkClientServerID().ID);
-      }
-      break;
-      case vtkClientServerStream::string_value:
-      {
-        // A string is represented as an array of 1 byte values.
-        vtkTypeUInt8* T = 0;
-        result.Size = sizeof(tp) + vtkClientServerStreamArraySize(data, T);
-      }
-      break;
-      case vtkClientServerStream::vtk_object_pointer:
-      {
-        result.Size = sizeof(tp) + sizeof(vtkObjectBase*);
-      }
-      break;
-      case vtkClientServerStream::stream_value:
-      {
-        // A stream is represented as an array of 1 byte values.
-        vtkTypeUInt8* T = 0;
-        result.Size = sizeof(tp) + vtkClientServerStreamArraySize(data, T);
-      }
-      break;
-      case vtkClientServerStream::LastResult:
-      {
-        result.Size = sizeof(tp);
-      }
-      break;
-      case vtkClientServerStream::End:
-      default:
-        result.Data = 0;
-        break;
+      result.Data = data;
+      result.Size = static_cast<size_t>(
+        this->Internal->ValueOffsets[index + 1] - this->Internal->ValueOffsets[index]);
     }
   }
   return result;
@@ -1956,11 +2071,10 @@ vtkClientServerStream::Argument vtkClientServerStream::GetArgument(int message,
 vtkClientServerStream::Commands vtkClientServerStream::GetCommand(int message) const
 {
   // The first value in a message is always the command.
-  if (const unsigned char* data = this->GetValue(message, 0))
+  if (this->GetNumberOfValues(message) > 0)
   {
-    // Retrieve the command value and convert it to the proper type.
-    vtkTypeUInt32 cmd;
-    memcpy(&cmd, data, sizeof(cmd));
+    // Retrieve the command value from the index.
+    vtkTypeUInt32 cmd = this->Internal->ValueTypes[this->Internal->MessageIndexes[message]];
     if (cmd < vtkClientServerStream::EndOfCommands)
     {
       return static_cast<vtkClientServerStream::Commands>(cmd);
@@ -1986,12 +2100,11 @@ int vtkClientServerStream::GetNumberOfArguments(int message) const
 //----------------------------------------------------------------------------
 vtkClientServerStream::Types vtkClientServerStream::GetArgumentType(int message, int argument) const
 {
-  // Get a pointer to the type/value pair in the stream.
-  if (const unsigned char* data = this->GetValue(message, 1 + argument))
+  // Look up the type of the value in the index.
+  if (argument >= 0 && 1 + argument < this->GetNumberOfValues(message))
   {
-    // Get the type of the value in the stream and convert it.
-    vtkTypeUInt32 type;
-    memcpy(&type, data, sizeof(type));
+    vtkTypeUInt32 type =
+      this->Internal->ValueTypes[this->Internal->MessageIndexes[message] + 1 + argument];
     if (type < vtkClientServerStream::End)
     {
       return static_cast<vtkClientServerStream::Types>(type);
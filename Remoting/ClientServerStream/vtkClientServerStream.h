@@ -244,7 +244,9 @@ public:
    * Get a pointer to the stream data and its length.  The values are
    * suitable for passing to another stream's SetData method, but are
    * invalidated when any further writing to the stream is done.
-   * Returns whether the stream is currently valid.
+   * Returns whether the stream is currently valid.  A stream made with
+   * ReferenceMessage has no contiguous buffer and returns 0; insert it
+   * in another stream to send it.
    */
   int GetData(const unsigned char** data, size_t* length) const;
 
@@ -335,6 +337,25 @@ public:
    */
   int SetData(const unsigned char* data, size_t length);
 
+  /**
+   * Same as SetData but the stream is parsed in place from the given
+   * buffer instead of copying it.  The buffer is byte-swapped to the
+   * native representation as needed and must remain valid until the
+   * stream is reset, assigned or destroyed.  Writing to the stream, or
+   * copying it, first copies the buffer into the stream's own storage.
+   */
+  int SetDataInPlace(unsigned char* data, size_t length);
+
+  /**
+   * Make this stream hold only the given message of another stream by
+   * referencing the source stream's data instead of copying it.  The
+   * source stream must not be modified, reset or destroyed while this
+   * stream is in use.  Returns whether the message exists.  This is
+   * used by vtkClientServerInterpreter to dispatch messages without
+   * copying them.
+   */
+  int ReferenceMessage(const vtkClientServerStream& source, int message);
+
   //--------------------------------------------------------------------------
   // Utility methods:
 
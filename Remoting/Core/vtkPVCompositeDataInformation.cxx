@@ -15,6 +15,8 @@
 #include "vtkPVCompositeDataInformation.h"
 
 #include "vtkClientServerStream.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataObjectTree.h"
 #include "vtkDataObjectTreeIterator.h"
 #include "vtkInformation.h"
 #include "vtkMultiPieceDataSet.h"
@@ -27,6 +29,7 @@
 #include "vtkUniformGrid.h"
 #include "vtkUniformGridAMR.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -42,6 +45,10 @@ struct vtkPVCompositeDataInformationInternals
   typedef std::vector<vtkNode> VectorOfDataInformation;
 
   VectorOfDataInformation ChildrenInformation;
+
+  // For a summary, the number of nodes, itself included, in the subtree of
+  // each child. The children have a name but no information.
+  std::vector<unsigned int> SummarizedChildrenSizes;
 };
 
 //----------------------------------------------------------------------------
@@ -52,6 +59,7 @@ vtkPVCompositeDataInformation::vtkPVCompositeDataInformation()
   this->DataIsMultiPiece = 0;
   this->NumberOfPieces = 0;
   this->NumberOfAMRLevels = 0;
+  this->IsSummary = false;
   // DON'T FORGET TO UPDATE Initialize().
 }
 
@@ -68,6 +76,7 @@ void vtkPVCompositeDataInformation::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "DataIsMultiPiece: " << this->DataIsMultiPiece << endl;
   os << indent << "DataIsComposite: " << this->DataIsComposite << endl;
   os << indent << "NumberOfAMRLevels: " << this->NumberOfAMRLevels << endl;
+  os << indent << "IsSummary: " << this->IsSummary << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -89,6 +98,17 @@ vtkPVDataInformation* vtkPVCompositeDataInformation::GetDataInformationForCompos
     (*index) -= this->NumberOfPieces;
   }
 
+  if (this->IsSummary)
+  {
+    // the summarized children hold no information, skip their subtrees.
+    (*index) -= static_cast<int>(this->GetSummarizedChildOffset(this->GetNumberOfChildren()) - 1);
+    if ((*index) < 0)
+    {
+      (*index) = -1;
+    }
+    return NULL;
+  }
+
   vtkPVCompositeDataInformationInternals::VectorOfDataInformation::iterator iter =
     this->Internal->ChildrenInformation.begin();
   for (; iter != this->Internal->ChildrenInformation.end(); ++iter)
@@ -120,14 +140,84 @@ void vtkPVCompositeDataInformation::Initialize()
   this->NumberOfPieces = 0;
   this->DataIsComposite = 0;
   this->NumberOfAMRLevels = 0;
+  this->IsSummary = false;
   this->Internal->ChildrenInformation.clear();
+  this->Internal->SummarizedChildrenSizes.clear();
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVCompositeDataInformation::CopySummaryFromObject(vtkCompositeDataSet* cds)
+{
+  this->Initialize();
+  if (!cds || vtkMultiPieceDataSet::SafeDownCast(cds) || vtkPartitionedDataSet::SafeDownCast(cds) ||
+    vtkUniformGridAMR::SafeDownCast(cds))
+  {
+    return false;
+  }
+
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(cds->NewIterator());
+  if (vtkDataObjectTreeIterator* treeIter = vtkDataObjectTreeIterator::SafeDownCast(iter))
+  {
+    treeIter->VisitOnlyLeavesOff();
+    treeIter->TraverseSubTreeOff();
+  }
+  iter->SkipEmptyNodesOff();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    // count the nodes under the child, the same way composite indices are
+    // assigned, so that the composite index of every child can be computed.
+    unsigned int size = 1;
+    if (vtkDataObjectTree* tree = vtkDataObjectTree::SafeDownCast(iter->GetCurrentDataObject()))
+    {
+      vtkSmartPointer<vtkDataObjectTreeIterator> subIter;
+      subIter.TakeReference(tree->NewTreeIterator());
+      subIter->VisitOnlyLeavesOff();
+      subIter->SkipEmptyNodesOff();
+      for (subIter->InitTraversal(); !subIter->IsDoneWithTraversal(); subIter->GoToNextItem())
+      {
+        size++;
+      }
+    }
+    this->Internal->SummarizedChildrenSizes.push_back(size);
+
+    vtkPVCompositeDataInformationInternals::vtkNode node;
+    if (iter->HasCurrentMetaData())
+    {
+      const char* name = iter->GetCurrentMetaData()->Get(vtkCompositeDataSet::NAME());
+      node.Name = name ? name : "";
+    }
+    this->Internal->ChildrenInformation.push_back(node);
+  }
+  this->DataIsComposite = 1;
+  this->IsSummary = true;
+  return true;
 }
 
 //----------------------------------------------------------------------------
 unsigned int vtkPVCompositeDataInformation::GetNumberOfChildren()
 {
-  return this->DataIsMultiPiece ? this->NumberOfPieces
-                                : static_cast<int>(this->Internal->ChildrenInformation.size());
+  if (this->DataIsMultiPiece)
+  {
+    return this->NumberOfPieces;
+  }
+  return static_cast<unsigned int>(this->Internal->ChildrenInformation.size());
+}
+
+//----------------------------------------------------------------------------
+unsigned int vtkPVCompositeDataInformation::GetSummarizedChildOffset(unsigned int idx)
+{
+  const std::vector<unsigned int>& sizes = this->Internal->SummarizedChildrenSizes;
+  if (!this->IsSummary || idx > sizes.size())
+  {
+    return 0;
+  }
+  unsigned int offset = 1;
+  for (unsigned int cc = 0; cc < idx; ++cc)
+  {
+    offset += sizes[cc];
+  }
+  return offset;
 }
 
 //----------------------------------------------------------------------------
@@ -311,6 +401,40 @@ void vtkPVCompositeDataInformation::AddInformation(vtkPVInformation* pvi)
     return;
   }
 
+  // When a process summarized its blocks, the merged information can only be
+  // a summary too. The children of a summary hold no information, only their
+  // name and the size of their subtree are merged.
+  if (this->IsSummary || info->IsSummary)
+  {
+    if (!this->IsSummary)
+    {
+      for (auto& child : this->Internal->ChildrenInformation)
+      {
+        child.Info = nullptr;
+      }
+    }
+    std::vector<unsigned int>& sizes = this->Internal->SummarizedChildrenSizes;
+    const std::vector<unsigned int>& otherSizes = info->Internal->SummarizedChildrenSizes;
+    const size_t numChildren = std::max(
+      this->Internal->ChildrenInformation.size(), info->Internal->ChildrenInformation.size());
+    this->Internal->ChildrenInformation.resize(numChildren);
+    sizes.resize(numChildren, 1);
+    for (size_t i = 0; i < numChildren; i++)
+    {
+      if (i < otherSizes.size())
+      {
+        sizes[i] = std::max(sizes[i], otherSizes[i]);
+      }
+      if (i < info->Internal->ChildrenInformation.size() &&
+        !info->Internal->ChildrenInformation[i].Name.empty())
+      {
+        this->Internal->ChildrenInformation[i].Name = info->Internal->ChildrenInformation[i].Name;
+      }
+    }
+    this->IsSummary = true;
+    return;
+  }
+
   size_t otherNumChildren = info->Internal->ChildrenInformation.size();
   size_t numChildren = this->Internal->ChildrenInformation.size();
   if (otherNumChildren > numChildren)
@@ -379,6 +503,13 @@ void vtkPVCompositeDataInformation::CopyToStream(vtkClientServerStream* css)
     *css << vtkClientServerStream::InsertArray(data, static_cast<int>(length));
   }
   *css << numChildren; // DONE marker
+  *css << this->IsSummary;
+  const std::vector<unsigned int>& sizes = this->Internal->SummarizedChildrenSizes;
+  *css << static_cast<unsigned int>(sizes.size());
+  for (unsigned int size : sizes)
+  {
+    *css << size;
+  }
   *css << vtkClientServerStream::End;
   //  vtkTimerLog::MarkEndEvent("Copying composite information to stream");
 }
@@ -469,4 +600,21 @@ void vtkPVCompositeDataInformation::CopyFromStream(const vtkClientServerStream*
       this->Internal->ChildrenInformation[childIdx].Info = dataInf;
     }
   }
+
+  unsigned int numSizes;
+  if (!css->GetArgument(0, ++msgIdx, &this->IsSummary) ||
+    !css->GetArgument(0, ++msgIdx, &numSizes))
+  {
+    vtkErrorMacro("Error parsing summary.");
+    return;
+  }
+  this->Internal->SummarizedChildrenSizes.resize(numSizes);
+  for (unsigned int cc = 0; cc < numSizes; ++cc)
+  {
+    if (!css->GetArgument(0, ++msgIdx, &this->Internal->SummarizedChildrenSizes[cc]))
+    {
+      vtkErrorMacro("Error parsing summary.");
+      return;
+    }
+  }
 }
@@ -29,6 +29,7 @@
 #include "vtkPVInformation.h"
 #include "vtkRemotingCoreModule.h" //needed for exports
 
+class vtkCompositeDataSet;
 class vtkPVDataInformation;
 class vtkUniformGridAMR;
 
@@ -108,6 +109,29 @@ public:
   vtkGetMacro(NumberOfAMRLevels, unsigned int);
   //@}
 
+  //@{
+  /**
+   * Returns true if the information only summarizes the children of the
+   * composite dataset. This is the case when the dataset had more leaves than
+   * vtkPVDataInformation::SummaryBlockThreshold. GetNumberOfChildren() and
+   * GetName() still return the number of children and their names but
+   * GetDataInformation() returns NULL for all of them. Use
+   * vtkSMOutputPort::GetSubsetDataInformation() to fetch the information for a
+   * given block on demand.
+   */
+  vtkGetMacro(IsSummary, bool);
+  //@}
+
+  /**
+   * For a summary, returns the composite index of the child at the given index
+   * relative to the composite index of this dataset, i.e. the value to add to
+   * the composite index of this dataset to fetch the information of the child
+   * with vtkSMOutputPort::GetSubsetDataInformation(). When idx is
+   * GetNumberOfChildren(), returns the number of nodes in the dataset. Returns
+   * 0 when the information is not a summary.
+   */
+  unsigned int GetSummarizedChildOffset(unsigned int idx);
+
   // TODO:
   // Add API to obtain meta data information for each of the children.
 
@@ -129,6 +153,17 @@ protected:
 
   unsigned int NumberOfAMRLevels;
 
+  bool IsSummary;
+
+  /**
+   * Initializes a summary for the composite dataset: only the names of the
+   * children and the number of nodes under each of them are recorded, no
+   * information is gathered for the blocks. Returns false, leaving the
+   * information empty, for AMR, multipiece and partitioned datasets, which do
+   * not hold per-block information.
+   */
+  bool CopySummaryFromObject(vtkCompositeDataSet* cds);
+
   friend class vtkPVDataInformation;
   vtkPVDataInformation* GetDataInformationForCompositeIndex(int* index);
 
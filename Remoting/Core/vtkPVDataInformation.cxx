@@ -25,6 +25,7 @@
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataArray.h"
+#include "vtkDataObjectTreeIterator.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkDataSet.h"
 #include "vtkExecutive.h"
@@ -48,6 +49,7 @@
 #include "vtkPointData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkSelection.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
 #include "vtkTable.h"
@@ -63,6 +65,45 @@ vtkStandardNewMacro(vtkPVDataInformation);
 
 std::map<std::string, std::string> helpers;
 
+namespace
+{
+// Returns the node with the given flat index, nullptr if it is empty on this
+// process.
+vtkDataObject* vtkPVDataInformationFindBlock(vtkCompositeDataSet* cds, unsigned int index)
+{
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(cds->NewIterator());
+  if (vtkDataObjectTreeIterator* treeIter = vtkDataObjectTreeIterator::SafeDownCast(iter))
+  {
+    treeIter->VisitOnlyLeavesOff();
+  }
+  iter->SkipEmptyNodesOff();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    if (iter->GetCurrentFlatIndex() == index)
+    {
+      return iter->GetCurrentDataObject();
+    }
+  }
+  return nullptr;
+}
+
+// Counts the leaves, including the empty ones, so that every process makes
+// the same decision for a given structure.
+unsigned int vtkPVDataInformationCountLeaves(vtkCompositeDataSet* cds)
+{
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(cds->NewIterator());
+  iter->SkipEmptyNodesOff();
+  unsigned int count = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    ++count;
+  }
+  return count;
+}
+}
+
 //----------------------------------------------------------------------------
 vtkPVDataInformation::vtkPVDataInformation()
 {
@@ -114,14 +155,14 @@ vtkPVDataInformation::~vtkPVDataInformation()
 //----------------------------------------------------------------------------
 void vtkPVDataInformation::CopyParametersToStream(vtkMultiProcessStream& str)
 {
-  str << 828792 << this->PortNumber;
+  str << 828792 << this->PortNumber << this->SummaryBlockThreshold << this->CompositeIndex;
 }
 
 //----------------------------------------------------------------------------
 void vtkPVDataInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
 {
   int magic_number;
-  str >> magic_number >> this->PortNumber;
+  str >> magic_number >> this->PortNumber >> this->SummaryBlockThreshold >> this->CompositeIndex;
   if (magic_number != 828792)
   {
     vtkErrorMacro("Magic number mismatch.");
@@ -135,6 +176,8 @@ void vtkPVDataInformation::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "PortNumber: " << this->PortNumber << endl;
+  os << indent << "SummaryBlockThreshold: " << this->SummaryBlockThreshold << endl;
+  os << indent << "CompositeIndex: " << this->CompositeIndex << endl;
   os << indent << "DataSetType: " << this->DataSetType << endl;
   os << indent << "CompositeDataSetType: " << this->CompositeDataSetType << endl;
   os << indent << "NumberOfPoints: " << this->NumberOfPoints << endl;
@@ -442,6 +485,31 @@ void vtkPVDataInformation::CopyFromCompositeDataSet(vtkCompositeDataSet* data)
   // this->NumberOfDataSets = numDataSets;
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVDataInformation::CopySummaryFromCompositeDataSet(vtkCompositeDataSet* data)
+{
+  this->Initialize();
+  if (!this->CompositeDataInformation->CopySummaryFromObject(data))
+  {
+    return false;
+  }
+
+  // Accumulate the leaves one at a time rather than building the per-block
+  // information tree that the summary would drop anyway.
+  vtkNew<vtkPVDataInformation> leafInfo;
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(data->NewIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    leafInfo->Initialize();
+    leafInfo->CopyFromObject(iter->GetCurrentDataObject());
+    this->AddInformation(leafInfo, /*addingParts=*/1);
+  }
+
+  this->CopyFromCompositeDataSetFinalize(data);
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataInformation::CopyCommonMetaData(vtkDataObject* data, vtkInformation* pinfo)
 {
@@ -779,9 +847,26 @@ void vtkPVDataInformation::CopyFromObject(vtkObject* object)
   }
 
   vtkCompositeDataSet* cds = vtkCompositeDataSet::SafeDownCast(dobj);
+  if (cds && this->CompositeIndex > 0)
+  {
+    dobj = vtkPVDataInformationFindBlock(cds, static_cast<unsigned int>(this->CompositeIndex));
+    if (!dobj)
+    {
+      // The block is empty on this process.
+      return;
+    }
+    cds = vtkCompositeDataSet::SafeDownCast(dobj);
+  }
+
   if (cds)
   {
-    this->CopyFromCompositeDataSet(cds);
+    if (this->SummaryBlockThreshold <= 0 ||
+      vtkPVDataInformationCountLeaves(cds) <=
+        static_cast<unsigned int>(this->SummaryBlockThreshold) ||
+      !this->CopySummaryFromCompositeDataSet(cds))
+    {
+      this->CopyFromCompositeDataSet(cds);
+    }
     this->CopyCommonMetaData(dobj, info);
     return;
   }
@@ -76,6 +76,32 @@ public:
   vtkGetMacro(PortNumber, int);
   //@}
 
+  //@{
+  /**
+   * When gathering the information for a composite dataset with more leaves
+   * than SummaryBlockThreshold, only the aggregate information (arrays, bounds,
+   * counts) is kept and the per-block information is dropped, see
+   * vtkPVCompositeDataInformation::GetIsSummary(). This keeps the information
+   * small for datasets with a very large number of blocks. 0, the default,
+   * always keeps the per-block information. This parameter is set on the
+   * client-side before gathering the information.
+   */
+  vtkSetClampMacro(SummaryBlockThreshold, int, 0, VTK_INT_MAX);
+  vtkGetMacro(SummaryBlockThreshold, int);
+  //@}
+
+  //@{
+  /**
+   * When set to a flat index greater than 0, the information is gathered for
+   * that block of the composite dataset only, instead of for the whole
+   * dataset. This is used to fetch the information for a block on demand when
+   * the information for the whole dataset is only a summary. Default is -1.
+   * This parameter is set on the client-side before gathering the information.
+   */
+  vtkSetMacro(CompositeIndex, int);
+  vtkGetMacro(CompositeIndex, int);
+  //@}
+
   /**
    * Transfer information about a single object into this object.
    */
@@ -304,6 +330,7 @@ protected:
 
   void AddFromMultiPieceDataSet(vtkCompositeDataSet* data);
   void CopyFromCompositeDataSet(vtkCompositeDataSet* data);
+  bool CopySummaryFromCompositeDataSet(vtkCompositeDataSet* data);
   void CopyFromCompositeDataSetInitialize(vtkCompositeDataSet* data);
   void CopyFromCompositeDataSetFinalize(vtkCompositeDataSet* data);
   virtual void CopyFromDataSet(vtkDataSet* data);
@@ -369,6 +396,8 @@ private:
   void operator=(const vtkPVDataInformation&) = delete;
 
   int PortNumber = -1;
+  int SummaryBlockThreshold = 0;
+  int CompositeIndex = -1;
 };
 
 #endif
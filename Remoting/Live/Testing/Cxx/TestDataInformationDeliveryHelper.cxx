@@ -0,0 +1,168 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestDataInformationDeliveryHelper.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Sends the data information of a changing dataset through a pair of
+// vtkDataInformationDeliveryHelper, checks that unchanged layouts are sent as
+// deltas that decode to the same information, and that a dropped delta is
+// detected and recovered from with a resync.
+
+#include "vtkClientServerStream.h"
+#include "vtkDataInformationDeliveryHelper.h"
+#include "vtkDoubleArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <string>
+
+namespace
+{
+const vtkTypeUInt32 ProxyId = 42;
+const unsigned int Port = 1;
+
+// Fills the dataset so that its bounds and ranges change with the step while
+// the layout of its serialized information does not.
+void Update(vtkPolyData* pd, int step)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Values");
+  for (int cc = 0; cc < 100; ++cc)
+  {
+    points->InsertNextPoint(cc + step, 0, 0);
+    values->InsertNextValue(cc * step);
+  }
+  pd->SetPoints(points);
+  pd->GetPointData()->AddArray(values);
+}
+
+std::string Serialize(vtkPVDataInformation* info)
+{
+  vtkClientServerStream stream;
+  info->CopyToStream(&stream);
+  size_t length = 0;
+  const unsigned char* data = nullptr;
+  stream.GetData(&data, &length);
+  return std::string(reinterpret_cast<const char*>(data), length);
+}
+
+// Appends the information of the dataset to a message as the sender, then
+// reads it as the receiver. Returns the encoding used, or -1 on failure.
+int Send(vtkPolyData* pd, vtkDataInformationDeliveryHelper* sender,
+  vtkDataInformationDeliveryHelper* receiver, bool expectValid = true)
+{
+  vtkNew<vtkPVDataInformation> info;
+  info->CopyFromObject(pd);
+  vtkClientServerStream stream;
+  stream << vtkClientServerStream::Reply;
+  if (!sender->AppendDataInformation(ProxyId, Port, info, stream))
+  {
+    vtkLogF(ERROR, "Changed information was not appended.");
+    return -1;
+  }
+  stream << vtkClientServerStream::End;
+
+  int encoding = -1;
+  stream.GetArgument(0, 2, &encoding);
+  int arg = 0;
+  vtkDataInformationDeliveryHelper::PortKey key;
+  std::string rawData;
+  const bool valid = receiver->ReadDataInformation(stream, arg, key, rawData);
+  if (arg != stream.GetNumberOfArguments(0))
+  {
+    vtkLogF(ERROR, "Information was not read entirely.");
+    return -1;
+  }
+  if (valid != expectValid)
+  {
+    vtkLogF(ERROR, "Information read %s.", valid ? "unexpectedly" : "failed");
+    return -1;
+  }
+  if (valid && (key.first != ProxyId || key.second != Port || rawData != Serialize(info)))
+  {
+    vtkLogF(ERROR, "Information does not round trip.");
+    return -1;
+  }
+  return encoding;
+}
+}
+
+int TestDataInformationDeliveryHelper(int, char* [])
+{
+  vtkNew<vtkDataInformationDeliveryHelper> sender;
+  vtkNew<vtkDataInformationDeliveryHelper> receiver;
+  vtkNew<vtkPolyData> pd;
+
+  // the first information is sent whole, the next ones as deltas.
+  Update(pd, 1);
+  if (Send(pd, sender, receiver) != vtkDataInformationDeliveryHelper::FULL_INFORMATION)
+  {
+    return EXIT_FAILURE;
+  }
+  for (int step = 2; step < 5; ++step)
+  {
+    Update(pd, step);
+    if (Send(pd, sender, receiver) != vtkDataInformationDeliveryHelper::DELTA_INFORMATION)
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // unchanged information is not sent again.
+  vtkNew<vtkPVDataInformation> info;
+  info->CopyFromObject(pd);
+  vtkClientServerStream unchanged;
+  if (sender->AppendDataInformation(ProxyId, Port, info, unchanged))
+  {
+    vtkLogF(ERROR, "Unchanged information was appended.");
+    return EXIT_FAILURE;
+  }
+
+  // the receiver misses a delta, so the next one must be rejected, even though
+  // it applies to information of the same size.
+  Update(pd, 5);
+  vtkNew<vtkPVDataInformation> droppedInfo;
+  droppedInfo->CopyFromObject(pd);
+  vtkClientServerStream dropped;
+  sender->AppendDataInformation(ProxyId, Port, droppedInfo, dropped);
+  Update(pd, 6);
+  if (Send(pd, sender, receiver, false) != vtkDataInformationDeliveryHelper::DELTA_INFORMATION ||
+    receiver->GetPendingResyncs().size() != 1)
+  {
+    vtkLogF(ERROR, "Delta against dropped information was not rejected.");
+    return EXIT_FAILURE;
+  }
+
+  // the resync makes the sender send the whole information again, after which
+  // deltas apply again.
+  for (const auto& key : receiver->GetPendingResyncs())
+  {
+    sender->Forget(key);
+  }
+  receiver->ClearPendingResyncs();
+  Update(pd, 7);
+  if (Send(pd, sender, receiver) != vtkDataInformationDeliveryHelper::FULL_INFORMATION)
+  {
+    return EXIT_FAILURE;
+  }
+  Update(pd, 8);
+  if (Send(pd, sender, receiver) != vtkDataInformationDeliveryHelper::DELTA_INFORMATION)
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
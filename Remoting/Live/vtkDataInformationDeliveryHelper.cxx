@@ -0,0 +1,188 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkDataInformationDeliveryHelper.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDataInformationDeliveryHelper.h"
+
+#include "vtkClientServerStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVDataInformation.h"
+
+#include <vector>
+
+vtkStandardNewMacro(vtkDataInformationDeliveryHelper);
+//----------------------------------------------------------------------------
+vtkDataInformationDeliveryHelper::vtkDataInformationDeliveryHelper()
+  : LastVersion(0)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkDataInformationDeliveryHelper::~vtkDataInformationDeliveryHelper()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkDataInformationDeliveryHelper::Clear()
+{
+  this->DataInformation.clear();
+  this->PendingResyncs.clear();
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataInformationDeliveryHelper::AppendDataInformation(vtkTypeUInt32 proxyId,
+  unsigned int port, vtkPVDataInformation* info, vtkClientServerStream& stream)
+{
+  vtkClientServerStream infoStream;
+  info->CopyToStream(&infoStream);
+  size_t length = 0;
+  const unsigned char* data = NULL;
+  infoStream.GetData(&data, &length);
+  std::string rawData(reinterpret_cast<const char*>(data), length);
+
+  const PortKey key(proxyId, port);
+  auto iter = this->DataInformation.find(key);
+  if (iter != this->DataInformation.end() && iter->second.Data == rawData)
+  {
+    return false;
+  }
+
+  // Ranges and bounds are updated in place in the serialized information, so
+  // they only need a few small runs. Runs closer than the cost of a new run
+  // are merged.
+  const size_t runOverhead = 16;
+  std::vector<std::pair<size_t, size_t> > runs;
+  size_t deltaSize = 0;
+  if (iter != this->DataInformation.end() && iter->second.Data.size() == length)
+  {
+    const std::string& previous = iter->second.Data;
+    for (size_t cc = 0; cc < length;)
+    {
+      if (previous[cc] == rawData[cc])
+      {
+        ++cc;
+        continue;
+      }
+      size_t end = cc + 1;
+      while (end < length && previous[end] != rawData[end])
+      {
+        ++end;
+      }
+      if (!runs.empty() && cc - runs.back().second < runOverhead)
+      {
+        runs.back().second = end;
+      }
+      else
+      {
+        runs.push_back(std::make_pair(cc, end));
+      }
+      cc = end;
+    }
+    for (const auto& run : runs)
+    {
+      deltaSize += run.second - run.first + runOverhead;
+    }
+  }
+
+  const vtkTypeUInt32 version = ++this->LastVersion;
+  if (runs.empty() || 2 * deltaSize > length)
+  {
+    stream << proxyId << port << static_cast<int>(FULL_INFORMATION) << version << infoStream;
+  }
+  else
+  {
+    stream << proxyId << port << static_cast<int>(DELTA_INFORMATION) << version
+           << iter->second.Version << static_cast<vtkTypeUInt32>(length)
+           << static_cast<int>(runs.size());
+    for (const auto& run : runs)
+    {
+      stream << static_cast<vtkTypeUInt32>(run.first)
+             << vtkClientServerStream::InsertArray(
+                  reinterpret_cast<const unsigned char*>(rawData.c_str()) + run.first,
+                  static_cast<int>(run.second - run.first));
+    }
+  }
+  VersionedInformation& sent = this->DataInformation[key];
+  sent.Data.swap(rawData);
+  sent.Version = version;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataInformationDeliveryHelper::ReadDataInformation(
+  const vtkClientServerStream& stream, int& arg, PortKey& key, std::string& rawData)
+{
+  int encoding = FULL_INFORMATION;
+  vtkTypeUInt32 version = 0;
+  stream.GetArgument(0, arg++, &key.first);
+  stream.GetArgument(0, arg++, &key.second);
+  stream.GetArgument(0, arg++, &encoding);
+  stream.GetArgument(0, arg++, &version);
+  if (encoding == FULL_INFORMATION)
+  {
+    vtkClientServerStream infoStream;
+    stream.GetArgument(0, arg++, &infoStream);
+    size_t length = 0;
+    const unsigned char* data = NULL;
+    infoStream.GetData(&data, &length);
+    rawData.assign(reinterpret_cast<const char*>(data), length);
+    VersionedInformation& received = this->DataInformation[key];
+    received.Data = rawData;
+    received.Version = version;
+    this->PendingResyncs.erase(key);
+    return true;
+  }
+
+  // A delta only applies to the information it was computed against, a
+  // dropped or rejected message leaves the receiver on an older version.
+  vtkTypeUInt32 baseVersion = 0;
+  vtkTypeUInt32 length = 0;
+  int numberOfRuns = 0;
+  stream.GetArgument(0, arg++, &baseVersion);
+  stream.GetArgument(0, arg++, &length);
+  stream.GetArgument(0, arg++, &numberOfRuns);
+  auto iter = this->DataInformation.find(key);
+  bool valid = iter != this->DataInformation.end() && iter->second.Version == baseVersion &&
+    iter->second.Data.size() == length;
+  for (int cc = 0; cc < numberOfRuns; ++cc)
+  {
+    vtkTypeUInt32 offset = 0;
+    vtkTypeUInt32 runLength = 0;
+    stream.GetArgument(0, arg++, &offset);
+    valid = valid && stream.GetArgumentLength(0, arg, &runLength) && offset <= length &&
+      runLength <= length - offset &&
+      stream.GetArgument(
+        0, arg, reinterpret_cast<unsigned char*>(&iter->second.Data[offset]), runLength);
+    arg++;
+  }
+  if (!valid)
+  {
+    if (iter != this->DataInformation.end())
+    {
+      this->DataInformation.erase(iter);
+    }
+    this->PendingResyncs.insert(key);
+    return false;
+  }
+  iter->second.Version = version;
+  rawData = iter->second.Data;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataInformationDeliveryHelper::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfPorts: " << this->DataInformation.size() << endl;
+  os << indent << "NumberOfPendingResyncs: " << this->PendingResyncs.size() << endl;
+}
@@ -0,0 +1,125 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkDataInformationDeliveryHelper.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkDataInformationDeliveryHelper
+ * @brief   encodes data information as deltas for ParaView Live.
+ *
+ * vtkDataInformationDeliveryHelper is used by vtkLiveInsituLink to send the
+ * data information of the Catalyst pipeline ports from the INSITU root node
+ * to the LIVE root node. The sender keeps the last information it sent for
+ * each port and, when the serialized layout is unchanged, only sends the runs
+ * of bytes that changed. The receiver keeps the last information it received
+ * and applies the runs to it.
+ *
+ * Each port's information carries a version so that the receiver can tell
+ * when a delta was computed against information it never received. Such a
+ * delta is rejected and the port is listed in the pending resyncs, which the
+ * receiver sends back so that the sender can Forget() the port and send its
+ * whole information next time.
+ */
+
+#ifndef vtkDataInformationDeliveryHelper_h
+#define vtkDataInformationDeliveryHelper_h
+
+#include "vtkObject.h"
+#include "vtkRemotingLiveModule.h" //needed for exports
+
+#include <map>     // needed for typedef
+#include <set>     // needed for typedef
+#include <string>  // needed for typedef
+#include <utility> // needed for typedef
+
+class vtkClientServerStream;
+class vtkPVDataInformation;
+
+class VTKREMOTINGLIVE_EXPORT vtkDataInformationDeliveryHelper : public vtkObject
+{
+public:
+  static vtkDataInformationDeliveryHelper* New();
+  vtkTypeMacro(vtkDataInformationDeliveryHelper, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  typedef std::pair<vtkTypeUInt32, unsigned int> PortKey;
+
+  /**
+   * How the data information of a port is encoded in the stream.
+   */
+  enum DataInformationEncodings
+  {
+    FULL_INFORMATION = 0,
+    DELTA_INFORMATION = 1
+  };
+
+  /**
+   * Appends the data information of a port to the stream, either whole or as
+   * the runs of bytes that changed since it was last sent. Returns false, and
+   * appends nothing, when it did not change.
+   */
+  bool AppendDataInformation(vtkTypeUInt32 proxyId, unsigned int port, vtkPVDataInformation* info,
+    vtkClientServerStream& stream);
+
+  /**
+   * Reads the data information of a port appended by AppendDataInformation()
+   * starting at argument `arg` of the first message, which is moved past it.
+   * `rawData` is set to the serialized information. Returns false when a delta
+   * does not apply to the last information received for that port, in which
+   * case the port is added to the pending resyncs.
+   */
+  bool ReadDataInformation(
+    const vtkClientServerStream& stream, int& arg, PortKey& key, std::string& rawData);
+
+  /**
+   * The ports whose whole data information the receiver needs again.
+   */
+  const std::set<PortKey>& GetPendingResyncs() const { return this->PendingResyncs; }
+  void ClearPendingResyncs() { this->PendingResyncs.clear(); }
+
+  /**
+   * Forgets the information last sent for a port, so that the next
+   * AppendDataInformation() for it sends the whole information.
+   */
+  void Forget(const PortKey& key) { this->DataInformation.erase(key); }
+
+  /**
+   * Forgets the information of every port and the pending resyncs, for
+   * instance when the connection drops.
+   */
+  void Clear();
+
+protected:
+  vtkDataInformationDeliveryHelper();
+  ~vtkDataInformationDeliveryHelper() override;
+
+  struct VersionedInformation
+  {
+    std::string Data;
+    vtkTypeUInt32 Version = 0;
+  };
+
+  // Last data information sent or received for each port.
+  std::map<PortKey, VersionedInformation> DataInformation;
+
+  // Ports whose whole data information the receiver needs again.
+  std::set<PortKey> PendingResyncs;
+
+  // Versions are never reused by a sender, even after Forget().
+  vtkTypeUInt32 LastVersion;
+
+private:
+  vtkDataInformationDeliveryHelper(const vtkDataInformationDeliveryHelper&) = delete;
+  void operator=(const vtkDataInformationDeliveryHelper&) = delete;
+};
+
+#endif
@@ -26,9 +26,11 @@
 #include "vtkPointData.h"
 #include "vtkSocketController.h"
 #include "vtkStructuredGrid.h"
+#include "vtkTimerLog.h"
 #include "vtkTrivialProducer.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
 #include <assert.h>
 
 vtkStandardNewMacro(vtkExtractsDeliveryHelper);
@@ -37,6 +39,13 @@ vtkExtractsDeliveryHelper::vtkExtractsDeliveryHelper()
   : ProcessIsProducer(true)
   , NumberOfSimulationProcesses(0)
   , NumberOfVisualizationProcesses(0)
+  , AdaptiveDelivery(false)
+  , MaximumBytesPerSecond(0)
+  , MaximumDeliveryTimeFraction(0.1)
+  , NumberOfSkippedDeliveries(0)
+  , DeliveryCredit(0)
+  , LastBudgetTime(-1)
+  , DeliveryThroughput(0)
 {
   this->SetParallelController(vtkMultiProcessController::GetGlobalController());
 }
@@ -150,6 +159,67 @@ vtkDataObject* vtkExtractsDeliveryHelper::Collect(int node_count, vtkDataObject*
   }
 }
 
+//----------------------------------------------------------------------------
+bool vtkExtractsDeliveryHelper::IsDeliveryWithinBudget(double& size)
+{
+  double localSize = 0;
+  for (ExtractProducersType::iterator iter = this->ExtractProducers.begin();
+       iter != this->ExtractProducers.end(); ++iter)
+  {
+    vtkDataObject* dObj =
+      iter->second->GetProducer()->GetOutputDataObject(iter->second->GetIndex());
+    if (dObj)
+    {
+      localSize += 1024.0 * dObj->GetActualMemorySize();
+    }
+  }
+  size = localSize;
+
+  const bool parallel = this->ParallelController.GetPointer() != nullptr &&
+    this->ParallelController->GetNumberOfProcesses() > 1;
+  if (parallel)
+  {
+    this->ParallelController->Reduce(&localSize, &size, 1, vtkCommunicator::SUM_OP, 0);
+  }
+
+  int withinBudget = 1;
+  if (!parallel || this->ParallelController->GetLocalProcessId() == 0)
+  {
+    // leaky bucket: the credit grows at the allowed rate, up to one second
+    // worth of it, and a push is allowed as long as it is not in debt.
+    double rate = this->MaximumBytesPerSecond;
+    if (this->DeliveryThroughput > 0)
+    {
+      const double linkRate = this->MaximumDeliveryTimeFraction * this->DeliveryThroughput;
+      rate = rate > 0 ? std::min(rate, linkRate) : linkRate;
+    }
+
+    const double now = vtkTimerLog::GetUniversalTime();
+    if (rate <= 0)
+    {
+      this->DeliveryCredit = 0;
+    }
+    else if (this->LastBudgetTime >= 0)
+    {
+      this->DeliveryCredit =
+        std::min(this->DeliveryCredit + (now - this->LastBudgetTime) * rate, rate);
+    }
+    this->LastBudgetTime = now;
+
+    withinBudget = this->DeliveryCredit >= 0 ? 1 : 0;
+    if (withinBudget && rate > 0)
+    {
+      this->DeliveryCredit -= size;
+    }
+  }
+
+  if (parallel)
+  {
+    this->ParallelController->Broadcast(&withinBudget, 1, 0);
+  }
+  return withinBudget != 0;
+}
+
 //----------------------------------------------------------------------------
 bool vtkExtractsDeliveryHelper::Update()
 {
@@ -176,6 +246,22 @@ bool vtkExtractsDeliveryHelper::Update()
     int M = this->NumberOfSimulationProcesses;
     int N = this->NumberOfVisualizationProcesses;
 
+    double size = 0;
+    const double startTime = vtkTimerLog::GetUniversalTime();
+    if (this->AdaptiveDelivery && !this->IsDeliveryWithinBudget(size))
+    {
+      // only mark the end, the visualization processes keep the extracts
+      // they already have.
+      this->NumberOfSkippedDeliveries++;
+      if (vtkSocketController* comm = this->Simulation2VisualizationController)
+      {
+        vtkMultiProcessStream stream;
+        stream << std::string("null");
+        comm->Send(stream, 1, 12000);
+      }
+      return retVal;
+    }
+
     std::map<std::string, vtkSmartPointer<vtkDataObject> > gathered_extracts;
     if (M > N)
     {
@@ -216,6 +302,17 @@ bool vtkExtractsDeliveryHelper::Update()
       stream << std::string("null");
       comm->Send(stream, 1, 12000);
     }
+
+    // the time spent pushing includes waiting for the receivers, so the
+    // estimated throughput drops when they lag behind.
+    const double elapsed = vtkTimerLog::GetUniversalTime() - startTime;
+    if (this->AdaptiveDelivery && size > 0 && elapsed > 0)
+    {
+      const double throughput = size / elapsed;
+      this->DeliveryThroughput = this->DeliveryThroughput > 0
+        ? 0.5 * (this->DeliveryThroughput + throughput)
+        : throughput;
+    }
   }
   else
   {
@@ -324,4 +421,8 @@ bool vtkExtractsDeliveryHelper::Update()
 void vtkExtractsDeliveryHelper::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "AdaptiveDelivery: " << this->AdaptiveDelivery << endl;
+  os << indent << "MaximumBytesPerSecond: " << this->MaximumBytesPerSecond << endl;
+  os << indent << "MaximumDeliveryTimeFraction: " << this->MaximumDeliveryTimeFraction << endl;
+  os << indent << "NumberOfSkippedDeliveries: " << this->NumberOfSkippedDeliveries << endl;
 }
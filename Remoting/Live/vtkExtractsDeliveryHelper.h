@@ -71,16 +71,78 @@ public:
   vtkSetMacro(NumberOfSimulationProcesses, int);
   vtkGetMacro(NumberOfSimulationProcesses, int);
 
+  //@{
+  /**
+   * When on, the simulation processes push extracts only as fast as
+   * MaximumBytesPerSecond and MaximumDeliveryTimeFraction allow. An Update()
+   * over budget pushes no extract, and the visualization processes keep the
+   * last ones they received. The next Update() within budget pushes the
+   * latest extracts. A slow ParaView Live therefore cannot hold up the
+   * simulation for long. Off by default, in which case every Update() pushes
+   * every extract. Only used on the simulation processes.
+   */
+  vtkSetMacro(AdaptiveDelivery, bool);
+  vtkGetMacro(AdaptiveDelivery, bool);
+  vtkBooleanMacro(AdaptiveDelivery, bool);
+  //@}
+
+  //@{
+  /**
+   * Upper bound on the average rate, in bytes per second, at which extracts
+   * are pushed with AdaptiveDelivery. Default is 0, i.e. no bound besides
+   * MaximumDeliveryTimeFraction.
+   */
+  vtkSetClampMacro(MaximumBytesPerSecond, double, 0, VTK_DOUBLE_MAX);
+  vtkGetMacro(MaximumBytesPerSecond, double);
+  //@}
+
+  //@{
+  /**
+   * Largest fraction of the simulation wall time spent pushing extracts with
+   * AdaptiveDelivery. The throughput of the link is estimated from the
+   * previous pushes. Those include the time spent waiting for the
+   * visualization processes to receive the extracts, so the throughput drops
+   * when they lag behind. Default is 0.1.
+   */
+  vtkSetClampMacro(MaximumDeliveryTimeFraction, double, 0.001, 1.0);
+  vtkGetMacro(MaximumDeliveryTimeFraction, double);
+  //@}
+
+  /**
+   * Number of Update() calls that pushed no extract because of
+   * AdaptiveDelivery.
+   */
+  vtkGetMacro(NumberOfSkippedDeliveries, int);
+
 protected:
   vtkExtractsDeliveryHelper();
   ~vtkExtractsDeliveryHelper() override;
 
   vtkDataObject* Collect(int nodes_to_collect_to, vtkDataObject*);
 
+  /**
+   * Decides on the simulation processes whether the extracts fit in the
+   * delivery budget of AdaptiveDelivery. Returns the same value on all of
+   * them, along with the size of the extracts in bytes.
+   */
+  bool IsDeliveryWithinBudget(double& size);
+
   bool ProcessIsProducer;
   int NumberOfSimulationProcesses;
   int NumberOfVisualizationProcesses;
 
+  bool AdaptiveDelivery;
+  double MaximumBytesPerSecond;
+  double MaximumDeliveryTimeFraction;
+  int NumberOfSkippedDeliveries;
+
+  // Bytes that may be pushed right away, negative while the previous pushes
+  // exceed the budget, updated on process 0 only.
+  double DeliveryCredit;
+  double LastBudgetTime;
+  // Estimated throughput of the link, in bytes per second, 0 when unknown.
+  double DeliveryThroughput;
+
   // the bool is to keep track of whether the trivial producer has had
   // its output set yet. we don't want to update the pipeline until
   // it gets its output.
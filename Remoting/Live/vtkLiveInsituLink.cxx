@@ -18,6 +18,7 @@
 #include "vtkClientSocket.h"
 #include "vtkCommand.h"
 #include "vtkCommunicationErrorCatcher.h"
+#include "vtkDataInformationDeliveryHelper.h"
 #include "vtkExtractsDeliveryHelper.h"
 #include "vtkLogger.h"
 #include "vtkMultiProcessStream.h"
@@ -47,6 +48,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 #include <vtksys/SystemInformation.hxx>
 #include <vtksys/SystemTools.hxx>
 
@@ -287,33 +289,11 @@ public:
     }
   };
 
-  bool IsNew(vtkTypeUInt32 proxyId, unsigned int port, vtkPVDataInformation* info)
-  {
-    vtkIdType id = static_cast<vtkIdType>(proxyId) * 100 + static_cast<vtkIdType>(port);
-    vtkClientServerStream stream;
-    info->CopyToStream(&stream);
-    size_t length = 0;
-    const unsigned char* data = NULL;
-    stream.GetData(&data, &length);
-    std::string rawData((const char*)data, length);
-
-    // Search if existing value is the same
-    std::map<vtkIdType, std::string>::iterator iter;
-    iter = this->LastSentDataInformationMap.find(id);
-    if ((iter != this->LastSentDataInformationMap.end()) && (iter->second == rawData))
-    {
-      return false;
-    }
-
-    // Store the new MTime
-    this->LastSentDataInformationMap[id] = rawData;
-
-    return true;
-  }
-
   typedef std::map<Key, vtkSmartPointer<vtkTrivialProducer> > ExtractsMap;
   ExtractsMap Extracts;
-  std::map<vtkIdType, std::string> LastSentDataInformationMap;
+
+  // Last data information sent (INSITU) or received (LIVE) for each port.
+  vtkNew<vtkDataInformationDeliveryHelper> DataInformation;
 };
 
 vtkStandardNewMacro(vtkLiveInsituLink);
@@ -326,6 +306,9 @@ vtkLiveInsituLink::vtkLiveInsituLink()
   , InsituXMLStateChanged(false)
   , ExtractsChanged(false)
   , SimulationPaused(0)
+  , AdaptiveExtractsDelivery(false)
+  , MaximumExtractsBytesPerSecond(0)
+  , MaximumExtractsDeliveryTimeFraction(0.1)
   , InsituXMLState(0)
   , URL(0)
   , Internals(new vtkInternals())
@@ -550,6 +533,7 @@ void vtkLiveInsituLink::DropLiveInsituConnection()
   this->Proc0NodesController = 0;
   this->ExtractsDeliveryHelper = 0;
   this->SimulationPaused = 0;
+  this->Internals->DataInformation->Clear();
   vtkDebugMacro("Catalyst and ParaView should now be disconnected");
 }
 
@@ -563,6 +547,10 @@ void vtkLiveInsituLink::InsituConnect(vtkMultiProcessController* proc0NodesContr
 
   this->ExtractsDeliveryHelper = vtkSmartPointer<vtkExtractsDeliveryHelper>::New();
   this->ExtractsDeliveryHelper->SetProcessIsProducer(this->ProcessType == LIVE ? false : true);
+  this->ExtractsDeliveryHelper->SetAdaptiveDelivery(this->AdaptiveExtractsDelivery);
+  this->ExtractsDeliveryHelper->SetMaximumBytesPerSecond(this->MaximumExtractsBytesPerSecond);
+  this->ExtractsDeliveryHelper->SetMaximumDeliveryTimeFraction(
+    this->MaximumExtractsDeliveryTimeFraction);
 
   vtkMultiProcessController* parallelController = vtkMultiProcessController::GetGlobalController();
   int numProcs = parallelController->GetNumberOfProcesses();
@@ -952,6 +940,17 @@ void vtkLiveInsituLink::InsituUpdate(double time, vtkIdType timeStep)
     }
   }
 
+  // Forget the data information the LIVE root node could not update, so that
+  // it is sent whole in InsituPostProcess().
+  int numberOfResyncs = 0;
+  extractsPauseMessage >> numberOfResyncs;
+  for (int cc = 0; cc < numberOfResyncs; ++cc)
+  {
+    vtkDataInformationDeliveryHelper::PortKey key;
+    extractsPauseMessage >> key.first >> key.second;
+    this->Internals->DataInformation->Forget(key);
+  }
+
   // Share the id mapping between INSITU and LIVE root node
   if (this->Proc0NodesController)
   {
@@ -1014,7 +1013,8 @@ void vtkLiveInsituLink::InsituPostProcess(double time, vtkIdType timeStep)
     proxyIterator->SetModeToOneGroup();
     proxyIterator->Begin("sources");
 
-    // Serialized DataInformation
+    // Serialized DataInformation, only for the ports where it changed and, when
+    // possible, as the bytes that changed since it was last sent.
     stream << vtkClientServerStream::Reply;
     while (!proxyIterator->IsAtEnd())
     {
@@ -1023,13 +1023,8 @@ void vtkLiveInsituLink::InsituPostProcess(double time, vtkIdType timeStep)
       {
         for (unsigned int port = 0; port < source->GetNumberOfOutputPorts(); ++port)
         {
-          if (this->Internals->IsNew(source->GetGlobalID(), port, source->GetDataInformation(port)))
-          {
-            vtkClientServerStream dataStream;
-            source->GetDataInformation(port)->CopyToStream(&dataStream);
-            // Serialize the data
-            stream << source->GetGlobalID() << port << dataStream;
-          }
+          this->Internals->DataInformation->AppendDataInformation(
+            source->GetGlobalID(), port, source->GetDataInformation(port), stream);
         }
       }
       proxyIterator->Next();
@@ -1101,6 +1096,13 @@ void vtkLiveInsituLink::OnInsituUpdate(double time, vtkIdType timeStep)
     {
       extractsPauseMessage << 0;
     }
+    const auto& resyncs = this->Internals->DataInformation->GetPendingResyncs();
+    extractsPauseMessage << static_cast<int>(resyncs.size());
+    for (const auto& key : resyncs)
+    {
+      extractsPauseMessage << key.first << key.second;
+    }
+    this->Internals->DataInformation->ClearPendingResyncs();
     this->Proc0NodesController->Send(extractsPauseMessage, 1, 8012);
 
     // Read the server id mapping
@@ -1155,20 +1157,14 @@ void vtkLiveInsituLink::OnInsituPostProcess(double time, vtkIdType timeStep)
 
     int nbArgs = mainStream.GetNumberOfArguments(0);
     int arg = 0;
-    vtkTypeUInt32 id;
-    unsigned int port;
-    vtkClientServerStream stream;
     while (arg < nbArgs)
     {
-      mainStream.GetArgument(0, arg++, &id);
-      mainStream.GetArgument(0, arg++, &port);
-      mainStream.GetArgument(0, arg++, &stream);
-      const unsigned char* oldStr;
-      size_t oldStrSize;
-      stream.GetData(&oldStr, &oldStrSize);
-      std::string newStr((const char*)oldStr, oldStrSize);
-
-      dataInformation[std::pair<vtkTypeUInt32, unsigned int>(id, port)] = newStr;
+      vtkDataInformationDeliveryHelper::PortKey key;
+      std::string rawData;
+      if (this->Internals->DataInformation->ReadDataInformation(mainStream, arg, key, rawData))
+      {
+        dataInformation[key] = rawData;
+      }
     }
   }
   if (myId == 0 && dataAvailable)
@@ -109,6 +109,24 @@ public:
   void SetSimulationPaused(int paused);
   //@}
 
+  //@{
+  /**
+   * Rate-adaptive delivery of the extracts on the Insitu side, see
+   * vtkExtractsDeliveryHelper::SetAdaptiveDelivery(),
+   * vtkExtractsDeliveryHelper::SetMaximumBytesPerSecond() and
+   * vtkExtractsDeliveryHelper::SetMaximumDeliveryTimeFraction(). These must be
+   * set before connecting to ParaView Live, and apply to all later
+   * connections.
+   */
+  vtkSetMacro(AdaptiveExtractsDelivery, bool);
+  vtkGetMacro(AdaptiveExtractsDelivery, bool);
+  vtkBooleanMacro(AdaptiveExtractsDelivery, bool);
+  vtkSetClampMacro(MaximumExtractsBytesPerSecond, double, 0, VTK_DOUBLE_MAX);
+  vtkGetMacro(MaximumExtractsBytesPerSecond, double);
+  vtkSetClampMacro(MaximumExtractsDeliveryTimeFraction, double, 0.001, 1.0);
+  vtkGetMacro(MaximumExtractsDeliveryTimeFraction, double);
+  //@}
+
   /**
    * Initializes the link. For in situ this returns true it there is a
    * connection and false otherwise. For live it always returns true.
@@ -242,6 +260,10 @@ protected:
   bool ExtractsChanged;
   int SimulationPaused;
 
+  bool AdaptiveExtractsDelivery;
+  double MaximumExtractsBytesPerSecond;
+  double MaximumExtractsDeliveryTimeFraction;
+
   char* InsituXMLState;
   vtkWeakPointer<vtkPVSessionBase> LiveSession;
   /**
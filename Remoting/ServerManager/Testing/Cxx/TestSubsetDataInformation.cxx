@@ -0,0 +1,138 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestSubsetDataInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the data information of a composite dataset with more blocks
+// than the summary threshold is a summary, and that the information for its
+// blocks can still be fetched with vtkSMOutputPort::GetSubsetDataInformation().
+
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVCompositeDataInformation.h"
+#include "vtkPVDataInformation.h"
+#include "vtkProcessModule.h"
+#include "vtkSMOutputPort.h"
+#include "vtkSMParaViewPipelineController.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <vector>
+
+namespace
+{
+bool ValidateSubsets(vtkSMOutputPort* port, const std::vector<vtkIdType>& numberOfPoints)
+{
+  for (size_t cc = 0; cc < numberOfPoints.size(); ++cc)
+  {
+    vtkPVDataInformation* info =
+      port->GetSubsetDataInformation(static_cast<unsigned int>(cc + 1));
+    if (!info || info->GetNumberOfPoints() != numberOfPoints[cc])
+    {
+      vtkLogF(ERROR, "Wrong information for block %d.", static_cast<int>(cc + 1));
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CheckSubsetDataInformation(vtkSMSessionProxyManager* pxm)
+{
+  vtkNew<vtkSMParaViewPipelineController> controller;
+
+  const int numberOfBlocks = 4;
+  auto group = vtkSmartPointer<vtkSMSourceProxy>::Take(
+    vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "GroupDataSets")));
+  controller->PreInitializeProxy(group);
+  for (int cc = 0; cc < numberOfBlocks; ++cc)
+  {
+    auto sphere = vtkSmartPointer<vtkSMProxy>::Take(pxm->NewProxy("sources", "SphereSource"));
+    controller->PreInitializeProxy(sphere);
+    vtkSMPropertyHelper(sphere, "ThetaResolution").Set(8 + cc);
+    controller->PostInitializeProxy(sphere);
+    controller->RegisterPipelineProxy(sphere);
+    vtkSMPropertyHelper(group, "Input").Add(sphere);
+  }
+  controller->PostInitializeProxy(group);
+  controller->RegisterPipelineProxy(group);
+  group->UpdatePipeline();
+
+  // below the threshold, the per-block information is available.
+  vtkSMOutputPort* port = group->GetOutputPort(0u);
+  vtkPVDataInformation* info = port->GetDataInformation();
+  if (info->GetCompositeDataInformation()->GetIsSummary())
+  {
+    vtkLogF(ERROR, "Information should not be summarized when disabled.");
+    return false;
+  }
+  const vtkIdType totalNumberOfPoints = info->GetNumberOfPoints();
+  std::vector<vtkIdType> numberOfPoints;
+  for (int cc = 0; cc < numberOfBlocks; ++cc)
+  {
+    vtkPVDataInformation* blockInfo = info->GetDataInformationForCompositeIndex(cc + 1);
+    numberOfPoints.push_back(blockInfo ? blockInfo->GetNumberOfPoints() : -1);
+  }
+  if (!ValidateSubsets(port, numberOfPoints))
+  {
+    return false;
+  }
+
+  // above the threshold, only a summary is gathered and the blocks are
+  // fetched on demand.
+  vtkSMOutputPort::SetSummaryBlockThreshold(numberOfBlocks - 1);
+  port->InvalidateDataInformation();
+  info = port->GetDataInformation();
+  vtkPVCompositeDataInformation* cinfo = info->GetCompositeDataInformation();
+  if (!cinfo->GetIsSummary() ||
+    cinfo->GetNumberOfChildren() != static_cast<unsigned int>(numberOfBlocks) ||
+    cinfo->GetDataInformation(0) != nullptr)
+  {
+    vtkLogF(ERROR, "Information should have been summarized.");
+    return false;
+  }
+  for (int cc = 0; cc <= numberOfBlocks; ++cc)
+  {
+    if (cinfo->GetSummarizedChildOffset(cc) != static_cast<unsigned int>(cc + 1))
+    {
+      vtkLogF(ERROR, "Wrong composite index for summarized block %d.", cc);
+      return false;
+    }
+  }
+  if (info->GetNumberOfPoints() != totalNumberOfPoints ||
+    info->GetNumberOfDataSets() != numberOfBlocks)
+  {
+    vtkLogF(ERROR, "Summary does not match the aggregate information.");
+    return false;
+  }
+  return ValidateSubsets(port, numberOfPoints);
+}
+}
+
+int TestSubsetDataInformation(int, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  vtkNew<vtkSMParaViewPipelineController> controller;
+  vtkNew<vtkSMSession> session;
+  controller->InitializeSession(session);
+
+  const bool success = CheckSubsetDataInformation(session->GetSessionProxyManager());
+
+  vtkSMOutputPort::SetSummaryBlockThreshold(0);
+  session->GetSessionProxyManager()->UnRegisterProxies();
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -26,6 +26,7 @@
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVInformation.h"
+#include "vtkPVLogger.h"
 #include "vtkPVOptions.h"
 #include "vtkPVSession.h"
 #include "vtkPVSessionCoreInterpreterHelper.h"
@@ -35,6 +36,7 @@
 #include "vtkSIProxyDefinitionManager.h"
 #include "vtkSMMessage.h"
 #include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
 
 #include "vtksys/FStream.hxx"
 
@@ -42,6 +44,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #define LOG(x)                                                                                     \
   if (this->LogStream)                                                                             \
@@ -616,8 +619,9 @@ void vtkPVSessionCore::ExecuteStreamSatelliteCallback()
   this->ParallelController->Broadcast(raw_data, byte_size[0], 0);
 
   vtkClientServerStream stream;
-  stream.SetData(raw_data, byte_size[0]);
+  stream.SetDataInPlace(raw_data, byte_size[0]);
   this->ExecuteStreamInternal(stream, byte_size[1] != 0);
+  stream.Reset();
   delete[] raw_data;
 }
 
@@ -886,106 +890,88 @@ void vtkPVSessionCore::GatherInformationStatelliteCallback()
 }
 
 //----------------------------------------------------------------------------
-#define SafeDeleteArray(array_ptr)                                                                 \
-  {                                                                                                \
-    if (array_ptr != NULL)                                                                         \
-    {                                                                                              \
-      delete[] array_ptr;                                                                          \
-      array_ptr = NULL;                                                                            \
-    }                                                                                              \
-  }
-
+// The information is reduced along a binomial tree rooted at rank 0. At step
+// k, a rank with the k-th bit set sends what it merged so far to the rank
+// without that bit and stops, while the others receive and merge from the
+// rank with that bit set, if any. Each rank merges at most log2(P) children,
+// in increasing rank order, so the root adds the ranks in the same order as
+// a flat gather would.
 bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
 {
-  // Sanity checks
-  assert("pre: NULL PV information!" && (info != NULL));
-
-  // STEP 0: temporary variables
   int rank = this->ParallelController->GetLocalProcessId();
   int nranks = this->ParallelController->GetNumberOfProcesses();
 
+  // The root always has an information object. Satellites that failed to
+  // create one still take part in the reduction so that the root doesn't
+  // hang, but contribute nothing.
+  assert("pre: NULL PV information!" && (info != NULL || rank != 0));
+
   if (nranks == 1)
   {
     /* short-circuit */
     return true;
   }
 
-  vtkIdType* rcvcounts = NULL;     /* significant only at rank 0 */
-  vtkIdType* offSet = NULL;        /* significant only at rank 0 */
-  int rbufsize = 0;                /* significant only at rank 0 */
-  unsigned char* rcvbuffer = NULL; /* significant only at rank 0 */
-
-  // STEP 1: Initialize data-structures at rank 0
-  if (rank == 0)
-  {
-    rcvcounts = new vtkIdType[nranks];
-    offSet = new vtkIdType[nranks];
-  } // END if rank == 0
-
-  // STEP 2: Serialize the vtkPVInformation object
-  vtkClientServerStream stream;
-  info->CopyToStream(&stream);
-
-  const unsigned char* data;
-  size_t length;
-
-  // Get pointer to the raw stream data. Note, this is a shallow copy, no
-  // need to delete the data.
-  stream.GetData(&data, &length);
-  vtkIdType local_length = static_cast<vtkIdType>(length);
-
-  // STEP 3: Get number of bytes that each process will send
-  this->ParallelController->Gather(&local_length, rcvcounts, 1, 0);
+  vtkVLogScopeF(PARAVIEW_LOG_EXECUTION_VERBOSITY(), "collect information (%s)",
+    info ? info->GetClassName() : "none");
+  vtkTimerLog::MarkStartEvent("Collect Information");
 
-  // STEP 4: Allocate temporary arrays at rank 0
-  if (rank == 0)
+  for (int mask = 1; mask < nranks; mask <<= 1)
   {
-    // STEP 4.1: Calculate rcvbuffer size & allocate rcvbuffer
-    rbufsize = rcvcounts[0];
-    for (int i = 1; i < nranks; ++i)
+    if ((rank & mask) != 0)
     {
-      rbufsize += rcvcounts[i];
+      // Forward the merged information to the parent.
+      vtkClientServerStream stream;
+      const unsigned char* data = NULL;
+      size_t length = 0;
+      if (info)
+      {
+        info->CopyToStream(&stream);
+        stream.GetData(&data, &length);
+      }
+      vtkIdType local_length = static_cast<vtkIdType>(length);
+      this->ParallelController->Send(&local_length, 1, rank - mask, ROOT_SATELLITE_INFO_TAG);
+      if (local_length > 0)
+      {
+        this->ParallelController->Send(
+          data, local_length, rank - mask, ROOT_SATELLITE_INFO_DATA_TAG);
+      }
+      break;
     }
-    rcvbuffer = new unsigned char[rbufsize];
 
-    // STEP 4.2: populate offset array
-    offSet[0] = 0;
-    for (int i = 1; i < nranks; ++i)
+    const int child = rank + mask;
+    if (child >= nranks)
     {
-      offSet[i] = offSet[i - 1] + rcvcounts[i - 1];
+      continue;
     }
-  } // END if rank==0
 
-  // STEP 5: GatherV all data from satellites
-  this->ParallelController->GatherV(data, rcvbuffer, local_length, rcvcounts, offSet, 0);
+    vtkTimerLog::MarkStartEvent("Receive Information");
+    vtkIdType child_length = 0;
+    this->ParallelController->Receive(&child_length, 1, child, ROOT_SATELLITE_INFO_TAG);
+    std::vector<unsigned char> buffer(static_cast<size_t>(child_length));
+    if (child_length > 0)
+    {
+      this->ParallelController->Receive(
+        buffer.data(), child_length, child, ROOT_SATELLITE_INFO_DATA_TAG);
+    }
+    vtkTimerLog::MarkEndEvent("Receive Information");
 
-  // STEP 6: Deserialize data from other ranks at rank 0 and add them to
-  // the information object associated with rank 0.
-  if (rank == 0)
-  {
-    vtkClientServerStream rcvStream;
-    for (int i = 1; i < nranks; ++i)
+    if (info && child_length > 0)
     {
-      rcvStream.SetData(&rcvbuffer[offSet[i]], rcvcounts[i]);
-      vtkPVInformation* tempInfo = info->NewInstance();
-      tempInfo->CopyFromStream(&rcvStream);
-      info->AddInformation(tempInfo);
-      tempInfo->Delete();
-    } // END for all remote ranks
-  }   // END if rank == 0
-
-  // STEP 7: De-allocate temporary arrays at rank 0
-  SafeDeleteArray(rcvcounts);
-  SafeDeleteArray(offSet);
-  SafeDeleteArray(rcvbuffer);
-
-  // Sanity checks -- ensure we return all dynamically allocated memory
-  assert("post: rcvcounts should be NULL" && (rcvcounts == NULL));
-  assert("post: offSet should be NULL" && (offSet == NULL));
-  assert("post: rcvbuffer should be NULL" && (rcvbuffer == NULL));
-
-  // STEP 8: Barrier synchronization
-  this->ParallelController->Barrier();
+      vtkTimerLog::MarkStartEvent("Merge Information");
+      vtkClientServerStream rcvStream;
+      rcvStream.SetData(buffer.data(), buffer.size());
+      vtkSmartPointer<vtkPVInformation> childInfo;
+      childInfo.TakeReference(info->NewInstance());
+      childInfo->CopyFromStream(&rcvStream);
+      info->AddInformation(childInfo);
+      vtkTimerLog::MarkEndEvent("Merge Information");
+    }
+    vtkVLogF(PARAVIEW_LOG_EXECUTION_VERBOSITY(), "merged information from rank %d (%lld bytes)",
+      child, static_cast<long long>(child_length));
+  }
+
+  vtkTimerLog::MarkEndEvent("Collect Information");
   return true;
 }
 
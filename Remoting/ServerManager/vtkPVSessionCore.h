@@ -211,7 +211,9 @@ protected:
   bool GatherInformationInternal(vtkPVInformation* information, vtkTypeUInt32 globalid);
 
   /**
-   * Gather information across MPI satellites.
+   * Gather information across MPI satellites. The information is merged
+   * along a binomial tree, so the root receives from log2(P) ranks only.
+   * The time spent is recorded in the timer log.
    */
   bool CollectInformation(vtkPVInformation*);
 
@@ -235,7 +237,8 @@ protected:
   enum
   {
     ROOT_SATELLITE_RMI_TAG = 887822,
-    ROOT_SATELLITE_INFO_TAG = 887823
+    ROOT_SATELLITE_INFO_TAG = 887823,
+    ROOT_SATELLITE_INFO_DATA_TAG = 887824
   };
 
   vtkSIProxyDefinitionManager* ProxyDefinitionManager;
@@ -601,8 +601,9 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
       unsigned char* css_data = new unsigned char[size + 1];
       this->Internal->GetActiveController()->Receive(
         css_data, size, 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
+      // Parse the received buffer without copying it again.
       vtkClientServerStream cssStream;
-      cssStream.SetData(css_data, size);
+      cssStream.SetDataInPlace(css_data, size);
       this->ExecuteStream(vtkPVSession::CLIENT_AND_SERVERS, cssStream, ignore_errors != 0);
       delete[] css_data;
     }
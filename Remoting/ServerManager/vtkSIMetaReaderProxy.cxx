@@ -62,6 +62,26 @@ void vtkSIMetaReaderProxy::OnCreateVTKObjects()
            << this->GetFileNameMethod() << vtkClientServerStream::End;
   }
   this->Interpreter->ProcessStream(stream);
+
+  // The internal reader may be reading the next time step in the background,
+  // see vtkFileSeriesReader::PrefetchNextTimeStep. Properties of the reader
+  // are pushed and pulled through the subproxy, so observe it as well.
+  if (this->GetVTKObject()->IsA("vtkFileSeriesReader"))
+  {
+    this->AddObserver(
+      vtkSIProxy::AccessVTKObjectEvent, this, &vtkSIMetaReaderProxy::WaitForPrefetch);
+    this->GetSubSIProxy("Reader")->AddObserver(
+      vtkSIProxy::AccessVTKObjectEvent, this, &vtkSIMetaReaderProxy::WaitForPrefetch);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSIMetaReaderProxy::WaitForPrefetch()
+{
+  vtkClientServerStream stream;
+  stream << vtkClientServerStream::Invoke << this->GetVTKObject() << "WaitForPrefetch"
+         << vtkClientServerStream::End;
+  this->Interpreter->ProcessStream(stream);
 }
 
 //----------------------------------------------------------------------------
@@ -43,6 +43,12 @@ protected:
 
   void OnCreateVTKObjects() override;
 
+  /**
+   * Waits for the time step prefetched by the vtkFileSeriesReader, if any,
+   * before its internal reader is accessed.
+   */
+  void WaitForPrefetch();
+
   /**
    * Read xml-attributes.
    */
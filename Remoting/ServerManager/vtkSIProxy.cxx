@@ -130,6 +130,7 @@ void vtkSIProxy::Push(vtkSMMessage* message)
   {
     return;
   }
+  this->InvokeEvent(vtkSIProxy::AccessVTKObjectEvent);
 
   // update log name, if changed.
   if (message->HasExtension(ProxyState::log_name))
@@ -176,6 +177,7 @@ void vtkSIProxy::Pull(vtkSMMessage* message)
   {
     return;
   }
+  this->InvokeEvent(vtkSIProxy::AccessVTKObjectEvent);
 
   // Return a set of Pull only property (information_only props)
   // In fact Pushed Property can not be fetch at the same time as Pull
@@ -56,6 +56,17 @@ public:
    */
   void Pull(vtkSMMessage* msg) override;
 
+  enum Events
+  {
+    /**
+     * Fired before properties are pushed to or pulled from the VTK object and
+     * before vtkSISourceProxy updates its pipeline information, so that
+     * observers can make sure the VTK object is not in use by another thread,
+     * see vtkSIMetaReaderProxy.
+     */
+    AccessVTKObjectEvent = 2100
+  };
+
   //@{
   /**
    * Returns access to the VTKObject pointer, if any.
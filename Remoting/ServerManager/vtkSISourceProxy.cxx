@@ -268,6 +268,7 @@ void vtkSISourceProxy::UpdatePipelineInformation()
 
   if (this->GetVTKObject())
   {
+    this->InvokeEvent(vtkSIProxy::AccessVTKObjectEvent);
     vtkAlgorithm* algo = vtkAlgorithm::SafeDownCast(this->GetVTKObject());
     if (algo)
     {
@@ -19,8 +19,10 @@
 #include "vtkCollectionIterator.h"
 #include "vtkCommand.h"
 #include "vtkDataObject.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVClassNameInformation.h"
+#include "vtkPVCompositeDataInformation.h"
 #include "vtkPVDataAssemblyInformation.h"
 #include "vtkPVDataInformation.h"
 #include "vtkPVTemporalDataInformation.h"
@@ -36,6 +38,8 @@
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkSMOutputPort);
 
+int vtkSMOutputPort::SummaryBlockThreshold = 0;
+
 //----------------------------------------------------------------------------
 vtkSMOutputPort::vtkSMOutputPort()
 {
@@ -86,6 +90,57 @@ vtkPVTemporalDataInformation* vtkSMOutputPort::GetTemporalDataInformation()
   return this->TemporalDataInformation;
 }
 
+//----------------------------------------------------------------------------
+vtkPVDataInformation* vtkSMOutputPort::GetSubsetDataInformation(unsigned int compositeIndex)
+{
+  // this also makes sure the cache is not holding information for a previous
+  // update.
+  vtkPVDataInformation* dataInfo = this->GetDataInformation();
+  if (compositeIndex == 0)
+  {
+    return dataInfo;
+  }
+  if (!dataInfo->GetCompositeDataInformation()->GetIsSummary())
+  {
+    // the per-block information is already available.
+    return dataInfo->GetDataInformationForCompositeIndex(static_cast<int>(compositeIndex));
+  }
+
+  auto iter = this->SubsetDataInformation.find(compositeIndex);
+  if (iter != this->SubsetDataInformation.end())
+  {
+    return iter->second;
+  }
+
+  if (!this->SourceProxy)
+  {
+    vtkErrorMacro("Invalid vtkSMOutputPort.");
+    return nullptr;
+  }
+
+  vtkNew<vtkPVDataInformation> info;
+  info->SetPortNumber(this->PortIndex);
+  info->SetSummaryBlockThreshold(vtkSMOutputPort::SummaryBlockThreshold);
+  info->SetCompositeIndex(static_cast<int>(compositeIndex));
+  this->SourceProxy->GetSession()->PrepareProgress();
+  this->SourceProxy->GatherInformation(info);
+  this->SourceProxy->GetSession()->CleanupPendingProgress();
+  this->SubsetDataInformation[compositeIndex] = info.Get();
+  return info;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMOutputPort::SetSummaryBlockThreshold(int threshold)
+{
+  vtkSMOutputPort::SummaryBlockThreshold = threshold > 0 ? threshold : 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkSMOutputPort::GetSummaryBlockThreshold()
+{
+  return vtkSMOutputPort::SummaryBlockThreshold;
+}
+
 //----------------------------------------------------------------------------
 vtkDataAssembly* vtkSMOutputPort::GetDataAssembly()
 {
@@ -118,6 +173,7 @@ void vtkSMOutputPort::InvalidateDataInformation()
   this->DataInformationValid = false;
   this->ClassNameInformationValid = false;
   this->TemporalDataInformationValid = false;
+  this->SubsetDataInformation.clear();
 }
 
 //----------------------------------------------------------------------------
@@ -132,6 +188,7 @@ void vtkSMOutputPort::GatherDataInformation()
   this->SourceProxy->GetSession()->PrepareProgress();
   this->DataInformation->Initialize();
   this->DataInformation->SetPortNumber(this->PortIndex);
+  this->DataInformation->SetSummaryBlockThreshold(vtkSMOutputPort::SummaryBlockThreshold);
   this->SourceProxy->GatherInformation(this->DataInformation);
 
   this->DataAssemblyInformation->Initialize();
@@ -32,7 +32,10 @@
 
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSMProxy.h"
-#include "vtkWeakPointer.h" // needed by SourceProxy pointer
+#include "vtkSmartPointer.h" // needed for vtkSmartPointer
+#include "vtkWeakPointer.h"  // needed by SourceProxy pointer
+
+#include <map> // needed for std::map
 
 class vtkCollection;
 class vtkDataAssembly;
@@ -65,6 +68,28 @@ public:
    */
   virtual vtkPVTemporalDataInformation* GetTemporalDataInformation();
 
+  /**
+   * Returns data information for the block with the given flat index of the
+   * composite dataset produced on this port. When GetDataInformation() only
+   * returns a summary, see SetSummaryBlockThreshold(), the information for the
+   * block is fetched on demand and cached until the data information is
+   * invalidated. Otherwise this is the same as
+   * `GetDataInformation()->GetDataInformationForCompositeIndex(compositeIndex)`.
+   * Use this method rather than the latter whenever the dataset may be summarized.
+   */
+  virtual vtkPVDataInformation* GetSubsetDataInformation(unsigned int compositeIndex);
+
+  //@{
+  /**
+   * Composite datasets with more leaves than this threshold only get summary
+   * data information, without the per-block information. 0, the default,
+   * disables summaries. Forwarded to
+   * vtkPVDataInformation::SetSummaryBlockThreshold().
+   */
+  static void SetSummaryBlockThreshold(int threshold);
+  static int GetSummaryBlockThreshold();
+  //@}
+
   /**
    * If available, returns the data assembly associated with the data produced
    * on this port. This is collected alongside DataInformation and hence all
@@ -155,6 +180,10 @@ protected:
   vtkPVTemporalDataInformation* TemporalDataInformation;
   bool TemporalDataInformationValid;
 
+  std::map<unsigned int, vtkSmartPointer<vtkPVDataInformation> > SubsetDataInformation;
+
+  static int SummaryBlockThreshold;
+
 private:
   vtkSMOutputPort(const vtkSMOutputPort&) = delete;
   void operator=(const vtkSMOutputPort&) = delete;
@@ -19,6 +19,7 @@
 #include "vtkSISourceProxy.h"
 #include "vtkSMArraySelectionDomain.h"
 #include "vtkSMInputArrayDomain.h"
+#include "vtkSMOutputPort.h"
 #include "vtkSMTrace.h"
 
 #if VTK_MODULE_ENABLE_ParaView_RemotingAnimation
@@ -107,6 +108,22 @@ bool vtkPVGeneralSettings::GetAutoConvertProperties()
   return vtkSMInputArrayDomain::GetAutomaticPropertyConversion();
 }
 
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetDataInformationSummaryThreshold(int val)
+{
+  if (this->GetDataInformationSummaryThreshold() != val)
+  {
+    vtkSMOutputPort::SetSummaryBlockThreshold(val);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkPVGeneralSettings::GetDataInformationSummaryThreshold()
+{
+  return vtkSMOutputPort::GetSummaryBlockThreshold();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVGeneralSettings::SetEnableAutoMPI(bool val)
 {
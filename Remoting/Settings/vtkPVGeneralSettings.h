@@ -53,6 +53,16 @@ public:
   bool GetAutoConvertProperties();
   //@}
 
+  //@{
+  /**
+   * Composite datasets with more blocks than this threshold only get summary
+   * data information, without per-block information. 0 disables summaries.
+   * Forwards the call to vtkSMOutputPort::SetSummaryBlockThreshold.
+   */
+  void SetDataInformationSummaryThreshold(int val);
+  int GetDataInformationSummaryThreshold();
+  //@}
+
   //@{
   /**
    * Determines the number of distinct values in
@@ -15,12 +15,14 @@
 =========================================================================*/
 #include "vtkPVClientServerSynchronizedRenderers.h"
 
+#include "vtkDeltaImageCompressor.h"
 #include "vtkLZ4Compressor.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkOpenGLRenderer.h"
 #include "vtkPVConfig.h"
 #include "vtkSquirtCompressor.h"
+#include "vtkTiledImageCompressor.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkZlibImageCompressor.h"
 #if VTK_MODULE_ENABLE_ParaView_nvpipe
@@ -56,17 +58,18 @@ void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
 
   vtkRawImage& rawImage = this->Image;
 
-  int header[4];
-  this->ParallelController->Receive(header, 4, 1, 0x023430);
+  int header[5];
+  this->ParallelController->Receive(header, 5, 1, 0x023430);
   if (header[0] > 0)
   {
     rawImage.Resize(header[1], header[2], header[3]);
+    int decoded = 0;
     if (this->Compressor)
     {
       vtkUnsignedCharArray* data = vtkUnsignedCharArray::New();
       this->ParallelController->Receive(data, 1, 0x023430);
       this->Compressor->SetImageResolution(header[1], header[2]);
-      this->Decompress(data, rawImage.GetRawPtr());
+      decoded = this->Decompress(data, rawImage.GetRawPtr()) ? 1 : 0;
       data->Delete();
     }
     else
@@ -74,6 +77,12 @@ void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
       this->ParallelController->Receive(rawImage.GetRawPtr(), 1, 0x023430);
     }
     rawImage.MarkValid();
+
+    // let a vtkDeltaImageCompressor know whether its next frame can be a delta.
+    if (header[4] > 0)
+    {
+      this->ParallelController->Send(&decoded, 1, 1, 0x023430);
+    }
   }
 }
 
@@ -85,14 +94,20 @@ void vtkPVClientServerSynchronizedRenderers::SlaveEndRender()
 
   vtkRawImage& rawImage = this->CaptureRenderedImage();
 
-  int header[4];
+  // delta frames only apply to the previous frame, so the client reports
+  // whether it decoded each one and a key frame follows any that it did not.
+  vtkDeltaImageCompressor* deltaCompressor =
+    vtkDeltaImageCompressor::SafeDownCast(this->Compressor);
+
+  int header[5];
   header[0] = rawImage.IsValid() ? 1 : 0;
   header[1] = rawImage.GetWidth();
   header[2] = rawImage.GetHeight();
   header[3] = rawImage.IsValid() ? rawImage.GetRawPtr()->GetNumberOfComponents() : 0;
+  header[4] = deltaCompressor ? 1 : 0;
 
   // send the image to the client.
-  this->ParallelController->Send(header, 4, 1, 0x023430);
+  this->ParallelController->Send(header, 5, 1, 0x023430);
 
   if (rawImage.IsValid())
   {
@@ -105,6 +120,16 @@ void vtkPVClientServerSynchronizedRenderers::SlaveEndRender()
     {
       this->ParallelController->Send(rawImage.GetRawPtr(), 1, 0x023430);
     }
+
+    if (deltaCompressor)
+    {
+      int decoded = 0;
+      this->ParallelController->Receive(&decoded, 1, 1, 0x023430);
+      if (!decoded)
+      {
+        deltaCompressor->ForceKeyFrame();
+      }
+    }
   }
 }
 
@@ -115,7 +140,7 @@ vtkUnsignedCharArray* vtkPVClientServerSynchronizedRenderers::Compress(vtkUnsign
   {
     this->Compressor->SetLossLessMode(this->LossLessCompression);
     this->Compressor->SetInput(data);
-    if (this->Compressor->Compress() == 0)
+    if (this->Compressor->Compress() != VTK_OK)
     {
       vtkErrorMacro("Image compression failed!");
       return data;
@@ -127,7 +152,7 @@ vtkUnsignedCharArray* vtkPVClientServerSynchronizedRenderers::Compress(vtkUnsign
 }
 
 //----------------------------------------------------------------------------
-void vtkPVClientServerSynchronizedRenderers::Decompress(
+bool vtkPVClientServerSynchronizedRenderers::Decompress(
   vtkUnsignedCharArray* data, vtkUnsignedCharArray* outputBuffer)
 {
   if (this->Compressor)
@@ -135,15 +160,18 @@ void vtkPVClientServerSynchronizedRenderers::Decompress(
     this->Compressor->SetLossLessMode(this->LossLessCompression);
     this->Compressor->SetInput(data);
     this->Compressor->SetOutput(outputBuffer);
-    if (this->Compressor->Decompress() == 0)
+    if (this->Compressor->Decompress() != VTK_OK)
     {
       vtkErrorMacro("Image de-compression failed!");
+      return false;
     }
+    return true;
   }
   else
   {
     vtkErrorMacro("No compressor present.");
   }
+  return false;
 }
 
 //----------------------------------------------------------------------------
@@ -172,6 +200,14 @@ void vtkPVClientServerSynchronizedRenderers::ConfigureCompressor(const char* str
     {
       comp = vtkLZ4Compressor::New();
     }
+    else if (className == "vtkTiledImageCompressor")
+    {
+      comp = vtkTiledImageCompressor::New();
+    }
+    else if (className == "vtkDeltaImageCompressor")
+    {
+      comp = vtkDeltaImageCompressor::New();
+    }
     else if (className == "vtkNvPipeCompressor" && this->NVPipeSupport)
     {
 #if VTK_MODULE_ENABLE_ParaView_nvpipe
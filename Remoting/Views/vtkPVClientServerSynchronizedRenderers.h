@@ -18,7 +18,9 @@
  *
  * vtkPVClientServerSynchronizedRenderers is similar to
  * vtkClientServerSynchronizedRenderers except that it optionally uses image
- * compressors to compress the image before transmitting.
+ * compressors to compress the image before transmitting. With a
+ * vtkDeltaImageCompressor, the client reports whether it decoded each image,
+ * so that the server sends a key frame after one that it could not.
 */
 
 #ifndef vtkPVClientServerSynchronizedRenderers_h
@@ -72,7 +74,11 @@ protected:
   //@}
 
   vtkUnsignedCharArray* Compress(vtkUnsignedCharArray*);
-  void Decompress(vtkUnsignedCharArray* input, vtkUnsignedCharArray* outputBuffer);
+
+  /**
+   * Decompress the image received from the server. Returns false on failure.
+   */
+  bool Decompress(vtkUnsignedCharArray* input, vtkUnsignedCharArray* outputBuffer);
 
   void MasterEndRender() override;
   void SlaveEndRender() override;
@@ -16,6 +16,9 @@
 #include "vtkPVDataDeliveryManagerInternals.h"
 
 #include "vtkAlgorithmOutput.h"
+#include "vtkCharArray.h"
+#include "vtkCommunicator.h"
+#include "vtkDataObjectTypes.h"
 #include "vtkInformation.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
@@ -25,10 +28,152 @@
 #include "vtkSmartPointer.h"
 #include "vtkWeakPointer.h"
 
+#include <vtksys/FStream.hxx>
+#include <vtksys/SystemInformation.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <iomanip>
+#include <limits>
+#include <list>
+
+//*****************************************************************************
+// Least-recently-used store of delivered data objects, written in the
+// marshaled (legacy VTK) format to files in a private directory.
+class vtkPVDataDeliveryManager::vtkDiskCache
+{
+  struct vtkEntry
+  {
+    std::string FileName;
+    size_t Size;
+    int DataObjectType;
+    std::list<std::string>::iterator Position;
+  };
+
+  std::string BaseDirectory;
+  std::string Directory;
+  std::map<std::string, vtkEntry> Entries;
+  // Most recently used keys first.
+  std::list<std::string> UsageOrder;
+  size_t TotalSize = 0;
+  unsigned long NextFileId = 0;
+
+  void Remove(std::map<std::string, vtkEntry>::iterator iter)
+  {
+    vtksys::SystemTools::RemoveFile(iter->second.FileName);
+    this->TotalSize -= iter->second.Size;
+    this->UsageOrder.erase(iter->second.Position);
+    this->Entries.erase(iter);
+  }
+
+public:
+  vtkDiskCache(const std::string& baseDirectory, const void* owner)
+    : BaseDirectory(baseDirectory)
+  {
+    vtksys::SystemInformation sysinfo;
+    std::ostringstream dirname;
+    dirname << baseDirectory << "/pvgeometry-" << sysinfo.GetProcessId() << "-" << owner;
+    this->Directory = dirname.str();
+    vtksys::SystemTools::MakeDirectory(this->Directory);
+  }
+
+  ~vtkDiskCache() { vtksys::SystemTools::RemoveADirectory(this->Directory); }
+
+  const std::string& GetBaseDirectory() const { return this->BaseDirectory; }
+
+  vtkSmartPointer<vtkDataObject> Get(const std::string& key)
+  {
+    auto iter = this->Entries.find(key);
+    if (iter == this->Entries.end())
+    {
+      return nullptr;
+    }
+
+    vtkNew<vtkCharArray> buffer;
+    buffer->SetNumberOfValues(static_cast<vtkIdType>(iter->second.Size));
+    vtksys::ifstream file(iter->second.FileName.c_str(), std::ios::in | std::ios::binary);
+    file.read(buffer->GetPointer(0), static_cast<std::streamsize>(iter->second.Size));
+
+    vtkSmartPointer<vtkDataObject> data;
+    data.TakeReference(vtkDataObjectTypes::NewDataObject(iter->second.DataObjectType));
+    if (!file || data == nullptr || !vtkCommunicator::UnMarshalDataObject(buffer, data))
+    {
+      this->Remove(iter);
+      return nullptr;
+    }
+
+    this->UsageOrder.splice(
+      this->UsageOrder.begin(), this->UsageOrder, iter->second.Position);
+    return data;
+  }
+
+  void Put(const std::string& key, vtkDataObject* data, size_t limit)
+  {
+    auto iter = this->Entries.find(key);
+    if (iter != this->Entries.end())
+    {
+      this->Remove(iter);
+    }
+
+    vtkNew<vtkCharArray> buffer;
+    if (!vtkCommunicator::MarshalDataObject(data, buffer))
+    {
+      return;
+    }
+    const size_t size = static_cast<size_t>(buffer->GetNumberOfValues());
+    if (size > limit)
+    {
+      return;
+    }
+
+    std::ostringstream filename;
+    filename << this->Directory << "/" << this->NextFileId++ << ".vtk";
+    vtksys::ofstream file(filename.str().c_str(), std::ios::out | std::ios::binary);
+    file.write(buffer->GetPointer(0), static_cast<std::streamsize>(size));
+    file.close();
+    if (!file)
+    {
+      vtksys::SystemTools::RemoveFile(filename.str());
+      return;
+    }
+
+    this->UsageOrder.push_front(key);
+    this->Entries[key] =
+      vtkEntry{ filename.str(), size, data->GetDataObjectType(), this->UsageOrder.begin() };
+    this->TotalSize += size;
+    this->Trim(limit);
+  }
+
+  // Removes least recently used entries until the cache fits in `limit` bytes.
+  void Trim(size_t limit)
+  {
+    while (this->TotalSize > limit && !this->UsageOrder.empty())
+    {
+      this->Remove(this->Entries.find(this->UsageOrder.back()));
+    }
+  }
+
+  // Removes all entries whose key starts with `prefix`.
+  void RemoveAll(const std::string& prefix)
+  {
+    for (auto iter = this->Entries.begin(); iter != this->Entries.end();)
+    {
+      auto next = std::next(iter);
+      if (iter->first.compare(0, prefix.size(), prefix) == 0)
+      {
+        this->Remove(iter);
+      }
+      iter = next;
+    }
+  }
+};
+
 //*****************************************************************************
 //----------------------------------------------------------------------------
 vtkPVDataDeliveryManager::vtkPVDataDeliveryManager()
   : Internals(new vtkInternals())
+  , DiskCacheSize(0)
+  , DiskCacheDirectory(nullptr)
+  , DiskCache(nullptr)
 {
 }
 
@@ -37,6 +182,9 @@ vtkPVDataDeliveryManager::~vtkPVDataDeliveryManager()
 {
   delete this->Internals;
   this->Internals = 0;
+  delete this->DiskCache;
+  this->DiskCache = nullptr;
+  this->SetDiskCacheDirectory(nullptr);
 }
 
 //----------------------------------------------------------------------------
@@ -69,6 +217,12 @@ void vtkPVDataDeliveryManager::UnRegisterRepresentation(vtkPVDataRepresentation*
 {
   unsigned int rid = repr->GetUniqueIdentifier();
   this->Internals->RepresentationsMap.erase(rid);
+  if (this->DiskCache)
+  {
+    std::ostringstream prefix;
+    prefix << rid << ":";
+    this->DiskCache->RemoveAll(prefix.str());
+  }
 
   vtkInternals::ItemsMapType::iterator iter = this->Internals->ItemsMap.begin();
   while (iter != this->Internals->ItemsMap.end())
@@ -213,6 +367,22 @@ bool vtkPVDataDeliveryManager::NeedsDelivery(
       if (item.GetTimeStamp(cacheKey) > timestamp ||
         item.GetDeliveryTimeStamp(dataKey, cacheKey) < item.GetTimeStamp(cacheKey))
       {
+        const int port = iter->first.second;
+        vtkDiskCache* diskCache =
+          this->CanUseDiskCache(repr, low_res, port) ? this->GetDiskCache() : nullptr;
+        vtkSmartPointer<vtkDataObject> data;
+        if (diskCache)
+        {
+          data = diskCache->Get(this->GetDiskCacheKey(repr, low_res, port));
+        }
+        if (data)
+        {
+          vtkVLogF(
+            PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "disk-cache: %s", repr->GetLogName().c_str());
+          item.SetDeliveredDataObject(dataKey, cacheKey, data);
+          continue;
+        }
+
         vtkVLogF(
           PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "needs-delivery: %s", repr->GetLogName().c_str());
         // FIXME: convert keys_to_deliver to a vector of pairs.
@@ -262,6 +432,17 @@ void vtkPVDataDeliveryManager::Deliver(int low_res, unsigned int size, unsigned
       vtkVLogScopeF(
         PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "move-data: %s", repr->GetLogName().c_str());
       this->MoveData(repr, low_res != 0, port);
+
+      vtkDiskCache* diskCache =
+        this->CanUseDiskCache(repr, low_res != 0, port) ? this->GetDiskCache() : nullptr;
+      vtkDataObject* delivered = diskCache
+        ? item->GetDeliveredDataObject(this->GetDeliveredDataKey(low_res != 0), cacheKey)
+        : nullptr;
+      if (delivered)
+      {
+        diskCache->Put(this->GetDiskCacheKey(repr, low_res != 0, port), delivered,
+          static_cast<size_t>(this->DiskCacheSize) * 1024 * 1024);
+      }
     }
   }
 }
@@ -297,8 +478,55 @@ void vtkPVDataDeliveryManager::ClearCache(vtkPVDataRepresentation* repr)
   this->Internals->ClearCache(repr);
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVDataDeliveryManager::CanUseDiskCache(vtkPVDataRepresentation*, bool, int)
+{
+  return false;
+}
+
+//----------------------------------------------------------------------------
+vtkPVDataDeliveryManager::vtkDiskCache* vtkPVDataDeliveryManager::GetDiskCache()
+{
+  if (this->DiskCacheSize <= 0 || this->DiskCacheDirectory == nullptr ||
+    this->DiskCacheDirectory[0] == '\0')
+  {
+    delete this->DiskCache;
+    this->DiskCache = nullptr;
+    return nullptr;
+  }
+
+  if (this->DiskCache && this->DiskCache->GetBaseDirectory() != this->DiskCacheDirectory)
+  {
+    delete this->DiskCache;
+    this->DiskCache = nullptr;
+  }
+  if (this->DiskCache == nullptr)
+  {
+    this->DiskCache = new vtkDiskCache(this->DiskCacheDirectory, this);
+  }
+  // The size may have been reduced since the last call.
+  this->DiskCache->Trim(static_cast<size_t>(this->DiskCacheSize) * 1024 * 1024);
+  return this->DiskCache;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkPVDataDeliveryManager::GetDiskCacheKey(
+  vtkPVDataRepresentation* repr, bool low_res, int port) const
+{
+  // The representation id must come first, see UnRegisterRepresentation.
+  std::ostringstream key;
+  key << repr->GetUniqueIdentifier() << ":" << port << ":" << (low_res ? 1 : 0) << ":"
+      << this->GetDeliveredDataKey(low_res) << ":" << repr->GetPipelineStateTime() << ":"
+      << std::setprecision(std::numeric_limits<double>::max_digits10)
+      << (repr->GetUpdateTimeValid() ? repr->GetUpdateTime() : 0.0);
+  return key.str();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataDeliveryManager::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "DiskCacheSize: " << this->DiskCacheSize << endl;
+  os << indent << "DiskCacheDirectory: "
+     << (this->DiskCacheDirectory ? this->DiskCacheDirectory : "(none)") << endl;
 }
@@ -42,6 +42,7 @@ class vtkInformation;
 class vtkPVDataRepresentation;
 class vtkPVView;
 
+#include <string>
 #include <vector>
 
 class VTKREMOTINGVIEWS_EXPORT vtkPVDataDeliveryManager : public vtkObject
@@ -103,10 +104,39 @@ public:
   vtkDataObject* GetDeliveredPiece(vtkPVDataRepresentation* repr, bool low_res, int port = 0);
 
   /**
-   * Clear all cached data objects for the given representation.
+   * Clear all cached data objects for the given representation. This does
+   * not affect the disk cache (see SetDiskCacheSize).
    */
   void ClearCache(vtkPVDataRepresentation* repr);
 
+  //@{
+  /**
+   * Set the maximum size, in megabytes, of the on-disk cache of delivered
+   * geometry. 0 (default) disables the disk cache.
+   *
+   * When enabled, geometry delivered to the client is also written to
+   * DiskCacheDirectory, keyed on the representation state, its update time,
+   * the level-of-detail and the port. When the same geometry is needed again,
+   * e.g. when going back to a previously visited time step, it is read from
+   * the disk instead of being requested from the server. The least recently
+   * used entries are removed once the cache grows beyond its size.
+   * The cache is only used on the client in client-server mode, and only for
+   * subclasses that allow it (see CanUseDiskCache).
+   */
+  vtkSetClampMacro(DiskCacheSize, int, 0, VTK_INT_MAX);
+  vtkGetMacro(DiskCacheSize, int);
+  //@}
+
+  //@{
+  /**
+   * Set the directory where the disk cache files are written. Each
+   * delivery manager uses its own sub-directory, removed on destruction.
+   * The disk cache is disabled when no directory is set.
+   */
+  vtkSetStringMacro(DiskCacheDirectory);
+  vtkGetStringMacro(DiskCacheDirectory);
+  //@}
+
   //@{
   /**
    * Provides access to the producer port for the geometry of a registered
@@ -175,6 +205,15 @@ protected:
 
   double GetCacheKey(vtkPVDataRepresentation* repr) const;
 
+  /**
+   * Returns true if the delivered data for the given representation may be
+   * served from, and stored into, the disk cache. This must only be the case
+   * when the local process is the sole destination of the delivery, since
+   * other processes skip delivery of data served from the disk cache.
+   * Default implementation returns false.
+   */
+  virtual bool CanUseDiskCache(vtkPVDataRepresentation* repr, bool low_res, int port);
+
   /**
    * This method is called to request that the subclass do appropriate transfer
    * for the indicated representation.
@@ -184,11 +223,21 @@ protected:
   class vtkInternals;
   vtkInternals* Internals;
 
+  int DiskCacheSize;
+  char* DiskCacheDirectory;
+
 private:
   vtkPVDataDeliveryManager(const vtkPVDataDeliveryManager&) = delete;
   void operator=(const vtkPVDataDeliveryManager&) = delete;
 
   vtkWeakPointer<vtkPVView> View;
+
+  class vtkDiskCache;
+  vtkDiskCache* DiskCache;
+
+  // Returns the disk cache if it is enabled, creating it as needed.
+  vtkDiskCache* GetDiskCache();
+  std::string GetDiskCacheKey(vtkPVDataRepresentation* repr, bool low_res, int port) const;
 };
 
 #endif
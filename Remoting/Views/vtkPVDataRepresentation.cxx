@@ -49,6 +49,9 @@ vtkPVDataRepresentation::vtkPVDataRepresentation()
   this->UniqueIdentifier = 0;
 
   this->HasTemporalPipeline = false;
+
+  this->PipelineStateTime.Modified();
+  this->UpdateTimeChanging = false;
 }
 
 //----------------------------------------------------------------------------
@@ -87,7 +90,9 @@ void vtkPVDataRepresentation::SetUpdateTime(double time)
       // upstream pipeline, which otherwise it has no clue since the pipeline
       // isn't being executed due to explicit property modification.
       this->InvokeEvent(vtkPVDataRepresentation::UpdateTimeChangedEvent);
+      this->UpdateTimeChanging = true;
       this->MarkModified();
+      this->UpdateTimeChanging = false;
     }
   }
 }
@@ -166,6 +171,10 @@ int vtkPVDataRepresentation::ProcessViewRequest(
 void vtkPVDataRepresentation::MarkModified()
 {
   this->Modified();
+  if (!this->UpdateTimeChanging)
+  {
+    this->PipelineStateTime.Modified();
+  }
 
   if (this->HasExecutive())
   {
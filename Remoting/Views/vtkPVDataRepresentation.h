@@ -179,6 +179,14 @@ public:
    */
   vtkMTimeType GetPipelineDataTime();
 
+  /**
+   * Returns the timestamp when the representation was last marked modified
+   * for any reason other than a change in the update time. Together with the
+   * update time, it identifies the data the representation produces, which
+   * makes it usable to key caches that must survive a time change.
+   */
+  vtkMTimeType GetPipelineStateTime() const { return this->PipelineStateTime.GetMTime(); }
+
   //@{
   /**
    * This is solely intended to simplify debugging and use for any other purpose
@@ -265,6 +273,9 @@ private:
 
   bool HasTemporalPipeline;
 
+  vtkTimeStamp PipelineStateTime;
+  bool UpdateTimeChanging;
+
   class Internals;
   Internals* Implementation;
   vtkWeakPointer<vtkView> View;
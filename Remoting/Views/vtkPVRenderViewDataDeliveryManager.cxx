@@ -29,7 +29,9 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkOrderedCompositeDistributor.h"
+#include "vtkProcessModule.h"
 #include "vtkPVRenderView.h"
+#include "vtkPVSession.h"
 #include "vtkPVStreamingMacros.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkWeakPointer.h"
@@ -646,6 +648,32 @@ void vtkPVRenderViewDataDeliveryManager::MoveData(
   item->SetDeliveredDataObject(viewMode, cacheKey, dataMover->GetOutputDataObject(0));
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVRenderViewDataDeliveryManager::CanUseDiskCache(
+  vtkPVDataRepresentation* repr, bool low_res, int port)
+{
+  if (this->UseRedistributedDataAsDeliveredData ||
+    vtkProcessModule::GetProcessType() != vtkProcessModule::PROCESS_CLIENT)
+  {
+    return false;
+  }
+
+  auto session =
+    vtkPVSession::SafeDownCast(vtkProcessModule::GetProcessModule()->GetActiveSession());
+  if (session == nullptr || session->GetController(vtkPVSession::DATA_SERVER_ROOT) == nullptr)
+  {
+    // builtin session, there's no round trip to save.
+    return false;
+  }
+
+  // Only cache data that is collected on the client. In that mode the server
+  // processes keep nothing from a delivery, so skipping one is safe.
+  vtkInternals::vtkItem* item = this->Internals->GetItem(repr, low_res, port);
+  auto info = item ? item->GetPieceInformation(this->GetCacheKey(repr)) : nullptr;
+  return info != nullptr &&
+    this->GetMoveMode(info, this->GetViewDataDistributionMode(low_res)) == vtkMPIMoveData::COLLECT;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVRenderViewDataDeliveryManager::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -193,6 +193,12 @@ protected:
 
   void MoveData(vtkPVDataRepresentation* repr, bool low_res, int port) override;
 
+  /**
+   * The disk cache is only used on the client of a remote session when the
+   * data is collected to the client, i.e. when rendering locally.
+   */
+  bool CanUseDiskCache(vtkPVDataRepresentation* repr, bool low_res, int port) override;
+
   int GetViewDataDistributionMode(bool low_res) const;
   int GetMoveMode(vtkInformation* info, int viewMode) const;
 
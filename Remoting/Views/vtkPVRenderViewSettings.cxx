@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkPVRenderViewSettings.h"
 
+#include "vtkMPIMoveData.h"
 #include "vtkMapper.h"
 #include "vtkObjectFactory.h"
 
@@ -112,6 +113,20 @@ void vtkPVRenderViewSettings::SetZShift(double val)
   this->Modified();
 }
 
+//----------------------------------------------------------------------------
+void vtkPVRenderViewSettings::SetGeometryDeliveryCompression(int method)
+{
+  vtkMPIMoveData::SetCompression(method);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVRenderViewSettings::SetGeometryDeliveryZLibLevel(int level)
+{
+  vtkMPIMoveData::SetZLibCompressionLevel(level);
+  this->Modified();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVRenderViewSettings::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -61,6 +61,16 @@ public:
   void SetZShift(double a);
   //@}
 
+  //@{
+  /**
+   * Set the method used to compress the geometry delivered to the client or
+   * to the render server, and the zlib level used with zlib compression.
+   * See vtkMPIMoveData::SetCompression().
+   */
+  void SetGeometryDeliveryCompression(int method);
+  void SetGeometryDeliveryZLibLevel(int level);
+  //@}
+
   //@{
   /**
    * Set the number of cells (in millions) when the representations show try to
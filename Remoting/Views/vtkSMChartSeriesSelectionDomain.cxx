@@ -25,6 +25,7 @@
 #include "vtkPVDataSetAttributesInformation.h"
 #include "vtkPVXMLElement.h"
 #include "vtkSMArrayListDomain.h"
+#include "vtkSMOutputPort.h"
 #include "vtkSMProperty.h"
 #include "vtkSMSourceProxy.h"
 #include "vtkSMStringVectorProperty.h"
@@ -168,6 +169,26 @@ vtkPVDataInformation* vtkSMChartSeriesSelectionDomain::GetInputInformation()
   return nullptr;
 }
 
+//----------------------------------------------------------------------------
+vtkPVDataInformation* vtkSMChartSeriesSelectionDomain::GetInputSubsetInformation(
+  unsigned int compositeIndex)
+{
+  vtkSMProperty* inputProperty = this->GetRequiredProperty("Input");
+  assert(inputProperty);
+
+  vtkSMUncheckedPropertyHelper helper(inputProperty);
+  if (helper.GetNumberOfElements() > 0)
+  {
+    vtkSMSourceProxy* sp = vtkSMSourceProxy::SafeDownCast(helper.GetAsProxy(0));
+    vtkSMOutputPort* port = sp ? sp->GetOutputPort(helper.GetOutputPort()) : nullptr;
+    if (port)
+    {
+      return port->GetSubsetDataInformation(compositeIndex);
+    }
+  }
+  return nullptr;
+}
+
 //----------------------------------------------------------------------------
 int vtkSMChartSeriesSelectionDomain::ReadXMLAttributes(
   vtkSMProperty* prop, vtkPVXMLElement* element)
@@ -260,7 +281,7 @@ void vtkSMChartSeriesSelectionDomain::Update(vtkSMProperty*)
   for (unsigned int cc = 0; cc < numElems; cc++)
   {
     vtkPVDataInformation* childInfo =
-      dataInfo->GetDataInformationForCompositeIndex(compositeIndexHelper.GetAsInt(cc));
+      this->GetInputSubsetInformation(static_cast<unsigned int>(compositeIndexHelper.GetAsInt(cc)));
     if (!childInfo)
     {
       continue;
@@ -111,6 +111,13 @@ protected:
    */
   vtkPVDataInformation* GetInputInformation();
 
+  /**
+   * Returns the data information for a block of the current input, if
+   * possible. The information is fetched on demand when the input only has
+   * summary information, see vtkSMOutputPort::GetSubsetDataInformation().
+   */
+  vtkPVDataInformation* GetInputSubsetInformation(unsigned int compositeIndex);
+
   /**
    * Process any specific XML definition tags.
    */
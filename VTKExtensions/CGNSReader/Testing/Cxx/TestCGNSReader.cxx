@@ -66,6 +66,17 @@ int TestCGNSReader(int argc, char* argv[])
     return EXIT_FAILURE;
   }
 
+  // Zones read concurrently must give the same output.
+  vtkNew<vtkCGNSReader> threadedReader;
+  threadedReader->SetFileName(mixed.c_str());
+  threadedReader->ReadZonesConcurrentlyOn();
+  threadedReader->Update();
+
+  if (0 != TestOutput(threadedReader->GetOutput(), 7, VTK_HEXAHEDRON))
+  {
+    return EXIT_FAILURE;
+  }
+
   fname = vtkTestUtilities::ExpandDataFileName(argc, argv, "Testing/Data/Example_nface_n.cgns");
   std::string nfacen = fname ? fname : "";
   delete[] fname;
@@ -62,6 +62,9 @@ int TestCGNSReaderMeshCaching(int argc, char* argv[])
   vtk_assert(ds != nullptr);
   vtk_assert(ds->GetCellData()->GetArray("Pressure") != nullptr);
   vtkDataArray* da = ds->GetPoints()->GetData();
+  vtk_assert(reader->GetNumberOfCacheHits() == 0);
+  vtk_assert(reader->GetNumberOfCacheMisses() > 0);
+  vtk_assert(reader->GetCacheMemorySize() > 0);
 
   reader->DisableAllCellArrays();
   timer->StartTimer();
@@ -77,6 +80,18 @@ int TestCGNSReaderMeshCaching(int argc, char* argv[])
 
   // Check Mesh Data pointer did not change between loadings
   vtk_assert(da == db);
+  vtk_assert(reader->GetNumberOfCacheHits() > 0);
+  vtk_assert(reader->GetNumberOfCacheEvictions() == 0);
+
+  // Lowering the limit evicts entries until each cache fits in it
+  reader->SetCacheMemoryLimit(1);
+  if (reader->GetCacheMemorySize() > 1024 * 1024)
+  {
+    cerr << "Cache memory size over the limit: " << reader->GetCacheMemorySize() << endl;
+    return EXIT_FAILURE;
+  }
+  reader->ResetCacheStatistics();
+  vtk_assert(reader->GetNumberOfCacheHits() == 0 && reader->GetNumberOfCacheEvictions() == 0);
   // Check that caching mesh implies lower loading time
   // vtk_assert(hot_timing < cold_timing);
   cout << "Expected timings: " << hot_timing << " < " << cold_timing << endl;
@@ -18,6 +18,13 @@
  *
  *     store an object in a container with its CGNS path key
  *
+ * The cache can be bounded both in number of entries and in memory. When
+ * inserting an object would exceed either limit, the least recently used
+ * entries are evicted first. The memory of an entry is the actual memory
+ * size of the cached object; since cached objects share their arrays with
+ * the reader output, this is not memory on top of what the output uses while
+ * the entry is in use. Hits, misses and evictions are counted to help tune
+ * the limits.
  *
  * @par Thanks:
  * Thanks to Mickael Philit
@@ -27,16 +34,17 @@
 #define vtkCGNSCache_h
 
 #include "vtkSmartPointer.h"
+#include "vtkType.h"
 
 #include <iterator>
+#include <list>
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 namespace CGNSRead
 {
-// No priority and no size limit right now
-
 template <typename CacheDataType>
 class vtkCGNSCache
 {
@@ -49,19 +57,61 @@ public:
 
   void ClearCache();
 
+  /**
+   * Maximum number of entries, -1 (default) means no limit.
+   */
   void SetCacheSizeLimit(int size);
   int GetCacheSizeLimit();
 
+  /**
+   * Maximum memory used by the cached objects in bytes, 0 (default) means no
+   * limit. Objects bigger than the limit are not cached.
+   */
+  void SetMemoryLimit(vtkTypeUInt64 bytes);
+  vtkTypeUInt64 GetMemoryLimit() const { return this->MemoryLimit; }
+
+  /**
+   * Memory used by the cached objects in bytes.
+   */
+  vtkTypeUInt64 GetMemorySize() const { return this->MemorySize; }
+
+  //@{
+  /**
+   * Statistics since the construction of the cache or the last call to
+   * ResetStatistics().
+   */
+  vtkTypeUInt64 GetNumberOfHits() const { return this->NumberOfHits; }
+  vtkTypeUInt64 GetNumberOfMisses() const { return this->NumberOfMisses; }
+  vtkTypeUInt64 GetNumberOfEvictions() const { return this->NumberOfEvictions; }
+  void ResetStatistics();
+  //@}
+
 private:
   vtkCGNSCache(const vtkCGNSCache&) = delete;
   void operator=(const vtkCGNSCache&) = delete;
 
-  typedef std::unordered_map<std::string, vtkSmartPointer<CacheDataType> > CacheMapper;
+  // Most recently used entries first.
+  typedef std::list<std::pair<std::string, vtkSmartPointer<CacheDataType> > > UsageList;
+  struct CacheEntry
+  {
+    typename UsageList::iterator Position;
+    vtkTypeUInt64 Size;
+  };
+  typedef std::unordered_map<std::string, CacheEntry> CacheMapper;
   CacheMapper CacheData;
+  UsageList Usage;
 
-  typename CacheMapper::iterator LastCacheAccess;
+  void Erase(typename CacheMapper::iterator iter);
+  // Evicts the least recently used entries until `extra` more bytes and one
+  // more entry fit in the cache.
+  void MakeRoom(vtkTypeUInt64 extra);
 
   int cacheSizeLimit;
+  vtkTypeUInt64 MemoryLimit;
+  vtkTypeUInt64 MemorySize;
+  vtkTypeUInt64 NumberOfHits;
+  vtkTypeUInt64 NumberOfMisses;
+  vtkTypeUInt64 NumberOfEvictions;
 };
 
 template <typename CacheDataType>
@@ -69,13 +119,25 @@ vtkCGNSCache<CacheDataType>::vtkCGNSCache()
   : CacheData()
 {
   this->cacheSizeLimit = -1;
-  this->LastCacheAccess = CacheData.end();
+  this->MemoryLimit = 0;
+  this->MemorySize = 0;
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->NumberOfEvictions = 0;
 }
 
 template <typename CacheDataType>
 void vtkCGNSCache<CacheDataType>::SetCacheSizeLimit(int size)
 {
   this->cacheSizeLimit = size;
+  if (this->cacheSizeLimit > 0)
+  {
+    while (this->CacheData.size() > static_cast<size_t>(this->cacheSizeLimit))
+    {
+      this->Erase(this->CacheData.find(this->Usage.back().first));
+      ++this->NumberOfEvictions;
+    }
+  }
 }
 
 template <typename CacheDataType>
@@ -84,36 +146,93 @@ int vtkCGNSCache<CacheDataType>::GetCacheSizeLimit()
   return this->cacheSizeLimit;
 }
 
+template <typename CacheDataType>
+void vtkCGNSCache<CacheDataType>::SetMemoryLimit(vtkTypeUInt64 bytes)
+{
+  this->MemoryLimit = bytes;
+  while (this->MemoryLimit > 0 && this->MemorySize > this->MemoryLimit)
+  {
+    this->Erase(this->CacheData.find(this->Usage.back().first));
+    ++this->NumberOfEvictions;
+  }
+}
+
 template <typename CacheDataType>
 vtkSmartPointer<CacheDataType> vtkCGNSCache<CacheDataType>::Find(const std::string& query)
 {
   typename CacheMapper::iterator iter;
   iter = this->CacheData.find(query);
   if (iter == this->CacheData.end())
+  {
+    ++this->NumberOfMisses;
     return vtkSmartPointer<CacheDataType>(nullptr);
-  this->LastCacheAccess = iter;
-  return iter->second;
+  }
+  ++this->NumberOfHits;
+  this->Usage.splice(this->Usage.begin(), this->Usage, iter->second.Position);
+  return iter->second.Position->second;
 }
 
 template <typename CacheDataType>
 void vtkCGNSCache<CacheDataType>::Insert(
   const std::string& key, const vtkSmartPointer<CacheDataType>& data)
 {
+  typename CacheMapper::iterator iter = this->CacheData.find(key);
+  if (iter != this->CacheData.end())
+  {
+    this->Erase(iter);
+  }
 
-  if (this->cacheSizeLimit > 0 &&
-    this->CacheData.size() >= static_cast<size_t>(this->cacheSizeLimit))
+  // GetActualMemorySize() is in kibibytes.
+  const vtkTypeUInt64 size =
+    data ? static_cast<vtkTypeUInt64>(data->GetActualMemorySize()) * 1024 : 0;
+  if (this->MemoryLimit > 0 && size > this->MemoryLimit)
   {
-    // Make some room by removing last accessed/inserted item
-    this->CacheData.erase(this->LastCacheAccess);
+    return;
   }
-  this->CacheData[key] = data;
-  this->LastCacheAccess = this->CacheData.find(key);
+  this->MakeRoom(size);
+
+  this->Usage.emplace_front(key, data);
+  CacheEntry& entry = this->CacheData[key];
+  entry.Position = this->Usage.begin();
+  entry.Size = size;
+  this->MemorySize += size;
 }
 
 template <typename CacheDataType>
 void vtkCGNSCache<CacheDataType>::ClearCache()
 {
   this->CacheData.clear();
+  this->Usage.clear();
+  this->MemorySize = 0;
+}
+
+template <typename CacheDataType>
+void vtkCGNSCache<CacheDataType>::ResetStatistics()
+{
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->NumberOfEvictions = 0;
+}
+
+template <typename CacheDataType>
+void vtkCGNSCache<CacheDataType>::Erase(typename CacheMapper::iterator iter)
+{
+  this->MemorySize -= iter->second.Size;
+  this->Usage.erase(iter->second.Position);
+  this->CacheData.erase(iter);
+}
+
+template <typename CacheDataType>
+void vtkCGNSCache<CacheDataType>::MakeRoom(vtkTypeUInt64 extra)
+{
+  while (!this->Usage.empty() &&
+    ((this->cacheSizeLimit > 0 &&
+       this->CacheData.size() >= static_cast<size_t>(this->cacheSizeLimit)) ||
+      (this->MemoryLimit > 0 && this->MemorySize + extra > this->MemoryLimit)))
+  {
+    this->Erase(this->CacheData.find(this->Usage.back().first));
+    ++this->NumberOfEvictions;
+  }
 }
 }
 #endif // vtkCGNSCache_h
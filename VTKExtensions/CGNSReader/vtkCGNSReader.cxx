@@ -45,10 +45,13 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVInformationKeys.h"
+#include "vtkPVLogger.h"
 #include "vtkPointData.h"
 #include "vtkPolyhedron.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
+#include "vtkTimerLog.h"
 #include "vtkTypeInt32Array.h"
 #include "vtkTypeInt64Array.h"
 #include "vtkUnsignedIntArray.h"
@@ -56,11 +59,13 @@
 #include "vtkVertex.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdlib>
 #include <functional>
 #include <iterator>
 #include <map>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <stdexcept>
@@ -411,10 +416,11 @@ class vtkCGNSReader::vtkPrivate
 public:
   static bool IsVarEnabled(
     CGNS_ENUMT(GridLocation_t) varcentering, const CGNSRead::char_33 name, vtkCGNSReader* self);
-  static int getGridAndSolutionNames(int base, std::string& gridCoordName,
+  static int getGridAndSolutionNames(int base, double zoneId, std::string& gridCoordName,
     std::vector<std::string>& solutionNames, vtkCGNSReader* reader);
   static int getCoordsIdAndFillRind(const std::string& gridCoordName, const int physicalDim,
-    std::size_t& nCoordsArray, std::vector<double>& gridChildId, int* rind, vtkCGNSReader* self);
+    double zoneId, std::size_t& nCoordsArray, std::vector<double>& gridChildId, int* rind,
+    vtkCGNSReader* self);
   static int getVarsIdAndFillRind(const double cgioSolId, std::size_t& nVarArray,
     CGNS_ENUMT(GridLocation_t) & varCentering, std::vector<double>& solChildId, int* rind,
     vtkCGNSReader* self);
@@ -424,8 +430,9 @@ public:
    * conventions i.e. 0-based point extents specified as (x-min,x-max,
    * y-min,y-max, z-min, z-max).
    */
-  static int readSolution(const std::string& solutionName, const int cellDim, const int physicalDim,
-    const cgsize_t* zsize, vtkDataSet* dataset, const int* voi, vtkCGNSReader* self);
+  static int readSolution(const std::string& solutionName, double zoneId, const int cellDim,
+    const int physicalDim, const cgsize_t* zsize, vtkDataSet* dataset, const int* voi,
+    vtkCGNSReader* self);
 
   static int fillArrayInformation(const std::vector<double>& solChildId, const int physicalDim,
     std::vector<CGNSRead::CGNSVariable>& cgnsVars, std::vector<CGNSRead::CGNSVector>& cgnsVectors,
@@ -475,16 +482,16 @@ public:
   // If voi is non-null, then a sub-extents (x-min, x-max, y-min,  y-max, z-min,
   // z-max) can be specified to only read a subset of the zone. Otherwise, the
   // entire zone is read in.
-  static vtkSmartPointer<vtkDataObject> readCurvilinearZone(int base, int zone, int cellDim,
-    int physicalDim, const cgsize_t* zsize, const int* voi, vtkCGNSReader* self);
+  static vtkSmartPointer<vtkDataObject> readCurvilinearZone(int base, int zone, double zoneId,
+    int cellDim, int physicalDim, const cgsize_t* zsize, const int* voi, vtkCGNSReader* self);
 
   static vtkSmartPointer<vtkDataSet> readBCDataSet(const BCInformation& bcinfo, int base, int zone,
-    int cellDim, int physicalDim, const cgsize_t* zsize, vtkCGNSReader* self)
+    double zoneId, int cellDim, int physicalDim, const cgsize_t* zsize, vtkCGNSReader* self)
   {
     int voi[6];
     bcinfo.GetVOI(voi, cellDim);
     vtkSmartPointer<vtkDataObject> zoneDO =
-      readCurvilinearZone(base, zone, cellDim, physicalDim, zsize, voi, self);
+      readCurvilinearZone(base, zone, zoneId, cellDim, physicalDim, zsize, voi, self);
     return vtkDataSet::SafeDownCast(zoneDO);
   }
 
@@ -492,8 +499,72 @@ public:
     const CGNS_ENUMT(GridLocation_t) locationParam, vtkDataSet* dataset, vtkCGNSReader* self);
 
   static std::string GenerateMeshKey(const char* basename, const char* zonename);
+
+  // Status of the reading of a zone by readZone().
+  enum ZoneStatus
+  {
+    ZONE_READ,
+    // The zone node itself could not be parsed: reading stops, but the
+    // request does not fail.
+    ZONE_INVALID,
+    ZONE_ERROR
+  };
+
+  // Reads the zone `zone` of base `base`, whose node id is `zoneId`, into
+  // `mbase`. When zones are read concurrently, the cgio lock is held while
+  // reading, except while working on data that is already in memory.
+  static ZoneStatus readZone(int base, int zone, double zoneId, int cellDim, int physicalDim,
+    vtkMultiBlockDataSet* mbase, vtkCGNSReader* self);
+
+  // Per thread timings of the zone being read.
+  struct ZoneState
+  {
+    // Time spent in each part of the zone, in seconds.
+    double Coordinates = 0.0;
+    double Connectivity = 0.0;
+    double Solutions = 0.0;
+    double Patches = 0.0;
+
+    // Whether a ScopedZoneTimer is running, so that time is not counted twice
+    // when a part is read while reading another (e.g. the coordinates of a
+    // structured patch).
+    bool Timing = false;
+  };
+  static thread_local ZoneState CurrentZone;
+
+  // Adds the lifetime of the object to `total`, unless another timer is
+  // already running.
+  class ScopedZoneTimer
+  {
+  public:
+    ScopedZoneTimer(double& total)
+      : Total(total)
+      , Start(vtkTimerLog::GetUniversalTime())
+      , Outermost(!CurrentZone.Timing)
+    {
+      CurrentZone.Timing = true;
+    }
+    ~ScopedZoneTimer()
+    {
+      if (this->Outermost)
+      {
+        this->Total += vtkTimerLog::GetUniversalTime() - this->Start;
+        CurrentZone.Timing = false;
+      }
+    }
+
+  private:
+    ScopedZoneTimer(const ScopedZoneTimer&) = delete;
+    void operator=(const ScopedZoneTimer&) = delete;
+
+    double& Total;
+    double Start;
+    bool Outermost;
+  };
 };
 
+thread_local vtkCGNSReader::vtkPrivate::ZoneState vtkCGNSReader::vtkPrivate::CurrentZone;
+
 // Helpers for FlowSolutionxxxPointers
 int EndsWithPointers(const char* s)
 {
@@ -579,6 +650,8 @@ vtkCGNSReader::vtkCGNSReader()
   this->IgnoreSILChangeEvents = false;
   this->CacheMesh = false;
   this->CacheConnectivity = false;
+  this->CacheMemoryLimit = 0;
+  this->ReadZonesConcurrently = false;
 
   // Setup the selection callback to modify this object when an array
   // selection is changed.
@@ -675,8 +748,8 @@ bool vtkCGNSReader::vtkPrivate::IsVarEnabled(
 }
 
 //------------------------------------------------------------------------------
-int vtkCGNSReader::vtkPrivate::getGridAndSolutionNames(int base, std::string& gridCoordName,
-  std::vector<std::string>& solutionNames, vtkCGNSReader* self)
+int vtkCGNSReader::vtkPrivate::getGridAndSolutionNames(int base, double zoneId,
+  std::string& gridCoordName, std::vector<std::string>& solutionNames, vtkCGNSReader* self)
 {
   // We encounter various ways in which solution grids are specified (standard
   // and non-standard). This code will try to handle all of them.
@@ -688,7 +761,7 @@ int vtkCGNSReader::vtkPrivate::getGridAndSolutionNames(int base, std::string& gr
   // Check if we have ZoneIterativeData_t/GridCoordinatesPointers present. If
   // so, use those to read grid coordinates for current timestep.
   double ziterId = 0;
-  bool hasZoneIterativeData = (CGNSRead::getFirstNodeId(self->cgioNum, self->currentId,
+  bool hasZoneIterativeData = (CGNSRead::getFirstNodeId(self->cgioNum, zoneId,
                                  "ZoneIterativeData_t", &ziterId) == CG_OK);
 
   if (hasZoneIterativeData && baseInfo.useGridPointers)
@@ -719,7 +792,7 @@ int vtkCGNSReader::vtkPrivate::getGridAndSolutionNames(int base, std::string& gr
     // GridCoordinatesPointers, locate the first element of type
     // `GridCoordinates_t`. That's the coordinates array.
     double giterId;
-    if (CGNSRead::getFirstNodeId(self->cgioNum, self->currentId, "GridCoordinates_t", &giterId) ==
+    if (CGNSRead::getFirstNodeId(self->cgioNum, zoneId, "GridCoordinates_t", &giterId) ==
       CG_OK)
     {
       CGNSRead::char_33 nodeName;
@@ -779,7 +852,7 @@ int vtkCGNSReader::vtkPrivate::getGridAndSolutionNames(int base, std::string& gr
     {
       double solId = 0.0;
       if (cgio_get_node_id(
-            self->cgioNum, self->currentId, unvalidatedSolutionNames[cc].c_str(), &solId) == CG_OK)
+            self->cgioNum, zoneId, unvalidatedSolutionNames[cc].c_str(), &solId) == CG_OK)
       {
         solutionNames.push_back(unvalidatedSolutionNames[cc]);
       }
@@ -815,7 +888,7 @@ int vtkCGNSReader::vtkPrivate::getGridAndSolutionNames(int base, std::string& gr
   }
 
   std::vector<double> childId;
-  CGNSRead::getNodeChildrenId(self->cgioNum, self->currentId, childId);
+  CGNSRead::getNodeChildrenId(self->cgioNum, zoneId, childId);
   // Case where FlowSolutionPointers where not enough but there is a pattern in nodeName.
   if (useUnsteadyPattern)
   {
@@ -939,8 +1012,8 @@ int vtkCGNSReader::vtkPrivate::getGridAndSolutionNames(int base, std::string& gr
 
 //------------------------------------------------------------------------------
 int vtkCGNSReader::vtkPrivate::getCoordsIdAndFillRind(const std::string& gridCoordNameStr,
-  const int physicalDim, std::size_t& nCoordsArray, std::vector<double>& gridChildId, int* rind,
-  vtkCGNSReader* self)
+  const int physicalDim, double zoneId, std::size_t& nCoordsArray, std::vector<double>& gridChildId,
+  int* rind, vtkCGNSReader* self)
 {
   CGNSRead::char_33 GridCoordName;
   strncpy(GridCoordName, gridCoordNameStr.c_str(), 32);
@@ -952,7 +1025,7 @@ int vtkCGNSReader::vtkPrivate::getCoordsIdAndFillRind(const std::string& gridCoo
   nCoordsArray = 0;
   // Get GridCoordinate node ID for low level access
   double gridId;
-  if (cgio_get_node_id(self->cgioNum, self->currentId, GridCoordName, &gridId) != CG_OK)
+  if (cgio_get_node_id(self->cgioNum, zoneId, GridCoordName, &gridId) != CG_OK)
   {
     char message[81];
     cgio_error_message(message);
@@ -1078,21 +1151,22 @@ int vtkCGNSReader::vtkPrivate::getVarsIdAndFillRind(const double cgioSolId, std:
 }
 
 //------------------------------------------------------------------------------
-int vtkCGNSReader::vtkPrivate::readSolution(const std::string& solutionNameStr, const int cellDim,
-  const int physicalDim, const cgsize_t* zsize, vtkDataSet* dataset, const int* voi,
-  vtkCGNSReader* self)
+int vtkCGNSReader::vtkPrivate::readSolution(const std::string& solutionNameStr, double zoneId,
+  const int cellDim, const int physicalDim, const cgsize_t* zsize, vtkDataSet* dataset,
+  const int* voi, vtkCGNSReader* self)
 {
   if (solutionNameStr.empty())
   {
     return CG_OK; // should this be error?
   }
 
+  vtkPrivate::ScopedZoneTimer timer(vtkPrivate::CurrentZone.Solutions);
   CGNSRead::char_33 solutionName;
   strncpy(solutionName, solutionNameStr.c_str(), 32);
   solutionName[32] = '\0';
 
   double cgioSolId = 0.0;
-  if (cgio_get_node_id(self->cgioNum, self->currentId, solutionName, &cgioSolId) != CG_OK)
+  if (cgio_get_node_id(self->cgioNum, zoneId, solutionName, &cgioSolId) != CG_OK)
   {
     char errmsg[CGIO_MAX_ERROR_LENGTH + 1];
     cgio_error_message(errmsg);
@@ -1211,10 +1285,13 @@ int vtkCGNSReader::vtkPrivate::readSolution(const std::string& solutionNameStr,
 
   //
   std::vector<vtkDataArray*> vtkVars(nVarArray);
-  // Count number of vars and vectors
-  // Assign vars and vectors to a vtkvars array
-  vtkPrivate::AllocateVtkArray(
-    physicalDim, nVals, varCentering, cgnsVars, cgnsVectors, vtkVars, self);
+  {
+    CGNSRead::ScopedCGIOUnlock unlock;
+    // Count number of vars and vectors
+    // Assign vars and vectors to a vtkvars array
+    vtkPrivate::AllocateVtkArray(
+      physicalDim, nVals, varCentering, cgnsVars, cgnsVectors, vtkVars, self);
+  }
 
   // Load Data
   for (std::size_t ff = 0; ff < nVarArray; ++ff)
@@ -1255,6 +1332,9 @@ int vtkCGNSReader::vtkPrivate::readSolution(const std::string& solutionNameStr,
   }
   cgio_release_id(self->cgioNum, cgioSolId);
 
+  // The arrays are filled, other zones can be read meanwhile.
+  CGNSRead::ScopedCGIOUnlock unlock;
+
   // Append data to dataset
   vtkDataSetAttributes* dsa = 0;
   if (varCentering == CGNS_ENUMV(Vertex)) // ON_NODES
@@ -1762,7 +1842,8 @@ int vtkCGNSReader::vtkPrivate::AttachReferenceValue(
 
 //------------------------------------------------------------------------------
 vtkSmartPointer<vtkDataObject> vtkCGNSReader::vtkPrivate::readCurvilinearZone(int base, int zone,
-  int cellDim, int physicalDim, const cgsize_t* zsize, const int* voi, vtkCGNSReader* self)
+  double zoneId, int cellDim, int physicalDim, const cgsize_t* zsize, const int* voi,
+  vtkCGNSReader* self)
 {
   int rind[6];
   int n;
@@ -1790,7 +1871,7 @@ vtkSmartPointer<vtkDataObject> vtkCGNSReader::vtkPrivate::readCurvilinearZone(in
   std::size_t nCoordsArray = 0;
   vtkSmartPointer<vtkPoints> points;
 
-  vtkPrivate::getGridAndSolutionNames(base, gridCoordName, solutionNames, self);
+  vtkPrivate::getGridAndSolutionNames(base, zoneId, gridCoordName, solutionNames, self);
   if (gridCoordName == "Null")
   {
     return vtkSmartPointer<vtkDataObject>();
@@ -1825,8 +1906,9 @@ vtkSmartPointer<vtkDataObject> vtkCGNSReader::vtkPrivate::readCurvilinearZone(in
   // Reading points in file since cache was not hit
   if (points.Get() == nullptr)
   {
+    vtkPrivate::ScopedZoneTimer timer(vtkPrivate::CurrentZone.Coordinates);
     vtkPrivate::getCoordsIdAndFillRind(
-      gridCoordName, physicalDim, nCoordsArray, gridChildId, rind, self);
+      gridCoordName, physicalDim, zoneId, nCoordsArray, gridChildId, rind, self);
 
     // Rind was parsed (or not) then populate dimensions :
     // Compute structured grid coordinate range
@@ -1883,18 +1965,21 @@ vtkSmartPointer<vtkDataObject> vtkCGNSReader::vtkPrivate::readCurvilinearZone(in
     memEnd[0] *= 3;
 
     // Set up points
-    points = vtkSmartPointer<vtkPoints>::New();
-    //
-    // vtkPoints assumes float data type
-    //
-    if (self->GetDoublePrecisionMesh() != 0)
     {
-      points->SetDataTypeToDouble();
+      CGNSRead::ScopedCGIOUnlock unlock;
+      points = vtkSmartPointer<vtkPoints>::New();
+      //
+      // vtkPoints assumes float data type
+      //
+      if (self->GetDoublePrecisionMesh() != 0)
+      {
+        points->SetDataTypeToDouble();
+      }
+      //
+      // Resize vtkPoints to fit data
+      //
+      points->SetNumberOfPoints(nPts);
     }
-    //
-    // Resize vtkPoints to fit data
-    //
-    points->SetNumberOfPoints(nPts);
 
     //
     // Populate the coordinates.  Put in 3D points with z=0 if the mesh is 2D.
@@ -1932,8 +2017,8 @@ vtkSmartPointer<vtkDataObject> vtkCGNSReader::vtkPrivate::readCurvilinearZone(in
       vtkNew<vtkStructuredGrid> sgrid;
       sgrid->SetExtent(extent);
       sgrid->SetPoints(points.Get());
-      if (vtkPrivate::readSolution(*sniter, cellDim, physicalDim, zsize, sgrid.Get(), voi, self) ==
-        CG_OK)
+      if (vtkPrivate::readSolution(
+            *sniter, zoneId, cellDim, physicalDim, zsize, sgrid.Get(), voi, self) == CG_OK)
       {
         vtkPrivate::AttachReferenceValue(base, sgrid.Get(), self);
         mzone->SetBlock(cc, sgrid.Get());
@@ -1953,7 +2038,7 @@ vtkSmartPointer<vtkDataObject> vtkCGNSReader::vtkPrivate::readCurvilinearZone(in
   for (std::vector<std::string>::const_iterator sniter = solutionNames.begin();
        sniter != solutionNames.end(); ++sniter)
   {
-    vtkPrivate::readSolution(*sniter, cellDim, physicalDim, zsize, sgrid.Get(), voi, self);
+    vtkPrivate::readSolution(*sniter, zoneId, cellDim, physicalDim, zsize, sgrid.Get(), voi, self);
   }
 
   vtkPrivate::AttachReferenceValue(base, sgrid.Get(), self);
@@ -1961,8 +2046,8 @@ vtkSmartPointer<vtkDataObject> vtkCGNSReader::vtkPrivate::readCurvilinearZone(in
 }
 
 //------------------------------------------------------------------------------
-int vtkCGNSReader::GetCurvilinearZone(
-  int base, int zone, int cellDim, int physicalDim, void* v_zsize, vtkMultiBlockDataSet* mbase)
+int vtkCGNSReader::GetCurvilinearZone(int base, int zone, double zoneId, int cellDim,
+  int physicalDim, void* v_zsize, vtkMultiBlockDataSet* mbase)
 {
   cgsize_t* zsize = reinterpret_cast<cgsize_t*>(v_zsize);
 
@@ -1971,7 +2056,8 @@ int vtkCGNSReader::GetCurvilinearZone(
   const char* zonename = this->Internal->GetBase(base).zones[zone].name;
 
   vtkSmartPointer<vtkDataObject> zoneDO = sil->ReadGridForZone(basename, zonename)
-    ? vtkPrivate::readCurvilinearZone(base, zone, cellDim, physicalDim, zsize, nullptr, this)
+    ? vtkPrivate::readCurvilinearZone(
+        base, zone, zoneId, cellDim, physicalDim, zsize, nullptr, this)
     : vtkSmartPointer<vtkDataObject>();
   mbase->SetBlock(zone, zoneDO.Get());
 
@@ -1980,6 +2066,7 @@ int vtkCGNSReader::GetCurvilinearZone(
   //----------------------------------------------------------------------------
   if (!this->CreateEachSolutionAsBlock && sil->ReadPatchesForBase(basename))
   {
+    vtkPrivate::ScopedZoneTimer timer(vtkPrivate::CurrentZone.Patches);
     vtkNew<vtkMultiBlockDataSet> newZoneMB;
 
     vtkSmartPointer<vtkStructuredGrid> zoneGrid = vtkStructuredGrid::SafeDownCast(zoneDO);
@@ -1992,7 +2079,7 @@ int vtkCGNSReader::GetCurvilinearZone(
     newZoneMB->GetMetaData(1)->Set(vtkCompositeDataSet::NAME(), "Patches");
 
     std::vector<double> zoneChildren;
-    CGNSRead::getNodeChildrenId(this->cgioNum, this->currentId, zoneChildren);
+    CGNSRead::getNodeChildrenId(this->cgioNum, zoneId, zoneChildren);
     for (auto iter = zoneChildren.begin(); iter != zoneChildren.end(); ++iter)
     {
       CGNSRead::char_33 nodeLabel;
@@ -2021,7 +2108,8 @@ int vtkCGNSReader::GetCurvilinearZone(
               const unsigned int idx = patchesMB->GetNumberOfBlocks();
               vtkSmartPointer<vtkDataSet> ds = zoneGrid
                 ? binfo.CreateDataSet(cellDim, zoneGrid)
-                : vtkPrivate::readBCDataSet(binfo, base, zone, cellDim, physicalDim, zsize, this);
+                : vtkPrivate::readBCDataSet(
+                    binfo, base, zone, zoneId, cellDim, physicalDim, zsize, this);
               vtkPrivate::AddIsPatchArray(ds, true);
               vtkCGNSReader::vtkPrivate::readBCData(
                 *bciter, cellDim, physicalDim, binfo.Location, ds.Get(), this);
@@ -2059,8 +2147,8 @@ int vtkCGNSReader::GetCurvilinearZone(
 }
 
 //------------------------------------------------------------------------------
-int vtkCGNSReader::GetUnstructuredZone(
-  int base, int zone, int cellDim, int physicalDim, void* v_zsize, vtkMultiBlockDataSet* mbase)
+int vtkCGNSReader::GetUnstructuredZone(int base, int zone, double zoneId, int cellDim,
+  int physicalDim, void* v_zsize, vtkMultiBlockDataSet* mbase)
 {
   cgsize_t* zsize = reinterpret_cast<cgsize_t*>(v_zsize);
 
@@ -2106,7 +2194,7 @@ int vtkCGNSReader::GetUnstructuredZone(
   std::vector<double> gridChildId;
   std::size_t nCoordsArray = 0;
 
-  vtkPrivate::getGridAndSolutionNames(base, gridCoordName, solutionNames, this);
+  vtkPrivate::getGridAndSolutionNames(base, zoneId, gridCoordName, solutionNames, this);
   if (gridCoordName == "Null")
   {
     mbase->SetBlock(zone, vtkSmartPointer<vtkDataObject>());
@@ -2114,7 +2202,7 @@ int vtkCGNSReader::GetUnstructuredZone(
   }
 
   vtkPrivate::getCoordsIdAndFillRind(
-    gridCoordName, physicalDim, nCoordsArray, gridChildId, rind, this);
+    gridCoordName, physicalDim, zoneId, nCoordsArray, gridChildId, rind, this);
 
   // Rind was parsed or not then populate dimensions :
   // get grid coordinate range
@@ -2161,23 +2249,27 @@ int vtkCGNSReader::GetUnstructuredZone(
   // Reading points from file instead of cache
   if (points.Get() == nullptr)
   {
-    // Set up points
-    points = vtkSmartPointer<vtkPoints>::New();
-
+    vtkPrivate::ScopedZoneTimer timer(vtkPrivate::CurrentZone.Coordinates);
     //
     // wacky hack ...
     memEnd[0] *= 3; // for memory aliasing
-    //
-    // vtkPoints assumes float data type
-    //
-    if (this->DoublePrecisionMesh != 0)
+
+    // Set up points
     {
-      points->SetDataTypeToDouble();
+      CGNSRead::ScopedCGIOUnlock unlock;
+      points = vtkSmartPointer<vtkPoints>::New();
+      //
+      // vtkPoints assumes float data type
+      //
+      if (this->DoublePrecisionMesh != 0)
+      {
+        points->SetDataTypeToDouble();
+      }
+      //
+      // Resize vtkPoints to fit data
+      //
+      points->SetNumberOfPoints(nPts);
     }
-    //
-    // Resize vtkPoints to fit data
-    //
-    points->SetNumberOfPoints(nPts);
 
     //
     // Populate the coordinates. Put in 3D points with z=0 if the mesh is 2D.
@@ -2199,13 +2291,17 @@ int vtkCGNSReader::GetUnstructuredZone(
     }
   }
 
-  this->UpdateProgress(0.2);
+  if (!CGNSRead::GetCGIOLockState().Lock)
+  {
+    // Progress is only reported from the main thread.
+    this->UpdateProgress(0.2);
+  }
   // points are now loaded
   //----------------------
   // Read List of zone children ids
   // and Get connectivities and solutions
   std::vector<double> zoneChildId;
-  CGNSRead::getNodeChildrenId(this->cgioNum, this->currentId, zoneChildId);
+  CGNSRead::getNodeChildrenId(this->cgioNum, zoneId, zoneChildId);
   //
   std::vector<double> elemIdList;
 
@@ -2445,6 +2541,7 @@ int vtkCGNSReader::GetUnstructuredZone(
   }
   if (ugrid.Get() == nullptr)
   {
+    vtkPrivate::ScopedZoneTimer timer(vtkPrivate::CurrentZone.Connectivity);
     ugrid = vtkSmartPointer<vtkUnstructuredGrid>::New();
     ugrid->SetPoints(points.Get());
     //
@@ -2483,9 +2580,12 @@ int vtkCGNSReader::GetUnstructuredZone(
       std::vector<vtkIdType> faceElementsArr;
       bool old_polygonal_layout = false;
 
-      faceElementsArr.resize(faceElementsSize);
-      faceElementsIdx.resize(numFaces + 1);
-      faceElementsIdx[0] = 0;
+      {
+        CGNSRead::ScopedCGIOUnlock unlock;
+        faceElementsArr.resize(faceElementsSize);
+        faceElementsIdx.resize(numFaces + 1);
+        faceElementsIdx[0] = 0;
+      }
       // Now load the faces that are in NGON_n format.
       for (std::size_t sec = 0; sec < ngonSec.size(); sec++)
       {
@@ -2523,6 +2623,7 @@ int vtkCGNSReader::GetUnstructuredZone(
 
         if (startArraySec[sec] != 0)
         {
+          CGNSRead::ScopedCGIOUnlock unlock;
           // Add offset since it is not the first section
           for (vtkIdType idx = 0; idx < offsetDataSize; idx++)
           {
@@ -2554,6 +2655,7 @@ int vtkCGNSReader::GetUnstructuredZone(
       //
       if (old_polygonal_layout)
       {
+        CGNSRead::ScopedCGIOUnlock unlock;
         // Regenerate a faceElementIdx lookupTable
         vtkIdType curFace = 0;
         vtkIdType curNodeInFace = 0;
@@ -2606,8 +2708,11 @@ int vtkCGNSReader::GetUnstructuredZone(
       //
       std::vector<vtkIdType> cellElementsArr;
       std::vector<vtkIdType> cellElementsIdx;
-      cellElementsArr.resize(cellElementsSize);
-      cellElementsIdx.resize(numCells + 1);
+      {
+        CGNSRead::ScopedCGIOUnlock unlock;
+        cellElementsArr.resize(cellElementsSize);
+        cellElementsIdx.resize(numCells + 1);
+      }
 
       if (hasNFace && numCells < zsize[1])
       {
@@ -2651,6 +2756,7 @@ int vtkCGNSReader::GetUnstructuredZone(
         }
         if (startNFaceArraySec[sec] != 0)
         {
+          CGNSRead::ScopedCGIOUnlock unlock;
           // Add offset since it is not the first section
           for (vtkIdType idx = 0; idx < offsetDataSize; idx++)
           {
@@ -2687,103 +2793,107 @@ int vtkCGNSReader::GetUnstructuredZone(
       // need to be taken out of the description.
       // Basic CGNS 3.4 support
 
-      if (old_polygonal_layout)
+      // Everything is in memory now, other zones can be read meanwhile.
       {
-        // Regenerate cellElementIdx lookupTable
-        vtkIdType curCell = 0;
-        vtkIdType curFaceInCell = 0;
-
-        cellElementsIdx[0] = 0;
-
-        for (vtkIdType idxCell = 0; idxCell < static_cast<vtkIdType>(cellElementsIdx.size() - 1);
-             ++idxCell)
+        CGNSRead::ScopedCGIOUnlock unlock;
+        if (old_polygonal_layout)
         {
-          vtkIdType nFaceInCell = cellElementsArr[curCell];
+          // Regenerate cellElementIdx lookupTable
+          vtkIdType curCell = 0;
+          vtkIdType curFaceInCell = 0;
 
-          cellElementsIdx[idxCell + 1] = cellElementsIdx[idxCell] + nFaceInCell;
+          cellElementsIdx[0] = 0;
 
-          for (vtkIdType idxFace = 0; idxFace < nFaceInCell; idxFace++)
+          for (vtkIdType idxCell = 0; idxCell < static_cast<vtkIdType>(cellElementsIdx.size() - 1);
+               ++idxCell)
           {
-            cellElementsArr[curFaceInCell] = cellElementsArr[curCell + idxFace + 1];
-            curFaceInCell++;
+            vtkIdType nFaceInCell = cellElementsArr[curCell];
+
+            cellElementsIdx[idxCell + 1] = cellElementsIdx[idxCell] + nFaceInCell;
+
+            for (vtkIdType idxFace = 0; idxFace < nFaceInCell; idxFace++)
+            {
+              cellElementsArr[curFaceInCell] = cellElementsArr[curCell + idxFace + 1];
+              curFaceInCell++;
+            }
+            curCell += nFaceInCell + 1;
           }
-          curCell += nFaceInCell + 1;
         }
-      }
 
-      for (vtkIdType nc = 0; nc < numCells; nc++)
-      {
-        int numCellFaces = cellElementsIdx[nc + 1] - cellElementsIdx[nc];
-        vtkNew<vtkIdList> faces;
-        faces->InsertNextId(numCellFaces);
-        for (vtkIdType nf = 0; nf < numCellFaces; ++nf)
+        for (vtkIdType nc = 0; nc < numCells; nc++)
         {
-          vtkIdType faceId = cellElementsArr[cellElementsIdx[nc] + nf];
-          bool mustReverse = faceId > 0;
-          faceId = std::abs(faceId);
-
-          // the following is needed because when the NGON_n face data do not precedes the
-          // NFACE_n cell data, the indices are continuous, so a "global-to-local" mapping must be
-          // done.
-          for (std::size_t sec = 0; sec < ngonSec.size(); sec++)
+          int numCellFaces = cellElementsIdx[nc + 1] - cellElementsIdx[nc];
+          vtkNew<vtkIdList> faces;
+          faces->InsertNextId(numCellFaces);
+          for (vtkIdType nf = 0; nf < numCellFaces; ++nf)
           {
-            int curSec = ngonSec[sec];
-            //
-            if (faceId <= sectionInfoList[curSec].range[1] &&
-              faceId >= sectionInfoList[curSec].range[0])
+            vtkIdType faceId = cellElementsArr[cellElementsIdx[nc] + nf];
+            bool mustReverse = faceId > 0;
+            faceId = std::abs(faceId);
+
+            // the following is needed because when the NGON_n face data do not precedes the
+            // NFACE_n cell data, the indices are continuous, so a "global-to-local" mapping must be
+            // done.
+            for (std::size_t sec = 0; sec < ngonSec.size(); sec++)
             {
-              faceId = faceId - sectionInfoList[curSec].range[0] + 1 + startRangeSec[sec];
-              break;
+              int curSec = ngonSec[sec];
+              //
+              if (faceId <= sectionInfoList[curSec].range[1] &&
+                faceId >= sectionInfoList[curSec].range[0])
+              {
+                faceId = faceId - sectionInfoList[curSec].range[0] + 1 + startRangeSec[sec];
+                break;
+              }
             }
-          }
-          faceId -= 1; // CGNS uses FORTRAN ID style, starting at 1
-
-          vtkIdType startNode = faceElementsIdx[faceId];
-          vtkIdType endNode = faceElementsIdx[faceId + 1];
-          vtkIdType numNodes = endNode - startNode;
-          faces->InsertNextId(numNodes);
-          /* Each face is composed of multiple vertex */
-          if (mustReverse)
-          {
-            for (vtkIdType nn = numNodes - 1; nn >= 0; --nn)
+            faceId -= 1; // CGNS uses FORTRAN ID style, starting at 1
+
+            vtkIdType startNode = faceElementsIdx[faceId];
+            vtkIdType endNode = faceElementsIdx[faceId + 1];
+            vtkIdType numNodes = endNode - startNode;
+            faces->InsertNextId(numNodes);
+            /* Each face is composed of multiple vertex */
+            if (mustReverse)
             {
-              vtkIdType nodeID =
-                faceElementsArr[startNode + nn] - 1; // AGAIN subtract 1 from node ID
+              for (vtkIdType nn = numNodes - 1; nn >= 0; --nn)
+              {
+                vtkIdType nodeID =
+                  faceElementsArr[startNode + nn] - 1; // AGAIN subtract 1 from node ID
 
-              faces->InsertNextId(nodeID);
+                faces->InsertNextId(nodeID);
+              }
             }
-          }
-          else
-          {
-            for (vtkIdType nn = 0; nn < numNodes; ++nn)
+            else
             {
-              vtkIdType nodeID =
-                faceElementsArr[startNode + nn] - 1; // AGAIN subtract 1 from node ID
-              faces->InsertNextId(nodeID);
+              for (vtkIdType nn = 0; nn < numNodes; ++nn)
+              {
+                vtkIdType nodeID =
+                  faceElementsArr[startNode + nn] - 1; // AGAIN subtract 1 from node ID
+                faces->InsertNextId(nodeID);
+              }
             }
           }
+          ugrid->InsertNextCell(VTK_POLYHEDRON, faces.GetPointer());
         }
-        ugrid->InsertNextCell(VTK_POLYHEDRON, faces.GetPointer());
-      }
 
-      // If NGon_n but no NFace_n load POLYGONS
-      if (!hasNFace)
-      {
-
-        for (vtkIdType nf = 0; nf < numFaces; ++nf)
+        // If NGon_n but no NFace_n load POLYGONS
+        if (!hasNFace)
         {
 
-          vtkIdType startNode = faceElementsIdx[nf];
-          vtkIdType endNode = faceElementsIdx[nf + 1];
-          vtkIdType numNodes = endNode - startNode;
-          vtkNew<vtkIdList> nodes;
-          // nodes->InsertNextId(numNodes);
-          for (vtkIdType nn = 0; nn < numNodes; ++nn)
+          for (vtkIdType nf = 0; nf < numFaces; ++nf)
           {
-            vtkIdType nodeID = faceElementsArr[startNode + nn] - 1;
-            nodes->InsertNextId(nodeID);
+
+            vtkIdType startNode = faceElementsIdx[nf];
+            vtkIdType endNode = faceElementsIdx[nf + 1];
+            vtkIdType numNodes = endNode - startNode;
+            vtkNew<vtkIdList> nodes;
+            // nodes->InsertNextId(numNodes);
+            for (vtkIdType nn = 0; nn < numNodes; ++nn)
+            {
+              vtkIdType nodeID = faceElementsArr[startNode + nn] - 1;
+              nodes->InsertNextId(nodeID);
+            }
+            ugrid->InsertNextCell(VTK_POLYGON, nodes.GetPointer());
           }
-          ugrid->InsertNextCell(VTK_POLYGON, nodes.GetPointer());
         }
       }
     }
@@ -2810,16 +2920,22 @@ int vtkCGNSReader::GetUnstructuredZone(
       vtkNew<vtkCellArray> cells;
       // Modification for memory reliability
       vtkNew<vtkIdTypeArray> cellLocations;
-      cellLocations->SetNumberOfValues(elementCoreSize);
-      vtkIdType* elements = cellLocations->GetPointer(0);
+      vtkIdType* elements = nullptr;
+      int* cellsTypes = nullptr;
+      {
+        CGNSRead::ScopedCGIOUnlock unlock;
+        cellLocations->SetNumberOfValues(elementCoreSize);
+        elements = cellLocations->GetPointer(0);
+        cellsTypes = new int[numCoreCells];
+      }
 
       if (elements == 0)
       {
         vtkErrorMacro(<< "Could not allocate memory for connectivity\n");
+        delete[] cellsTypes;
         return 1;
       }
 
-      int* cellsTypes = new int[numCoreCells];
       if (cellsTypes == 0)
       {
         vtkErrorMacro(<< "Could not allocate memory for connectivity\n");
@@ -2897,11 +3013,15 @@ int vtkCGNSReader::GetUnstructuredZone(
           memDim[0] = npe + 1;
           memDim[1] = EltsEnd - start + 1;
 
-          memset(localElements, 1, sizeof(vtkIdType) * (npe + 1) * (EltsEnd - start + 1));
+          {
+            CGNSRead::ScopedCGIOUnlock unlock;
+            memset(localElements, 1, sizeof(vtkIdType) * (npe + 1) * (EltsEnd - start + 1));
+          }
 
           CGNSRead::get_section_connectivity(this->cgioNum, cgioSectionId, 2, srcStart, srcEnd,
             srcStride, memStart, memEnd, memStride, memDim, localElements);
 
+          CGNSRead::ScopedCGIOUnlock unlock;
           // Add numptspercell and do -1 on indexes
           for (vtkIdType icell = 0; icell < elementSize; ++icell)
           {
@@ -2949,6 +3069,7 @@ int vtkCGNSReader::GetUnstructuredZone(
           CGNSRead::get_section_connectivity(this->cgioNum, cgioSectionId, 1, srcStart, srcEnd,
             srcStride, memStart, memEnd, memStride, memDim, localElements);
 
+          CGNSRead::ScopedCGIOUnlock unlock;
           vtkIdType pos = 0;
           reOrderElements = false;
           for (vtkIdType icell = 0, i = start - 1; icell < elementSize; ++icell, ++i)
@@ -2982,9 +3103,12 @@ int vtkCGNSReader::GetUnstructuredZone(
         cgio_release_id(this->cgioNum, cgioSectionId);
       }
 
-      cells->SetCells(numCoreCells, cellLocations.GetPointer());
+      {
+        CGNSRead::ScopedCGIOUnlock unlock;
+        cells->SetCells(numCoreCells, cellLocations.GetPointer());
 
-      ugrid->SetCells(cellsTypes, cells.GetPointer());
+        ugrid->SetCells(cellsTypes, cells.GetPointer());
+      }
 
       delete[] cellsTypes;
     }
@@ -3021,7 +3145,7 @@ int vtkCGNSReader::GetUnstructuredZone(
     // able to share the code between Curlinear and Unstructured grids for reading
     // solutions.
     vtkPrivate::readSolution(
-      *sniter, /*cellDim=*/1, physicalDim, zsize, ugrid.Get(), /*voi=*/nullptr, this);
+      *sniter, zoneId, /*cellDim=*/1, physicalDim, zsize, ugrid.Get(), /*voi=*/nullptr, this);
   }
 
   // Handle Reference Values (Mach Number, ...)
@@ -3035,6 +3159,7 @@ int vtkCGNSReader::GetUnstructuredZone(
 
   if (hasNFace && requiredPatch)
   {
+    vtkPrivate::ScopedZoneTimer timer(vtkPrivate::CurrentZone.Patches);
     //----------------------------------------------------------------------------
     // Handle boundary conditions (BC) patches for polyhedral grid
     //----------------------------------------------------------------------------
@@ -3047,7 +3172,7 @@ int vtkCGNSReader::GetUnstructuredZone(
     // multi patch build
     //
     std::vector<double> zoneChildren;
-    CGNSRead::getNodeChildrenId(this->cgioNum, this->currentId, zoneChildren);
+    CGNSRead::getNodeChildrenId(this->cgioNum, zoneId, zoneChildren);
     for (auto iter = zoneChildren.begin(); iter != zoneChildren.end(); ++iter)
     {
       CGNSRead::char_33 nodeLabel;
@@ -3409,6 +3534,7 @@ int vtkCGNSReader::GetUnstructuredZone(
   }
   else if (bndSec.size() > 0 && requiredPatch)
   {
+    vtkPrivate::ScopedZoneTimer timer(vtkPrivate::CurrentZone.Patches);
     //----------------------------------------------------------------------------
     // Handle boundary conditions (BC) patches for unstructured grid
     //----------------------------------------------------------------------------
@@ -3422,7 +3548,7 @@ int vtkCGNSReader::GetUnstructuredZone(
     // Build Multi Patches
     //
     std::vector<double> zoneChildren;
-    CGNSRead::getNodeChildrenId(this->cgioNum, this->currentId, zoneChildren);
+    CGNSRead::getNodeChildrenId(this->cgioNum, zoneId, zoneChildren);
     for (auto iter = zoneChildren.begin(); iter != zoneChildren.end(); ++iter)
     {
       CGNSRead::char_33 nodeLabel;
@@ -4179,6 +4305,138 @@ public:
   }
 };
 
+//----------------------------------------------------------------------------
+vtkCGNSReader::vtkPrivate::ZoneStatus vtkCGNSReader::vtkPrivate::readZone(int base, int zone,
+  double zoneId, int cellDim, int physicalDim, vtkMultiBlockDataSet* mbase, vtkCGNSReader* self)
+{
+  ZoneState& state = CurrentZone;
+  state.Coordinates = state.Connectivity = state.Solutions = state.Patches = 0.0;
+  CGNSRead::CGIOLockState& lockState = CGNSRead::GetCGIOLockState();
+  lockState.Waiting = 0.0;
+  CGNSRead::ScopedCGIOLock lock;
+
+  CGNSRead::char_33 zoneName;
+  cgsize_t zsize[9];
+  CGNS_ENUMT(ZoneType_t) zt = CGNS_ENUMV(ZoneTypeNull);
+  memset(zoneName, 0, 33);
+  memset(zsize, 0, 9 * sizeof(cgsize_t));
+
+  if (cgio_get_name(self->cgioNum, zoneId, zoneName) != CG_OK)
+  {
+    char errmsg[CGIO_MAX_ERROR_LENGTH + 1];
+    cgio_error_message(errmsg);
+    vtkErrorWithObjectMacro(
+      self, << "Problem while reading name of zone number " << zone << ", error : " << errmsg);
+    return ZONE_INVALID;
+  }
+
+  CGNSRead::char_33 dataType;
+  if (cgio_get_data_type(self->cgioNum, zoneId, dataType) != CG_OK)
+  {
+    char errmsg[CGIO_MAX_ERROR_LENGTH + 1];
+    cgio_error_message(errmsg);
+    vtkErrorWithObjectMacro(
+      self, << "Problem while reading data_type of zone number " << zone << " " << errmsg);
+    return ZONE_INVALID;
+  }
+
+  if (strcmp(dataType, "I4") == 0)
+  {
+    std::vector<vtkTypeInt32> mdata;
+    CGNSRead::readNodeData<vtkTypeInt32>(self->cgioNum, zoneId, mdata);
+    for (std::size_t index = 0; index < mdata.size(); index++)
+    {
+      zsize[index] = static_cast<cgsize_t>(mdata[index]);
+    }
+  }
+  else if (strcmp(dataType, "I8") == 0)
+  {
+    std::vector<vtkTypeInt64> mdata;
+    CGNSRead::readNodeData<vtkTypeInt64>(self->cgioNum, zoneId, mdata);
+    for (std::size_t index = 0; index < mdata.size(); index++)
+    {
+      zsize[index] = static_cast<cgsize_t>(mdata[index]);
+    }
+  }
+  else
+  {
+    vtkErrorWithObjectMacro(self, << "Problem while reading dimension in zone number " << zone);
+    return ZONE_INVALID;
+  }
+
+  vtkVLogScopeF(PARAVIEW_LOG_EXECUTION_VERBOSITY(), "read zone '%s'", zoneName);
+  mbase->GetMetaData(zone)->Set(vtkCompositeDataSet::NAME(), zoneName);
+
+  std::string familyName;
+  double famId;
+  if (CGNSRead::getFirstNodeId(self->cgioNum, zoneId, "FamilyName_t", &famId) == CG_OK)
+  {
+    CGNSRead::readNodeStringData(self->cgioNum, famId, familyName);
+    cgio_release_id(self->cgioNum, famId);
+    famId = 0;
+  }
+
+  if (familyName.empty() == false)
+  {
+    vtkInformationStringKey* zonefamily =
+      new vtkInformationStringKey("FAMILY", "vtkCompositeDataSet");
+    mbase->GetMetaData(zone)->Set(zonefamily, familyName.c_str());
+  }
+
+  double zoneTypeId;
+  zt = CGNS_ENUMV(Structured);
+  if (CGNSRead::getFirstNodeId(self->cgioNum, zoneId, "ZoneType_t", &zoneTypeId) == CG_OK)
+  {
+    std::string zoneType;
+    CGNSRead::readNodeStringData(self->cgioNum, zoneTypeId, zoneType);
+    cgio_release_id(self->cgioNum, zoneTypeId);
+    zoneTypeId = 0;
+
+    if (zoneType == "Structured")
+    {
+      zt = CGNS_ENUMV(Structured);
+    }
+    else if (zoneType == "Unstructured")
+    {
+      zt = CGNS_ENUMV(Unstructured);
+    }
+    else if (zoneType == "Null")
+    {
+      zt = CGNS_ENUMV(ZoneTypeNull);
+    }
+    else if (zoneType == "UserDefined")
+    {
+      zt = CGNS_ENUMV(ZoneTypeUserDefined);
+    }
+  }
+
+  int ier = CG_OK;
+  switch (zt)
+  {
+    case CGNS_ENUMV(ZoneTypeNull):
+      break;
+    case CGNS_ENUMV(ZoneTypeUserDefined):
+      break;
+    case CGNS_ENUMV(Structured):
+      ier = self->GetCurvilinearZone(base, zone, zoneId, cellDim, physicalDim, zsize, mbase);
+      break;
+    case CGNS_ENUMV(Unstructured):
+      ier = self->GetUnstructuredZone(base, zone, zoneId, cellDim, physicalDim, zsize, mbase);
+      break;
+  }
+  if (ier != CG_OK)
+  {
+    vtkErrorWithObjectMacro(self, << "Error Reading file");
+    return ZONE_ERROR;
+  }
+
+  vtkVLogF(PARAVIEW_LOG_EXECUTION_VERBOSITY(),
+    "coordinates: %.3f s, connectivity: %.3f s, solutions: %.3f s, patches: %.3f s, "
+    "waiting for file access: %.3f s",
+    state.Coordinates, state.Connectivity, state.Solutions, state.Patches, lockState.Waiting);
+  return ZONE_READ;
+}
+
 //----------------------------------------------------------------------------
 int vtkCGNSReader::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
@@ -4439,133 +4697,48 @@ int vtkCGNSReader::RequestData(vtkInformation* vtkNotUsed(request),
 
     int zonemin = baseToZoneRange[numBase][0];
     int zonemax = baseToZoneRange[numBase][1];
-    for (int zone = zonemin; zone < zonemax; ++zone)
+    std::atomic<int> status(vtkPrivate::ZONE_READ);
+    if (this->ReadZonesConcurrently)
     {
-      CGNSRead::char_33 zoneName;
-      cgsize_t zsize[9];
-      CGNS_ENUMT(ZoneType_t) zt = CGNS_ENUMV(ZoneTypeNull);
-      memset(zoneName, 0, 33);
-      memset(zsize, 0, 9 * sizeof(cgsize_t));
-
-      if (cgio_get_name(this->cgioNum, baseChildId[zone], zoneName) != CG_OK)
-      {
-        char errmsg[CGIO_MAX_ERROR_LENGTH + 1];
-        cgio_error_message(errmsg);
-        vtkErrorMacro(<< "Problem while reading name of zone number " << zone
-                      << ", error : " << errmsg);
-        return 1;
-      }
-
-      CGNSRead::char_33 dataType;
-      if (cgio_get_data_type(this->cgioNum, baseChildId[zone], dataType) != CG_OK)
-      {
-        char errmsg[CGIO_MAX_ERROR_LENGTH + 1];
-        cgio_error_message(errmsg);
-        vtkErrorMacro(<< "Problem while reading data_type of zone number " << zone << " "
-                      << errmsg);
-        return 1;
-      }
-
-      if (strcmp(dataType, "I4") == 0)
-      {
-        std::vector<vtkTypeInt32> mdata;
-        CGNSRead::readNodeData<vtkTypeInt32>(this->cgioNum, baseChildId[zone], mdata);
-        for (std::size_t index = 0; index < mdata.size(); index++)
-        {
-          zsize[index] = static_cast<cgsize_t>(mdata[index]);
-        }
-      }
-      else if (strcmp(dataType, "I8") == 0)
-      {
-        std::vector<vtkTypeInt64> mdata;
-        CGNSRead::readNodeData<vtkTypeInt64>(this->cgioNum, baseChildId[zone], mdata);
-        for (std::size_t index = 0; index < mdata.size(); index++)
-        {
-          zsize[index] = static_cast<cgsize_t>(mdata[index]);
-        }
-      }
-      else
-      {
-        vtkErrorMacro(<< "Problem while reading dimension in zone number " << zone);
-        return 1;
-      }
-
-      mbase->GetMetaData(zone)->Set(vtkCompositeDataSet::NAME(), zoneName);
-
-      std::string familyName;
-      double famId;
-      if (CGNSRead::getFirstNodeId(this->cgioNum, baseChildId[zone], "FamilyName_t", &famId) ==
-        CG_OK)
-      {
-        CGNSRead::readNodeStringData(this->cgioNum, famId, familyName);
-        cgio_release_id(cgioNum, famId);
-        famId = 0;
-      }
-
-      if (familyName.empty() == false)
-      {
-        vtkInformationStringKey* zonefamily =
-          new vtkInformationStringKey("FAMILY", "vtkCompositeDataSet");
-        mbase->GetMetaData(zone)->Set(zonefamily, familyName.c_str());
-      }
-
-      this->currentId = baseChildId[zone];
-
-      double zoneTypeId;
-      zt = CGNS_ENUMV(Structured);
-      if (CGNSRead::getFirstNodeId(this->cgioNum, baseChildId[zone], "ZoneType_t", &zoneTypeId) ==
-        CG_OK)
-      {
-        std::string zoneType;
-        CGNSRead::readNodeStringData(this->cgioNum, zoneTypeId, zoneType);
-        cgio_release_id(cgioNum, zoneTypeId);
-        zoneTypeId = 0;
-
-        if (zoneType == "Structured")
-        {
-          zt = CGNS_ENUMV(Structured);
-        }
-        else if (zoneType == "Unstructured")
+      // A zone holds the cgio lock while it is read, except while working on
+      // data that is already in memory.
+      auto readZones = [&](vtkIdType begin, vtkIdType end) {
+        CGNSRead::CGIOLockState& lockState = CGNSRead::GetCGIOLockState();
+        for (vtkIdType zone = begin; zone < end && status == vtkPrivate::ZONE_READ; ++zone)
         {
-          zt = CGNS_ENUMV(Unstructured);
+          // The SMP backend may run this while another zone is being read by
+          // the same thread, restore the state of that zone afterwards.
+          const CGNSRead::CGIOLockState outerLockState = lockState;
+          const vtkPrivate::ZoneState outerZoneState = vtkPrivate::CurrentZone;
+          std::unique_lock<std::recursive_mutex> lock(CGNSRead::GetCGIOMutex(), std::defer_lock);
+          lockState.Lock = &lock;
+          const int zoneStatus = vtkPrivate::readZone(numBase, static_cast<int>(zone),
+            baseChildId[zone], cellDim, physicalDim, mbase, this);
+          lockState = outerLockState;
+          vtkPrivate::CurrentZone = outerZoneState;
+          int expected = vtkPrivate::ZONE_READ;
+          status.compare_exchange_strong(expected, zoneStatus);
         }
-        else if (zoneType == "Null")
-        {
-          zt = CGNS_ENUMV(ZoneTypeNull);
-        }
-        else if (zoneType == "UserDefined")
-        {
-          zt = CGNS_ENUMV(ZoneTypeUserDefined);
-        }
-      }
-
-      switch (zt)
+      };
+      vtkSMPTools::For(zonemin, zonemax, 1, readZones);
+      this->UpdateProgress(0.5);
+    }
+    else
+    {
+      for (int zone = zonemin; zone < zonemax && status == vtkPrivate::ZONE_READ; ++zone)
       {
-        case CGNS_ENUMV(ZoneTypeNull):
-          break;
-        case CGNS_ENUMV(ZoneTypeUserDefined):
-          break;
-        case CGNS_ENUMV(Structured):
-        {
-          ier = GetCurvilinearZone(numBase, zone, cellDim, physicalDim, zsize, mbase);
-          if (ier != CG_OK)
-          {
-            vtkErrorMacro(<< "Error Reading file");
-            return 0;
-          }
-
-          break;
-        }
-        case CGNS_ENUMV(Unstructured):
-          ier = GetUnstructuredZone(numBase, zone, cellDim, physicalDim, zsize, mbase);
-          if (ier != CG_OK)
-          {
-            vtkErrorMacro(<< "Error Reading file");
-            return 0;
-          }
-          break;
+        status = vtkPrivate::readZone(
+          numBase, zone, baseChildId[zone], cellDim, physicalDim, mbase, this);
+        this->UpdateProgress(0.5);
       }
-      this->UpdateProgress(0.5);
+    }
+    if (status != vtkPrivate::ZONE_READ)
+    {
+      cgio_close_file(this->cgioNum);
+      mbase->Delete();
+      // A zone node that cannot be parsed stops the reading without failing
+      // the request.
+      return status == vtkPrivate::ZONE_INVALID ? 1 : 0;
     }
     rootNode->SetBlock(blockIndex, mbase);
     rootNode->GetMetaData(blockIndex)->Set(vtkCompositeDataSet::NAME(), curBaseInfo.name);
@@ -4686,6 +4859,10 @@ void vtkCGNSReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "CreateEachSolutionAsBlock: " << this->CreateEachSolutionAsBlock << endl;
   os << indent << "IgnoreFlowSolutionPointers: " << this->IgnoreFlowSolutionPointers << endl;
   os << indent << "DistributeBlocks: " << this->DistributeBlocks << endl;
+  os << indent << "CacheMesh: " << this->CacheMesh << endl;
+  os << indent << "CacheConnectivity: " << this->CacheConnectivity << endl;
+  os << indent << "CacheMemoryLimit: " << this->CacheMemoryLimit << endl;
+  os << indent << "ReadZonesConcurrently: " << this->ReadZonesConcurrently << endl;
   os << indent << "Controller: " << this->Controller << endl;
 }
 
@@ -5073,6 +5250,51 @@ void vtkCGNSReader::SetCacheConnectivity(bool enable)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkCGNSReader::SetCacheMemoryLimit(int megabytes)
+{
+  megabytes = std::max(megabytes, 0);
+  if (this->CacheMemoryLimit != megabytes)
+  {
+    this->CacheMemoryLimit = megabytes;
+    const vtkTypeUInt64 bytes = static_cast<vtkTypeUInt64>(megabytes) * 1024 * 1024;
+    this->MeshPointsCache.SetMemoryLimit(bytes);
+    this->ConnectivitiesCache.SetMemoryLimit(bytes);
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkCGNSReader::GetNumberOfCacheHits() const
+{
+  return this->MeshPointsCache.GetNumberOfHits() + this->ConnectivitiesCache.GetNumberOfHits();
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkCGNSReader::GetNumberOfCacheMisses() const
+{
+  return this->MeshPointsCache.GetNumberOfMisses() + this->ConnectivitiesCache.GetNumberOfMisses();
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkCGNSReader::GetNumberOfCacheEvictions() const
+{
+  return this->MeshPointsCache.GetNumberOfEvictions() +
+    this->ConnectivitiesCache.GetNumberOfEvictions();
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkCGNSReader::GetCacheMemorySize() const
+{
+  return this->MeshPointsCache.GetMemorySize() + this->ConnectivitiesCache.GetMemorySize();
+}
+
+//----------------------------------------------------------------------------
+void vtkCGNSReader::ResetCacheStatistics()
+{
+  this->MeshPointsCache.ResetStatistics();
+  this->ConnectivitiesCache.ResetStatistics();
+}
+
 //==============================================================================
 // *************** LEGACY API **************************************************
 //------------------------------------------------------------------------------
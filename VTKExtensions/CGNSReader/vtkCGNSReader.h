@@ -242,6 +242,43 @@ public:
   vtkGetMacro(CacheConnectivity, bool);
   vtkBooleanMacro(CacheConnectivity, bool);
 
+  //@{
+  /**
+   * Set/get the maximum memory, in MiB, used by each of the mesh points and
+   * mesh connectivity caches. When a cache is full, the least recently used
+   * zones are evicted. 0 (default) means no limit.
+   */
+  void SetCacheMemoryLimit(int megabytes);
+  vtkGetMacro(CacheMemoryLimit, int);
+  //@}
+
+  //@{
+  /**
+   * Statistics of the mesh points and mesh connectivity caches, summed over
+   * both caches, since the reader was created or ResetCacheStatistics() was
+   * last called. GetCacheMemorySize() returns the memory currently used by
+   * the cached objects, in bytes.
+   */
+  vtkTypeUInt64 GetNumberOfCacheHits() const;
+  vtkTypeUInt64 GetNumberOfCacheMisses() const;
+  vtkTypeUInt64 GetNumberOfCacheEvictions() const;
+  vtkTypeUInt64 GetCacheMemorySize() const;
+  void ResetCacheStatistics();
+  //@}
+
+  //@{
+  /**
+   * When on, the zones of a base are read concurrently with vtkSMPTools, so the
+   * number of threads follows the SMP backend configuration. The CGNS I/O
+   * library is not thread safe, so reading the file itself is still
+   * serialized, only the work on data already in memory (type conversions,
+   * buffer setup, building the VTK cells and arrays) overlaps. Off by default.
+   */
+  vtkSetMacro(ReadZonesConcurrently, bool);
+  vtkGetMacro(ReadZonesConcurrently, bool);
+  vtkBooleanMacro(ReadZonesConcurrently, bool);
+  //@}
+
   //@{
   /**
    * Set/get the communication object used to relay a list of files
@@ -282,11 +319,11 @@ protected:
   static void SelectionModifiedCallback(
     vtkObject* caller, unsigned long eid, void* clientdata, void* calldata);
 
-  int GetCurvilinearZone(
-    int base, int zone, int cell_dim, int phys_dim, void* zsize, vtkMultiBlockDataSet* mbase);
+  int GetCurvilinearZone(int base, int zone, double zoneId, int cell_dim, int phys_dim,
+    void* zsize, vtkMultiBlockDataSet* mbase);
 
-  int GetUnstructuredZone(
-    int base, int zone, int cell_dim, int phys_dim, void* zsize, vtkMultiBlockDataSet* mbase);
+  int GetUnstructuredZone(int base, int zone, double zoneId, int cell_dim, int phys_dim,
+    void* zsize, vtkMultiBlockDataSet* mbase);
   vtkMultiProcessController* Controller;
   vtkIdType ProcRank;
   vtkIdType ProcSize;
@@ -318,11 +355,12 @@ private:
   bool DistributeBlocks;
   bool CacheMesh;
   bool CacheConnectivity;
+  int CacheMemoryLimit;
+  bool ReadZonesConcurrently;
 
   // For internal cgio calls (low level IO)
-  int cgioNum;      // cgio file reference
-  double rootId;    // id of root node
-  double currentId; // id of node currently being read (zone)
+  int cgioNum;   // cgio file reference
+  double rootId; // id of root node
   //
   unsigned int NumberOfBases;
   int ActualTimeStep;
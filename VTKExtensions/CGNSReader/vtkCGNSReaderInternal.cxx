@@ -19,11 +19,74 @@
 #include "cgio_helpers.h"
 #include "vtkCellType.h"
 #include "vtkMultiProcessStream.h"
+#include "vtkTimerLog.h"
 
 #include <algorithm>
 
 namespace CGNSRead
 {
+//------------------------------------------------------------------------------
+std::recursive_mutex& GetCGIOMutex()
+{
+  static std::recursive_mutex mutex;
+  return mutex;
+}
+
+//------------------------------------------------------------------------------
+CGIOLockState& GetCGIOLockState()
+{
+  static thread_local CGIOLockState state;
+  return state;
+}
+
+//------------------------------------------------------------------------------
+ScopedCGIOLock::ScopedCGIOLock()
+  : Acquired(false)
+{
+  CGIOLockState& state = GetCGIOLockState();
+  if (state.Lock && !state.Lock->owns_lock())
+  {
+    const double start = vtkTimerLog::GetUniversalTime();
+    state.Lock->lock();
+    state.Waiting += vtkTimerLog::GetUniversalTime() - start;
+    this->Acquired = true;
+  }
+}
+
+//------------------------------------------------------------------------------
+ScopedCGIOLock::~ScopedCGIOLock()
+{
+  CGIOLockState& state = GetCGIOLockState();
+  if (this->Acquired && state.Lock)
+  {
+    state.Lock->unlock();
+  }
+}
+
+//------------------------------------------------------------------------------
+ScopedCGIOUnlock::ScopedCGIOUnlock()
+  : Released(false)
+{
+  CGIOLockState& state = GetCGIOLockState();
+  if (state.Lock && state.Lock->owns_lock())
+  {
+    state.Lock->unlock();
+    this->Released = true;
+  }
+}
+
+//------------------------------------------------------------------------------
+ScopedCGIOUnlock::~ScopedCGIOUnlock()
+{
+  CGIOLockState& state = GetCGIOLockState();
+  if (this->Released && state.Lock)
+  {
+    const double start = vtkTimerLog::GetUniversalTime();
+    state.Lock->lock();
+    state.Waiting += vtkTimerLog::GetUniversalTime() - start;
+  }
+}
+
 //------------------------------------------------------------------------------
 int setUpRind(const int cgioNum, const double rindId, int* rind)
 {
@@ -190,6 +253,7 @@ int get_section_connectivity(const int cgioNum, const double cgioSectionId, cons
         std::cerr << "cgio_read_data_type :" << message;
         return 1;
       }
+      ScopedCGIOUnlock unlock;
       for (cgsize_t n = 0; n < nn; n++)
       {
         localElements[n] = static_cast<vtkIdType>(data[n]);
@@ -213,6 +277,7 @@ int get_section_connectivity(const int cgioNum, const double cgioSectionId, cons
         std::cerr << "cgio_read_data_type :" << message;
         return 1;
       }
+      ScopedCGIOUnlock unlock;
       for (cgsize_t n = 0; n < nn; n++)
       {
         localElements[n] = static_cast<vtkIdType>(data[n]);
@@ -292,6 +357,7 @@ int get_section_start_offset(const int cgioNum, const double cgioSectionId, cons
         std::cerr << "cgio_read_data_type :" << message;
         return 1;
       }
+      ScopedCGIOUnlock unlock;
       for (cgsize_t n = 0; n < nn; n++)
       {
         localElementsIdx[n] = static_cast<vtkIdType>(data[n]);
@@ -315,6 +381,7 @@ int get_section_start_offset(const int cgioNum, const double cgioSectionId, cons
         std::cerr << "cgio_read_data_type :" << message;
         return 1;
       }
+      ScopedCGIOUnlock unlock;
       for (cgsize_t n = 0; n < nn; n++)
       {
         localElementsIdx[n] = static_cast<vtkIdType>(data[n]);
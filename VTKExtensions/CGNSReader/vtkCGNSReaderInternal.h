@@ -31,6 +31,7 @@
 
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <string.h> // for inline strcmp
 #include <string>
 #include <vector>
@@ -415,6 +416,60 @@ int setUpRind(const int cgioNum, const double rindId, int* rind);
 int getFirstNodeId(
   const int cgioNum, const double parentId, const char* label, double* id, const char* name = NULL);
 //------------------------------------------------------------------------------
+/**
+ * cgio is not thread safe: when zones are read concurrently, each thread holds
+ * the mutex returned by GetCGIOMutex() while calling cgio and releases it with a
+ * ScopedCGIOUnlock while working on data that is already in memory.
+ */
+std::recursive_mutex& GetCGIOMutex();
+
+/**
+ * Per thread state of the cgio lock. `Lock` is the lock on GetCGIOMutex() of
+ * the zone being read by the current thread, nullptr when zones are read
+ * serially. `Waiting` accumulates the time spent waiting for it, in seconds.
+ */
+struct CGIOLockState
+{
+  std::unique_lock<std::recursive_mutex>* Lock = nullptr;
+  double Waiting = 0.0;
+};
+CGIOLockState& GetCGIOLockState();
+
+/**
+ * Acquires the cgio lock for the lifetime of the object when zones are read
+ * concurrently.
+ */
+class ScopedCGIOLock
+{
+public:
+  ScopedCGIOLock();
+  ~ScopedCGIOLock();
+
+private:
+  ScopedCGIOLock(const ScopedCGIOLock&) = delete;
+  void operator=(const ScopedCGIOLock&) = delete;
+
+  bool Acquired;
+};
+
+/**
+ * Releases the cgio lock for the lifetime of the object so that other threads
+ * can read while this one works on data that is already in memory. Must not be
+ * used around any cgio call or any access to state shared between zones.
+ */
+class ScopedCGIOUnlock
+{
+public:
+  ScopedCGIOUnlock();
+  ~ScopedCGIOUnlock();
+
+private:
+  ScopedCGIOUnlock(const ScopedCGIOUnlock&) = delete;
+  void operator=(const ScopedCGIOUnlock&) = delete;
+
+  bool Released;
+};
+//------------------------------------------------------------------------------
 int get_section_connectivity(const int cgioNum, const double cgioSectionId, const int dim,
   const cgsize_t* srcStart, const cgsize_t* srcEnd, const cgsize_t* srcStride,
   const cgsize_t* memStart, const cgsize_t* memEnd, const cgsize_t* memStride,
@@ -447,7 +502,10 @@ int get_XYZ_mesh(const int cgioNum, const std::vector<double>& gridChildId,
   bool sameType = true;
   double coordId;
 
-  memset(coords, 0, 3 * nPts * sizeof(T));
+  {
+    ScopedCGIOUnlock unlock;
+    memset(coords, 0, 3 * nPts * sizeof(T));
+  }
 
   for (std::size_t c = 1; c <= nCoordsArray; ++c)
   {
@@ -533,6 +591,7 @@ int get_XYZ_mesh(const int cgioNum, const std::vector<double>& gridChildId,
         std::cerr << "Buffer array cgio_read_data_type :" << message;
         break;
       }
+      ScopedCGIOUnlock unlock;
       for (vtkIdType ii = 0; ii < nPts; ++ii)
       {
         currentCoord[memStride[0] * ii] = static_cast<T>(dataArray[ii]);
@@ -0,0 +1,250 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    BenchmarkMPIMoveDataMarshaling.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Measures vtkMPIMoveData marshaling throughput on a large polydata with the
+// legacy and binary formats and with every compression method, and checks
+// that they all round trip the data, including the extent of image data.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkMPIMoveData.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTimerLog.h"
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+// Exposes the marshaling methods so that a dataset can go through them
+// without any communication.
+class vtkMarshalingMoveData : public vtkMPIMoveData
+{
+public:
+  static vtkMarshalingMoveData* New();
+  vtkTypeMacro(vtkMarshalingMoveData, vtkMPIMoveData);
+
+  vtkIdType Marshal(vtkDataObject* data)
+  {
+    this->ClearBuffer();
+    this->MarshalDataToBuffer(data);
+    return this->BufferTotalLength;
+  }
+
+  void Reconstruct(vtkDataObject* data)
+  {
+    this->ReconstructDataFromBuffer(data);
+    this->ClearBuffer();
+  }
+};
+vtkStandardNewMacro(vtkMarshalingMoveData);
+
+// A triangulated height field with a point and a cell array.
+void FillSurface(vtkPolyData* surface, int resolution)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  points->SetNumberOfPoints(static_cast<vtkIdType>(resolution) * resolution);
+  vtkNew<vtkFloatArray> elevation;
+  elevation->SetName("Elevation");
+  elevation->SetNumberOfTuples(points->GetNumberOfPoints());
+  for (int j = 0; j < resolution; ++j)
+  {
+    for (int i = 0; i < resolution; ++i)
+    {
+      const vtkIdType id = static_cast<vtkIdType>(j) * resolution + i;
+      const float z = static_cast<float>((i * j) % 17) / 17.0f;
+      points->SetPoint(id, i, j, z);
+      elevation->SetValue(id, z);
+    }
+  }
+
+  vtkNew<vtkCellArray> polys;
+  const vtkIdType numQuads = static_cast<vtkIdType>(resolution - 1) * (resolution - 1);
+  polys->AllocateExact(2 * numQuads, 6 * numQuads);
+  for (int j = 0; j + 1 < resolution; ++j)
+  {
+    for (int i = 0; i + 1 < resolution; ++i)
+    {
+      const vtkIdType id = static_cast<vtkIdType>(j) * resolution + i;
+      const vtkIdType lower[3] = { id, id + 1, id + resolution };
+      const vtkIdType upper[3] = { id + 1, id + resolution + 1, id + resolution };
+      polys->InsertNextCell(3, lower);
+      polys->InsertNextCell(3, upper);
+    }
+  }
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfTuples(polys->GetNumberOfCells());
+  for (vtkIdType cc = 0; cc < cellIds->GetNumberOfTuples(); ++cc)
+  {
+    cellIds->SetValue(cc, cc);
+  }
+
+  surface->SetPoints(points);
+  surface->SetPolys(polys);
+  surface->GetPointData()->SetScalars(elevation);
+  surface->GetCellData()->AddArray(cellIds);
+}
+
+bool SameSurface(vtkPolyData* expected, vtkPolyData* actual)
+{
+  if (expected->GetNumberOfPoints() != actual->GetNumberOfPoints() ||
+    expected->GetNumberOfPolys() != actual->GetNumberOfPolys() ||
+    actual->GetPointData()->GetScalars() == nullptr ||
+    actual->GetCellData()->GetArray("CellIds") == nullptr)
+  {
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < expected->GetNumberOfPoints(); cc += 997)
+  {
+    double p1[3], p2[3];
+    expected->GetPoint(cc, p1);
+    actual->GetPoint(cc, p2);
+    if (p1[0] != p2[0] || p1[1] != p2[1] || p1[2] != p2[2] ||
+      expected->GetPointData()->GetScalars()->GetTuple1(cc) !=
+        actual->GetPointData()->GetScalars()->GetTuple1(cc))
+    {
+      return false;
+    }
+  }
+  vtkDataArray* cellIds = actual->GetCellData()->GetArray("CellIds");
+  for (vtkIdType cc = 0; cc < expected->GetNumberOfPolys(); cc += 997)
+  {
+    vtkIdType npts1, npts2;
+    const vtkIdType *pts1, *pts2;
+    expected->GetPolys()->GetCellAtId(cc, npts1, pts1);
+    actual->GetPolys()->GetCellAtId(cc, npts2, pts2);
+    if (npts1 != npts2 || pts1[0] != pts2[0] || pts1[npts1 - 1] != pts2[npts2 - 1] ||
+      cellIds->GetTuple1(cc) != cc)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+const char* CompressionName(int compression)
+{
+  switch (compression)
+  {
+    case vtkMPIMoveData::LZ4_COMPRESSION:
+      return "lz4";
+    case vtkMPIMoveData::ZLIB_COMPRESSION:
+      return "zlib";
+    case vtkMPIMoveData::SHUFFLE_LZ4_COMPRESSION:
+      return "shuffle+lz4";
+    default:
+      return "uncompressed";
+  }
+}
+
+bool Run(vtkPolyData* surface, int mode, int compression, int iterations)
+{
+  vtkMPIMoveData::SetMarshalingMode(mode);
+  vtkMPIMoveData::SetCompression(compression);
+  vtkNew<vtkMarshalingMoveData> mover;
+  vtkNew<vtkTimerLog> timer;
+  double marshalTime = 0;
+  double reconstructTime = 0;
+  vtkIdType length = 0;
+  for (int cc = 0; cc < iterations; ++cc)
+  {
+    vtkNew<vtkPolyData> result;
+    timer->StartTimer();
+    length = mover->Marshal(surface);
+    timer->StopTimer();
+    marshalTime += timer->GetElapsedTime();
+
+    timer->StartTimer();
+    mover->Reconstruct(result);
+    timer->StopTimer();
+    reconstructTime += timer->GetElapsedTime();
+
+    if (!SameSurface(surface, result))
+    {
+      cerr << "Surface did not round trip." << endl;
+      return false;
+    }
+  }
+
+  // Throughputs are relative to the size of the dataset in memory so that
+  // they compare across formats and compression methods.
+  const double megabytes = surface->GetActualMemorySize() * iterations / 1024.0;
+  cout << "  " << (mode == vtkMPIMoveData::BINARY_MARSHALING ? "binary" : "legacy") << " "
+       << CompressionName(compression) << ": marshal " << megabytes / marshalTime
+       << " MB/s, reconstruct " << megabytes / reconstructTime << " MB/s (" << length
+       << " bytes sent)" << endl;
+  return true;
+}
+
+bool RunImage(int mode)
+{
+  vtkMPIMoveData::SetMarshalingMode(mode);
+  vtkNew<vtkImageData> image;
+  image->SetExtent(4, 13, -2, 7, 1, 1);
+  image->SetOrigin(0.5, -1.0, 2.0);
+  image->SetSpacing(0.25, 0.25, 1.0);
+  image->AllocateScalars(VTK_FLOAT, 1);
+
+  vtkNew<vtkMarshalingMoveData> mover;
+  vtkNew<vtkImageData> result;
+  mover->Marshal(image);
+  mover->Reconstruct(result);
+
+  int extent[6];
+  result->GetExtent(extent);
+  if (extent[0] != 4 || extent[1] != 13 || extent[2] != -2 || extent[3] != 7 ||
+    result->GetOrigin()[0] != 0.5 || result->GetNumberOfPoints() != image->GetNumberOfPoints())
+  {
+    cerr << "Image data did not round trip." << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int BenchmarkMPIMoveDataMarshaling(int, char* [])
+{
+  const int iterations = 3;
+  vtkNew<vtkPolyData> surface;
+  FillSurface(surface, 1024);
+  cout << surface->GetNumberOfPoints() << " points, " << surface->GetNumberOfPolys()
+       << " triangles:" << endl;
+
+  const int mode = vtkMPIMoveData::GetMarshalingMode();
+  const int compression = vtkMPIMoveData::GetCompression();
+  bool success = true;
+  for (int cc = vtkMPIMoveData::NO_COMPRESSION;
+       success && cc <= vtkMPIMoveData::SHUFFLE_LZ4_COMPRESSION; ++cc)
+  {
+    success = Run(surface, vtkMPIMoveData::LEGACY_MARSHALING, cc, iterations) &&
+      Run(surface, vtkMPIMoveData::BINARY_MARSHALING, cc, iterations);
+  }
+  vtkMPIMoveData::SetCompression(vtkMPIMoveData::NO_COMPRESSION);
+  success = success && RunImage(vtkMPIMoveData::LEGACY_MARSHALING) &&
+    RunImage(vtkMPIMoveData::BINARY_MARSHALING);
+  vtkMPIMoveData::SetMarshalingMode(mode);
+  vtkMPIMoveData::SetCompression(compression);
+  return success ? TEST_SUCCESS : TEST_FAILED;
+}
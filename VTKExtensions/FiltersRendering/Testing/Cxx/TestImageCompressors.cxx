@@ -13,6 +13,7 @@
 
 =========================================================================*/
 
+#include "vtkDeltaImageCompressor.h"
 #include "vtkImageCompressor.h"
 #include "vtkImageData.h"
 #include "vtkLZ4Compressor.h"
@@ -22,10 +23,13 @@
 #include "vtkSmartPointer.h"
 #include "vtkSquirtCompressor.h"
 #include "vtkTesting.h"
+#include "vtkTiledImageCompressor.h"
 #include "vtkTimerLog.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkZlibImageCompressor.h"
 
+#include <algorithm>
+#include <cstring>
 #include <map>
 #include <string>
 #include <vtksys/CommandLineArguments.hxx>
@@ -60,7 +64,7 @@ bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* in
 
   vtkNew<vtkTimerLog> timer;
   timer->StartTimer();
-  if (!compressor->Compress())
+  if (compressor->Compress() != VTK_OK)
   {
     return false;
   }
@@ -70,7 +74,7 @@ bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* in
   compressor->SetInput(outputCompressed.Get());
   compressor->SetOutput(outputDeCompressed.Get());
   timer->StartTimer();
-  if (!compressor->Decompress())
+  if (compressor->Decompress() != VTK_OK)
   {
     return false;
   }
@@ -81,6 +85,115 @@ bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* in
   return true;
 }
 
+// Send two frames through a pair of delta compressors, the second one only
+// differing from the first in a small region.
+bool DoDeltaTest(vtkUnsignedCharArray* input, int width, int height)
+{
+  vtkNew<vtkDeltaImageCompressor> encoder;
+  vtkNew<vtkDeltaImageCompressor> decoder;
+  encoder->SetLossLessMode(1);
+  encoder->SetImageResolution(width, height);
+  decoder->SetImageResolution(width, height);
+
+  vtkNew<vtkUnsignedCharArray> frame;
+  frame->DeepCopy(input);
+  vtkNew<vtkUnsignedCharArray> decompressed;
+  decompressed->SetNumberOfComponents(input->GetNumberOfComponents());
+  decompressed->SetNumberOfTuples(input->GetNumberOfTuples());
+  const size_t frameSize = static_cast<size_t>(input->GetNumberOfValues());
+
+  vtkIdType keyFrameSize = 0;
+  for (int cc = 0; cc < 2; ++cc)
+  {
+    if (cc == 1)
+    {
+      // Invert a 10x10 block of pixels.
+      for (int y = 0; y < std::min(10, height); ++y)
+      {
+        for (int x = 0; x < std::min(10, width); ++x)
+        {
+          for (int comp = 0; comp < frame->GetNumberOfComponents(); ++comp)
+          {
+            const vtkIdType tuple = static_cast<vtkIdType>(y) * width + x;
+            frame->SetTypedComponent(tuple, comp, 255 - frame->GetTypedComponent(tuple, comp));
+          }
+        }
+      }
+    }
+
+    vtkNew<vtkUnsignedCharArray> compressed;
+    encoder->SetInput(frame.Get());
+    encoder->SetOutput(compressed.Get());
+    if (encoder->Compress() != VTK_OK || encoder->GetLastFrameWasKeyFrame() != (cc == 0))
+    {
+      cerr << "Unexpected delta frame compression result." << endl;
+      return false;
+    }
+    decoder->SetInput(compressed.Get());
+    decoder->SetOutput(decompressed.Get());
+    if (decoder->Decompress() != VTK_OK ||
+      memcmp(decompressed->GetPointer(0), frame->GetPointer(0), frameSize) != 0)
+    {
+      cerr << "Delta frame " << cc << " did not round trip." << endl;
+      return false;
+    }
+    if (cc == 0)
+    {
+      keyFrameSize = compressed->GetNumberOfValues();
+    }
+    else if (compressed->GetNumberOfValues() * 10 > keyFrameSize)
+    {
+      cerr << "Delta frame is not smaller than the key frame (" << compressed->GetNumberOfValues()
+           << " vs. " << keyFrameSize << ")." << endl;
+      return false;
+    }
+  }
+
+  // The decoder misses a frame, so it must reject the next delta frame until
+  // the encoder is asked for a key frame.
+  vtkNew<vtkUnsignedCharArray> dropped;
+  encoder->SetInput(frame.Get());
+  encoder->SetOutput(dropped.Get());
+  if (encoder->Compress() != VTK_OK)
+  {
+    cerr << "Dropped frame compression failed." << endl;
+    return false;
+  }
+  for (int cc = 0; cc < 2; ++cc)
+  {
+    frame->SetTypedComponent(0, 0, static_cast<unsigned char>(frame->GetTypedComponent(0, 0) + 1));
+    vtkNew<vtkUnsignedCharArray> compressed;
+    encoder->SetInput(frame.Get());
+    encoder->SetOutput(compressed.Get());
+    if (encoder->Compress() != VTK_OK || encoder->GetLastFrameWasKeyFrame() != (cc == 1))
+    {
+      cerr << "Unexpected resync frame compression result." << endl;
+      return false;
+    }
+    decoder->SetInput(compressed.Get());
+    decoder->SetOutput(decompressed.Get());
+    vtkObject::GlobalWarningDisplayOff();
+    const bool decoded = decoder->Decompress() == VTK_OK;
+    vtkObject::GlobalWarningDisplayOn();
+    if (decoded != (cc == 1) || decoder->GetKeyFrameNeeded() != (cc == 0))
+    {
+      cerr << "Delta frame after a dropped frame was not rejected, or the key frame was."
+           << endl;
+      return false;
+    }
+    if (decoder->GetKeyFrameNeeded())
+    {
+      encoder->ForceKeyFrame();
+    }
+  }
+  if (memcmp(decompressed->GetPointer(0), frame->GetPointer(0), frameSize) != 0)
+  {
+    cerr << "Key frame did not resynchronize the decoder." << endl;
+    return false;
+  }
+  return true;
+}
+
 int TestImageCompressors(int argc, char* argv[])
 {
   int max_count = 10;
@@ -145,6 +258,49 @@ int TestImageCompressors(int argc, char* argv[])
       }
     }
 
+    vtkNew<vtkTiledImageCompressor> tiled;
+    tiled->SetQuality(0);
+    tiled->SetImageResolution(image->GetDimensions()[0], image->GetDimensions()[1]);
+    if (!DoTest(datas["TILED LZ4 (quality: 0)"], tiled.Get(), input))
+    {
+      return TEST_FAILED;
+    }
+    if (cc == 0)
+    {
+      // Lossless tiles must reassemble to the original image.
+      vtkNew<vtkUnsignedCharArray> compressed;
+      vtkNew<vtkUnsignedCharArray> decompressed;
+      decompressed->SetNumberOfComponents(input->GetNumberOfComponents());
+      decompressed->SetNumberOfTuples(input->GetNumberOfTuples());
+      tiled->SetNumberOfTiles(7);
+      tiled->SetInput(input);
+      tiled->SetOutput(compressed.Get());
+      const bool encoded = tiled->Compress() == VTK_OK;
+      tiled->SetInput(compressed.Get());
+      tiled->SetOutput(decompressed.Get());
+      if (!encoded || tiled->Decompress() != VTK_OK ||
+        memcmp(decompressed->GetPointer(0), input->GetPointer(0), uncompressedSize) != 0)
+      {
+        cerr << "Tiled LZ4 round trip did not preserve the image." << endl;
+        return TEST_FAILED;
+      }
+      tiled->SetNumberOfTiles(0);
+    }
+    if (test_lossy)
+    {
+      tiled->SetQuality(3);
+      tiled->SetLossLessMode(0);
+      if (!DoTest(datas["TILED LZ4 (quality: 3)"], tiled.Get(), input))
+      {
+        return TEST_FAILED;
+      }
+    }
+
+    if (cc == 0 && !DoDeltaTest(input, image->GetDimensions()[0], image->GetDimensions()[1]))
+    {
+      return TEST_FAILED;
+    }
+
     vtkNew<vtkSquirtCompressor> squirt;
     squirt->SetSquirtLevel(0);
     if (!DoTest(datas["SQUIRT (squirt-level: 0)"], squirt.Get(), input))
@@ -0,0 +1,213 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestMPIMoveDataMarshaling.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks that a polydata with arrays of 1, 4 and 8 byte values round trips
+// through vtkMPIMoveData marshaling with the legacy and binary formats and
+// with every compression method, along with the names of the components of
+// its arrays and their information keys. BenchmarkMPIMoveDataMarshaling
+// measures their throughput.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkLogger.h"
+#include "vtkMPIMoveData.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+// Exposes the marshaling methods so that a dataset can go through them
+// without any communication.
+class vtkMarshalingMoveData : public vtkMPIMoveData
+{
+public:
+  static vtkMarshalingMoveData* New();
+  vtkTypeMacro(vtkMarshalingMoveData, vtkMPIMoveData);
+
+  void RoundTrip(vtkDataObject* input, vtkDataObject* output)
+  {
+    this->ClearBuffer();
+    this->MarshalDataToBuffer(input);
+    this->ReconstructDataFromBuffer(output);
+    this->ClearBuffer();
+  }
+};
+vtkStandardNewMacro(vtkMarshalingMoveData);
+
+void FillSurface(vtkPolyData* surface, int resolution)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  vtkNew<vtkDoubleArray> elevation;
+  elevation->SetName("Elevation");
+  vtkNew<vtkUnsignedCharArray> flags;
+  flags->SetName("Flags");
+  vtkNew<vtkFloatArray> normals;
+  normals->SetName("Normals");
+  normals->SetNumberOfComponents(3);
+  normals->SetComponentName(0, "Nx");
+  normals->SetComponentName(2, "Nz");
+  for (int j = 0; j < resolution; ++j)
+  {
+    for (int i = 0; i < resolution; ++i)
+    {
+      const double z = ((i * j) % 17) / 17.0;
+      points->InsertNextPoint(i, j, z);
+      elevation->InsertNextValue(z);
+      flags->InsertNextValue(static_cast<unsigned char>(i + j));
+      normals->InsertNextTuple3(0, -z, 1);
+    }
+  }
+
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkFloatArray> areas;
+  areas->SetName("Areas");
+  for (int j = 0; j + 1 < resolution; ++j)
+  {
+    for (int i = 0; i + 1 < resolution; ++i)
+    {
+      const vtkIdType id = static_cast<vtkIdType>(j) * resolution + i;
+      const vtkIdType quad[4] = { id, id + 1, id + resolution + 1, id + resolution };
+      polys->InsertNextCell(4, quad);
+      areas->InsertNextValue(1.0f + id);
+    }
+  }
+
+  surface->SetPoints(points);
+  surface->SetPolys(polys);
+  surface->GetPointData()->AddArray(elevation);
+  surface->GetPointData()->AddArray(flags);
+  surface->GetPointData()->AddArray(normals);
+  surface->GetCellData()->AddArray(areas);
+}
+
+bool SameArray(vtkDataArray* expected, vtkDataArray* actual)
+{
+  if (!actual || actual->GetDataType() != expected->GetDataType() ||
+    actual->GetNumberOfTuples() != expected->GetNumberOfTuples() ||
+    actual->GetNumberOfComponents() != expected->GetNumberOfComponents())
+  {
+    return false;
+  }
+  if (expected->GetInformation()->Has(vtkAbstractArray::GUI_HIDE()) &&
+    actual->GetInformation()->Get(vtkAbstractArray::GUI_HIDE()) !=
+      expected->GetInformation()->Get(vtkAbstractArray::GUI_HIDE()))
+  {
+    return false;
+  }
+  for (int cc = 0; cc < expected->GetNumberOfComponents(); ++cc)
+  {
+    const char* expectedName = expected->GetComponentName(cc);
+    const char* actualName = actual->GetComponentName(cc);
+    if ((expectedName == nullptr) != (actualName == nullptr) ||
+      (expectedName && strcmp(expectedName, actualName) != 0))
+    {
+      return false;
+    }
+  }
+  for (vtkIdType cc = 0; cc < expected->GetNumberOfValues(); ++cc)
+  {
+    if (actual->GetComponent(cc / expected->GetNumberOfComponents(),
+          cc % expected->GetNumberOfComponents()) !=
+      expected->GetComponent(
+        cc / expected->GetNumberOfComponents(), cc % expected->GetNumberOfComponents()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameSurface(vtkPolyData* expected, vtkPolyData* actual)
+{
+  if (actual->GetNumberOfPolys() != expected->GetNumberOfPolys() ||
+    !SameArray(expected->GetPoints()->GetData(), actual->GetPoints()->GetData()) ||
+    !SameArray(expected->GetPointData()->GetArray("Elevation"),
+      actual->GetPointData()->GetArray("Elevation")) ||
+    !SameArray(
+      expected->GetPointData()->GetArray("Flags"), actual->GetPointData()->GetArray("Flags")) ||
+    !SameArray(expected->GetPointData()->GetArray("Normals"),
+      actual->GetPointData()->GetArray("Normals")) ||
+    !SameArray(
+      expected->GetCellData()->GetArray("Areas"), actual->GetCellData()->GetArray("Areas")))
+  {
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < expected->GetNumberOfPolys(); ++cc)
+  {
+    vtkIdType npts1, npts2;
+    const vtkIdType *pts1, *pts2;
+    expected->GetPolys()->GetCellAtId(cc, npts1, pts1);
+    actual->GetPolys()->GetCellAtId(cc, npts2, pts2);
+    if (npts1 != npts2 || !std::equal(pts1, pts1 + npts1, pts2))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestMPIMoveDataMarshaling(int, char* [])
+{
+  vtkNew<vtkPolyData> surface;
+  FillSurface(surface, 64);
+  // information keys make the binary format fall back to the legacy one.
+  vtkNew<vtkPolyData> hiddenSurface;
+  FillSurface(hiddenSurface, 8);
+  hiddenSurface->GetPointData()->GetArray("Flags")->GetInformation()->Set(
+    vtkAbstractArray::GUI_HIDE(), 1);
+
+  const int mode = vtkMPIMoveData::GetMarshalingMode();
+  const int compression = vtkMPIMoveData::GetCompression();
+  bool success = true;
+  for (int method = vtkMPIMoveData::NO_COMPRESSION;
+       method <= vtkMPIMoveData::SHUFFLE_LZ4_COMPRESSION; ++method)
+  {
+    vtkMPIMoveData::SetCompression(method);
+    for (int marshaling :
+      { vtkMPIMoveData::LEGACY_MARSHALING, vtkMPIMoveData::BINARY_MARSHALING })
+    {
+      vtkMPIMoveData::SetMarshalingMode(marshaling);
+      for (vtkPolyData* input : { surface.GetPointer(), hiddenSurface.GetPointer() })
+      {
+        vtkNew<vtkMarshalingMoveData> mover;
+        vtkNew<vtkPolyData> result;
+        mover->RoundTrip(input, result);
+        if (!SameSurface(input, result))
+        {
+          vtkLogF(ERROR, "Surface did not round trip with marshaling mode %d and compression %d.",
+            marshaling, method);
+          success = false;
+        }
+      }
+    }
+  }
+  vtkMPIMoveData::SetMarshalingMode(mode);
+  vtkMPIMoveData::SetCompression(compression);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,458 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkDeltaImageCompressor.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDeltaImageCompressor.h"
+
+#include "vtkMultiProcessStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+
+#include "vtk_lz4.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <sstream>
+
+namespace
+{
+// Same masks as vtkLZ4Compressor/vtkSquirtCompressor.
+const unsigned char compress_masks[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF },
+  { 0xFE, 0xFF, 0xFE, 0xFE }, { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 },
+  { 0xF0, 0xF8, 0xF0, 0xF0 }, { 0xE0, 0xF0, 0xE0, 0xE0 } };
+
+// Layout of the header that starts every compressed frame. The header is
+// followed by the indices of the dirty tiles (delta frames only) and by the
+// LZ4 compressed pixels.
+enum HeaderFields
+{
+  HEADER_KEY_FRAME = 0,
+  HEADER_SEQUENCE,
+  HEADER_BASE_SEQUENCE,
+  HEADER_WIDTH,
+  HEADER_HEIGHT,
+  HEADER_COMPONENTS,
+  HEADER_TILE_SIZE,
+  HEADER_DIRTY_TILES,
+  HEADER_RAW_SIZE,
+  HEADER_SIZE
+};
+
+// Extents of a tile, in pixels.
+struct TileExtent
+{
+  int X0, X1, Y0, Y1;
+
+  TileExtent(vtkTypeUInt32 tile, int width, int height, int tileSize)
+  {
+    const int tilesX = (width + tileSize - 1) / tileSize;
+    this->X0 = static_cast<int>(tile % tilesX) * tileSize;
+    this->Y0 = static_cast<int>(tile / tilesX) * tileSize;
+    this->X1 = std::min(this->X0 + tileSize, width);
+    this->Y1 = std::min(this->Y0 + tileSize, height);
+  }
+};
+}
+
+vtkStandardNewMacro(vtkDeltaImageCompressor);
+//----------------------------------------------------------------------------
+vtkDeltaImageCompressor::vtkDeltaImageCompressor()
+  : Quality(3)
+  , KeyFrameInterval(30)
+  , TileSize(32)
+  , Width(0)
+  , Height(0)
+  , LastFrameWasKeyFrame(false)
+  , KeyFrameNeeded(false)
+  , ReferenceWidth(0)
+  , ReferenceHeight(0)
+  , ReferenceComponents(0)
+  , SequenceNumber(0)
+  , FramesSinceKeyFrame(0)
+  , KeyFrameRequested(true)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkDeltaImageCompressor::~vtkDeltaImageCompressor()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::ForceKeyFrame()
+{
+  this->KeyFrameRequested = true;
+}
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::SetImageResolution(int width, int height)
+{
+  this->Width = width > 0 ? width : 0;
+  this->Height = height > 0 ? height : 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkDeltaImageCompressor::Compress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot compress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  int compress_level = this->LossLessMode ? 0 : this->Quality;
+  assert(compress_level >= 0 && compress_level <= 5);
+  unsigned int compress_mask;
+  memcpy(&compress_mask, &compress_masks[compress_level], 4);
+
+  vtkUnsignedCharArray* input = this->Input;
+  const int numComps = input->GetNumberOfComponents();
+  const vtkIdType numTuples = input->GetNumberOfTuples();
+
+  // Without a matching resolution, treat the input as a single row.
+  int width = this->Width;
+  int height = this->Height;
+  if (static_cast<vtkIdType>(width) * height != numTuples)
+  {
+    width = static_cast<int>(numTuples);
+    height = numTuples > 0 ? 1 : 0;
+  }
+
+  // Build the frame as the decompressor will see it.
+  const size_t frameSize = static_cast<size_t>(numTuples) * numComps;
+  this->Current.resize(frameSize);
+  if (compress_level > 0 && numComps == 4)
+  {
+    const unsigned int* in = reinterpret_cast<const unsigned int*>(input->GetPointer(0));
+    unsigned int* out = reinterpret_cast<unsigned int*>(this->Current.data());
+    for (vtkIdType cc = 0; cc < numTuples; ++cc)
+    {
+      out[cc] = in[cc] & compress_mask;
+    }
+  }
+  else if (frameSize > 0)
+  {
+    memcpy(this->Current.data(), input->GetPointer(0), frameSize);
+  }
+
+  const int tileSize = this->TileSize;
+  const int tilesX = (width + tileSize - 1) / tileSize;
+  const int tilesY = (height + tileSize - 1) / tileSize;
+  const vtkTypeUInt32 numTiles = static_cast<vtkTypeUInt32>(tilesX) * tilesY;
+
+  bool keyFrame = this->KeyFrameRequested ||
+    this->FramesSinceKeyFrame + 1 >= this->KeyFrameInterval || width != this->ReferenceWidth ||
+    height != this->ReferenceHeight || numComps != this->ReferenceComponents;
+
+  this->DirtyTiles.clear();
+  if (!keyFrame)
+  {
+    // Flag the tiles that differ from the previous frame, one row of tiles
+    // per task.
+    this->DirtyFlags.assign(numTiles, 0);
+    const unsigned char* current = this->Current.data();
+    const unsigned char* reference = this->Reference.data();
+    vtkSMPTools::For(0, tilesY, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ty = begin; ty < end; ++ty)
+      {
+        for (int tx = 0; tx < tilesX; ++tx)
+        {
+          const vtkTypeUInt32 tile = static_cast<vtkTypeUInt32>(ty * tilesX + tx);
+          const TileExtent ext(tile, width, height, tileSize);
+          const size_t rowBytes = static_cast<size_t>(ext.X1 - ext.X0) * numComps;
+          for (int y = ext.Y0; y < ext.Y1; ++y)
+          {
+            const size_t offset = (static_cast<size_t>(y) * width + ext.X0) * numComps;
+            if (memcmp(current + offset, reference + offset, rowBytes) != 0)
+            {
+              this->DirtyFlags[tile] = 1;
+              break;
+            }
+          }
+        }
+      }
+    });
+
+    for (vtkTypeUInt32 tile = 0; tile < numTiles; ++tile)
+    {
+      if (this->DirtyFlags[tile])
+      {
+        this->DirtyTiles.push_back(tile);
+      }
+    }
+    // Nothing to gain over a key frame when everything changed.
+    keyFrame = this->DirtyTiles.size() == numTiles;
+  }
+
+  const unsigned char* payload = this->Current.data();
+  size_t payloadSize = frameSize;
+  if (keyFrame)
+  {
+    this->DirtyTiles.clear();
+  }
+  else
+  {
+    // Gather the pixels of the dirty tiles, row by row.
+    this->TileData.clear();
+    for (vtkTypeUInt32 tile : this->DirtyTiles)
+    {
+      const TileExtent ext(tile, width, height, tileSize);
+      const size_t rowBytes = static_cast<size_t>(ext.X1 - ext.X0) * numComps;
+      for (int y = ext.Y0; y < ext.Y1; ++y)
+      {
+        const unsigned char* row =
+          this->Current.data() + (static_cast<size_t>(y) * width + ext.X0) * numComps;
+        this->TileData.insert(this->TileData.end(), row, row + rowBytes);
+      }
+    }
+    payload = this->TileData.data();
+    payloadSize = this->TileData.size();
+  }
+
+  vtkTypeUInt32 header[HEADER_SIZE];
+  header[HEADER_KEY_FRAME] = keyFrame ? 1 : 0;
+  header[HEADER_SEQUENCE] = this->SequenceNumber + 1;
+  header[HEADER_BASE_SEQUENCE] = this->SequenceNumber;
+  header[HEADER_WIDTH] = static_cast<vtkTypeUInt32>(width);
+  header[HEADER_HEIGHT] = static_cast<vtkTypeUInt32>(height);
+  header[HEADER_COMPONENTS] = static_cast<vtkTypeUInt32>(numComps);
+  header[HEADER_TILE_SIZE] = static_cast<vtkTypeUInt32>(tileSize);
+  header[HEADER_DIRTY_TILES] = static_cast<vtkTypeUInt32>(this->DirtyTiles.size());
+  header[HEADER_RAW_SIZE] = static_cast<vtkTypeUInt32>(payloadSize);
+
+  const size_t headerBytes = sizeof(header) + this->DirtyTiles.size() * sizeof(vtkTypeUInt32);
+  const int maxPayloadSize = payloadSize > 0 ? LZ4_compressBound(static_cast<int>(payloadSize)) : 0;
+  this->Output->SetNumberOfComponents(1);
+  unsigned char* outPtr =
+    this->Output->WritePointer(0, static_cast<vtkIdType>(headerBytes + maxPayloadSize));
+  memcpy(outPtr, header, sizeof(header));
+  if (!this->DirtyTiles.empty())
+  {
+    memcpy(outPtr + sizeof(header), this->DirtyTiles.data(),
+      this->DirtyTiles.size() * sizeof(vtkTypeUInt32));
+  }
+
+  int compressedSize = 0;
+  if (payloadSize > 0)
+  {
+    compressedSize = LZ4_compress_fast(reinterpret_cast<const char*>(payload),
+      reinterpret_cast<char*>(outPtr + headerBytes), static_cast<int>(payloadSize),
+      maxPayloadSize, 16);
+    if (compressedSize <= 0)
+    {
+      vtkErrorMacro("LZ4 compression failed.");
+      return VTK_ERROR;
+    }
+  }
+  this->Output->SetNumberOfTuples(static_cast<vtkIdType>(headerBytes + compressedSize));
+
+  // The frame is now what the decompressor will hold.
+  this->Reference.swap(this->Current);
+  this->ReferenceWidth = width;
+  this->ReferenceHeight = height;
+  this->ReferenceComponents = numComps;
+  this->SequenceNumber++;
+  this->FramesSinceKeyFrame = keyFrame ? 0 : this->FramesSinceKeyFrame + 1;
+  this->KeyFrameRequested = false;
+  this->LastFrameWasKeyFrame = keyFrame;
+  return VTK_OK;
+}
+
+//----------------------------------------------------------------------------
+int vtkDeltaImageCompressor::Decompress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot decompress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  // Cleared once the frame is decoded. Until then, the previous frame may be
+  // partially overwritten or older than what the compressor holds.
+  this->KeyFrameNeeded = true;
+
+  const unsigned char* inPtr = this->Input->GetPointer(0);
+  const size_t inSize = static_cast<size_t>(
+    this->Input->GetNumberOfTuples() * this->Input->GetNumberOfComponents());
+  vtkTypeUInt32 header[HEADER_SIZE];
+  if (inSize < sizeof(header))
+  {
+    vtkErrorMacro("Compressed stream is too short.");
+    return VTK_ERROR;
+  }
+  memcpy(header, inPtr, sizeof(header));
+
+  const bool keyFrame = header[HEADER_KEY_FRAME] != 0;
+  const int width = static_cast<int>(header[HEADER_WIDTH]);
+  const int height = static_cast<int>(header[HEADER_HEIGHT]);
+  const int numComps = static_cast<int>(header[HEADER_COMPONENTS]);
+  const int tileSize = static_cast<int>(header[HEADER_TILE_SIZE]);
+  const vtkTypeUInt32 numDirty = header[HEADER_DIRTY_TILES];
+  const size_t rawSize = header[HEADER_RAW_SIZE];
+  const size_t frameSize = static_cast<size_t>(width) * height * numComps;
+  const size_t headerBytes = sizeof(header) + static_cast<size_t>(numDirty) * sizeof(vtkTypeUInt32);
+
+  const size_t outSize = static_cast<size_t>(
+    this->Output->GetNumberOfTuples() * this->Output->GetNumberOfComponents());
+  if (headerBytes > inSize || outSize != frameSize || tileSize <= 0)
+  {
+    vtkErrorMacro("Compressed frame does not match the expected image.");
+    return VTK_ERROR;
+  }
+
+  if (!keyFrame &&
+    (header[HEADER_BASE_SEQUENCE] != this->SequenceNumber || width != this->ReferenceWidth ||
+      height != this->ReferenceHeight || numComps != this->ReferenceComponents))
+  {
+    vtkErrorMacro("Delta frame " << header[HEADER_SEQUENCE]
+                                 << " does not follow the last decompressed frame "
+                                 << this->SequenceNumber << ".");
+    return VTK_ERROR;
+  }
+
+  std::vector<unsigned char>& target = keyFrame ? this->Reference : this->TileData;
+  if (keyFrame && rawSize != frameSize)
+  {
+    vtkErrorMacro("Key frame does not hold a whole image.");
+    return VTK_ERROR;
+  }
+  target.resize(rawSize);
+  if (rawSize > 0)
+  {
+    const int decompressedSize =
+      LZ4_decompress_safe(reinterpret_cast<const char*>(inPtr + headerBytes),
+        reinterpret_cast<char*>(target.data()), static_cast<int>(inSize - headerBytes),
+        static_cast<int>(rawSize));
+    if (decompressedSize != static_cast<int>(rawSize))
+    {
+      vtkErrorMacro("LZ4 decompression failed.");
+      return VTK_ERROR;
+    }
+  }
+
+  if (!keyFrame)
+  {
+    // Scatter the dirty tiles into the previous frame.
+    const vtkTypeUInt32* dirtyTiles =
+      reinterpret_cast<const vtkTypeUInt32*>(inPtr + sizeof(header));
+    const vtkTypeUInt32 numTiles = static_cast<vtkTypeUInt32>((width + tileSize - 1) / tileSize) *
+      static_cast<vtkTypeUInt32>((height + tileSize - 1) / tileSize);
+    size_t offset = 0;
+    for (vtkTypeUInt32 cc = 0; cc < numDirty; ++cc)
+    {
+      vtkTypeUInt32 tile;
+      memcpy(&tile, dirtyTiles + cc, sizeof(tile));
+      if (tile >= numTiles)
+      {
+        vtkErrorMacro("Invalid tile index " << tile << ".");
+        return VTK_ERROR;
+      }
+      const TileExtent ext(tile, width, height, tileSize);
+      const size_t rowBytes = static_cast<size_t>(ext.X1 - ext.X0) * numComps;
+      for (int y = ext.Y0; y < ext.Y1; ++y)
+      {
+        if (offset + rowBytes > rawSize)
+        {
+          vtkErrorMacro("Dirty tiles exceed the decompressed data.");
+          return VTK_ERROR;
+        }
+        memcpy(this->Reference.data() + (static_cast<size_t>(y) * width + ext.X0) * numComps,
+          this->TileData.data() + offset, rowBytes);
+        offset += rowBytes;
+      }
+    }
+  }
+
+  if (frameSize > 0)
+  {
+    memcpy(this->Output->GetPointer(0), this->Reference.data(), frameSize);
+  }
+  this->ReferenceWidth = width;
+  this->ReferenceHeight = height;
+  this->ReferenceComponents = numComps;
+  this->SequenceNumber = header[HEADER_SEQUENCE];
+  this->LastFrameWasKeyFrame = keyFrame;
+  this->KeyFrameNeeded = false;
+  return VTK_OK;
+}
+
+//-----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::SaveConfiguration(vtkMultiProcessStream* stream)
+{
+  this->Superclass::SaveConfiguration(stream);
+  *stream << this->Quality << this->KeyFrameInterval << this->TileSize;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkDeltaImageCompressor::RestoreConfiguration(vtkMultiProcessStream* stream)
+{
+  if (this->Superclass::RestoreConfiguration(stream))
+  {
+    int quality, keyFrameInterval, tileSize;
+    *stream >> quality >> keyFrameInterval >> tileSize;
+    this->SetQuality(quality);
+    this->SetKeyFrameInterval(keyFrameInterval);
+    this->SetTileSize(tileSize);
+    return true;
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkDeltaImageCompressor::SaveConfiguration()
+{
+  std::ostringstream oss;
+  oss << this->Superclass::SaveConfiguration() << " " << this->Quality << " "
+      << this->KeyFrameInterval << " " << this->TileSize;
+  this->SetConfiguration(oss.str().c_str());
+  return this->Configuration;
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkDeltaImageCompressor::RestoreConfiguration(const char* stream)
+{
+  stream = this->Superclass::RestoreConfiguration(stream);
+  if (stream)
+  {
+    std::istringstream iss(stream);
+    int quality = this->Quality;
+    int keyFrameInterval = this->KeyFrameInterval;
+    int tileSize = this->TileSize;
+    iss >> quality;
+    this->SetQuality(quality);
+    // The key frame interval and the tile size are optional.
+    if (iss >> keyFrameInterval)
+    {
+      this->SetKeyFrameInterval(keyFrameInterval);
+      if (iss >> tileSize)
+      {
+        this->SetTileSize(tileSize);
+      }
+    }
+    const std::streamoff pos = iss.tellg();
+    return pos < 0 ? stream + strlen(stream) : stream + pos;
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Quality: " << this->Quality << endl;
+  os << indent << "KeyFrameInterval: " << this->KeyFrameInterval << endl;
+  os << indent << "TileSize: " << this->TileSize << endl;
+  os << indent << "LastFrameWasKeyFrame: " << this->LastFrameWasKeyFrame << endl;
+  os << indent << "KeyFrameNeeded: " << this->KeyFrameNeeded << endl;
+}
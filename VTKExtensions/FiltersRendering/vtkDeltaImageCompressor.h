@@ -0,0 +1,164 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkDeltaImageCompressor.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkDeltaImageCompressor
+ * @brief   Image compressor/decompressor that only sends the tiles that
+ * changed since the previous frame.
+ *
+ * vtkDeltaImageCompressor splits the image into square tiles and compares
+ * each one against the previously compressed frame. Only the tiles that
+ * differ (dirty tiles) are compressed with LZ4 and sent, which greatly reduces
+ * the amount of data for mostly static scenes. A key frame holding the whole
+ * image is sent every KeyFrameInterval frames, when the image resolution
+ * changes or when every tile is dirty.
+ *
+ * Both ends keep a copy of the last frame, so a given instance must see every
+ * frame in order: the compressing instance every compressed frame and the
+ * decompressing instance every one of them decompressed. Each frame carries
+ * a sequence number and a delta frame that does not follow the last frame
+ * seen by the decompressor is rejected. After a rejected or corrupted frame,
+ * GetKeyFrameNeeded() is true on the decompressing side until a frame is
+ * decoded, and ForceKeyFrame() must be called on the compressing side to
+ * resynchronize. vtkPVClientServerSynchronizedRenderers does it after each
+ * frame.
+ *
+ * Quality has the same meaning as for vtkLZ4Compressor.
+ *
+ * The configuration string is "vtkDeltaImageCompressor <lossless> <quality>
+ * <key frame interval> <tile size>".
+*/
+
+#ifndef vtkDeltaImageCompressor_h
+#define vtkDeltaImageCompressor_h
+
+#include "vtkImageCompressor.h"
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for exports
+#include "vtkType.h"                                  // needed for vtkTypeUInt32
+
+#include <vector> // for std::vector
+
+class vtkMultiProcessStream;
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkDeltaImageCompressor : public vtkImageCompressor
+{
+public:
+  static vtkDeltaImageCompressor* New();
+  vtkTypeMacro(vtkDeltaImageCompressor, vtkImageCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set the quality measure. The value can be between 0 and 5. 0 means preserve
+   * input image quality while 5 means improve compression at the cost of image
+   * quality. See vtkLZ4Compressor.
+   */
+  vtkSetClampMacro(Quality, int, 0, 5);
+  vtkGetMacro(Quality, int);
+  //@}
+
+  //@{
+  /**
+   * Set the number of frames between two key frames. 1 means every frame is a
+   * key frame. Default is 30.
+   */
+  vtkSetClampMacro(KeyFrameInterval, int, 1, VTK_INT_MAX);
+  vtkGetMacro(KeyFrameInterval, int);
+  //@}
+
+  //@{
+  /**
+   * Set the width and height, in pixels, of the tiles compared between
+   * frames. Default is 32.
+   */
+  vtkSetClampMacro(TileSize, int, 4, 1024);
+  vtkGetMacro(TileSize, int);
+  //@}
+
+  /**
+   * Make the next compressed frame a key frame.
+   */
+  void ForceKeyFrame();
+
+  /**
+   * Returns true if the last compressed or decompressed frame was a key frame.
+   */
+  vtkGetMacro(LastFrameWasKeyFrame, bool);
+
+  /**
+   * Returns true if the last call to Decompress() failed. Delta frames are
+   * rejected until the next key frame, so the compressing side should be asked
+   * to ForceKeyFrame().
+   */
+  vtkGetMacro(KeyFrameNeeded, bool);
+
+  //@{
+  /**
+   * Compress/Decompress data array on the objects input with results
+   * in the objects output. See also Set/GetInput/Output.
+   */
+  int Compress() override;
+  int Decompress() override;
+  //@}
+
+  /**
+   * Communicates the next expected image resolution. Used to lay out the
+   * tiles.
+   */
+  void SetImageResolution(int width, int height) override;
+
+  //@{
+  /**
+   * Serialize/Restore compressor configuration (but not the data) into the stream.
+   */
+  void SaveConfiguration(vtkMultiProcessStream* stream) override;
+  bool RestoreConfiguration(vtkMultiProcessStream* stream) override;
+  const char* SaveConfiguration() override;
+  const char* RestoreConfiguration(const char* stream) override;
+  //@}
+
+protected:
+  vtkDeltaImageCompressor();
+  ~vtkDeltaImageCompressor() override;
+
+  int Quality;
+  int KeyFrameInterval;
+  int TileSize;
+  int Width;
+  int Height;
+  bool LastFrameWasKeyFrame;
+  bool KeyFrameNeeded;
+
+private:
+  vtkDeltaImageCompressor(const vtkDeltaImageCompressor&) = delete;
+  void operator=(const vtkDeltaImageCompressor&) = delete;
+
+  // The last frame as seen by the decompressing side.
+  std::vector<unsigned char> Reference;
+  int ReferenceWidth;
+  int ReferenceHeight;
+  int ReferenceComponents;
+
+  // Scratch buffers reused between frames.
+  std::vector<unsigned char> Current;
+  std::vector<unsigned char> TileData;
+  std::vector<unsigned char> DirtyFlags;
+  std::vector<vtkTypeUInt32> DirtyTiles;
+
+  vtkTypeUInt32 SequenceNumber;
+  int FramesSinceKeyFrame;
+  bool KeyFrameRequested;
+};
+
+#endif
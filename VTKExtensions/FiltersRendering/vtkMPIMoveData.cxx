@@ -15,40 +15,57 @@
 #include "vtkMPIMoveData.h"
 
 #include "vtkAllToNRedistributeCompositePolyData.h"
+#include "vtkByteSwap.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
 #include "vtkCompositeDataIterator.h"
+#include "vtkDataArray.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkGenericDataObjectReader.h"
 #include "vtkGenericDataObjectWriter.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
+#include "vtkInformationKey.h"
 #include "vtkInformationVector.h"
 #include "vtkMPIMToNSocketConnection.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessControllerHelper.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkOutlineFilter.h"
 #include "vtkPVConfig.h"
 #include "vtkPVLogger.h"
 #include "vtkPVSession.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkProcessModule.h"
 #include "vtkSmartPointer.h"
 #include "vtkSocketCommunicator.h"
+#include "vtkSMPTools.h"
 #include "vtkSocketController.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTimerLog.h"
 #include "vtkToolkits.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
 
+#include "vtk_lz4.h"
 #include "vtk_zlib.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <mutex>
 #include <sstream>
+#include <string>
 #include <vector>
 
-#include <vector>
-
-bool vtkMPIMoveData::UseZLibCompression = false;
+int vtkMPIMoveData::Compression = vtkMPIMoveData::NO_COMPRESSION;
+int vtkMPIMoveData::ZLibCompressionLevel = 6;
+int vtkMPIMoveData::MarshalingMode = vtkMPIMoveData::BINARY_MARSHALING;
 
 namespace
 {
@@ -82,8 +99,1100 @@ void unsetGlobalIdsAttribute(vtkDataObject* piece)
     it->Delete();
   }
 }
+
+//-----------------------------------------------------------------------------
+// Binary marshaling.
+//
+// A binary piece starts with a fixed 16 bytes prefix: the magic "vtkB", the
+// format version, 1 if the sender is little endian, two bytes of padding and
+// the size of the header as a 64 bit integer. The header describes the
+// dataset and every array it holds, including the width of its elements since
+// VTK_LONG, VTK_UNSIGNED_LONG and VTK_ID_TYPE differ between platforms and
+// builds, and the names of its components. It is followed by the raw memory
+// of the arrays in the order they appear in the header, each one starting on a 16
+// bytes boundary relative to the start of the piece so that the receiver can
+// use it in place. The piece itself is padded to a multiple of 16 bytes to
+// keep that property for pieces gathered back to back.
+const char vtkMPIMoveDataBinaryMagic[4] = { 'v', 't', 'k', 'B' };
+const vtkTypeUInt8 vtkMPIMoveDataBinaryVersion = 3;
+const size_t vtkMPIMoveDataBinaryPrefixSize = 16;
+const size_t vtkMPIMoveDataBinaryAlignment = 16;
+
+// A run of `Length` bytes at `Offset` in a piece that holds values of
+// `Stride` bytes, used to shuffle each array by its own element width.
+struct vtkMPIMoveDataRegion
+{
+  vtkTypeUInt64 Offset;
+  vtkTypeUInt64 Length;
+  vtkTypeUInt32 Stride;
+};
+
+size_t vtkMPIMoveDataAlign(size_t offset)
+{
+  return (offset + vtkMPIMoveDataBinaryAlignment - 1) & ~(vtkMPIMoveDataBinaryAlignment - 1);
+}
+
+vtkTypeUInt8 vtkMPIMoveDataIsLittleEndian()
+{
+  const vtkTypeUInt16 one = 1;
+  vtkTypeUInt8 first;
+  memcpy(&first, &one, 1);
+  return first;
+}
+
+// Integer type of the given width and signedness of `type`, used for the
+// types whose width depends on the platform.
+int vtkMPIMoveDataFixedWidthType(int type, int wordSize)
+{
+  const bool isUnsigned = type == VTK_UNSIGNED_LONG || type == VTK_UNSIGNED_LONG_LONG ||
+    type == VTK_UNSIGNED_INT || type == VTK_UNSIGNED_SHORT || type == VTK_UNSIGNED_CHAR;
+  switch (wordSize)
+  {
+    case 4:
+      return isUnsigned ? VTK_TYPE_UINT32 : VTK_TYPE_INT32;
+    case 8:
+      return isUnsigned ? VTK_TYPE_UINT64 : VTK_TYPE_INT64;
+    default:
+      return VTK_VOID;
+  }
+}
+
+// True if the array holds information keys other than the ranges cached by
+// vtkDataArray, which the receiver computes again.
+bool vtkMPIMoveDataHasInformation(vtkAbstractArray* array)
+{
+  if (!array->HasInformation())
+  {
+    return false;
+  }
+  vtkInformation* info = array->GetInformation();
+  int numberOfCachedRanges = 0;
+  for (vtkInformationKey* key :
+    { static_cast<vtkInformationKey*>(vtkDataArray::L2_NORM_RANGE()),
+      static_cast<vtkInformationKey*>(vtkDataArray::L2_NORM_FINITE_RANGE()),
+      static_cast<vtkInformationKey*>(vtkAbstractArray::PER_COMPONENT()),
+      static_cast<vtkInformationKey*>(vtkAbstractArray::PER_FINITE_COMPONENT()) })
+  {
+    numberOfCachedRanges += key->Has(info) ? 1 : 0;
+  }
+  return info->GetNumberOfKeys() > numberOfCachedRanges;
+}
+
+// Only arrays whose memory is a single contiguous block of a numeric type can
+// be sent as is. Information keys are only kept by the legacy format.
+bool vtkMPIMoveDataIsRawArray(vtkAbstractArray* array)
+{
+  vtkDataArray* da = vtkDataArray::SafeDownCast(array);
+  if (da == nullptr || !da->HasStandardMemoryLayout() || vtkMPIMoveDataHasInformation(da))
+  {
+    return false;
+  }
+  switch (da->GetDataType())
+  {
+    case VTK_CHAR:
+    case VTK_SIGNED_CHAR:
+    case VTK_UNSIGNED_CHAR:
+    case VTK_SHORT:
+    case VTK_UNSIGNED_SHORT:
+    case VTK_INT:
+    case VTK_UNSIGNED_INT:
+    case VTK_LONG:
+    case VTK_UNSIGNED_LONG:
+    case VTK_LONG_LONG:
+    case VTK_UNSIGNED_LONG_LONG:
+    case VTK_ID_TYPE:
+    case VTK_FLOAT:
+    case VTK_DOUBLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool vtkMPIMoveDataHasRawArrays(vtkFieldData* fd)
+{
+  for (int cc = 0, max = fd ? fd->GetNumberOfArrays() : 0; cc < max; ++cc)
+  {
+    if (!vtkMPIMoveDataIsRawArray(fd->GetAbstractArray(cc)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool vtkMPIMoveDataHasRawCells(vtkCellArray* cells)
+{
+  return cells == nullptr || (vtkMPIMoveDataIsRawArray(cells->GetOffsetsArray()) &&
+                               vtkMPIMoveDataIsRawArray(cells->GetConnectivityArray()));
+}
+
+bool vtkMPIMoveDataCanMarshalBinary(vtkDataObject* data)
+{
+  vtkDataSet* ds = vtkDataSet::SafeDownCast(data);
+  if (ds == nullptr || !vtkMPIMoveDataHasRawArrays(ds->GetPointData()) ||
+    !vtkMPIMoveDataHasRawArrays(ds->GetCellData()) ||
+    !vtkMPIMoveDataHasRawArrays(ds->GetFieldData()))
+  {
+    return false;
+  }
+
+  switch (ds->GetDataObjectType())
+  {
+    case VTK_IMAGE_DATA:
+      return true;
+
+    case VTK_POLY_DATA:
+    {
+      vtkPolyData* pd = vtkPolyData::SafeDownCast(ds);
+      return (pd->GetPoints() == nullptr || vtkMPIMoveDataIsRawArray(pd->GetPoints()->GetData())) &&
+        vtkMPIMoveDataHasRawCells(pd->GetVerts()) && vtkMPIMoveDataHasRawCells(pd->GetLines()) &&
+        vtkMPIMoveDataHasRawCells(pd->GetPolys()) && vtkMPIMoveDataHasRawCells(pd->GetStrips());
+    }
+
+    case VTK_UNSTRUCTURED_GRID:
+    {
+      vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(ds);
+      return ug->GetFaces() == nullptr &&
+        (ug->GetPoints() == nullptr || vtkMPIMoveDataIsRawArray(ug->GetPoints()->GetData())) &&
+        vtkMPIMoveDataHasRawCells(ug->GetCells());
+    }
+
+    default:
+      return false;
+  }
+}
+
+// Builds a binary piece: the header is written as the dataset is traversed
+// and the arrays are copied into the piece once its layout is known.
+class vtkMPIMoveDataBinaryWriter
+{
+public:
+  vtkMPIMoveDataBinaryWriter()
+    : Header(vtkMPIMoveDataBinaryPrefixSize, 0)
+  {
+  }
+
+  template <typename T>
+  void Put(const T& value)
+  {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    this->Header.insert(this->Header.end(), bytes, bytes + sizeof(T));
+  }
+
+  void PutString(const char* str)
+  {
+    const vtkTypeUInt32 length = str ? static_cast<vtkTypeUInt32>(strlen(str)) : 0;
+    this->Put(length);
+    this->Header.insert(this->Header.end(), str, str + length);
+  }
+
+  void PutArray(vtkDataArray* array)
+  {
+    this->Put<vtkTypeUInt8>(array ? 1 : 0);
+    if (array)
+    {
+      this->PutString(array->GetName());
+      this->Put<vtkTypeInt32>(array->GetDataType());
+      this->Put<vtkTypeInt32>(array->GetDataTypeSize());
+      this->Put<vtkTypeInt32>(array->GetNumberOfComponents());
+      this->Put<vtkTypeInt64>(array->GetNumberOfTuples());
+      const bool hasComponentNames = array->HasAComponentName();
+      this->Put<vtkTypeUInt8>(hasComponentNames ? 1 : 0);
+      for (int cc = 0; hasComponentNames && cc < array->GetNumberOfComponents(); ++cc)
+      {
+        this->PutString(array->GetComponentName(cc));
+      }
+      this->Arrays.push_back(array);
+    }
+  }
+
+  void PutCells(vtkCellArray* cells)
+  {
+    this->PutArray(cells ? cells->GetOffsetsArray() : nullptr);
+    this->PutArray(cells ? cells->GetConnectivityArray() : nullptr);
+  }
+
+  void PutAttributes(vtkFieldData* fd)
+  {
+    vtkDataSetAttributes* dsa = vtkDataSetAttributes::SafeDownCast(fd);
+    this->Put<vtkTypeInt32>(fd->GetNumberOfArrays());
+    for (int cc = 0; cc < fd->GetNumberOfArrays(); ++cc)
+    {
+      this->PutArray(fd->GetArray(cc));
+      this->Put<vtkTypeInt32>(dsa ? dsa->IsArrayAnAttribute(cc) : -1);
+    }
+  }
+
+  void PutDataSet(vtkDataSet* ds)
+  {
+    this->Put<vtkTypeInt32>(ds->GetDataObjectType());
+    if (vtkImageData* id = vtkImageData::SafeDownCast(ds))
+    {
+      const int* extent = id->GetExtent();
+      for (int cc = 0; cc < 6; ++cc)
+      {
+        this->Put<vtkTypeInt32>(extent[cc]);
+      }
+      for (int cc = 0; cc < 3; ++cc)
+      {
+        this->Put<double>(id->GetOrigin()[cc]);
+      }
+      for (int cc = 0; cc < 3; ++cc)
+      {
+        this->Put<double>(id->GetSpacing()[cc]);
+      }
+    }
+    else if (vtkPolyData* pd = vtkPolyData::SafeDownCast(ds))
+    {
+      this->PutArray(pd->GetPoints() ? pd->GetPoints()->GetData() : nullptr);
+      this->PutCells(pd->GetVerts());
+      this->PutCells(pd->GetLines());
+      this->PutCells(pd->GetPolys());
+      this->PutCells(pd->GetStrips());
+    }
+    else if (vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(ds))
+    {
+      this->PutArray(ug->GetPoints() ? ug->GetPoints()->GetData() : nullptr);
+      this->PutArray(ug->GetCellTypesArray());
+      this->PutCells(ug->GetCells());
+    }
+    this->PutAttributes(ds->GetPointData());
+    this->PutAttributes(ds->GetCellData());
+    this->PutAttributes(ds->GetFieldData());
+  }
+
+  // Allocates the piece (with new[]) and fills it. The arrays of values wider
+  // than a byte are appended to `layout`.
+  char* Finalize(vtkIdType& length, std::vector<vtkMPIMoveDataRegion>& layout)
+  {
+    const vtkTypeUInt64 headerSize = static_cast<vtkTypeUInt64>(this->Header.size());
+    memcpy(&this->Header[0], vtkMPIMoveDataBinaryMagic, 4);
+    this->Header[4] = static_cast<char>(vtkMPIMoveDataBinaryVersion);
+    this->Header[5] = static_cast<char>(vtkMPIMoveDataIsLittleEndian());
+    memcpy(&this->Header[8], &headerSize, sizeof(headerSize));
+
+    size_t total = vtkMPIMoveDataAlign(this->Header.size());
+    for (vtkDataArray* array : this->Arrays)
+    {
+      total = vtkMPIMoveDataAlign(total + vtkMPIMoveDataBinaryWriter::GetSize(array));
+    }
+
+    char* piece = new char[total];
+    memcpy(piece, this->Header.data(), this->Header.size());
+    size_t offset = this->Header.size();
+    for (vtkDataArray* array : this->Arrays)
+    {
+      const size_t start = vtkMPIMoveDataAlign(offset);
+      memset(piece + offset, 0, start - offset);
+      const size_t size = vtkMPIMoveDataBinaryWriter::GetSize(array);
+      if (size > 0)
+      {
+        memcpy(piece + start, array->GetVoidPointer(0), size);
+        const int wordSize = array->GetDataTypeSize();
+        if (wordSize > 1)
+        {
+          layout.push_back({ static_cast<vtkTypeUInt64>(start), static_cast<vtkTypeUInt64>(size),
+            static_cast<vtkTypeUInt32>(wordSize) });
+        }
+      }
+      offset = start + size;
+    }
+    memset(piece + offset, 0, total - offset);
+    length = static_cast<vtkIdType>(total);
+    return piece;
+  }
+
+  static size_t GetSize(vtkDataArray* array)
+  {
+    return static_cast<size_t>(array->GetNumberOfValues()) *
+      static_cast<size_t>(array->GetDataTypeSize());
+  }
+
+private:
+  std::vector<char> Header;
+  std::vector<vtkDataArray*> Arrays;
+};
+
+// A received buffer shared by the arrays that use its memory in place. Each
+// such array holds a reference on the buffer which is released through the
+// array free function. That function only gets the array memory, hence the
+// map from array memory to buffer.
+struct vtkMPIMoveDataSharedBuffer
+{
+  char* Data;
+  int References;
+};
+
+std::mutex& vtkMPIMoveDataSharedBuffersMutex()
+{
+  // Never destroyed: arrays may be released during static destruction.
+  static std::mutex* mutex = new std::mutex;
+  return *mutex;
+}
+
+std::map<void*, vtkMPIMoveDataSharedBuffer*>& vtkMPIMoveDataSharedRegions()
+{
+  static auto* regions = new std::map<void*, vtkMPIMoveDataSharedBuffer*>;
+  return *regions;
+}
+
+vtkMPIMoveDataSharedBuffer* vtkMPIMoveDataNewSharedBuffer(char* data)
+{
+  return new vtkMPIMoveDataSharedBuffer{ data, 1 };
+}
+
+// Must be called with the mutex locked.
+void vtkMPIMoveDataUnRegisterSharedBuffer(vtkMPIMoveDataSharedBuffer* buffer)
+{
+  if (--buffer->References == 0)
+  {
+    delete[] buffer->Data;
+    delete buffer;
+  }
+}
+
+void vtkMPIMoveDataReleaseSharedBuffer(vtkMPIMoveDataSharedBuffer* buffer)
+{
+  std::lock_guard<std::mutex> lock(vtkMPIMoveDataSharedBuffersMutex());
+  vtkMPIMoveDataUnRegisterSharedBuffer(buffer);
+}
+
+void vtkMPIMoveDataFreeSharedRegion(void* region)
+{
+  std::lock_guard<std::mutex> lock(vtkMPIMoveDataSharedBuffersMutex());
+  auto& regions = vtkMPIMoveDataSharedRegions();
+  auto iter = regions.find(region);
+  if (iter != regions.end())
+  {
+    vtkMPIMoveDataSharedBuffer* buffer = iter->second;
+    regions.erase(iter);
+    vtkMPIMoveDataUnRegisterSharedBuffer(buffer);
+  }
+}
+
+// Reads back a piece built by vtkMPIMoveDataBinaryWriter. Arrays use the
+// memory of the piece, which must belong to `owner`, whenever it is suitably
+// aligned and are copied otherwise.
+class vtkMPIMoveDataBinaryReader
+{
+public:
+  vtkMPIMoveDataBinaryReader(char* piece, size_t length, vtkMPIMoveDataSharedBuffer* owner)
+    : Piece(piece)
+    , Length(length)
+    , Owner(owner)
+    , Position(vtkMPIMoveDataBinaryPrefixSize)
+    , HeaderSize(0)
+    , PayloadPosition(0)
+    , Swap(false)
+  {
+  }
+
+  static bool IsBinaryPiece(const char* piece, size_t length)
+  {
+    return length >= vtkMPIMoveDataBinaryPrefixSize &&
+      memcmp(piece, vtkMPIMoveDataBinaryMagic, 4) == 0;
+  }
+
+  vtkSmartPointer<vtkDataObject> ReadDataObject()
+  {
+    if (!vtkMPIMoveDataBinaryReader::IsBinaryPiece(this->Piece, this->Length) ||
+      static_cast<vtkTypeUInt8>(this->Piece[4]) != vtkMPIMoveDataBinaryVersion)
+    {
+      return nullptr;
+    }
+    this->Swap = static_cast<vtkTypeUInt8>(this->Piece[5]) != vtkMPIMoveDataIsLittleEndian();
+    vtkTypeUInt64 headerSize;
+    memcpy(&headerSize, this->Piece + 8, sizeof(headerSize));
+    if (this->Swap)
+    {
+      vtkByteSwap::SwapVoidRange(&headerSize, 1, sizeof(headerSize));
+    }
+    if (headerSize < vtkMPIMoveDataBinaryPrefixSize || headerSize > this->Length)
+    {
+      return nullptr;
+    }
+    this->HeaderSize = static_cast<size_t>(headerSize);
+    this->PayloadPosition = vtkMPIMoveDataAlign(this->HeaderSize);
+
+    vtkTypeInt32 type;
+    if (!this->Get(type) ||
+      (type != VTK_IMAGE_DATA && type != VTK_POLY_DATA && type != VTK_UNSTRUCTURED_GRID))
+    {
+      return nullptr;
+    }
+    vtkSmartPointer<vtkDataSet> ds;
+    ds.TakeReference(vtkDataSet::SafeDownCast(vtkDataObjectTypes::NewDataObject(type)));
+    if (!ds || !this->ReadDataSet(ds) || !this->ReadAttributes(ds->GetPointData()) ||
+      !this->ReadAttributes(ds->GetCellData()) || !this->ReadAttributes(ds->GetFieldData()))
+    {
+      return nullptr;
+    }
+    return ds;
+  }
+
+private:
+  template <typename T>
+  bool Get(T& value)
+  {
+    if (this->Position + sizeof(T) > this->HeaderSize)
+    {
+      return false;
+    }
+    memcpy(&value, this->Piece + this->Position, sizeof(T));
+    if (this->Swap)
+    {
+      vtkByteSwap::SwapVoidRange(&value, 1, sizeof(T));
+    }
+    this->Position += sizeof(T);
+    return true;
+  }
+
+  bool GetString(std::string& str)
+  {
+    vtkTypeUInt32 length;
+    if (!this->Get(length) || this->Position + length > this->HeaderSize)
+    {
+      return false;
+    }
+    str.assign(this->Piece + this->Position, length);
+    this->Position += length;
+    return true;
+  }
+
+  // `array` is left null, and true returned, when the sender had no array.
+  bool GetArray(vtkSmartPointer<vtkDataArray>& array)
+  {
+    array = nullptr;
+    vtkTypeUInt8 present;
+    if (!this->Get(present))
+    {
+      return false;
+    }
+    if (!present)
+    {
+      return true;
+    }
+
+    std::string name;
+    vtkTypeInt32 type, wordSize, numComps;
+    vtkTypeInt64 numTuples;
+    if (!this->GetString(name) || !this->Get(type) || !this->Get(wordSize) ||
+      !this->Get(numComps) || !this->Get(numTuples) || numComps < 1 || numTuples < 0)
+    {
+      return false;
+    }
+    array.TakeReference(vtkDataArray::CreateDataArray(type));
+    if (array && array->GetDataTypeSize() != wordSize)
+    {
+      // The sender's long or id type has another width than ours, use the
+      // fixed width integer type of the same width instead.
+      const int fixedType = vtkMPIMoveDataFixedWidthType(type, wordSize);
+      if (fixedType == VTK_VOID)
+      {
+        return false;
+      }
+      array.TakeReference(vtkDataArray::CreateDataArray(fixedType));
+    }
+    if (!array || !vtkMPIMoveDataIsRawArray(array) || array->GetDataTypeSize() != wordSize)
+    {
+      return false;
+    }
+    array->SetNumberOfComponents(numComps);
+    if (!name.empty())
+    {
+      array->SetName(name.c_str());
+    }
+    vtkTypeUInt8 hasComponentNames;
+    if (!this->Get(hasComponentNames))
+    {
+      return false;
+    }
+    for (vtkTypeInt32 cc = 0; hasComponentNames && cc < numComps; ++cc)
+    {
+      std::string componentName;
+      if (!this->GetString(componentName))
+      {
+        return false;
+      }
+      if (!componentName.empty())
+      {
+        array->SetComponentName(cc, componentName.c_str());
+      }
+    }
+
+    // Check the array fits in what was received before computing its size so
+    // that a corrupted header cannot overflow it.
+    const size_t start = this->PayloadPosition;
+    const size_t valueSize = static_cast<size_t>(numComps) * static_cast<size_t>(wordSize);
+    if (start > this->Length ||
+      static_cast<vtkTypeUInt64>(numTuples) > (this->Length - start) / valueSize)
+    {
+      return false;
+    }
+    const vtkIdType numValues = static_cast<vtkIdType>(numTuples) * numComps;
+    const size_t size = static_cast<size_t>(numTuples) * valueSize;
+    this->PayloadPosition = vtkMPIMoveDataAlign(start + size);
+    if (numValues == 0)
+    {
+      array->SetNumberOfTuples(0);
+      return true;
+    }
+
+    char* region = this->Piece + start;
+    if (this->Swap && wordSize > 1)
+    {
+      vtkByteSwap::SwapVoidRange(region, numValues, wordSize);
+    }
+    if (reinterpret_cast<std::uintptr_t>(region) % wordSize == 0)
+    {
+      {
+        std::lock_guard<std::mutex> lock(vtkMPIMoveDataSharedBuffersMutex());
+        vtkMPIMoveDataSharedRegions()[region] = this->Owner;
+        ++this->Owner->References;
+      }
+      array->SetVoidArray(region, numValues, 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+      array->SetArrayFreeFunction(&vtkMPIMoveDataFreeSharedRegion);
+    }
+    else
+    {
+      // Pieces marshaled in the legacy format break the alignment of the
+      // pieces gathered after them.
+      array->SetNumberOfTuples(static_cast<vtkIdType>(numTuples));
+      memcpy(array->GetVoidPointer(0), region, size);
+    }
+    return true;
+  }
+
+  bool GetPoints(vtkPointSet* ps)
+  {
+    vtkSmartPointer<vtkDataArray> data;
+    if (!this->GetArray(data))
+    {
+      return false;
+    }
+    if (data)
+    {
+      if (data->GetNumberOfComponents() != 3)
+      {
+        return false;
+      }
+      vtkNew<vtkPoints> points;
+      points->SetData(data);
+      ps->SetPoints(points);
+    }
+    return true;
+  }
+
+  bool GetCells(vtkSmartPointer<vtkCellArray>& cells)
+  {
+    vtkSmartPointer<vtkDataArray> offsets, connectivity;
+    if (!this->GetArray(offsets) || !this->GetArray(connectivity))
+    {
+      return false;
+    }
+    cells = nullptr;
+    if (offsets && connectivity)
+    {
+      cells = vtkSmartPointer<vtkCellArray>::New();
+      return cells->SetData(offsets, connectivity);
+    }
+    return true;
+  }
+
+  bool ReadDataSet(vtkDataSet* ds)
+  {
+    if (vtkImageData* id = vtkImageData::SafeDownCast(ds))
+    {
+      vtkTypeInt32 extent[6];
+      double origin[3], spacing[3];
+      for (int cc = 0; cc < 6; ++cc)
+      {
+        if (!this->Get(extent[cc]))
+        {
+          return false;
+        }
+      }
+      for (int cc = 0; cc < 3; ++cc)
+      {
+        if (!this->Get(origin[cc]))
+        {
+          return false;
+        }
+      }
+      for (int cc = 0; cc < 3; ++cc)
+      {
+        if (!this->Get(spacing[cc]))
+        {
+          return false;
+        }
+      }
+      id->SetExtent(extent[0], extent[1], extent[2], extent[3], extent[4], extent[5]);
+      id->SetOrigin(origin);
+      id->SetSpacing(spacing);
+      return true;
+    }
+
+    if (vtkPolyData* pd = vtkPolyData::SafeDownCast(ds))
+    {
+      vtkSmartPointer<vtkCellArray> verts, lines, polys, strips;
+      if (!this->GetPoints(pd) || !this->GetCells(verts) || !this->GetCells(lines) ||
+        !this->GetCells(polys) || !this->GetCells(strips))
+      {
+        return false;
+      }
+      pd->SetVerts(verts);
+      pd->SetLines(lines);
+      pd->SetPolys(polys);
+      pd->SetStrips(strips);
+      return true;
+    }
+
+    if (vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(ds))
+    {
+      vtkSmartPointer<vtkDataArray> types;
+      vtkSmartPointer<vtkCellArray> cells;
+      if (!this->GetPoints(ug) || !this->GetArray(types) || !this->GetCells(cells))
+      {
+        return false;
+      }
+      vtkUnsignedCharArray* cellTypes = vtkUnsignedCharArray::SafeDownCast(types);
+      if (cellTypes && cells)
+      {
+        if (cellTypes->GetNumberOfTuples() != cells->GetNumberOfCells())
+        {
+          return false;
+        }
+        ug->SetCells(cellTypes, cells);
+      }
+      return true;
+    }
+    return false;
+  }
+
+  bool ReadAttributes(vtkFieldData* fd)
+  {
+    vtkDataSetAttributes* dsa = vtkDataSetAttributes::SafeDownCast(fd);
+    vtkTypeInt32 numArrays;
+    if (!this->Get(numArrays))
+    {
+      return false;
+    }
+    for (vtkTypeInt32 cc = 0; cc < numArrays; ++cc)
+    {
+      vtkSmartPointer<vtkDataArray> array;
+      vtkTypeInt32 attribute;
+      if (!this->GetArray(array) || !this->Get(attribute) || !array)
+      {
+        return false;
+      }
+      const int index = fd->AddArray(array);
+      if (dsa && attribute >= 0 && attribute < vtkDataSetAttributes::NUM_ATTRIBUTES)
+      {
+        dsa->SetActiveAttribute(index, attribute);
+      }
+    }
+    return true;
+  }
+
+  char* Piece;
+  size_t Length;
+  vtkMPIMoveDataSharedBuffer* Owner;
+  size_t Position;
+  size_t HeaderSize;
+  size_t PayloadPosition;
+  bool Swap;
 };
 
+//-----------------------------------------------------------------------------
+// Compression.
+//
+// zlib compressed pieces start with "zlib" and the uncompressed size on 8
+// bytes, followed by the zlib stream.
+//
+// LZ4 compressed pieces start with "lz4b", 4 bytes of padding, the
+// uncompressed size on 8 bytes, the block size on 4 bytes and the number of
+// shuffled regions on 4 bytes. Each region follows, as its offset and length
+// on 8 bytes and the size of its values on 4 bytes, then each block, preceded
+// by its compressed size on 4 bytes. The bytes of the values of a region are
+// grouped by significance before the blocks are compressed. All sizes are
+// little endian.
+const size_t vtkMPIMoveDataZLibHeaderSize = 12;
+const size_t vtkMPIMoveDataLZ4HeaderSize = 24;
+const size_t vtkMPIMoveDataLZ4RegionSize = 20;
+const size_t vtkMPIMoveDataLZ4BlockSize = 4 << 20;
+
+// zlib counts bytes with 32 bit integers, larger pieces go through it in
+// chunks of this size.
+const size_t vtkMPIMoveDataZLibChunkSize = 1 << 30;
+
+// Neither LZ4 nor zlib expand data more than this many times, so a header
+// claiming more than that is corrupted.
+const vtkTypeUInt64 vtkMPIMoveDataLZ4MaxRatio = 255;
+const vtkTypeUInt64 vtkMPIMoveDataZLibMaxRatio = 1032;
+
+void vtkMPIMoveDataEncodeSize(char* out, vtkTypeUInt64 value, int numBytes)
+{
+  for (int cc = 0; cc < numBytes; ++cc)
+  {
+    out[cc] = static_cast<char>(value & 0xff);
+    value >>= 8;
+  }
+}
+
+vtkTypeUInt64 vtkMPIMoveDataDecodeSize(const char* in, int numBytes)
+{
+  vtkTypeUInt64 value = 0;
+  for (int cc = numBytes - 1; cc >= 0; --cc)
+  {
+    value = (value << 8) | static_cast<unsigned char>(in[cc]);
+  }
+  return value;
+}
+
+// Groups the i-th byte of every `stride` bytes value together. Trailing bytes
+// that do not make a whole value are left in place.
+void vtkMPIMoveDataShuffle(const char* in, char* out, size_t length, size_t stride)
+{
+  const size_t count = length / stride;
+  for (size_t i = 0; i < count; ++i)
+  {
+    for (size_t b = 0; b < stride; ++b)
+    {
+      out[b * count + i] = in[i * stride + b];
+    }
+  }
+  memcpy(out + count * stride, in + count * stride, length - count * stride);
+}
+
+void vtkMPIMoveDataUnshuffle(const char* in, char* out, size_t length, size_t stride)
+{
+  const size_t count = length / stride;
+  for (size_t i = 0; i < count; ++i)
+  {
+    for (size_t b = 0; b < stride; ++b)
+    {
+      out[i * stride + b] = in[b * count + i];
+    }
+  }
+  memcpy(out + count * stride, in + count * stride, length - count * stride);
+}
+
+const char* vtkMPIMoveDataCompressionName(int method)
+{
+  switch (method)
+  {
+    case vtkMPIMoveData::LZ4_COMPRESSION:
+      return "lz4";
+    case vtkMPIMoveData::ZLIB_COMPRESSION:
+      return "zlib";
+    case vtkMPIMoveData::SHUFFLE_LZ4_COMPRESSION:
+      return "shuffle+lz4";
+    default:
+      return "none";
+  }
+}
+
+char* vtkMPIMoveDataCompressZLib(const char* raw, vtkIdType rawLength, int level, vtkIdType& length)
+{
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  if (deflateInit(&stream, level) != Z_OK)
+  {
+    return nullptr;
+  }
+
+  // the uncompressed size follows the magic since zlib doesn't provide it to
+  // the receiver.
+  std::vector<char> out(vtkMPIMoveDataZLibHeaderSize);
+  memcpy(out.data(), "zlib", 4);
+  vtkMPIMoveDataEncodeSize(out.data() + 4, static_cast<vtkTypeUInt64>(rawLength), 8);
+  out.reserve(vtkMPIMoveDataZLibHeaderSize + static_cast<size_t>(rawLength) / 2);
+
+  const size_t outChunkSize = vtkMPIMoveDataLZ4BlockSize;
+  const char* in = raw;
+  size_t remaining = static_cast<size_t>(rawLength);
+  int flush = Z_NO_FLUSH;
+  int status = Z_OK;
+  do
+  {
+    const size_t inChunkSize = std::min(remaining, vtkMPIMoveDataZLibChunkSize);
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in));
+    stream.avail_in = static_cast<uInt>(inChunkSize);
+    in += inChunkSize;
+    remaining -= inChunkSize;
+    flush = remaining == 0 ? Z_FINISH : Z_NO_FLUSH;
+    do
+    {
+      const size_t used = out.size();
+      out.resize(used + outChunkSize);
+      stream.next_out = reinterpret_cast<Bytef*>(out.data() + used);
+      stream.avail_out = static_cast<uInt>(outChunkSize);
+      status = deflate(&stream, flush);
+      out.resize(used + outChunkSize - stream.avail_out);
+    } while (stream.avail_out == 0 && status == Z_OK);
+  } while (flush != Z_FINISH && status == Z_OK);
+  deflateEnd(&stream);
+  if (status != Z_STREAM_END)
+  {
+    return nullptr;
+  }
+
+  char* buffer = new char[out.size()];
+  memcpy(buffer, out.data(), out.size());
+  length = static_cast<vtkIdType>(out.size());
+  return buffer;
+}
+
+char* vtkMPIMoveDataCompressLZ4(const char* raw, vtkIdType rawLength,
+  const std::vector<vtkMPIMoveDataRegion>& layout, vtkIdType& length)
+{
+  const size_t total = static_cast<size_t>(rawLength);
+
+  // Shuffle each region by the size of its values, the rest of the piece
+  // (header, padding) is compressed as is.
+  std::vector<char> shuffled;
+  const char* source = raw;
+  if (!layout.empty())
+  {
+    shuffled.assign(raw, raw + total);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(layout.size()), 1,
+      [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType cc = begin; cc < end; ++cc)
+        {
+          const vtkMPIMoveDataRegion& region = layout[cc];
+          vtkMPIMoveDataShuffle(raw + region.Offset, shuffled.data() + region.Offset,
+            static_cast<size_t>(region.Length), region.Stride);
+        }
+      });
+    source = shuffled.data();
+  }
+
+  const size_t blockSize = vtkMPIMoveDataLZ4BlockSize;
+  const vtkIdType numBlocks = static_cast<vtkIdType>((total + blockSize - 1) / blockSize);
+  std::vector<std::vector<char> > blocks(static_cast<size_t>(numBlocks));
+  std::vector<int> sizes(static_cast<size_t>(numBlocks), 0);
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      const size_t start = static_cast<size_t>(block) * blockSize;
+      const int size = static_cast<int>(std::min(blockSize, total - start));
+      std::vector<char>& out = blocks[block];
+      out.resize(static_cast<size_t>(LZ4_compressBound(size)));
+      sizes[block] =
+        LZ4_compress_default(source + start, out.data(), size, static_cast<int>(out.size()));
+    }
+  });
+
+  size_t compressedTotal =
+    vtkMPIMoveDataLZ4HeaderSize + layout.size() * vtkMPIMoveDataLZ4RegionSize;
+  for (vtkIdType block = 0; block < numBlocks; ++block)
+  {
+    if (sizes[block] <= 0)
+    {
+      return nullptr;
+    }
+    compressedTotal += 4 + static_cast<size_t>(sizes[block]);
+  }
+
+  char* buffer = new char[compressedTotal];
+  memcpy(buffer, "lz4b", 4);
+  memset(buffer + 4, 0, 4);
+  vtkMPIMoveDataEncodeSize(buffer + 8, static_cast<vtkTypeUInt64>(total), 8);
+  vtkMPIMoveDataEncodeSize(buffer + 16, static_cast<vtkTypeUInt64>(blockSize), 4);
+  vtkMPIMoveDataEncodeSize(buffer + 20, static_cast<vtkTypeUInt64>(layout.size()), 4);
+  char* out = buffer + vtkMPIMoveDataLZ4HeaderSize;
+  for (const vtkMPIMoveDataRegion& region : layout)
+  {
+    vtkMPIMoveDataEncodeSize(out, region.Offset, 8);
+    vtkMPIMoveDataEncodeSize(out + 8, region.Length, 8);
+    vtkMPIMoveDataEncodeSize(out + 16, region.Stride, 4);
+    out += vtkMPIMoveDataLZ4RegionSize;
+  }
+  for (vtkIdType block = 0; block < numBlocks; ++block)
+  {
+    vtkMPIMoveDataEncodeSize(out, static_cast<vtkTypeUInt64>(sizes[block]), 4);
+    memcpy(out + 4, blocks[block].data(), static_cast<size_t>(sizes[block]));
+    out += 4 + sizes[block];
+  }
+  length = static_cast<vtkIdType>(compressedTotal);
+  return buffer;
+}
+
+// Returns a new[] allocated, compressed copy of `raw`, or null on failure.
+// `layout` lists the arrays of `raw`, it is only used by
+// SHUFFLE_LZ4_COMPRESSION and is empty for pieces in the legacy format.
+char* vtkMPIMoveDataCompress(int method, int level, const char* raw, vtkIdType rawLength,
+  const std::vector<vtkMPIMoveDataRegion>& layout, vtkIdType& length)
+{
+  switch (method)
+  {
+    case vtkMPIMoveData::LZ4_COMPRESSION:
+      return vtkMPIMoveDataCompressLZ4(raw, rawLength, {}, length);
+    case vtkMPIMoveData::SHUFFLE_LZ4_COMPRESSION:
+      return vtkMPIMoveDataCompressLZ4(raw, rawLength, layout, length);
+    case vtkMPIMoveData::ZLIB_COMPRESSION:
+      return vtkMPIMoveDataCompressZLib(raw, rawLength, level, length);
+    default:
+      return nullptr;
+  }
+}
+
+bool vtkMPIMoveDataIsCompressed(const char* piece, vtkIdType length)
+{
+  return (length >= static_cast<vtkIdType>(vtkMPIMoveDataZLibHeaderSize) &&
+           strncmp(piece, "zlib", 4) == 0) ||
+    (length >= static_cast<vtkIdType>(vtkMPIMoveDataLZ4HeaderSize) &&
+           strncmp(piece, "lz4b", 4) == 0);
+}
+
+char* vtkMPIMoveDataDecompressLZ4(const char* piece, vtkIdType length, vtkIdType& rawLength)
+{
+  const size_t received = static_cast<size_t>(length);
+  const vtkTypeUInt64 total = vtkMPIMoveDataDecodeSize(piece + 8, 8);
+  const size_t blockSize = static_cast<size_t>(vtkMPIMoveDataDecodeSize(piece + 16, 4));
+  const size_t numRegions = static_cast<size_t>(vtkMPIMoveDataDecodeSize(piece + 20, 4));
+  // Check the header against what was received before allocating anything.
+  if (blockSize == 0 || blockSize > LZ4_MAX_INPUT_SIZE ||
+    numRegions > (received - vtkMPIMoveDataLZ4HeaderSize) / vtkMPIMoveDataLZ4RegionSize ||
+    total / vtkMPIMoveDataLZ4MaxRatio > received)
+  {
+    return nullptr;
+  }
+
+  std::vector<vtkMPIMoveDataRegion> layout(numRegions);
+  size_t offset = vtkMPIMoveDataLZ4HeaderSize;
+  for (vtkMPIMoveDataRegion& region : layout)
+  {
+    region.Offset = vtkMPIMoveDataDecodeSize(piece + offset, 8);
+    region.Length = vtkMPIMoveDataDecodeSize(piece + offset + 8, 8);
+    region.Stride = static_cast<vtkTypeUInt32>(vtkMPIMoveDataDecodeSize(piece + offset + 16, 4));
+    if (region.Stride == 0 || region.Offset > total || region.Length > total - region.Offset)
+    {
+      return nullptr;
+    }
+    offset += vtkMPIMoveDataLZ4RegionSize;
+  }
+
+  // Locate the blocks first so that they can be decompressed concurrently.
+  const vtkIdType numBlocks = static_cast<vtkIdType>((total + blockSize - 1) / blockSize);
+  std::vector<size_t> offsets(static_cast<size_t>(numBlocks));
+  for (vtkIdType block = 0; block < numBlocks; ++block)
+  {
+    if (offset + 4 > received)
+    {
+      return nullptr;
+    }
+    offsets[block] = offset;
+    offset += 4 + static_cast<size_t>(vtkMPIMoveDataDecodeSize(piece + offset, 4));
+  }
+  if (offset > received)
+  {
+    return nullptr;
+  }
+
+  const size_t size = static_cast<size_t>(total);
+  char* buffer = new char[std::max<size_t>(size, 1)];
+  std::vector<char> shuffled(layout.empty() ? 0 : size);
+  char* target = layout.empty() ? buffer : shuffled.data();
+  std::vector<unsigned char> status(static_cast<size_t>(numBlocks), 0);
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      const size_t start = static_cast<size_t>(block) * blockSize;
+      const int blockLength = static_cast<int>(std::min(blockSize, size - start));
+      const int compressedSize =
+        static_cast<int>(vtkMPIMoveDataDecodeSize(piece + offsets[block], 4));
+      status[block] = LZ4_decompress_safe(piece + offsets[block] + 4, target + start,
+                        compressedSize, blockLength) == blockLength;
+    }
+  });
+  if (std::find(status.begin(), status.end(), 0) != status.end())
+  {
+    delete[] buffer;
+    return nullptr;
+  }
+
+  if (!layout.empty())
+  {
+    memcpy(buffer, shuffled.data(), size);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(layout.size()), 1,
+      [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType cc = begin; cc < end; ++cc)
+        {
+          const vtkMPIMoveDataRegion& region = layout[cc];
+          vtkMPIMoveDataUnshuffle(shuffled.data() + region.Offset, buffer + region.Offset,
+            static_cast<size_t>(region.Length), region.Stride);
+        }
+      });
+  }
+  rawLength = static_cast<vtkIdType>(size);
+  return buffer;
+}
+
+char* vtkMPIMoveDataDecompressZLib(const char* piece, vtkIdType length, vtkIdType& rawLength)
+{
+  const size_t received = static_cast<size_t>(length) - vtkMPIMoveDataZLibHeaderSize;
+  const vtkTypeUInt64 total = vtkMPIMoveDataDecodeSize(piece + 4, 8);
+  // Check the header against what was received before allocating anything.
+  if (total / vtkMPIMoveDataZLibMaxRatio > received)
+  {
+    return nullptr;
+  }
+
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  if (inflateInit(&stream) != Z_OK)
+  {
+    return nullptr;
+  }
+  const size_t size = static_cast<size_t>(total);
+  char* buffer = new char[std::max<size_t>(size, 1)];
+  const char* in = piece + vtkMPIMoveDataZLibHeaderSize;
+  size_t inRemaining = received;
+  char* out = buffer;
+  size_t outRemaining = size;
+  int status = Z_OK;
+  while (status == Z_OK)
+  {
+    if (stream.avail_in == 0 && inRemaining > 0)
+    {
+      const size_t chunkSize = std::min(inRemaining, vtkMPIMoveDataZLibChunkSize);
+      stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in));
+      stream.avail_in = static_cast<uInt>(chunkSize);
+      in += chunkSize;
+      inRemaining -= chunkSize;
+    }
+    if (stream.avail_out == 0 && outRemaining > 0)
+    {
+      const size_t chunkSize = std::min(outRemaining, vtkMPIMoveDataZLibChunkSize);
+      stream.next_out = reinterpret_cast<Bytef*>(out);
+      stream.avail_out = static_cast<uInt>(chunkSize);
+      out += chunkSize;
+      outRemaining -= chunkSize;
+    }
+    status = inflate(&stream, Z_NO_FLUSH);
+  }
+  const size_t produced = size - outRemaining - stream.avail_out;
+  inflateEnd(&stream);
+  if (status != Z_STREAM_END || produced != size)
+  {
+    delete[] buffer;
+    return nullptr;
+  }
+  rawLength = static_cast<vtkIdType>(size);
+  return buffer;
+}
+
+// Returns a new[] allocated, decompressed copy of a piece for which
+// vtkMPIMoveDataIsCompressed() is true, or null on failure.
+char* vtkMPIMoveDataDecompress(const char* piece, vtkIdType length, vtkIdType& rawLength)
+{
+  return strncmp(piece, "zlib", 4) == 0 ? vtkMPIMoveDataDecompressZLib(piece, length, rawLength)
+                                         : vtkMPIMoveDataDecompressLZ4(piece, length, rawLength);
+}
+}
+
 vtkStandardNewMacro(vtkMPIMoveData);
 
 vtkCxxSetObjectMacro(vtkMPIMoveData, Controller, vtkMultiProcessController);
@@ -168,16 +1277,56 @@ void vtkMPIMoveData::InitializeForCommunicationForParaView()
   this->SetMPIMToNSocketConnection(session->GetMPIMToNSocketConnection());
 }
 
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetCompression(int method)
+{
+  vtkMPIMoveData::Compression = (method >= vtkMPIMoveData::NO_COMPRESSION &&
+                                  method <= vtkMPIMoveData::SHUFFLE_LZ4_COMPRESSION)
+    ? method
+    : vtkMPIMoveData::NO_COMPRESSION;
+}
+
+//----------------------------------------------------------------------------
+int vtkMPIMoveData::GetCompression()
+{
+  return vtkMPIMoveData::Compression;
+}
+
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetZLibCompressionLevel(int level)
+{
+  vtkMPIMoveData::ZLibCompressionLevel = std::min(std::max(level, 1), 9);
+}
+
+//----------------------------------------------------------------------------
+int vtkMPIMoveData::GetZLibCompressionLevel()
+{
+  return vtkMPIMoveData::ZLibCompressionLevel;
+}
+
 //----------------------------------------------------------------------------
 void vtkMPIMoveData::SetUseZLibCompression(bool b)
 {
-  vtkMPIMoveData::UseZLibCompression = b;
+  vtkMPIMoveData::SetCompression(
+    b ? vtkMPIMoveData::ZLIB_COMPRESSION : vtkMPIMoveData::NO_COMPRESSION);
 }
 
 //----------------------------------------------------------------------------
 bool vtkMPIMoveData::GetUseZLibCompression()
 {
-  return vtkMPIMoveData::UseZLibCompression;
+  return vtkMPIMoveData::Compression == vtkMPIMoveData::ZLIB_COMPRESSION;
+}
+
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetMarshalingMode(int mode)
+{
+  vtkMPIMoveData::MarshalingMode = mode;
+}
+
+//----------------------------------------------------------------------------
+int vtkMPIMoveData::GetMarshalingMode()
+{
+  return vtkMPIMoveData::MarshalingMode;
 }
 
 //----------------------------------------------------------------------------
@@ -959,57 +2108,79 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
     this->NumberOfBuffers = 0;
   }
 
-  // Copy input to isolate reader from the pipeline.
-  vtkDataWriter* writer = vtkGenericDataObjectWriter::New();
-  writer->SetInputData(data);
-  if (imageData)
+  char* raw_buffer = NULL;
+  vtkIdType raw_length = 0;
+  std::vector<vtkMPIMoveDataRegion> layout;
+  if (vtkMPIMoveData::MarshalingMode == vtkMPIMoveData::BINARY_MARSHALING &&
+    vtkMPIMoveDataCanMarshalBinary(data))
   {
-    // We add the image extents to the header, since the writer doesn't preserve
-    // the extents.
-    int* extent = imageData->GetExtent();
-    double* origin = imageData->GetOrigin();
-    std::ostringstream stream;
-    stream << "EXTENT " << extent[0] << " " << extent[1] << " " << extent[2] << " " << extent[3]
-           << " " << extent[4] << " " << extent[5];
-    stream << " ORIGIN " << origin[0] << " " << origin[1] << " " << origin[2];
-    writer->SetHeader(stream.str().c_str());
+    vtkTimerLog::MarkStartEvent("Binary marshal");
+    vtkMPIMoveDataBinaryWriter binaryWriter;
+    binaryWriter.PutDataSet(vtkDataSet::SafeDownCast(data));
+    raw_buffer = binaryWriter.Finalize(raw_length, layout);
+    vtkTimerLog::MarkEndEvent("Binary marshal");
+    vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "marshaled %s in binary (%lld bytes)",
+      data->GetClassName(), static_cast<long long>(raw_length));
   }
+  else
+  {
+    // Copy input to isolate reader from the pipeline.
+    vtkDataWriter* writer = vtkGenericDataObjectWriter::New();
+    writer->SetInputData(data);
+    if (imageData)
+    {
+      // We add the image extents to the header, since the writer doesn't preserve
+      // the extents.
+      int* extent = imageData->GetExtent();
+      double* origin = imageData->GetOrigin();
+      std::ostringstream stream;
+      stream << "EXTENT " << extent[0] << " " << extent[1] << " " << extent[2] << " " << extent[3]
+             << " " << extent[4] << " " << extent[5];
+      stream << " ORIGIN " << origin[0] << " " << origin[1] << " " << origin[2];
+      writer->SetHeader(stream.str().c_str());
+    }
 
-  writer->SetFileTypeToBinary();
-  writer->WriteToOutputStringOn();
-  writer->Write();
+    writer->SetFileTypeToBinary();
+    writer->WriteToOutputStringOn();
+    writer->Write();
 
-  char* buffer = NULL;
-  vtkIdType buffer_length = 0;
+    raw_length = writer->GetOutputStringLength();
+    raw_buffer = writer->RegisterAndGetOutputString();
+    writer->Delete();
+    writer = 0;
+    vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "marshaled %s in legacy format (%lld bytes)",
+      data->GetClassName(), static_cast<long long>(raw_length));
+  }
 
-  if (vtkMPIMoveData::UseZLibCompression)
-  {
-    vtkTimerLog::MarkStartEvent("Zlib compress");
-    // Use z-lib compression.
-    uLongf out_size = compressBound(writer->GetOutputStringLength());
-    buffer = new char[out_size + 8];
-    memcpy(buffer, "zlib0000", 8);
+  char* buffer = raw_buffer;
+  vtkIdType buffer_length = raw_length;
 
-    compress2(reinterpret_cast<Bytef*>(buffer + 8), &out_size,
-      reinterpret_cast<const Bytef*>(writer->GetOutputString()), writer->GetOutputStringLength(),
-      /* compression_level */ Z_DEFAULT_COMPRESSION);
-    vtkTimerLog::MarkEndEvent("Zlib compress");
-    int in_size = static_cast<int>(writer->GetOutputStringLength());
-    for (int cc = 0; cc < 4; cc++)
+  const int method = vtkMPIMoveData::Compression;
+  if (method != vtkMPIMoveData::NO_COMPRESSION)
+  {
+    vtkTimerLog::MarkStartEvent("Compress");
+    const double start = vtkTimerLog::GetUniversalTime();
+    vtkIdType compressed_length = 0;
+    char* compressed = vtkMPIMoveDataCompress(method, vtkMPIMoveData::ZLibCompressionLevel,
+      raw_buffer, raw_length, layout, compressed_length);
+    const double elapsed = vtkTimerLog::GetUniversalTime() - start;
+    vtkTimerLog::MarkEndEvent("Compress");
+    if (compressed)
     {
-      // the first 4 bytes in the header are "zlib" which helps the receiver
-      // identify that zlib compression has been used.
-      // the next 4 bytes are the original length since zlib doesn't provide
-      // that to the receiver.
-      buffer[4 + cc] = (in_size & 0x0ff);
-      in_size = in_size >> 8;
+      vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(),
+        "compressed %lld bytes to %lld bytes with %s (ratio %.2f) in %.3f s",
+        static_cast<long long>(raw_length), static_cast<long long>(compressed_length),
+        vtkMPIMoveDataCompressionName(method),
+        static_cast<double>(raw_length) / std::max<vtkIdType>(compressed_length, 1), elapsed);
+      delete[] raw_buffer;
+      buffer = compressed;
+      buffer_length = compressed_length;
+    }
+    else
+    {
+      vtkWarningMacro(
+        "Failed to compress with " << vtkMPIMoveDataCompressionName(method) << ", sending raw.");
     }
-    buffer_length = out_size + 8;
-  }
-  else
-  {
-    buffer_length = writer->GetOutputStringLength();
-    buffer = writer->RegisterAndGetOutputString();
   }
 
   // Get string.
@@ -1020,9 +2191,6 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
   this->BufferOffsets[0] = 0;
   this->Buffers = buffer;
   this->BufferTotalLength = this->BufferLengths[0];
-
-  writer->Delete();
-  writer = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -1037,34 +2205,64 @@ void vtkMPIMoveData::ReconstructDataFromBuffer(vtkDataObject* data)
   bool is_image_data = data->IsA("vtkImageData") != 0;
   std::vector<vtkSmartPointer<vtkDataObject> > pieces;
 
+  // Arrays of binary pieces keep using the received memory, so its ownership
+  // moves to a buffer shared with them.
+  vtkMPIMoveDataSharedBuffer* received = vtkMPIMoveDataNewSharedBuffer(this->Buffers);
+  this->Buffers = 0;
+
   for (int idx = 0; idx < this->NumberOfBuffers; ++idx)
   {
-    char* bufferArray = this->Buffers + this->BufferOffsets[idx];
+    char* bufferArray = received->Data + this->BufferOffsets[idx];
     vtkIdType bufferLength = this->BufferLengths[idx];
 
     char* realBuffer = 0;
-    if (bufferLength > 4 && strncmp(bufferArray, "zlib", 4) == 0)
+    if (vtkMPIMoveDataIsCompressed(bufferArray, bufferLength))
     {
-      // sender used zlib compression. Decompress it.
-      vtkIdType compressed_length = bufferLength - 8; // remove the zlib header.
+      // sender used compression. Decompress it.
+      vtkTimerLog::MarkStartEvent("Decompress");
+      const double start = vtkTimerLog::GetUniversalTime();
       vtkIdType uncompressed_length = 0;
-      for (int cc = 0; cc < 4; cc++)
+      realBuffer = vtkMPIMoveDataDecompress(bufferArray, bufferLength, uncompressed_length);
+      vtkTimerLog::MarkEndEvent("Decompress");
+      if (!realBuffer)
       {
-        uncompressed_length = uncompressed_length | ((0xff & (bufferArray[4 + cc])) << 8 * cc);
+        vtkErrorMacro("Failed to decompress piece " << idx << ".");
+        continue;
       }
-
-      // using zlib compression.
-      realBuffer = new char[uncompressed_length];
-      uLongf destLen = uncompressed_length;
-      vtkTimerLog::MarkStartEvent("Zlib uncompress");
-      uncompress(reinterpret_cast<Bytef*>(realBuffer), &destLen,
-        reinterpret_cast<const Bytef*>(bufferArray + 8), compressed_length);
-      vtkTimerLog::MarkEndEvent("Zlib uncompress");
+      vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(),
+        "decompressed %lld bytes to %lld bytes in %.3f s", static_cast<long long>(bufferLength),
+        static_cast<long long>(uncompressed_length), vtkTimerLog::GetUniversalTime() - start);
 
       bufferArray = realBuffer;
       bufferLength = uncompressed_length;
     }
 
+    if (vtkMPIMoveDataBinaryReader::IsBinaryPiece(bufferArray, bufferLength))
+    {
+      vtkTimerLog::MarkStartEvent("Binary unmarshal");
+      vtkMPIMoveDataSharedBuffer* owner =
+        realBuffer ? vtkMPIMoveDataNewSharedBuffer(realBuffer) : received;
+      realBuffer = 0;
+      vtkMPIMoveDataBinaryReader binaryReader(bufferArray, bufferLength, owner);
+      vtkSmartPointer<vtkDataObject> output = binaryReader.ReadDataObject();
+      if (owner != received)
+      {
+        vtkMPIMoveDataReleaseSharedBuffer(owner);
+      }
+      vtkTimerLog::MarkEndEvent("Binary unmarshal");
+      if (output)
+      {
+        // reconstructing data distributted on MPI node, so global ids are valid
+        unsetGlobalIdsAttribute(output);
+        pieces.push_back(output);
+      }
+      else
+      {
+        vtkErrorMacro("Failed to unmarshal binary piece " << idx << ".");
+      }
+      continue;
+    }
+
     // Setup a reader.
     vtkDataReader* reader = vtkGenericDataObjectReader::New();
     reader->ReadFromInputStringOn();
@@ -1116,6 +2314,9 @@ void vtkMPIMoveData::ReconstructDataFromBuffer(vtkDataObject* data)
     realBuffer = 0;
   }
 
+  // The received memory is freed here unless arrays still use it.
+  vtkMPIMoveDataReleaseSharedBuffer(received);
+
   vtkMPIMoveDataMerge(pieces, data);
 }
 
@@ -105,14 +105,56 @@ public:
 
   //@{
   /**
-   * When set to true, zlib compression is used. False by default.
+   * Select the codec used to compress the marshaled data, one of
+   * CompressionMethods. NO_COMPRESSION by default. LZ4_COMPRESSION is fast
+   * enough for local networks, ZLIB_COMPRESSION, with
+   * ZLibCompressionLevel, compresses better for slow links and
+   * SHUFFLE_LZ4_COMPRESSION groups the bytes of the values of each array by
+   * significance, according to the size of the values of that array, before
+   * LZ4 compression, which helps with point coordinates and scalars. It only
+   * applies to data marshaled with BINARY_MARSHALING, and is the same as
+   * LZ4_COMPRESSION otherwise. LZ4 compresses the data in blocks, concurrently.
    * This value has any effect only on the data-sender processes. The receiver
-   * always checks the received data to see if zlib decompression is required.
+   * always checks the received data to see if decompression is required.
+   */
+  static void SetCompression(int method);
+  static int GetCompression();
+  //@}
+
+  //@{
+  /**
+   * Set the zlib compression level, from 1 (fastest) to 9 (smallest), used
+   * with ZLIB_COMPRESSION. Default is 6.
+   */
+  static void SetZLibCompressionLevel(int level);
+  static int GetZLibCompressionLevel();
+  //@}
+
+  //@{
+  /**
+   * When set to true, zlib compression is used. False by default.
+   * Same as SetCompression(ZLIB_COMPRESSION) or
+   * SetCompression(NO_COMPRESSION).
    */
   static void SetUseZLibCompression(bool b);
   static bool GetUseZLibCompression();
   //@}
 
+  //@{
+  /**
+   * Select how datasets are serialized before being sent. BINARY_MARSHALING,
+   * the default, sends a small header followed by the raw memory of every
+   * array and the receiver adopts that memory in place instead of parsing and
+   * copying it. LEGACY_MARSHALING uses vtkGenericDataObjectWriter and
+   * vtkGenericDataObjectReader. Datasets the binary form cannot represent
+   * (composite datasets, graphs, polyhedral cells, non-numeric arrays, arrays
+   * with information keys...) are always sent in the legacy format. As for zlib compression, only the
+   * value on the sender matters; the receiver detects the format used.
+   */
+  static void SetMarshalingMode(int mode);
+  static int GetMarshalingMode();
+  //@}
+
   /**
    * vtkMPIMoveData doesn't necessarily generate a valid output data on all the
    * involved processes (depending on the MoveMode and Server ivars). This
@@ -140,6 +182,20 @@ public:
     INVALID
   };
 
+  enum MarshalingModes
+  {
+    LEGACY_MARSHALING = 0,
+    BINARY_MARSHALING = 1
+  };
+
+  enum CompressionMethods
+  {
+    NO_COMPRESSION = 0,
+    LZ4_COMPRESSION = 1,
+    ZLIB_COMPRESSION = 2,
+    SHUFFLE_LZ4_COMPRESSION = 3
+  };
+
 protected:
   vtkMPIMoveData();
   ~vtkMPIMoveData() override;
@@ -196,7 +252,9 @@ private:
   vtkMPIMoveData(const vtkMPIMoveData&) = delete;
   void operator=(const vtkMPIMoveData&) = delete;
 
-  static bool UseZLibCompression;
+  static int Compression;
+  static int ZLibCompressionLevel;
+  static int MarshalingMode;
 };
 
 #endif
@@ -23,12 +23,227 @@
 #include <algorithm>
 #include <sstream>
 
+// SSE2 is part of the x86-64 baseline. AVX2 code is compiled for a specific
+// target and only used when the processor supports it. clang-cl defines
+// _MSC_VER but, like clang, needs the target attribute for AVX2 intrinsics.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && \
+  defined(__SSE2__)
+#define VTK_SQUIRT_USE_X86 1
+#define VTK_SQUIRT_AVX2_TARGET __attribute__((target("avx2")))
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(_MSC_VER) && !defined(__clang__) && \
+  (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define VTK_SQUIRT_USE_X86 1
+#define VTK_SQUIRT_AVX2_TARGET
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace
+{
+// Number of pixels following `index` whose masked value is `target`, at most
+// 15 since the run length is stored on 4 bits.
+typedef int (*RunLengthFunction)(
+  const unsigned int* pixels, int index, int end, unsigned int target, unsigned int mask);
+
+// Writes `color` to `count` pixels.
+typedef void (*FillFunction)(unsigned int* pixels, unsigned int color, int count);
+
+int ScalarRunLength(
+  const unsigned int* pixels, int index, int end, unsigned int target, unsigned int mask)
+{
+  int count = 0;
+  while ((index < end) && (count < 0x0F) && ((pixels[index] & mask) == target))
+  {
+    index++;
+    count++;
+  }
+  return count;
+}
+
+void ScalarFill(unsigned int* pixels, unsigned int color, int count)
+{
+  std::fill(pixels, pixels + count, color);
+}
+
+#if defined(VTK_SQUIRT_USE_X86)
+// Number of consecutive matches from the lowest bit of a movemask result.
+inline int TrailingOnes(int bits)
+{
+  int count = 0;
+  while (bits & 1)
+  {
+    bits >>= 1;
+    count++;
+  }
+  return count;
+}
+
+int SSE2RunLength(
+  const unsigned int* pixels, int index, int end, unsigned int target, unsigned int mask)
+{
+  const int limit = std::min(0x0F, end - index);
+  const __m128i vmask = _mm_set1_epi32(static_cast<int>(mask));
+  const __m128i vtarget = _mm_set1_epi32(static_cast<int>(target));
+  int count = 0;
+  for (; count + 4 <= limit; count += 4)
+  {
+    const __m128i v =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + index + count));
+    const int equal =
+      _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(v, vmask), vtarget)));
+    if (equal != 0x0F)
+    {
+      return count + TrailingOnes(equal);
+    }
+  }
+  return count + ScalarRunLength(pixels, index + count, index + limit, target, mask);
+}
+
+void SSE2Fill(unsigned int* pixels, unsigned int color, int count)
+{
+  const __m128i v = _mm_set1_epi32(static_cast<int>(color));
+  int cc = 0;
+  for (; cc + 4 <= count; cc += 4)
+  {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + cc), v);
+  }
+  ScalarFill(pixels + cc, color, count - cc);
+}
+
+VTK_SQUIRT_AVX2_TARGET int AVX2RunLength(
+  const unsigned int* pixels, int index, int end, unsigned int target, unsigned int mask)
+{
+  const int limit = std::min(0x0F, end - index);
+  const __m256i vmask = _mm256_set1_epi32(static_cast<int>(mask));
+  const __m256i vtarget = _mm256_set1_epi32(static_cast<int>(target));
+  int count = 0;
+  for (; count + 8 <= limit; count += 8)
+  {
+    const __m256i v =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + index + count));
+    const int equal = _mm256_movemask_ps(
+      _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(v, vmask), vtarget)));
+    if (equal != 0xFF)
+    {
+      return count + TrailingOnes(equal);
+    }
+  }
+  return count + SSE2RunLength(pixels, index + count, index + limit, target, mask);
+}
+
+VTK_SQUIRT_AVX2_TARGET void AVX2Fill(unsigned int* pixels, unsigned int color, int count)
+{
+  const __m256i v = _mm256_set1_epi32(static_cast<int>(color));
+  int cc = 0;
+  for (; cc + 8 <= count; cc += 8)
+  {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + cc), v);
+  }
+  SSE2Fill(pixels + cc, color, count - cc);
+}
+
+#if defined(_MSC_VER) && defined(__clang__)
+// clang-cl only lets functions targeting XSAVE call _xgetbv.
+__attribute__((target("xsave")))
+#endif
+bool CPUSupportsAVX2()
+{
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7)
+  {
+    return false;
+  }
+  __cpuid(info, 1);
+  // The OS must save the AVX registers (OSXSAVE and AVX bits).
+  const int osxsaveAndAVX = (1 << 27) | (1 << 28);
+  if ((info[2] & osxsaveAndAVX) != osxsaveAndAVX || (_xgetbv(0) & 0x6) != 0x6)
+  {
+    return false;
+  }
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+#endif
+
+enum SIMDInstructionSet
+{
+  SCALAR,
+  SSE2,
+  AVX2
+};
+
+SIMDInstructionSet GetInstructionSet()
+{
+#if defined(VTK_SQUIRT_USE_X86)
+  static const SIMDInstructionSet instructionSet = CPUSupportsAVX2() ? AVX2 : SSE2;
+  return instructionSet;
+#else
+  return SCALAR;
+#endif
+}
+
+RunLengthFunction GetRunLengthFunction(bool useSIMD)
+{
+  switch (useSIMD ? GetInstructionSet() : SCALAR)
+  {
+#if defined(VTK_SQUIRT_USE_X86)
+    case AVX2:
+      return AVX2RunLength;
+    case SSE2:
+      return SSE2RunLength;
+#endif
+    default:
+      return ScalarRunLength;
+  }
+}
+
+FillFunction GetFillFunction(bool useSIMD)
+{
+  switch (useSIMD ? GetInstructionSet() : SCALAR)
+  {
+#if defined(VTK_SQUIRT_USE_X86)
+    case AVX2:
+      return AVX2Fill;
+    case SSE2:
+      return SSE2Fill;
+#endif
+    default:
+      return ScalarFill;
+  }
+}
+}
+
 vtkStandardNewMacro(vtkSquirtCompressor);
 
 //-----------------------------------------------------------------------------
 vtkSquirtCompressor::vtkSquirtCompressor()
   : SquirtLevel(3)
+  , UseSIMD(true)
+{
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkSquirtCompressor::GetSIMDInstructionSet()
 {
+  switch (GetInstructionSet())
+  {
+    case AVX2:
+      return "AVX2";
+    case SSE2:
+      return "SSE2";
+    default:
+      return "scalar";
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -83,6 +298,7 @@ int vtkSquirtCompressor::Compress()
     _rawColorBuffer = (unsigned int*)input->GetPointer(0);
     _rawCompressedBuffer = (unsigned int*)this->Output->WritePointer(0, numPixels * 4);
     end_index = numPixels;
+    RunLengthFunction runLength = GetRunLengthFunction(this->UseSIMD);
 
     // Go through color buffer and put RLE format into compressed buffer
     while ((index < end_index) && (comp_index < end_index))
@@ -94,12 +310,9 @@ int vtkSquirtCompressor::Compress()
       index++;
 
       // Compute Run
-      while ((index < end_index) && (count < 0x0F) &&
-        ((current_color & compress_mask) == (_rawColorBuffer[index] & compress_mask)))
-      {
-        index++;
-        count++;
-      }
+      count = runLength(_rawColorBuffer, index, end_index, current_color & compress_mask,
+        compress_mask);
+      index += count;
       if (opacity > 0)
       {
         opacity /= 16; // since we want to encode 8-bit opacity into 4 bits.
@@ -221,6 +434,7 @@ int vtkSquirtCompressor::DecompressRGBA()
   // Access raw arrays directly
   _rawColorBuffer = (unsigned int*)out->GetPointer(0);
   _rawCompressedBuffer = (unsigned int*)in->GetPointer(0);
+  FillFunction fill = GetFillFunction(this->UseSIMD);
 
   // Go through compress buffer and extract RLE format into color buffer
   for (int i = 0; i < CompSize; i++)
@@ -245,14 +459,9 @@ int vtkSquirtCompressor::DecompressRGBA()
     }
     count &= 0x0F;
 
-    // Set color
-    _rawColorBuffer[index++] = current_color;
-
-    // Blast color into color buffer
-    for (int j = 0; j < count; j++)
-    {
-      _rawColorBuffer[index++] = current_color;
-    }
+    // Set color and blast it into color buffer
+    fill(_rawColorBuffer + index, current_color, count + 1);
+    index += count + 1;
   }
   return VTK_OK;
 }
@@ -348,4 +557,5 @@ void vtkSquirtCompressor::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "SquirtLevel: " << this->SquirtLevel << endl;
+  os << indent << "UseSIMD: " << this->UseSIMD << endl;
 }
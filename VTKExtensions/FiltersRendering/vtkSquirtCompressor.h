@@ -73,6 +73,23 @@ public:
   vtkGetMacro(SquirtLevel, int);
   //@}
 
+  //@{
+  /**
+   * When set (default), RGBA images are encoded and decoded using SSE2 or AVX2
+   * instructions when the processor supports them. The compressed stream is
+   * the same either way; this is mainly useful for testing and benchmarking.
+   */
+  vtkSetMacro(UseSIMD, bool);
+  vtkGetMacro(UseSIMD, bool);
+  vtkBooleanMacro(UseSIMD, bool);
+  //@}
+
+  /**
+   * Returns the name of the instruction set used for RGBA images when
+   * UseSIMD is set: "AVX2", "SSE2" or "scalar".
+   */
+  static const char* GetSIMDInstructionSet();
+
   //@{
   /**
    * Compress/Decompress data array on the objects input with results
@@ -100,6 +117,7 @@ protected:
   int DecompressRGBA();
 
   int SquirtLevel;
+  bool UseSIMD;
 
 private:
   vtkSquirtCompressor(const vtkSquirtCompressor&) = delete;
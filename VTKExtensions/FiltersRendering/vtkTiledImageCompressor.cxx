@@ -0,0 +1,297 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkTiledImageCompressor.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkTiledImageCompressor.h"
+
+#include "vtkMultiProcessStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkType.h"
+#include "vtkUnsignedCharArray.h"
+
+#include "vtk_lz4.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+// Same masks as vtkLZ4Compressor/vtkSquirtCompressor.
+const unsigned char compress_masks[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF },
+  { 0xFE, 0xFF, 0xFE, 0xFE }, { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 },
+  { 0xF0, 0xF8, 0xF0, 0xF0 }, { 0xE0, 0xF0, 0xE0, 0xE0 } };
+
+// Size of the stream header for the given number of tiles: the tile count
+// followed by the compressed and uncompressed size of each tile.
+size_t vtkTiledImageCompressorHeaderSize(vtkTypeUInt32 numTiles)
+{
+  return sizeof(vtkTypeUInt32) * (1 + 2 * static_cast<size_t>(numTiles));
+}
+}
+
+vtkStandardNewMacro(vtkTiledImageCompressor);
+//----------------------------------------------------------------------------
+vtkTiledImageCompressor::vtkTiledImageCompressor()
+  : Quality(3)
+  , NumberOfTiles(0)
+  , Width(0)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkTiledImageCompressor::~vtkTiledImageCompressor()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkTiledImageCompressor::SetImageResolution(int width, int)
+{
+  this->Width = width > 0 ? width : 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkTiledImageCompressor::Compress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot compress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  int compress_level = this->LossLessMode ? 0 : this->Quality;
+  assert(compress_level >= 0 && compress_level <= 5);
+  unsigned int compress_mask;
+  memcpy(&compress_mask, &compress_masks[compress_level], 4);
+
+  vtkUnsignedCharArray* input = this->Input;
+  const int numComps = input->GetNumberOfComponents();
+  const vtkIdType numTuples = input->GetNumberOfTuples();
+  const bool useMask = compress_level > 0 && numComps == 4;
+
+  // Tiles are made of whole rows when the resolution matches the input,
+  // otherwise of whole tuples.
+  vtkIdType unit = 1;
+  if (this->Width > 0 && numTuples % this->Width == 0)
+  {
+    unit = this->Width;
+  }
+  const vtkIdType numUnits = numTuples / unit;
+
+  vtkIdType numTiles = this->NumberOfTiles;
+  if (numTiles <= 0)
+  {
+    numTiles = static_cast<vtkIdType>(std::max(1u, std::thread::hardware_concurrency()));
+  }
+  numTiles = std::max<vtkIdType>(1, std::min(numTiles, numUnits));
+
+  this->TileBuffers.resize(static_cast<size_t>(numTiles));
+  if (useMask)
+  {
+    this->MaskBuffers.resize(static_cast<size_t>(numTiles));
+  }
+  std::vector<int> compressedSizes(static_cast<size_t>(numTiles), 0);
+  std::vector<vtkIdType> tileStart(static_cast<size_t>(numTiles) + 1);
+  for (vtkIdType tile = 0; tile <= numTiles; ++tile)
+  {
+    tileStart[tile] = (numUnits * tile / numTiles) * unit;
+  }
+  // Any tuples left over when the input is not a multiple of the row size
+  // go into the last tile.
+  tileStart[numTiles] = numTuples;
+
+  const unsigned char* inPtr = input->GetPointer(0);
+  vtkSMPTools::For(0, numTiles, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType tile = begin; tile < end; ++tile)
+    {
+      const vtkIdType tupleCount = tileStart[tile + 1] - tileStart[tile];
+      const int tileSize = static_cast<int>(tupleCount * numComps);
+      const char* source = reinterpret_cast<const char*>(inPtr + tileStart[tile] * numComps);
+      if (useMask)
+      {
+        std::vector<unsigned int>& masked = this->MaskBuffers[tile];
+        masked.resize(static_cast<size_t>(tupleCount));
+        const unsigned int* in = reinterpret_cast<const unsigned int*>(source);
+        for (vtkIdType cc = 0; cc < tupleCount; ++cc)
+        {
+          masked[cc] = in[cc] & compress_mask;
+        }
+        source = reinterpret_cast<const char*>(masked.data());
+      }
+
+      std::vector<char>& buffer = this->TileBuffers[tile];
+      const int maxOutputSize = LZ4_compressBound(tileSize);
+      buffer.resize(static_cast<size_t>(maxOutputSize));
+      compressedSizes[tile] =
+        LZ4_compress_fast(source, buffer.data(), tileSize, maxOutputSize, 16);
+    }
+  });
+
+  const vtkTypeUInt32 count = static_cast<vtkTypeUInt32>(numTiles);
+  std::vector<vtkTypeUInt32> header(1 + 2 * static_cast<size_t>(numTiles));
+  header[0] = count;
+  size_t totalSize = vtkTiledImageCompressorHeaderSize(count);
+  for (vtkIdType tile = 0; tile < numTiles; ++tile)
+  {
+    if (compressedSizes[tile] <= 0)
+    {
+      vtkErrorMacro("Failed to compress tile " << tile << ".");
+      return VTK_ERROR;
+    }
+    header[1 + 2 * tile] = static_cast<vtkTypeUInt32>(compressedSizes[tile]);
+    header[2 + 2 * tile] =
+      static_cast<vtkTypeUInt32>((tileStart[tile + 1] - tileStart[tile]) * numComps);
+    totalSize += static_cast<size_t>(compressedSizes[tile]);
+  }
+
+  this->Output->SetNumberOfComponents(1);
+  unsigned char* outPtr = this->Output->WritePointer(0, static_cast<vtkIdType>(totalSize));
+  this->Output->SetNumberOfTuples(static_cast<vtkIdType>(totalSize));
+  memcpy(outPtr, header.data(), vtkTiledImageCompressorHeaderSize(count));
+  outPtr += vtkTiledImageCompressorHeaderSize(count);
+  for (vtkIdType tile = 0; tile < numTiles; ++tile)
+  {
+    memcpy(outPtr, this->TileBuffers[tile].data(), static_cast<size_t>(compressedSizes[tile]));
+    outPtr += compressedSizes[tile];
+  }
+  return VTK_OK;
+}
+
+//----------------------------------------------------------------------------
+int vtkTiledImageCompressor::Decompress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot decompress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  const unsigned char* inPtr = this->Input->GetPointer(0);
+  const size_t inSize = static_cast<size_t>(
+    this->Input->GetNumberOfTuples() * this->Input->GetNumberOfComponents());
+  vtkTypeUInt32 count = 0;
+  if (inSize < sizeof(count))
+  {
+    vtkErrorMacro("Compressed stream is too short.");
+    return VTK_ERROR;
+  }
+  memcpy(&count, inPtr, sizeof(count));
+  const size_t headerSize = vtkTiledImageCompressorHeaderSize(count);
+  if (count == 0 || inSize < headerSize)
+  {
+    vtkErrorMacro("Invalid tile header in compressed stream.");
+    return VTK_ERROR;
+  }
+  std::vector<vtkTypeUInt32> header(1 + 2 * static_cast<size_t>(count));
+  memcpy(header.data(), inPtr, headerSize);
+
+  // Compute where each tile starts in both the compressed and the
+  // decompressed buffers.
+  std::vector<size_t> inOffsets(count);
+  std::vector<size_t> outOffsets(count);
+  size_t inOffset = headerSize;
+  size_t outOffset = 0;
+  for (vtkTypeUInt32 tile = 0; tile < count; ++tile)
+  {
+    inOffsets[tile] = inOffset;
+    outOffsets[tile] = outOffset;
+    inOffset += header[1 + 2 * tile];
+    outOffset += header[2 + 2 * tile];
+  }
+  const size_t maxDecompressedSize = static_cast<size_t>(
+    this->Output->GetNumberOfComponents() * this->Output->GetNumberOfTuples());
+  if (inOffset > inSize || outOffset > maxDecompressedSize)
+  {
+    vtkErrorMacro("Tile sizes do not match the compressed stream or the output.");
+    return VTK_ERROR;
+  }
+
+  unsigned char* outPtr = this->Output->GetPointer(0);
+  std::vector<unsigned char> status(count, 0);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(count), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType tile = begin; tile < end; ++tile)
+    {
+      const int rawSize = static_cast<int>(header[2 + 2 * tile]);
+      const int decompressedSize =
+        LZ4_decompress_safe(reinterpret_cast<const char*>(inPtr + inOffsets[tile]),
+          reinterpret_cast<char*>(outPtr + outOffsets[tile]),
+          static_cast<int>(header[1 + 2 * tile]), rawSize);
+      status[tile] = decompressedSize == rawSize ? 1 : 0;
+    }
+  });
+
+  return std::find(status.begin(), status.end(), 0) == status.end() ? VTK_OK : VTK_ERROR;
+}
+
+//-----------------------------------------------------------------------------
+void vtkTiledImageCompressor::SaveConfiguration(vtkMultiProcessStream* stream)
+{
+  this->Superclass::SaveConfiguration(stream);
+  *stream << this->Quality << this->NumberOfTiles;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkTiledImageCompressor::RestoreConfiguration(vtkMultiProcessStream* stream)
+{
+  if (this->Superclass::RestoreConfiguration(stream))
+  {
+    int quality, numberOfTiles;
+    *stream >> quality >> numberOfTiles;
+    this->SetQuality(quality);
+    this->SetNumberOfTiles(numberOfTiles);
+    return true;
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkTiledImageCompressor::SaveConfiguration()
+{
+  std::ostringstream oss;
+  oss << this->Superclass::SaveConfiguration() << " " << this->Quality << " "
+      << this->NumberOfTiles;
+  this->SetConfiguration(oss.str().c_str());
+  return this->Configuration;
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkTiledImageCompressor::RestoreConfiguration(const char* stream)
+{
+  stream = this->Superclass::RestoreConfiguration(stream);
+  if (stream)
+  {
+    std::istringstream iss(stream);
+    int quality = this->Quality;
+    int numberOfTiles = this->NumberOfTiles;
+    iss >> quality;
+    this->SetQuality(quality);
+    // The number of tiles is optional.
+    if (iss >> numberOfTiles)
+    {
+      this->SetNumberOfTiles(numberOfTiles);
+    }
+    const std::streamoff pos = iss.tellg();
+    return pos < 0 ? stream + strlen(stream) : stream + pos;
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkTiledImageCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Quality: " << this->Quality << endl;
+  os << indent << "NumberOfTiles: " << this->NumberOfTiles << endl;
+}
@@ -0,0 +1,114 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkTiledImageCompressor.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkTiledImageCompressor
+ * @brief   Image compressor/decompressor that compresses horizontal
+ * strips of the image concurrently using LZ4.
+ *
+ * vtkTiledImageCompressor splits the image into a number of strips (tiles)
+ * and compresses each one independently with LZ4 using vtkSMPTools. Since
+ * the tiles are independent, decompression is done concurrently as well.
+ * The compressed stream starts with a small header holding the number of
+ * tiles followed by the compressed and uncompressed size of each tile.
+ *
+ * Quality has the same meaning as for vtkLZ4Compressor. When the image
+ * resolution is known (see SetImageResolution), tiles are aligned on image
+ * rows.
+ *
+ * The configuration string is "vtkTiledImageCompressor <lossless> <quality>
+ * <number of tiles>".
+*/
+
+#ifndef vtkTiledImageCompressor_h
+#define vtkTiledImageCompressor_h
+
+#include "vtkImageCompressor.h"
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for exports
+
+#include <vector> // for std::vector
+
+class vtkMultiProcessStream;
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkTiledImageCompressor : public vtkImageCompressor
+{
+public:
+  static vtkTiledImageCompressor* New();
+  vtkTypeMacro(vtkTiledImageCompressor, vtkImageCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set the quality measure. The value can be between 0 and 5. 0 means preserve
+   * input image quality while 5 means improve compression at the cost of image
+   * quality. See vtkLZ4Compressor.
+   */
+  vtkSetClampMacro(Quality, int, 0, 5);
+  vtkGetMacro(Quality, int);
+  //@}
+
+  //@{
+  /**
+   * Set the number of tiles the image is split into when compressing. 0
+   * (default) means use one tile per hardware thread.
+   * Decompression always uses the number of tiles found in the compressed
+   * stream.
+   */
+  vtkSetClampMacro(NumberOfTiles, int, 0, 256);
+  vtkGetMacro(NumberOfTiles, int);
+  //@}
+
+  //@{
+  /**
+   * Compress/Decompress data array on the objects input with results
+   * in the objects output. See also Set/GetInput/Output.
+   */
+  int Compress() override;
+  int Decompress() override;
+  //@}
+
+  /**
+   * Communicates the next expected image resolution. Used to align tiles
+   * on image rows.
+   */
+  void SetImageResolution(int width, int height) override;
+
+  //@{
+  /**
+   * Serialize/Restore compressor configuration (but not the data) into the stream.
+   */
+  void SaveConfiguration(vtkMultiProcessStream* stream) override;
+  bool RestoreConfiguration(vtkMultiProcessStream* stream) override;
+  const char* SaveConfiguration() override;
+  const char* RestoreConfiguration(const char* stream) override;
+  //@}
+
+protected:
+  vtkTiledImageCompressor();
+  ~vtkTiledImageCompressor() override;
+
+  int Quality;
+  int NumberOfTiles;
+  int Width;
+
+private:
+  vtkTiledImageCompressor(const vtkTiledImageCompressor&) = delete;
+  void operator=(const vtkTiledImageCompressor&) = delete;
+
+  // Per tile scratch buffers reused between frames.
+  std::vector<std::vector<char> > TileBuffers;
+  std::vector<std::vector<unsigned int> > MaskBuffers;
+};
+
+#endif
@@ -0,0 +1,132 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestFileSeriesReaderPrefetch.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Steps through a file series with PrefetchNextTimeStep on, forward, backward
+// and out of order, and checks that the output matches the file of each time
+// step, including after the internal reader is modified.
+
+#include "vtkDoubleArray.h"
+#include "vtkFileSeriesReader.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+const int NumberOfFiles = 5;
+const vtkIdType NumberOfPoints = 1000;
+
+void WriteFile(const std::string& fname, int step)
+{
+  vtkNew<vtkPolyData> pd;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Step");
+  for (vtkIdType cc = 0; cc < NumberOfPoints; ++cc)
+  {
+    points->InsertNextPoint(cc, step, 0);
+    values->InsertNextValue(step * NumberOfPoints + cc);
+  }
+  pd->SetPoints(points);
+  pd->GetPointData()->AddArray(values);
+
+  vtkNew<vtkXMLPolyDataWriter> writer;
+  writer->SetFileName(fname.c_str());
+  writer->SetInputDataObject(pd);
+  writer->Write();
+}
+
+bool Validate(vtkFileSeriesReader* reader, int step, bool hasArray)
+{
+  reader->UpdateTimeStep(step);
+  vtkPolyData* pd = vtkPolyData::SafeDownCast(reader->GetOutputDataObject(0));
+  if (!pd || pd->GetNumberOfPoints() != NumberOfPoints)
+  {
+    vtkLogF(ERROR, "Wrong output for time step %d.", step);
+    return false;
+  }
+  vtkDataArray* values = pd->GetPointData()->GetArray("Step");
+  if ((values != nullptr) != hasArray)
+  {
+    vtkLogF(ERROR, "Array selection not honored for time step %d.", step);
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < NumberOfPoints; ++cc)
+  {
+    double pt[3];
+    pd->GetPoint(cc, pt);
+    if (pt[0] != cc || pt[1] != step ||
+      (values && values->GetTuple1(cc) != step * NumberOfPoints + cc))
+    {
+      vtkLogF(ERROR, "Wrong values for time step %d.", step);
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestFileSeriesReaderPrefetch(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string tname(tempDir);
+  delete[] tempDir;
+
+  vtkNew<vtkXMLPolyDataReader> xmlReader;
+  vtkNew<vtkFileSeriesReader> reader;
+  reader->SetReader(xmlReader);
+  reader->SetFileNameMethod("SetFileName");
+  reader->PrefetchNextTimeStepOn();
+  for (int cc = 0; cc < NumberOfFiles; ++cc)
+  {
+    std::ostringstream fname;
+    fname << tname << "/TestFileSeriesReaderPrefetch_" << cc << ".vtp";
+    WriteFile(fname.str(), cc);
+    reader->AddFileName(fname.str().c_str());
+  }
+
+  // forward, backward, then out of order so that the prefetched time step is
+  // not the one requested. Time step 3 is being prefetched after the last one.
+  std::vector<int> steps = { 0, 1, 2, 3, 4, 3, 2, 1, 0, 3, 1, 4, 1, 2 };
+  for (int step : steps)
+  {
+    if (!Validate(reader, step, true))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // the time step prefetched with the array enabled must not be used once the
+  // internal reader is modified.
+  reader->WaitForPrefetch();
+  xmlReader->SetPointArrayStatus("Step", 0);
+  for (int step : { 3, 2 })
+  {
+    if (!Validate(reader, step, false))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
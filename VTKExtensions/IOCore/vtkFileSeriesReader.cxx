@@ -27,12 +27,16 @@
 #include "vtkClientServerInterpreter.h"
 #include "vtkClientServerInterpreterInitializer.h"
 #include "vtkClientServerStream.h"
+#include "vtkCommand.h"
+#include "vtkDataObject.h"
 #include "vtkGenericDataObjectReader.h"
 #include "vtkInformation.h"
 #include "vtkInformationIntegerKey.h"
 #include "vtkInformationStringKey.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
@@ -45,10 +49,12 @@
 #define VTK_CREATE(type, name) vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
 #include <algorithm>
+#include <cstring>
 #include <ctype.h> // for isprint().
 #include <map>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "vtk_jsoncpp.h"
@@ -368,29 +374,63 @@ struct vtkFileSeriesReaderInternals
   std::vector<double> TimeValues;
   bool FileNameIsSet;
   vtkFileSeriesReaderTimeRanges* TimeRanges;
+
+  // Index of the file the current output was read from.
+  int OutputFileIndex;
+
+  // Read-ahead of the next time step, see PrefetchNextTimeStep.
+  std::thread PrefetchThread;
+  std::thread::id MainThreadId;
+  unsigned long PrefetchObserverIds[2];
+  bool PrefetchScheduled;
+  vtkSmartPointer<vtkInformation> PrefetchRequest;
+  vtkSmartPointer<vtkInformationVector> PrefetchOutputs;
+  int PrefetchFileIndex;
+  double PrefetchTime;
+  vtkMTimeType PrefetchMTime;
+  // Set by the prefetch thread.
+  int PrefetchStatus;
+  vtkMTimeType PrefetchReaderMTime;
+  // Index of the last time step read and the direction of the time steps
+  // requested so far (1 or -1).
+  int LastTimeIndex;
+  int Direction;
 };
 
 //=============================================================================
 vtkFileSeriesReader::vtkFileSeriesReader()
 {
+  // Allocated first since Modified() uses it.
+  this->Internal = new vtkFileSeriesReaderInternals;
   this->SetNumberOfInputPorts(0);
   this->SetNumberOfOutputPorts(1);
 
-  this->Internal = new vtkFileSeriesReaderInternals;
   this->Internal->FileNameIsSet = false;
   this->Internal->TimeRanges = new vtkFileSeriesReaderTimeRanges;
+  this->Internal->OutputFileIndex = -1;
+  this->Internal->PrefetchScheduled = false;
+  this->Internal->PrefetchFileIndex = -1;
+  this->Internal->PrefetchTime = 0.0;
+  this->Internal->PrefetchMTime = 0;
+  this->Internal->PrefetchStatus = 0;
+  this->Internal->PrefetchReaderMTime = 0;
+  this->Internal->LastTimeIndex = -1;
+  this->Internal->Direction = 1;
 
   this->UseMetaFile = 0;
   this->UseJsonMetaFile = false;
 
   this->IgnoreReaderTime = false;
+  this->PrefetchNextTimeStep = false;
 }
 
 //-----------------------------------------------------------------------------
 vtkFileSeriesReader::~vtkFileSeriesReader()
 {
+  this->WaitForPrefetch();
   delete this->Internal->TimeRanges;
   delete this->Internal;
+  this->Internal = nullptr;
 }
 
 //----------------------------------------------------------------------------
@@ -490,6 +530,19 @@ int vtkFileSeriesReader::CanReadFile(const char* filename)
 //----------------------------------------------------------------------------
 int vtkFileSeriesReader::ProcessRequest(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  // The reader cannot be used while it is prefetching a time step.
+  this->WaitForPrefetch();
+  const int retVal = this->ProcessRequestInternal(request, inputVector, outputVector);
+  // Only start reading the next time step once the MTime checks are done
+  // since the reader may modify itself while reading.
+  this->StartPrefetch();
+  return retVal;
+}
+
+//----------------------------------------------------------------------------
+int vtkFileSeriesReader::ProcessRequestInternal(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
   vtkEnsureMTime check(this);
 
@@ -704,17 +757,203 @@ int vtkFileSeriesReader::RequestData(
   vtkInformation* outInfo = outputVector->GetInformationObject(requestFromPort);
   this->Internal->TimeRanges->GetInputTimeInfo(this->_FileIndex, outInfo);
 
-  int retVal = this->Reader->ProcessRequest(request, inputVector, outputVector);
+  int retVal = 1;
+  if (!this->UsePrefetchedData(outInfo))
+  {
+    retVal = this->Reader->ProcessRequest(request, inputVector, outputVector);
+  }
+  this->Internal->OutputFileIndex = static_cast<int>(this->_FileIndex);
 
   if (this->GetNumberOfFileNames() > 0)
   {
     // Now restore the information.
     this->Internal->TimeRanges->GetAggregateTimeInfo(outInfo);
+
+    if (retVal && this->PrefetchNextTimeStep)
+    {
+      this->SchedulePrefetch(outInfo);
+    }
   }
 
   return retVal;
 }
 
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::SchedulePrefetch(vtkInformation* outInfo)
+{
+  vtkFileSeriesReaderInternals* internal = this->Internal;
+  if (this->GetNumberOfOutputPorts() != 1 ||
+    !outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()) ||
+    !outInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()) ||
+    !outInfo->Get(vtkDataObject::DATA_OBJECT()))
+  {
+    return;
+  }
+
+  // Parallel readers may communicate while reading, which cannot be done from
+  // a background thread.
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  if (controller && controller->GetNumberOfProcesses() > 1)
+  {
+    return;
+  }
+
+  // Find the time step that was just read and the one that is likely to be
+  // requested next.
+  const double* timeSteps = outInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  const int numTimeSteps = outInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  const double time = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+  int current = static_cast<int>(std::upper_bound(timeSteps, timeSteps + numTimeSteps, time) -
+                  timeSteps) - 1;
+  current = std::max(current, 0);
+  if (internal->LastTimeIndex >= 0 && current != internal->LastTimeIndex)
+  {
+    internal->Direction = current > internal->LastTimeIndex ? 1 : -1;
+  }
+  internal->LastTimeIndex = current;
+
+  const int next = current + internal->Direction;
+  if (next < 0 || next >= numTimeSteps)
+  {
+    return;
+  }
+  const double nextTime = timeSteps[next];
+  const int nextIndex = internal->TimeRanges->GetIndexForTime(nextTime);
+  if (nextIndex < 0 || nextIndex >= static_cast<int>(this->GetNumberOfFileNames()))
+  {
+    return;
+  }
+
+  // Changing the file name goes through the interpreter, so it is done here
+  // along with the RequestInformation pass. Only RequestData runs in the
+  // background.
+  this->RequestInformationForInput(nextIndex);
+
+  vtkNew<vtkInformation> info;
+  info->Copy(outInfo);
+  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  info->Set(vtkDataObject::DATA_OBJECT(),
+    vtkSmartPointer<vtkDataObject>::Take(output->NewInstance()).GetPointer());
+  info->Set(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(), nextTime);
+  info->Set(FILE_SERIES_CURRENT_FILE_NUMBER(), nextIndex);
+  internal->TimeRanges->GetInputTimeInfo(nextIndex, info);
+
+  internal->PrefetchOutputs = vtkSmartPointer<vtkInformationVector>::New();
+  internal->PrefetchOutputs->Append(info);
+  internal->PrefetchRequest = vtkSmartPointer<vtkInformation>::New();
+  internal->PrefetchRequest->Set(vtkDemandDrivenPipeline::REQUEST_DATA());
+  internal->PrefetchRequest->Set(vtkStreamingDemandDrivenPipeline::FROM_OUTPUT_PORT(), 0);
+  internal->PrefetchFileIndex = nextIndex;
+  internal->PrefetchTime = nextTime;
+  internal->PrefetchMTime = this->vtkObject::GetMTime();
+  internal->PrefetchStatus = 0;
+  internal->PrefetchScheduled = true;
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::StartPrefetch()
+{
+  vtkFileSeriesReaderInternals* internal = this->Internal;
+  if (!internal->PrefetchScheduled || !this->Reader)
+  {
+    return;
+  }
+  internal->PrefetchScheduled = false;
+
+  // Progress and messages of the reader are reported by observers that expect
+  // to be called from the main thread while a pipeline update is in progress.
+  internal->MainThreadId = std::this_thread::get_id();
+  internal->PrefetchObserverIds[0] = this->Reader->AddObserver(
+    vtkCommand::ProgressEvent, this, &vtkFileSeriesReader::SuppressPrefetchEvents, 1000.0f);
+  internal->PrefetchObserverIds[1] = this->Reader->AddObserver(
+    vtkCommand::MessageEvent, this, &vtkFileSeriesReader::SuppressPrefetchEvents, 1000.0f);
+
+  internal->PrefetchThread = std::thread([this, internal]() {
+    internal->PrefetchStatus = this->Reader->ProcessRequest(
+      internal->PrefetchRequest, nullptr, internal->PrefetchOutputs);
+    internal->PrefetchReaderMTime = this->Reader->GetMTime();
+  });
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::WaitForPrefetch()
+{
+  vtkFileSeriesReaderInternals* internal = this->Internal;
+  // Nothing to wait for when called while prefetching.
+  if (internal && internal->PrefetchThread.joinable() &&
+    internal->PrefetchThread.get_id() != std::this_thread::get_id())
+  {
+    internal->PrefetchThread.join();
+    this->Reader->RemoveObserver(internal->PrefetchObserverIds[0]);
+    this->Reader->RemoveObserver(internal->PrefetchObserverIds[1]);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::Modified()
+{
+  this->WaitForPrefetch();
+  this->Superclass::Modified();
+}
+
+//-----------------------------------------------------------------------------
+vtkMTimeType vtkFileSeriesReader::GetMTime()
+{
+  // This also includes the MTime of the internal reader.
+  this->WaitForPrefetch();
+  return this->Superclass::GetMTime();
+}
+
+//-----------------------------------------------------------------------------
+bool vtkFileSeriesReader::SuppressPrefetchEvents(vtkObject*, unsigned long, void*)
+{
+  return std::this_thread::get_id() != this->Internal->MainThreadId;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkFileSeriesReader::UsePrefetchedData(vtkInformation* outInfo)
+{
+  vtkFileSeriesReaderInternals* internal = this->Internal;
+  vtkSmartPointer<vtkInformationVector> outputs = internal->PrefetchOutputs;
+  internal->PrefetchOutputs = nullptr;
+  internal->PrefetchRequest = nullptr;
+  if (!outputs || !internal->PrefetchStatus)
+  {
+    return false;
+  }
+
+  // The prefetched data is only valid if neither this reader nor the internal
+  // one were modified since and if the same piece of the same time step is
+  // requested.
+  vtkInformation* info = outputs->GetInformationObject(0);
+  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  vtkDataObject* prefetched = info->Get(vtkDataObject::DATA_OBJECT());
+  if (internal->PrefetchFileIndex != this->_FileIndex ||
+    internal->PrefetchMTime != this->vtkObject::GetMTime() ||
+    internal->PrefetchReaderMTime != this->Reader->GetMTime() || !output || !prefetched ||
+    strcmp(output->GetClassName(), prefetched->GetClassName()) != 0 ||
+    !outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()) ||
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()) != internal->PrefetchTime)
+  {
+    return false;
+  }
+  vtkInformationIntegerKey* pieceKeys[] = {
+    vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(),
+    vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(),
+    vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS()
+  };
+  for (vtkInformationIntegerKey* key : pieceKeys)
+  {
+    if (outInfo->Has(key) != info->Has(key) || outInfo->Get(key) != info->Get(key))
+    {
+      return false;
+    }
+  }
+
+  output->ShallowCopy(prefetched);
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 int vtkFileSeriesReader::RequestInformationForInput(
   int index, vtkInformation* request, vtkInformationVector* outputVector)
@@ -950,6 +1189,11 @@ void vtkFileSeriesReader::UpdateMetaData()
 //-----------------------------------------------------------------------------
 const char* vtkFileSeriesReader::GetCurrentFileName()
 {
+  // The file name of the reader may already be set to the prefetched file.
+  if (this->Internal->OutputFileIndex >= 0)
+  {
+    return this->GetFileName(static_cast<unsigned int>(this->Internal->OutputFileIndex));
+  }
   return this->GetFileName(this->_FileIndex);
 }
 
@@ -962,6 +1206,7 @@ void vtkFileSeriesReader::PrintSelf(ostream& os, vtkIndent indent)
      << endl;
   os << indent << "UseMetaFile: " << this->UseMetaFile << endl;
   os << indent << "IgnoreReaderTime: " << this->IgnoreReaderTime << endl;
+  os << indent << "PrefetchNextTimeStep: " << this->PrefetchNextTimeStep << endl;
 }
 
 //-----------------------------------------------------------------------------
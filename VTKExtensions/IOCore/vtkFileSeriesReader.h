@@ -75,6 +75,13 @@
  * with SetMetaFileName in this case. Do not use the AddFileName() method when
  * using SetMetaFileName() as names set with AddFileName() will be ignored.
  *
+ * When PrefetchNextTimeStep is on, once a time step is read the next one, in
+ * the direction the time steps were last requested in, is read on a
+ * background thread while the current one is being processed and rendered.
+ * If that time step is requested next, its data is handed over without
+ * reading the file again. Prefetching is disabled when running with more
+ * than one process.
+ *
 */
 
 #ifndef vtkFileSeriesReader_h
@@ -153,6 +160,33 @@ public:
   vtkBooleanMacro(IgnoreReaderTime, bool);
   //@}
 
+  //@{
+  /**
+   * If true, read the next time step on a background thread after each time
+   * step is read. The internal reader must not be used directly while a time
+   * step is being prefetched, call WaitForPrefetch() first. False by default.
+   */
+  vtkGetMacro(PrefetchNextTimeStep, bool);
+  vtkSetMacro(PrefetchNextTimeStep, bool);
+  vtkBooleanMacro(PrefetchNextTimeStep, bool);
+  //@}
+
+  /**
+   * Waits for the time step being prefetched, if any, to be read. Pipeline
+   * requests, Modified() and GetMTime() call it. Code that sets properties
+   * on the internal reader or queries it directly must call it first, see
+   * vtkSIMetaReaderProxy.
+   */
+  void WaitForPrefetch();
+
+  //@{
+  /**
+   * Overridden to wait for the time step being prefetched, if any.
+   */
+  void Modified() override;
+  vtkMTimeType GetMTime() override;
+  //@}
+
   // Expose number of files, first filename and current file number as
   // information keys for potential use in the internal reader
   static vtkInformationIntegerKey* FILE_SERIES_NUMBER_OF_FILES();
@@ -232,6 +266,7 @@ protected:
   void CopyRealFileNamesFromFileNames();
 
   bool IgnoreReaderTime;
+  bool PrefetchNextTimeStep;
 
   int ChooseInput(vtkInformation*);
 
@@ -239,6 +274,22 @@ private:
   vtkFileSeriesReader(const vtkFileSeriesReader&) = delete;
   void operator=(const vtkFileSeriesReader&) = delete;
 
+  int ProcessRequestInternal(vtkInformation*, vtkInformationVector**, vtkInformationVector*);
+
+  //@{
+  /**
+   * Read-ahead of the next time step. SchedulePrefetch() prepares the request
+   * for the time step following the one described by outInfo, StartPrefetch()
+   * runs it on a background thread once the current pipeline request is done.
+   * UsePrefetchedData() copies
+   * the prefetched data to the output if it matches the request.
+   */
+  void SchedulePrefetch(vtkInformation* outInfo);
+  void StartPrefetch();
+  bool UsePrefetchedData(vtkInformation* outInfo);
+  bool SuppressPrefetchEvents(vtkObject*, unsigned long, void*);
+  //@}
+
   vtkFileSeriesReaderInternals* Internal;
 };
 
@@ -0,0 +1,259 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPEnSightGoldBinaryCollectiveReads.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reads an EnSight Gold binary dataset, and a file set it writes with a part
+// too small to be split between the processes, in parallel with
+// UseCollectiveReads off and on, and checks that each process gets the same
+// output. Then makes the case file unreadable on one process only, and checks
+// that all the processes fail instead of waiting for each other.
+
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPGenericEnSightReader.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+#include "vtksys/FStream.hxx"
+#include "vtksys/SystemTools.hxx"
+
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+const int NumberOfTimeSteps = 3;
+
+void WriteLine(std::ostream& os, const char* line)
+{
+  char buffer[80];
+  memset(buffer, 0, sizeof(buffer));
+  strncpy(buffer, line, sizeof(buffer) - 1);
+  os.write(buffer, sizeof(buffer));
+}
+
+void WriteInts(std::ostream& os, const std::vector<int>& values)
+{
+  os.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(int));
+}
+
+void WriteFloats(std::ostream& os, const std::vector<float>& values)
+{
+  os.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+}
+
+// Writes a file set of two parts made of points, of 24 and 1 points, with a
+// variable per node and one per element.
+void WriteFileSet(const std::string& dir)
+{
+  vtksys::ofstream caseFile((dir + "/fileset.case").c_str());
+  caseFile << "FORMAT\n"
+           << "type: ensight gold\n\n"
+           << "GEOMETRY\n"
+           << "model: 1 1 fileset.geo\n\n"
+           << "TIME\n"
+           << "time set: 1\n"
+           << "number of steps: " << NumberOfTimeSteps << "\n"
+           << "time values:";
+  for (int step = 0; step < NumberOfTimeSteps; ++step)
+  {
+    caseFile << " " << step;
+  }
+  caseFile << "\n\n"
+           << "FILE\n"
+           << "file set: 1\n"
+           << "number of steps: " << NumberOfTimeSteps << "\n\n"
+           << "VARIABLE\n"
+           << "scalar per node: 1 1 Temperature fileset.scl\n"
+           << "scalar per element: 1 1 Pressure fileset.esc\n";
+
+  const int numberOfPoints[2] = { 24, 1 };
+  vtksys::ofstream geoFile((dir + "/fileset.geo").c_str(), ios::out | ios::binary);
+  vtksys::ofstream sclFile((dir + "/fileset.scl").c_str(), ios::out | ios::binary);
+  vtksys::ofstream escFile((dir + "/fileset.esc").c_str(), ios::out | ios::binary);
+  WriteLine(geoFile, "C Binary");
+  for (int step = 0; step < NumberOfTimeSteps; ++step)
+  {
+    WriteLine(geoFile, "BEGIN TIME STEP");
+    WriteLine(geoFile, "file set geometry");
+    WriteLine(geoFile, "for the collective reads test");
+    WriteLine(geoFile, "node id off");
+    WriteLine(geoFile, "element id off");
+    WriteLine(sclFile, "BEGIN TIME STEP");
+    WriteLine(sclFile, "file set temperature");
+    WriteLine(escFile, "BEGIN TIME STEP");
+    WriteLine(escFile, "file set pressure");
+    for (int part = 0; part < 2; ++part)
+    {
+      const int numPts = numberOfPoints[part];
+      std::vector<float> x, y(numPts, static_cast<float>(part)), z(numPts, 0.f);
+      std::vector<float> temperature, pressure;
+      std::vector<int> ids;
+      for (int cc = 0; cc < numPts; ++cc)
+      {
+        x.push_back(static_cast<float>(cc + step));
+        ids.push_back(cc + 1);
+        temperature.push_back(static_cast<float>(100 * part + 10 * step + cc));
+        pressure.push_back(static_cast<float>(-100 * part - 10 * step - cc));
+      }
+      WriteLine(geoFile, "part");
+      WriteInts(geoFile, { part + 1 });
+      WriteLine(geoFile, "points");
+      WriteLine(geoFile, "coordinates");
+      WriteInts(geoFile, { numPts });
+      WriteFloats(geoFile, x);
+      WriteFloats(geoFile, y);
+      WriteFloats(geoFile, z);
+      WriteLine(geoFile, "point");
+      WriteInts(geoFile, { numPts });
+      WriteInts(geoFile, ids);
+
+      WriteLine(sclFile, "part");
+      WriteInts(sclFile, { part + 1 });
+      WriteLine(sclFile, "coordinates");
+      WriteFloats(sclFile, temperature);
+
+      WriteLine(escFile, "part");
+      WriteInts(escFile, { part + 1 });
+      WriteLine(escFile, "point");
+      WriteFloats(escFile, pressure);
+    }
+    WriteLine(geoFile, "END TIME STEP");
+    WriteLine(sclFile, "END TIME STEP");
+    WriteLine(escFile, "END TIME STEP");
+  }
+}
+
+// The ranges of the arrays of a block.
+void SummarizeArrays(vtkFieldData* fd, std::vector<double>& summary)
+{
+  summary.push_back(fd->GetNumberOfArrays());
+  for (int cc = 0; cc < fd->GetNumberOfArrays(); ++cc)
+  {
+    vtkDataArray* array = fd->GetArray(cc);
+    if (array && array->GetNumberOfTuples() > 0)
+    {
+      double range[2];
+      array->GetRange(range, -1);
+      summary.insert(summary.end(), range, range + 2);
+    }
+  }
+}
+
+// The number of points, cells and arrays of each block, their bounds and the
+// ranges of the arrays.
+std::vector<double> Summarize(vtkMultiBlockDataSet* mb)
+{
+  std::vector<double> summary;
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(mb->NewIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkDataSet* ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+    if (!ds)
+    {
+      continue;
+    }
+    summary.push_back(ds->GetNumberOfPoints());
+    summary.push_back(ds->GetNumberOfCells());
+    double bounds[6];
+    ds->GetBounds(bounds);
+    summary.insert(summary.end(), bounds, bounds + 6);
+    SummarizeArrays(ds->GetPointData(), summary);
+    SummarizeArrays(ds->GetCellData(), summary);
+  }
+  return summary;
+}
+
+bool Read(
+  const std::string& caseName, bool collective, double time, std::vector<double>& summary)
+{
+  vtkNew<vtkPGenericEnSightReader> reader;
+  reader->SetCaseFileName(caseName.c_str());
+  reader->SetUseCollectiveReads(collective);
+  reader->UpdateTimeStep(time);
+  vtkMultiBlockDataSet* mb = reader->GetOutput();
+  summary = mb ? Summarize(mb) : std::vector<double>();
+  return !summary.empty();
+}
+}
+
+int TestPEnSightGoldBinaryCollectiveReads(int argc, char* argv[])
+{
+  vtkMPIController* controller = vtkMPIController::New();
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+  const int rank = controller->GetLocalProcessId();
+
+  char* fname =
+    vtkTestUtilities::ExpandDataFileName(argc, argv, "Testing/Data/EnSight/TEST_bin.case");
+  const std::string caseName(fname);
+  delete[] fname;
+
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string dir = std::string(tempDir) + "/TestPEnSightGoldBinaryCollectiveReads";
+  delete[] tempDir;
+  if (rank == 0)
+  {
+    vtksys::SystemTools::RemoveADirectory(dir);
+    vtksys::SystemTools::MakeDirectory(dir);
+    WriteFileSet(dir);
+  }
+  controller->Barrier();
+
+  // every process must make the same reads, whatever their results. The
+  // last time step of the file set is read, so that its time steps and parts
+  // are indexed.
+  int success = 1;
+  for (const auto& dataset :
+    { std::make_pair(caseName, 0.0), std::make_pair(dir + "/fileset.case", 2.0) })
+  {
+    std::vector<double> expected, summary;
+    const bool readIndependently = Read(dataset.first, false, dataset.second, expected);
+    const bool readCollectively = Read(dataset.first, true, dataset.second, summary);
+    if (!readIndependently || !readCollectively || summary != expected)
+    {
+      vtkLogF(ERROR, "Collective reads of %s do not match independent reads on process %d.",
+        dataset.first.c_str(), rank);
+      success = 0;
+    }
+  }
+
+  // a case file missing on one process only must make all of them fail.
+  const std::string localCaseName = rank == 1 ? caseName + ".missing" : caseName;
+  vtkObject::GlobalWarningDisplayOff();
+  std::vector<double> summary;
+  if (controller->GetNumberOfProcesses() > 1 && Read(localCaseName, true, 0.0, summary))
+  {
+    vtkLogF(ERROR, "Process %d read a file another process could not.", rank);
+    success = 0;
+  }
+  vtkObject::GlobalWarningDisplayOn();
+
+  int allSucceeded = 0;
+  controller->AllReduce(&success, &allSucceeded, 1, vtkCommunicator::MIN_OP);
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  controller->Delete();
+  return allSucceeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
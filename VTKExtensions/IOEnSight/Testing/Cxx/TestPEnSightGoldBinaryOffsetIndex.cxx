@@ -0,0 +1,237 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPEnSightGoldBinaryOffsetIndex.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes an EnSight Gold binary file set, reads it with UseOffsetIndexFiles
+// on, which saves the offsets of its time steps, and of the parts of the
+// time steps of its variable, next to it, then reads it again with a new
+// reader that seeks with the saved offsets.
+
+#include "vtkDataArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPGenericEnSightReader.h"
+#include "vtkPointData.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include "vtksys/FStream.hxx"
+#include "vtksys/SystemTools.hxx"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+const int NumberOfTimeSteps = 4;
+const int NumberOfPoints = 10;
+
+void WriteLine(std::ostream& os, const char* line)
+{
+  char buffer[80];
+  memset(buffer, 0, sizeof(buffer));
+  strncpy(buffer, line, sizeof(buffer) - 1);
+  os.write(buffer, sizeof(buffer));
+}
+
+void WriteInts(std::ostream& os, const std::vector<int>& values)
+{
+  os.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(int));
+}
+
+void WriteFloats(std::ostream& os, const std::vector<float>& values)
+{
+  os.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+}
+
+// The value of the variable at a point for a time step.
+float Temperature(int point, int step)
+{
+  return static_cast<float>(10 * step + point);
+}
+
+// A single file holding every time step of a part made of points, whose x
+// coordinates are shifted by the time step, and another one holding a
+// variable for each time step.
+void WriteFileSet(const std::string& dir)
+{
+  vtksys::ofstream caseFile((dir + "/fileset.case").c_str());
+  caseFile << "FORMAT\n"
+           << "type: ensight gold\n\n"
+           << "GEOMETRY\n"
+           << "model: 1 1 fileset.geo\n\n"
+           << "TIME\n"
+           << "time set: 1\n"
+           << "number of steps: " << NumberOfTimeSteps << "\n"
+           << "time values:";
+  for (int step = 0; step < NumberOfTimeSteps; ++step)
+  {
+    caseFile << " " << step;
+  }
+  caseFile << "\n\n"
+           << "FILE\n"
+           << "file set: 1\n"
+           << "number of steps: " << NumberOfTimeSteps << "\n\n"
+           << "VARIABLE\n"
+           << "scalar per node: 1 1 Temperature fileset.scl\n";
+
+  vtksys::ofstream geoFile((dir + "/fileset.geo").c_str(), ios::out | ios::binary);
+  WriteLine(geoFile, "C Binary");
+  for (int step = 0; step < NumberOfTimeSteps; ++step)
+  {
+    WriteLine(geoFile, "BEGIN TIME STEP");
+    WriteLine(geoFile, "file set geometry");
+    WriteLine(geoFile, "for the offset index test");
+    WriteLine(geoFile, "node id off");
+    WriteLine(geoFile, "element id off");
+    WriteLine(geoFile, "part");
+    WriteInts(geoFile, { 1 });
+    WriteLine(geoFile, "points");
+    WriteLine(geoFile, "coordinates");
+    WriteInts(geoFile, { NumberOfPoints });
+    std::vector<float> x, zeros(NumberOfPoints, 0.f);
+    std::vector<int> ids;
+    for (int cc = 0; cc < NumberOfPoints; ++cc)
+    {
+      x.push_back(static_cast<float>(cc + step));
+      ids.push_back(cc + 1);
+    }
+    WriteFloats(geoFile, x);
+    WriteFloats(geoFile, zeros);
+    WriteFloats(geoFile, zeros);
+    WriteLine(geoFile, "point");
+    WriteInts(geoFile, { NumberOfPoints });
+    WriteInts(geoFile, ids);
+    WriteLine(geoFile, "END TIME STEP");
+  }
+
+  vtksys::ofstream sclFile((dir + "/fileset.scl").c_str(), ios::out | ios::binary);
+  for (int step = 0; step < NumberOfTimeSteps; ++step)
+  {
+    WriteLine(sclFile, "BEGIN TIME STEP");
+    WriteLine(sclFile, "file set temperature");
+    WriteLine(sclFile, "part");
+    WriteInts(sclFile, { 1 });
+    WriteLine(sclFile, "coordinates");
+    std::vector<float> temperature;
+    for (int cc = 0; cc < NumberOfPoints; ++cc)
+    {
+      temperature.push_back(Temperature(cc, step));
+    }
+    WriteFloats(sclFile, temperature);
+    WriteLine(sclFile, "END TIME STEP");
+  }
+}
+
+bool Validate(vtkPGenericEnSightReader* reader, int step)
+{
+  reader->UpdateTimeStep(step);
+  vtkMultiBlockDataSet* mb = reader->GetOutput();
+  vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(mb ? mb->GetBlock(0) : nullptr);
+  if (!ug || ug->GetNumberOfPoints() != NumberOfPoints)
+  {
+    std::cerr << "Wrong output for time step " << step << "." << std::endl;
+    return false;
+  }
+  vtkDataArray* temperature = ug->GetPointData()->GetArray("Temperature");
+  if (!temperature || temperature->GetNumberOfTuples() != NumberOfPoints)
+  {
+    std::cerr << "Missing variable for time step " << step << "." << std::endl;
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < NumberOfPoints; ++cc)
+  {
+    double pt[3];
+    ug->GetPoint(cc, pt);
+    if (pt[0] != cc + step)
+    {
+      std::cerr << "Wrong coordinates for time step " << step << "." << std::endl;
+      return false;
+    }
+    if (temperature->GetComponent(cc, 0) != Temperature(cc, step))
+    {
+      std::cerr << "Wrong variable for time step " << step << "." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Checks that the offset index of the variable lists the parts of a time
+// step.
+bool HasPartOffsets(const std::string& indexName)
+{
+  vtksys::ifstream index(indexName.c_str());
+  std::string word;
+  while (index >> word)
+  {
+    if (word == "parts")
+    {
+      return true;
+    }
+  }
+  return false;
+}
+}
+
+int TestPEnSightGoldBinaryOffsetIndex(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string dir = std::string(tempDir) + "/TestPEnSightGoldBinaryOffsetIndex";
+  delete[] tempDir;
+  vtksys::SystemTools::RemoveADirectory(dir);
+  vtksys::SystemTools::MakeDirectory(dir);
+  WriteFileSet(dir);
+  const std::string caseName = dir + "/fileset.case";
+  const std::string indexName = dir + "/fileset.geo.pvoffsets";
+  const std::string variableIndexName = dir + "/fileset.scl.pvoffsets";
+
+  // the last time step first, so that the whole file is scanned and indexed.
+  {
+    vtkNew<vtkPGenericEnSightReader> reader;
+    reader->SetCaseFileName(caseName.c_str());
+    reader->UseOffsetIndexFilesOn();
+    for (int step : { NumberOfTimeSteps - 1, 0, 1 })
+    {
+      if (!Validate(reader, step))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  if (!vtksys::SystemTools::FileExists(indexName))
+  {
+    std::cerr << "The offset index file was not written." << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (!HasPartOffsets(variableIndexName))
+  {
+    std::cerr << "The part offsets of the variable were not saved." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // a new reader seeks to each time step with the saved offsets.
+  vtkNew<vtkPGenericEnSightReader> reader;
+  reader->SetCaseFileName(caseName.c_str());
+  reader->UseOffsetIndexFilesOn();
+  for (int step : { 2, NumberOfTimeSteps - 1, 1, 0 })
+  {
+    if (!Validate(reader, step))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -7,6 +7,8 @@
 #include "vtkIdList.h"
 #include "vtkImageData.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
@@ -18,14 +20,319 @@
 #include "vtksys/FStream.hxx"
 #include "vtksys/SystemTools.hxx"
 
+#include <algorithm>
 #include <ctype.h>
+#include <istream>
+#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 vtkStandardNewMacro(vtkPEnSightGoldBinaryReader);
 
 // This is half the precision of an int.
 #define MAXIMUM_PART_ID 65536
 
+namespace
+{
+// Appended to the name of a data file to name its offset index file.
+const char* const OffsetIndexSuffix = ".pvoffsets";
+const char* const OffsetIndexSignature = "vtkPEnSightGoldBinaryReaderOffsets2";
+
+// Where the parts of each time step start, see PartOffsets.
+typedef std::map<int, std::vector<long> > PartOffsetsType;
+
+// Reads the time step and part offsets saved for a data file, if they were
+// saved for the same size and modification time.
+void ReadOffsetIndex(
+  const std::string& path, std::map<int, long>& offsets, PartOffsetsType& partOffsets)
+{
+  vtksys::ifstream index((path + OffsetIndexSuffix).c_str());
+  std::string signature;
+  unsigned long size = 0;
+  long modifiedTime = 0;
+  if (!(index >> signature >> size >> modifiedTime) || signature != OffsetIndexSignature ||
+    size != vtksys::SystemTools::FileLength(path) ||
+    modifiedTime != vtksys::SystemTools::ModifiedTime(path))
+  {
+    return;
+  }
+  // "step <time step> <offset>" and "parts <time step> <count> <offsets>..."
+  std::string kind;
+  int timeStep;
+  while (index >> kind >> timeStep)
+  {
+    if (kind == "step")
+    {
+      long offset;
+      if (!(index >> offset))
+      {
+        return;
+      }
+      offsets[timeStep] = offset;
+    }
+    else if (kind == "parts")
+    {
+      size_t count = 0;
+      index >> count;
+      std::vector<long> parts(count);
+      for (size_t cc = 0; cc < count; ++cc)
+      {
+        index >> parts[cc];
+      }
+      if (!index)
+      {
+        return;
+      }
+      partOffsets[timeStep] = parts;
+    }
+    else
+    {
+      return;
+    }
+  }
+}
+
+// Saves the time step and part offsets of a data file. Failing is not an
+// error, the directory of the data may not be writable.
+void WriteOffsetIndex(
+  const std::string& path, const std::map<int, long>& offsets, const PartOffsetsType& partOffsets)
+{
+  vtksys::ofstream index((path + OffsetIndexSuffix).c_str());
+  if (!index)
+  {
+    return;
+  }
+  index << OffsetIndexSignature << " " << vtksys::SystemTools::FileLength(path) << " "
+        << vtksys::SystemTools::ModifiedTime(path) << "\n";
+  for (const auto& offset : offsets)
+  {
+    index << "step " << offset.first << " " << offset.second << "\n";
+  }
+  for (const auto& parts : partOffsets)
+  {
+    index << "parts " << parts.first << " " << parts.second.size();
+    for (long offset : parts.second)
+    {
+      index << " " << offset;
+    }
+    index << "\n";
+  }
+}
+
+void SerializePartOffsets(const std::vector<long>& offsets, vtkMultiProcessStream& stream)
+{
+  stream << static_cast<int>(offsets.size());
+  for (long offset : offsets)
+  {
+    stream << static_cast<vtkTypeInt64>(offset);
+  }
+}
+
+void SerializeOffsets(const std::map<int, long>& offsets, const PartOffsetsType& partOffsets,
+  vtkMultiProcessStream& stream)
+{
+  stream << static_cast<int>(offsets.size());
+  for (const auto& offset : offsets)
+  {
+    stream << offset.first << static_cast<vtkTypeInt64>(offset.second);
+  }
+  stream << static_cast<int>(partOffsets.size());
+  for (const auto& parts : partOffsets)
+  {
+    stream << parts.first;
+    SerializePartOffsets(parts.second, stream);
+  }
+}
+
+// An input stream over the ranges of a file process 0 sent, see
+// vtkPEnSightGoldBinaryReader::ShareFileRange(). Positions are those of the
+// file, reading outside of the ranges fails as at the end of the file.
+class vtkPEnSightWindowStream : public std::istream
+{
+public:
+  explicit vtkPEnSightWindowStream(long fileSize)
+    : std::istream(nullptr)
+    , Buffer(fileSize)
+  {
+    this->init(&this->Buffer);
+  }
+
+  // Replaces the ranges with the one starting at begin.
+  void SetRange(long begin, std::vector<char>&& data)
+  {
+    this->Buffer.AddRange(begin, std::move(data), true);
+  }
+
+  // Adds a range to the ones already there.
+  void AddRange(long begin, std::vector<char>&& data)
+  {
+    this->Buffer.AddRange(begin, std::move(data), false);
+  }
+
+private:
+  class WindowBuffer : public std::streambuf
+  {
+  public:
+    explicit WindowBuffer(long size)
+      : Size(size)
+      , Base(0)
+      , Empty(0)
+    {
+      this->SetPosition(0);
+    }
+
+    void AddRange(long begin, std::vector<char>&& data, bool replace)
+    {
+      const long position = this->GetPosition();
+      if (replace)
+      {
+        this->Ranges.clear();
+      }
+      this->Ranges[begin] = std::move(data);
+      this->SetPosition(position);
+    }
+
+  protected:
+    int_type underflow() override
+    {
+      // moves on to the range that follows, if any.
+      this->SetPosition(this->GetPosition());
+      if (this->gptr() == this->egptr())
+      {
+        return traits_type::eof();
+      }
+      return traits_type::to_int_type(*this->gptr());
+    }
+
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+      std::ios_base::openmode which = std::ios_base::in) override
+    {
+      off_type position = off;
+      if (dir == std::ios_base::cur)
+      {
+        position += this->GetPosition();
+      }
+      else if (dir == std::ios_base::end)
+      {
+        position += this->Size;
+      }
+      if (!(which & std::ios_base::in) || position < 0 || position > this->Size)
+      {
+        return pos_type(off_type(-1));
+      }
+      this->SetPosition(static_cast<long>(position));
+      return pos_type(position);
+    }
+
+    pos_type seekpos(
+      pos_type position, std::ios_base::openmode which = std::ios_base::in) override
+    {
+      return this->seekoff(off_type(position), std::ios_base::beg, which);
+    }
+
+  private:
+    long GetPosition() const
+    {
+      return this->Base + static_cast<long>(this->gptr() - this->eback());
+    }
+
+    // Points the get area at the range holding position, or leaves it empty.
+    void SetPosition(long position)
+    {
+      std::map<long, std::vector<char> >::iterator range = this->Ranges.upper_bound(position);
+      if (range != this->Ranges.begin())
+      {
+        --range;
+        const long size = static_cast<long>(range->second.size());
+        if (position < range->first + size)
+        {
+          char* data = range->second.data();
+          this->Base = range->first;
+          this->setg(data, data + (position - range->first), data + size);
+          return;
+        }
+      }
+      this->Base = position;
+      this->setg(&this->Empty, &this->Empty, &this->Empty);
+    }
+
+    std::map<long, std::vector<char> > Ranges;
+    long Size;
+    // The position in the file of the start of the get area.
+    long Base;
+    char Empty;
+  };
+
+  WindowBuffer Buffer;
+};
+
+// MPI counts are ints, larger ranges are sent in chunks.
+const vtkIdType ChunkSize = 1 << 30;
+const int FileRangeTag = 48731;
+
+void BroadcastChunks(vtkMultiProcessController* controller, std::vector<char>& data)
+{
+  const vtkIdType size = static_cast<vtkIdType>(data.size());
+  for (vtkIdType offset = 0; offset < size; offset += ChunkSize)
+  {
+    controller->Broadcast(data.data() + offset, std::min(ChunkSize, size - offset), 0);
+  }
+}
+
+void SendChunks(
+  vtkMultiProcessController* controller, const char* data, vtkIdType size, int remote)
+{
+  for (vtkIdType offset = 0; offset < size; offset += ChunkSize)
+  {
+    controller->Send(data + offset, std::min(ChunkSize, size - offset), remote, FileRangeTag);
+  }
+}
+
+void ReceiveChunks(vtkMultiProcessController* controller, std::vector<char>& data)
+{
+  const vtkIdType size = static_cast<vtkIdType>(data.size());
+  for (vtkIdType offset = 0; offset < size; offset += ChunkSize)
+  {
+    controller->Receive(data.data() + offset, std::min(ChunkSize, size - offset), 0, FileRangeTag);
+  }
+}
+
+void DeserializePartOffsets(vtkMultiProcessStream& stream, std::vector<long>& offsets)
+{
+  int count = 0;
+  stream >> count;
+  offsets.resize(count);
+  for (int cc = 0; cc < count; ++cc)
+  {
+    vtkTypeInt64 offset;
+    stream >> offset;
+    offsets[cc] = static_cast<long>(offset);
+  }
+}
+
+void DeserializeOffsets(
+  vtkMultiProcessStream& stream, std::map<int, long>& offsets, PartOffsetsType& partOffsets)
+{
+  int count = 0;
+  stream >> count;
+  for (int cc = 0; cc < count; ++cc)
+  {
+    int timeStep;
+    vtkTypeInt64 offset;
+    stream >> timeStep >> offset;
+    offsets[timeStep] = static_cast<long>(offset);
+  }
+  stream >> count;
+  for (int cc = 0; cc < count; ++cc)
+  {
+    int timeStep;
+    stream >> timeStep;
+    DeserializePartOffsets(stream, partOffsets[timeStep]);
+  }
+}
+}
+
 //----------------------------------------------------------------------------
 vtkPEnSightGoldBinaryReader::vtkPEnSightGoldBinaryReader()
 {
@@ -44,6 +351,7 @@ vtkPEnSightGoldBinaryReader::vtkPEnSightGoldBinaryReader()
   this->FloatBufferIndexBegin = -1;
   this->FloatBufferFilePosition = 0;
   this->FloatBufferNumberOfVectors = 0;
+  this->CurrentPartsType = GEOMETRY_PARTS;
 }
 
 //----------------------------------------------------------------------------
@@ -58,6 +366,13 @@ vtkPEnSightGoldBinaryReader::~vtkPEnSightGoldBinaryReader()
 
 //----------------------------------------------------------------------------
 int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
+{
+  return this->AllProcessesSucceeded(
+    this->OpenFileInternal(filename), this->CollectiveFileAccess());
+}
+
+//----------------------------------------------------------------------------
+int vtkPEnSightGoldBinaryReader::OpenFileInternal(const char* filename)
 {
   if (!filename)
   {
@@ -68,11 +383,20 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
   // Close file from any previous image
   delete this->IFile;
   this->IFile = NULL;
+  this->CurrentPartOffsets.clear();
 
   // Open the new file
   vtkDebugMacro(<< "Opening file " << filename);
   vtksys::SystemTools::Stat_t fs;
-  if (!vtksys::SystemTools::Stat(filename, &fs))
+  if (this->ReadsCollectively())
+  {
+    if (!this->OpenFileCollectively(filename))
+    {
+      vtkErrorMacro(<< "Could not read file " << filename);
+      return 0;
+    }
+  }
+  else if (!vtksys::SystemTools::Stat(filename, &fs))
   {
     // Find out how big the file is.
     this->FileSize = (long)(fs.st_size);
@@ -159,17 +483,589 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
 }
 
 //----------------------------------------------------------------------------
-int vtkPEnSightGoldBinaryReader::InitializeFile(const char* fileName)
+bool vtkPEnSightGoldBinaryReader::ReadsCollectively()
+{
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  return this->UseCollectiveReads && controller && controller->GetNumberOfProcesses() > 1;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPEnSightGoldBinaryReader::OpenFileCollectively(const char* filename)
+{
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  const bool root = controller->GetLocalProcessId() == 0;
+
+  // only process 0 opens the file, -1 means it failed.
+  vtkTypeInt64 size = -1;
+  vtksys::SystemTools::Stat_t fs;
+  if (root && !vtksys::SystemTools::Stat(filename, &fs))
+  {
+    this->IFile = new vtksys::ifstream(filename, ios::in | ios::binary);
+    if (!this->IFile->fail())
+    {
+      size = static_cast<vtkTypeInt64>(fs.st_size);
+    }
+  }
+  controller->Broadcast(&size, 1, 0);
+  if (size < 0)
+  {
+    return false;
+  }
+  this->FileSize = static_cast<long>(size);
+  if (!root)
+  {
+    this->IFile = new vtkPEnSightWindowStream(this->FileSize);
+  }
+
+  // the first line, which tells whether the file was written by Fortran.
+  this->ShareFileRange(0, std::min(this->FileSize, 88L));
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPEnSightGoldBinaryReader::ShareFileRange(long begin, long end)
+{
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  std::vector<char> data(static_cast<size_t>(std::max(end - begin, 0L)));
+  if (controller->GetLocalProcessId() == 0)
+  {
+    this->ReadFileRange(begin, data);
+  }
+  BroadcastChunks(controller, data);
+  vtkPEnSightWindowStream* window = dynamic_cast<vtkPEnSightWindowStream*>(this->IFile);
+  if (window)
+  {
+    window->SetRange(begin, std::move(data));
+    window->clear();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPEnSightGoldBinaryReader::ReadFileRange(long begin, std::vector<char>& data)
+{
+  const long position = this->IFile->tellg();
+  this->IFile->seekg(begin, ios::beg);
+  this->IFile->read(data.data(), static_cast<std::streamsize>(data.size()));
+  this->IFile->clear();
+  this->IFile->seekg(position, ios::beg);
+}
+
+//----------------------------------------------------------------------------
+void vtkPEnSightGoldBinaryReader::SharePart()
+{
+  if (this->CurrentPartOffsets.empty() || !this->ReadsCollectively())
+  {
+    return;
+  }
+
+  // the "part" line was just read, the processes are all at the same place.
+  const long lineSize = this->Fortran ? 88 : 80;
+  const long start = static_cast<long>(this->IFile->tellg()) - lineSize;
+  std::vector<long>::const_iterator part = std::lower_bound(
+    this->CurrentPartOffsets.begin(), this->CurrentPartOffsets.end(), start);
+  if (part == this->CurrentPartOffsets.end() || *part != start ||
+    part + 1 == this->CurrentPartOffsets.end())
+  {
+    return;
+  }
+  // the part, and the line that follows it.
+  const long next = *(part + 1);
+  const long end = std::min(next + lineSize, this->FileSize);
+  if (this->CurrentPartsType == GEOMETRY_PARTS)
+  {
+    // each process keeps a share of the cells of every part.
+    this->ShareFileRange(start, end);
+    return;
+  }
+
+  // the processes that hold no piece of the part only read its id and the
+  // line after it before they seek to the next one.
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  const int numProcs = controller->GetNumberOfProcesses();
+  const long headerEnd = std::min(next, start + 2 * lineSize + (this->Fortran ? 12 : 4));
+  this->ShareFileRange(start, headerEnd);
+  int partId = 0;
+  this->ReadPartId(&partId);
+  this->IFile->seekg(start + lineSize, ios::beg);
+  const int realId = this->InsertNewPartId(partId - 1); // EnSight starts #ing with 1.
+  int needed = this->CurrentPartsType == NODE_PARTS
+    ? this->GetPointIds(realId)->GetLocalNumberOfIds() > 0
+    : this->GetLocalTotalNumberOfCellIds(realId) > 0;
+  std::vector<int> needs(numProcs);
+  controller->AllGather(&needed, needs.data(), 1);
+  if (std::find(needs.begin(), needs.end(), 0) == needs.end())
+  {
+    this->ShareFileRange(start, end);
+    return;
+  }
+
+  // process 0 sends each process the part or the line after it.
+  vtkPEnSightWindowStream* window = dynamic_cast<vtkPEnSightWindowStream*>(this->IFile);
+  if (controller->GetLocalProcessId() == 0)
+  {
+    std::vector<char> data(static_cast<size_t>(end - start));
+    this->ReadFileRange(start, data);
+    for (int proc = 1; proc < numProcs; ++proc)
+    {
+      const long begin = needs[proc] ? start : next;
+      SendChunks(controller, data.data() + (begin - start), end - begin, proc);
+    }
+  }
+  else if (window)
+  {
+    std::vector<char> data(static_cast<size_t>(end - (needed ? start : next)));
+    ReceiveChunks(controller, data);
+    if (needed)
+    {
+      window->SetRange(start, std::move(data));
+    }
+    else
+    {
+      window->AddRange(next, std::move(data));
+    }
+    window->clear();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkPEnSightGoldBinaryReader::InitializeFile(const char* fileName)
+{
+  // Initialize
+  //
+  if (!fileName)
+  {
+    vtkErrorMacro("A GeometryFileName must be specified in the case file.");
+    return 0;
+  }
+  std::string sfilename;
+  if (this->FilePath)
+  {
+    sfilename = this->FilePath;
+    if (sfilename.at(sfilename.length() - 1) != '/')
+    {
+      sfilename += "/";
+    }
+    sfilename += fileName;
+    vtkDebugMacro("full path to geometry file: " << sfilename.c_str());
+  }
+  else
+  {
+    sfilename = fileName;
+  }
+
+  if (this->OpenFile(sfilename.c_str()) == 0)
+  {
+    vtkErrorMacro("Unable to open file: " << sfilename.c_str());
+    return 0;
+  }
+
+  // the header is checked on each process, agree on the result before the
+  // callers go on with collective calls.
+  return this->AllProcessesSucceeded(this->CheckFileHeader(), this->CollectiveFileAccess());
+}
+
+//----------------------------------------------------------------------------
+int vtkPEnSightGoldBinaryReader::CheckFileHeader()
+{
+  char line[80], subLine[80];
+
+  line[0] = '\0';
+  subLine[0] = '\0';
+  if (this->ReadLine(line) == 0)
+  {
+    vtkErrorMacro("Error with line reading upon file initialization");
+    return 0;
+  }
+
+  if (sscanf(line, " %*s %s", subLine) != 1)
+  {
+    vtkErrorMacro("Error with subline extraction upon file initialization");
+    return 0;
+  }
+
+  if (strncmp(subLine, "Binary", 6) != 0 && strncmp(subLine, "binary", 6) != 0)
+  {
+    vtkErrorMacro("This is not a binary data set. Try "
+      << "vtkEnSightGoldReader.");
+    return 0;
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPEnSightGoldBinaryReader::LoadOffsetIndex(const char* fileName)
+{
+  if (!this->UseOffsetIndexFiles || !this->LoadedOffsetIndices.insert(fileName).second)
+  {
+    return;
+  }
+
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  const bool parallel = controller && controller->GetNumberOfProcesses() > 1;
+  const bool root = !parallel || controller->GetLocalProcessId() == 0;
+  std::map<int, long>& offsets = this->FileOffsets[fileName];
+  PartOffsetsType& partOffsets = this->PartOffsets[fileName];
+
+  vtkMultiProcessStream stream;
+  if (root)
+  {
+    ReadOffsetIndex(this->GetFullFileName(fileName), offsets, partOffsets);
+    SerializeOffsets(offsets, partOffsets, stream);
+  }
+  if (parallel)
+  {
+    controller->Broadcast(stream, 0);
+    if (!root)
+    {
+      DeserializeOffsets(stream, offsets, partOffsets);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkPEnSightGoldBinaryReader::SeekFileOffset(const char* fileName, int timeStep, bool& share)
+{
+  share = false;
+  if (timeStep <= 0)
+  {
+    // the first time step starts right after the header.
+    return 0;
+  }
+
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  const bool parallel = controller && controller->GetNumberOfProcesses() > 1;
+  const bool root = !parallel || controller->GetLocalProcessId() == 0;
+  std::map<int, long>& offsets = this->FileOffsets[fileName];
+  this->LoadOffsetIndex(fileName);
+
+  // the offsets are the same on all processes, so they all agree on whether
+  // process 0 has to scan the file.
+  std::map<int, long>::iterator iter = offsets.find(timeStep);
+  if (iter != offsets.end())
+  {
+    this->IFile->seekg(iter->second, ios::beg);
+    return timeStep;
+  }
+
+  share = true;
+  if (!root)
+  {
+    // positioned by ShareFileOffsets() once process 0 is done scanning.
+    return timeStep;
+  }
+  iter = offsets.lower_bound(timeStep);
+  if (iter == offsets.begin())
+  {
+    return 0;
+  }
+  --iter;
+  this->IFile->seekg(iter->second, ios::beg);
+  return iter->first;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPEnSightGoldBinaryReader::ShareFileOffsets(const char* fileName, int timeStep, bool share)
+{
+  if (!share)
+  {
+    return true;
+  }
+
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  const bool parallel = controller && controller->GetNumberOfProcesses() > 1;
+  const bool root = !parallel || controller->GetLocalProcessId() == 0;
+  std::map<int, long>& offsets = this->FileOffsets[fileName];
+  PartOffsetsType& partOffsets = this->PartOffsets[fileName];
+
+  if (root && this->UseOffsetIndexFiles)
+  {
+    WriteOffsetIndex(this->GetFullFileName(fileName), offsets, partOffsets);
+  }
+  if (parallel)
+  {
+    vtkMultiProcessStream stream;
+    if (root)
+    {
+      SerializeOffsets(offsets, partOffsets, stream);
+    }
+    controller->Broadcast(stream, 0);
+    if (!root)
+    {
+      DeserializeOffsets(stream, offsets, partOffsets);
+    }
+  }
+
+  std::map<int, long>::iterator iter = offsets.find(timeStep);
+  if (iter == offsets.end())
+  {
+    return false;
+  }
+  if (!root)
+  {
+    this->IFile->seekg(iter->second, ios::beg);
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPEnSightGoldBinaryReader::IndexParts(
+  const char* fileName, int timeStep, int partsType, int numberOfComponents)
+{
+  this->CurrentPartOffsets.clear();
+  this->CurrentPartsType = partsType;
+  const bool windows = this->ReadsCollectively();
+  if (!this->CollectiveFileAccess() ||
+    (!windows && partsType != NODE_PARTS && partsType != ELEMENT_PARTS))
+  {
+    return;
+  }
+  this->LoadOffsetIndex(fileName);
+
+  // the processes are all at the start of the time step, and the part
+  // offsets are the same on all of them, so they all agree on whether process
+  // 0 has to scan the time step.
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  const bool parallel = controller && controller->GetNumberOfProcesses() > 1;
+  const bool root = !parallel || controller->GetLocalProcessId() == 0;
+  const long start = this->IFile->tellg();
+  PartOffsetsType& partOffsets = this->PartOffsets[fileName];
+  PartOffsetsType::iterator iter = partOffsets.find(timeStep);
+  if (iter == partOffsets.end())
+  {
+    std::vector<long> offsets;
+    if (root)
+    {
+      if (!this->SkipParts(partsType, numberOfComponents, offsets))
+      {
+        offsets.clear();
+      }
+      this->IFile->clear();
+      this->IFile->seekg(start, ios::beg);
+    }
+    if (parallel)
+    {
+      vtkMultiProcessStream stream;
+      if (root)
+      {
+        SerializePartOffsets(offsets, stream);
+      }
+      controller->Broadcast(stream, 0);
+      if (!root)
+      {
+        DeserializePartOffsets(stream, offsets);
+      }
+    }
+    if (offsets.empty())
+    {
+      if (windows && !root)
+      {
+        // the other processes read the time step from the file themselves.
+        delete this->IFile;
+        this->IFile =
+          new vtksys::ifstream(this->GetFullFileName(fileName).c_str(), ios::in | ios::binary);
+        this->IFile->seekg(start, ios::beg);
+      }
+      return;
+    }
+
+    iter = partOffsets.insert(std::make_pair(timeStep, offsets)).first;
+    if (root && this->UseOffsetIndexFiles)
+    {
+      WriteOffsetIndex(
+        this->GetFullFileName(fileName), this->FileOffsets[fileName], partOffsets);
+    }
+  }
+  this->CurrentPartOffsets = iter->second;
+
+  if (windows)
+  {
+    // what comes before the first part, and its "part" line. SharePart()
+    // sends the parts.
+    const long lineSize = this->Fortran ? 88 : 80;
+    this->ShareFileRange(start, std::min(this->CurrentPartOffsets[0] + lineSize, this->FileSize));
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkPEnSightGoldBinaryReader::SkipParts(
+  int partsType, int numberOfComponents, std::vector<long>& partOffsets)
+{
+  char line[80];
+  line[0] = '\0';
+  if (this->UseFileSets)
+  {
+    while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
+    {
+      if (!this->ReadLine(line))
+      {
+        return 0;
+      }
+    }
+  }
+
+  int result;
+  switch (partsType)
+  {
+    case GEOMETRY_PARTS:
+      // the geometry is skipped without the Fortran record markers.
+      result = !this->Fortran && this->SkipGeometryParts(partOffsets) > 0;
+      break;
+    case MEASURED_GEOMETRY:
+    case MEASURED_NODES:
+      result = this->SkipMeasuredData(partsType, numberOfComponents, partOffsets);
+      break;
+    default:
+      result =
+        this->SkipVariableParts(numberOfComponents, partsType == ELEMENT_PARTS, partOffsets);
+      break;
+  }
+  if (!result || partOffsets.empty())
+  {
+    return 0;
+  }
+
+  // the last part must end with the time step or the file, anything else
+  // was not skipped.
+  if (partOffsets.back() == this->FileSize)
+  {
+    return 1;
+  }
+  this->IFile->clear();
+  this->IFile->seekg(partOffsets.back(), ios::beg);
+  return this->ReadLine(line) && strncmp(line, "END TIME STEP", 13) == 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkPEnSightGoldBinaryReader::SkipMeasuredData(
+  int partsType, int numberOfComponents, std::vector<long>& partOffsets)
+{
+  char line[80];
+  this->ReadLine(line); // skip the description line
+
+  vtkTypeInt64 dataSize = 0;
+  if (partsType == MEASURED_GEOMETRY)
+  {
+    // the coordinates are read without the Fortran record markers.
+    if (this->Fortran)
+    {
+      return 0;
+    }
+    this->ReadLine(line); // "particle coordinates"
+    int numPts;
+    if (!this->ReadInt(&numPts) || numPts < 0)
+    {
+      return 0;
+    }
+    // point ids and coordinates.
+    dataSize = (sizeof(int) + 3 * sizeof(float)) * static_cast<vtkTypeInt64>(numPts);
+  }
+  else
+  {
+    int partId = this->UnstructuredPartIds->IsId(this->NumberOfGeometryParts);
+    vtkTypeInt64 numPts = this->GetPointIds(partId)->GetNumberOfIds();
+    if (numPts)
+    {
+      // the values are a single array.
+      dataSize = numberOfComponents * sizeof(float) * numPts + (this->Fortran ? 8 : 0);
+    }
+  }
+  this->IFile->seekg(dataSize, ios::cur);
+
+  // there is no part, only where the data ends.
+  partOffsets.push_back(this->GetLastLineOffset(this->ReadLine(line)));
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPEnSightGoldBinaryReader::SkipVariableParts(
+  int numberOfComponents, int perElement, std::vector<long>& partOffsets)
+{
+  char line[80];
+  this->ReadLine(line); // skip the description line
+
+  // each component is an array of its own, between two record markers with
+  // Fortran.
+  const vtkTypeInt64 markers = this->Fortran ? 8 : 0;
+  int lineRead = this->ReadLine(line); // "part"
+  while (lineRead && strncmp(line, "part", 4) == 0)
+  {
+    partOffsets.push_back(this->GetLastLineOffset(lineRead));
+    int partId;
+    if (!this->ReadPartId(&partId))
+    {
+      return 0;
+    }
+    partId--; // EnSight starts #ing with 1.
+    int realId = this->InsertNewPartId(partId);
+    vtkTypeInt64 numValues = perElement ? this->GetTotalNumberOfCellIds(realId)
+                                        : this->GetPointIds(realId)->GetNumberOfIds();
+    if (numValues == 0)
+    {
+      lineRead = this->ReadLine(line);
+      continue;
+    }
+
+    lineRead = this->ReadLine(line); // "coordinates", "block" or element type
+    if (!perElement || strncmp(line, "block", 5) == 0)
+    {
+      this->IFile->seekg(
+        numberOfComponents * (static_cast<vtkTypeInt64>(sizeof(float)) * numValues + markers),
+        ios::cur);
+      lineRead = this->ReadLine(line);
+      continue;
+    }
+
+    int idx = this->UnstructuredPartIds->IsId(realId);
+    while (lineRead && strncmp(line, "part", 4) != 0 && strncmp(line, "END TIME STEP", 13) != 0)
+    {
+      int elementType = this->GetElementType(line);
+      if (elementType == -1)
+      {
+        vtkErrorMacro("Unknown element type \"" << line << "\"");
+        return 0;
+      }
+      numValues = this->GetCellIds(idx, elementType)->GetNumberOfIds();
+      this->IFile->seekg(
+        numberOfComponents * (static_cast<vtkTypeInt64>(sizeof(float)) * numValues + markers),
+        ios::cur);
+      lineRead = this->ReadLine(line);
+    }
+  }
+  partOffsets.push_back(this->GetLastLineOffset(lineRead));
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPEnSightGoldBinaryReader::SkipPart()
+{
+  if (this->CurrentPartOffsets.empty())
+  {
+    return 0;
+  }
+  const long position = this->IFile->tellg();
+  std::vector<long>::const_iterator next = std::upper_bound(
+    this->CurrentPartOffsets.begin(), this->CurrentPartOffsets.end(), position);
+  if (next == this->CurrentPartOffsets.end())
+  {
+    return 0;
+  }
+  this->IFile->seekg(*next, ios::beg);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+long vtkPEnSightGoldBinaryReader::GetLastLineOffset(int lineRead)
 {
-  char line[80], subLine[80];
-
-  // Initialize
-  //
-  if (!fileName)
+  if (!lineRead)
   {
-    vtkErrorMacro("A GeometryFileName must be specified in the case file.");
-    return 0;
+    return this->FileSize;
   }
+  return static_cast<long>(this->IFile->tellg()) - (this->Fortran ? 88 : 80);
+}
+
+//----------------------------------------------------------------------------
+std::string vtkPEnSightGoldBinaryReader::GetFullFileName(const char* fileName)
+{
   std::string sfilename;
   if (this->FilePath)
   {
@@ -178,41 +1074,8 @@ int vtkPEnSightGoldBinaryReader::InitializeFile(const char* fileName)
     {
       sfilename += "/";
     }
-    sfilename += fileName;
-    vtkDebugMacro("full path to geometry file: " << sfilename.c_str());
-  }
-  else
-  {
-    sfilename = fileName;
-  }
-
-  if (this->OpenFile(sfilename.c_str()) == 0)
-  {
-    vtkErrorMacro("Unable to open file: " << sfilename.c_str());
-    return 0;
   }
-
-  line[0] = '\0';
-  subLine[0] = '\0';
-  if (this->ReadLine(line) == 0)
-  {
-    vtkErrorMacro("Error with line reading upon file initialization");
-    return 0;
-  }
-
-  if (sscanf(line, " %*s %s", subLine) != 1)
-  {
-    vtkErrorMacro("Error with subline extraction upon file initialization");
-    return 0;
-  }
-
-  if (strncmp(subLine, "Binary", 6) != 0 && strncmp(subLine, "binary", 6) != 0)
-  {
-    vtkErrorMacro("This is not a binary data set. Try "
-      << "vtkEnSightGoldReader.");
-    return 0;
-  }
-  return 1;
+  return sfilename + fileName;
 }
 
 //----------------------------------------------------------------------------
@@ -221,7 +1084,7 @@ int vtkPEnSightGoldBinaryReader::ReadGeometryFile(
 {
   char line[80], subLine[80], nameline[80];
   int partId, realId;
-  int lineRead, i;
+  int lineRead;
 
   if (!this->InitializeFile(fileName))
   {
@@ -242,18 +1105,9 @@ int vtkPEnSightGoldBinaryReader::ReadGeometryFile(
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
-    int j = 0;
     // Try to find the nearest time step for which we know the offset
-    for (i = realTimeStep; i >= 0; i--)
-    {
-      if (this->FileOffsets.find(fileName) != this->FileOffsets.end() &&
-        this->FileOffsets[fileName].find(i) != this->FileOffsets[fileName].end())
-      {
-        this->IFile->seekg(this->FileOffsets[fileName][i], ios::beg);
-        j = i;
-        break;
-      }
-    }
+    bool shareOffsets = false;
+    int j = this->SeekFileOffset(fileName, realTimeStep, shareOffsets);
 
     // Hopefully we are not very far from the timestep we want to use
     // Find it (and cache any timestep we find on the way...)
@@ -261,24 +1115,28 @@ int vtkPEnSightGoldBinaryReader::ReadGeometryFile(
     {
       if (!this->SkipTimeStep())
       {
-        return 0;
-      }
-      else
-      {
-        if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
-        {
-          std::map<int, long> tsMap;
-          this->FileOffsets[fileName] = tsMap;
-        }
-        this->FileOffsets[fileName][j] = this->IFile->tellg();
+        break;
       }
+      this->FileOffsets[fileName][j] = this->IFile->tellg();
     }
+    if (!this->ShareFileOffsets(fileName, realTimeStep, shareOffsets))
+    {
+      vtkErrorMacro("Could not find time step " << timeStep << " in " << fileName);
+      delete this->IFile;
+      this->IFile = NULL;
+      return 0;
+    }
+    this->IndexParts(fileName, realTimeStep, GEOMETRY_PARTS);
 
     while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
     {
       this->ReadLine(line);
     }
   }
+  else
+  {
+    this->IndexParts(fileName, 0, GEOMETRY_PARTS);
+  }
 
   // Skip the 2 description lines.
   this->ReadLine(line);
@@ -325,6 +1183,7 @@ int vtkPEnSightGoldBinaryReader::ReadGeometryFile(
 
   while (lineRead > 0 && strncmp(line, "part", 4) == 0)
   {
+    this->SharePart();
     this->ReadPartId(&partId);
     partId--; // EnSight starts #ing at 1.
     if (partId < 0 || partId >= MAXIMUM_PART_ID)
@@ -424,8 +1283,7 @@ int vtkPEnSightGoldBinaryReader::CountTimeSteps()
 //----------------------------------------------------------------------------
 int vtkPEnSightGoldBinaryReader::SkipTimeStep()
 {
-  char line[80], subLine[80];
-  int lineRead;
+  char line[80];
 
   line[0] = '\0';
   while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
@@ -436,6 +1294,24 @@ int vtkPEnSightGoldBinaryReader::SkipTimeStep()
     }
   }
 
+  std::vector<long> partOffsets;
+  int result = this->SkipGeometryParts(partOffsets);
+  if (result < 0)
+  {
+    delete this->IFile;
+    this->IFile = NULL;
+    return 0;
+  }
+
+  return result;
+}
+
+//----------------------------------------------------------------------------
+int vtkPEnSightGoldBinaryReader::SkipGeometryParts(std::vector<long>& partOffsets)
+{
+  char line[80], subLine[80];
+  int lineRead;
+
   // Skip the 2 description lines.
   this->ReadLine(line);
   this->ReadLine(line);
@@ -477,6 +1353,7 @@ int vtkPEnSightGoldBinaryReader::SkipTimeStep()
 
   while (lineRead > 0 && strncmp(line, "part", 4) == 0)
   {
+    partOffsets.push_back(this->GetLastLineOffset(lineRead));
     int tmpInt;
     this->ReadPartId(&tmpInt);
     if (tmpInt < 0 || tmpInt > MAXIMUM_PART_ID)
@@ -521,10 +1398,9 @@ int vtkPEnSightGoldBinaryReader::SkipTimeStep()
 
   if (lineRead < 0)
   {
-    delete this->IFile;
-    this->IFile = NULL;
-    return 0;
+    return -1;
   }
+  partOffsets.push_back(this->GetLastLineOffset(lineRead));
 
   return 1;
 }
@@ -1121,18 +1997,9 @@ int vtkPEnSightGoldBinaryReader::ReadMeasuredGeometryFile(
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
-    int k, j = 0;
     // Try to find the nearest time step for which we know the offset
-    for (k = realTimeStep; k >= 0; k--)
-    {
-      if (this->FileOffsets.find(fileName) != this->FileOffsets.end() &&
-        this->FileOffsets[fileName].find(k) != this->FileOffsets[fileName].end())
-      {
-        this->IFile->seekg(this->FileOffsets[fileName][k], ios::beg);
-        j = k;
-        break;
-      }
-    }
+    bool shareOffsets = false;
+    int j = this->SeekFileOffset(fileName, realTimeStep, shareOffsets);
 
     // Hopefully we are not very far from the timestep we want to use
     // Find it (and cache any timestep we find on the way...)
@@ -1160,18 +2027,25 @@ int vtkPEnSightGoldBinaryReader::ReadMeasuredGeometryFile(
       this->IFile->seekg(
         (sizeof(float) * 3 + sizeof(int)) * this->NumberOfMeasuredPoints, ios::cur);
       this->ReadLine(line); // END TIME STEP
-      if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
-      {
-        std::map<int, long> tsMap;
-        this->FileOffsets[fileName] = tsMap;
-      }
       this->FileOffsets[fileName][j] = this->IFile->tellg();
     }
+    if (!this->ShareFileOffsets(fileName, realTimeStep, shareOffsets))
+    {
+      vtkErrorMacro("Could not find time step " << timeStep << " in " << fileName);
+      points->Delete();
+      pd->Delete();
+      return 0;
+    }
+    this->IndexParts(fileName, realTimeStep, MEASURED_GEOMETRY);
     while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
     {
       this->ReadLine(line);
     }
   }
+  else
+  {
+    this->IndexParts(fileName, 0, MEASURED_GEOMETRY);
+  }
 
   // Skip the description line.
   this->ReadLine(line);
@@ -1309,17 +2183,8 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
   {
     int realTimeStep = timeStep - 1;
     // Try to find the nearest time step for which we know the offset
-    int j = 0;
-    for (i = realTimeStep; i >= 0; i--)
-    {
-      if (this->FileOffsets.find(fileName) != this->FileOffsets.end() &&
-        this->FileOffsets[fileName].find(i) != this->FileOffsets[fileName].end())
-      {
-        this->IFile->seekg(this->FileOffsets[fileName][i], ios::beg);
-        j = i;
-        break;
-      }
-    }
+    bool shareOffsets = false;
+    int j = this->SeekFileOffset(fileName, realTimeStep, shareOffsets);
 
     // Hopefully we are not very far from the timestep we want to use
     // Find it (and cache any timestep we find on the way...)
@@ -1359,13 +2224,14 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
           this->IFile->seekg(sizeof(float) * numPts, ios::cur);
         }
       }
-      if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
-      {
-        std::map<int, long> tsMap;
-        this->FileOffsets[fileName] = tsMap;
-      }
       this->FileOffsets[fileName][j] = this->IFile->tellg();
     }
+    if (!this->ShareFileOffsets(fileName, realTimeStep, shareOffsets))
+    {
+      vtkErrorMacro("Could not find time step " << timeStep << " in " << fileName);
+      return 0;
+    }
+    this->IndexParts(fileName, realTimeStep, measured ? MEASURED_NODES : NODE_PARTS);
 
     this->ReadLine(line);
     while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
@@ -1373,6 +2239,10 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
       this->ReadLine(line);
     }
   }
+  else
+  {
+    this->IndexParts(fileName, 0, measured ? MEASURED_NODES : NODE_PARTS);
+  }
 
   this->ReadLine(line); // skip the description line
 
@@ -1420,6 +2290,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
   lineRead = this->ReadLine(line);
   while (lineRead && strncmp(line, "part", 4) == 0)
   {
+    this->SharePart();
     this->ReadPartId(&partId);
     partId--; // EnSight starts #ing with 1.
     realId = this->InsertNewPartId(partId);
@@ -1441,13 +2312,18 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
         scalars = (vtkFloatArray*)(output->GetPointData()->GetArray(description));
       }
 
-      scalarsRead = new float[numPts];
-      this->ReadFloatArray(scalarsRead, numPts);
-
-      for (i = 0; i < numPts; i++)
+      // a process that has no point of the part seeks straight to the next one.
+      if (this->GetPointIds(realId)->GetLocalNumberOfIds() > 0 || !this->SkipPart())
       {
-        this->InsertVariableComponent(
-          scalars, i, component, &(scalarsRead[i]), realId, 0, SCALAR_PER_NODE);
+        scalarsRead = new float[numPts];
+        this->ReadFloatArray(scalarsRead, numPts);
+
+        for (i = 0; i < numPts; i++)
+        {
+          this->InsertVariableComponent(
+            scalars, i, component, &(scalarsRead[i]), realId, 0, SCALAR_PER_NODE);
+        }
+        delete[] scalarsRead;
       }
       if (component == 0)
       {
@@ -1463,7 +2339,6 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
       {
         output->GetPointData()->AddArray(scalars);
       }
-      delete[] scalarsRead;
     }
 
     this->IFile->peek();
@@ -1526,17 +2401,8 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
   {
     int realTimeStep = timeStep - 1;
     // Try to find the nearest time step for which we know the offset
-    int j = 0;
-    for (i = realTimeStep; i >= 0; i--)
-    {
-      if (this->FileOffsets.find(fileName) != this->FileOffsets.end() &&
-        this->FileOffsets[fileName].find(i) != this->FileOffsets[fileName].end())
-      {
-        this->IFile->seekg(this->FileOffsets[fileName][i], ios::beg);
-        j = i;
-        break;
-      }
-    }
+    bool shareOffsets = false;
+    int j = this->SeekFileOffset(fileName, realTimeStep, shareOffsets);
 
     // Hopefully we are not very far from the timestep we want to use
     // Find it (and cache any timestep we find on the way...)
@@ -1576,13 +2442,14 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
           this->IFile->seekg(sizeof(float) * 3 * numPts, ios::cur);
         }
       }
-      if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
-      {
-        std::map<int, long> tsMap;
-        this->FileOffsets[fileName] = tsMap;
-      }
       this->FileOffsets[fileName][j] = this->IFile->tellg();
     }
+    if (!this->ShareFileOffsets(fileName, realTimeStep, shareOffsets))
+    {
+      vtkErrorMacro("Could not find time step " << timeStep << " in " << fileName);
+      return 0;
+    }
+    this->IndexParts(fileName, realTimeStep, measured ? MEASURED_NODES : NODE_PARTS, 3);
 
     this->ReadLine(line);
     while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
@@ -1590,6 +2457,10 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
       this->ReadLine(line);
     }
   }
+  else
+  {
+    this->IndexParts(fileName, 0, measured ? MEASURED_NODES : NODE_PARTS, 3);
+  }
 
   this->ReadLine(line); // skip the description line
 
@@ -1636,6 +2507,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
   lineRead = this->ReadLine(line);
   while (lineRead && strncmp(line, "part", 4) == 0)
   {
+    this->SharePart();
     vectors = vtkFloatArray::New();
     this->ReadPartId(&partId);
     partId--; // EnSight starts #ing with 1.
@@ -1647,18 +2519,25 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
       this->ReadLine(line); // "coordinates" or "block"
       vectors->SetNumberOfComponents(3);
       vectors->SetNumberOfTuples(this->GetPointIds(realId)->GetLocalNumberOfIds());
-      comp1 = new float[numPts];
-      comp2 = new float[numPts];
-      comp3 = new float[numPts];
-      this->ReadFloatArray(comp1, numPts);
-      this->ReadFloatArray(comp2, numPts);
-      this->ReadFloatArray(comp3, numPts);
-      for (i = 0; i < numPts; i++)
-      {
-        tuple[0] = comp1[i];
-        tuple[1] = comp2[i];
-        tuple[2] = comp3[i];
-        this->InsertVariableComponent(vectors, i, -1, tuple, realId, 0, VECTOR_PER_NODE);
+      // a process that has no point of the part seeks straight to the next one.
+      if (this->GetPointIds(realId)->GetLocalNumberOfIds() > 0 || !this->SkipPart())
+      {
+        comp1 = new float[numPts];
+        comp2 = new float[numPts];
+        comp3 = new float[numPts];
+        this->ReadFloatArray(comp1, numPts);
+        this->ReadFloatArray(comp2, numPts);
+        this->ReadFloatArray(comp3, numPts);
+        for (i = 0; i < numPts; i++)
+        {
+          tuple[0] = comp1[i];
+          tuple[1] = comp2[i];
+          tuple[2] = comp3[i];
+          this->InsertVariableComponent(vectors, i, -1, tuple, realId, 0, VECTOR_PER_NODE);
+        }
+        delete[] comp1;
+        delete[] comp2;
+        delete[] comp3;
       }
       vectors->SetName(description);
       output->GetPointData()->AddArray(vectors);
@@ -1667,9 +2546,6 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
         output->GetPointData()->SetVectors(vectors);
       }
       vectors->Delete();
-      delete[] comp1;
-      delete[] comp2;
-      delete[] comp3;
     }
 
     this->IFile->peek();
@@ -1730,18 +2606,9 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerNode(const char* fileName, const
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
-    int j = 0;
     // Try to find the nearest time step for which we know the offset
-    for (i = realTimeStep; i >= 0; i--)
-    {
-      if (this->FileOffsets.find(fileName) != this->FileOffsets.end() &&
-        this->FileOffsets[fileName].find(i) != this->FileOffsets[fileName].end())
-      {
-        this->IFile->seekg(this->FileOffsets[fileName][i], ios::beg);
-        j = i;
-        break;
-      }
-    }
+    bool shareOffsets = false;
+    int j = this->SeekFileOffset(fileName, realTimeStep, shareOffsets);
 
     // Hopefully we are not very far from the timestep we want to use
     // Find it (and cache any timestep we find on the way...)
@@ -1768,25 +2635,31 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerNode(const char* fileName, const
           this->IFile->seekg(sizeof(float) * 6 * numPts, ios::cur);
         }
       }
-      if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
-      {
-        std::map<int, long> tsMap;
-        this->FileOffsets[fileName] = tsMap;
-      }
       this->FileOffsets[fileName][j] = this->IFile->tellg();
     }
+    if (!this->ShareFileOffsets(fileName, realTimeStep, shareOffsets))
+    {
+      vtkErrorMacro("Could not find time step " << timeStep << " in " << fileName);
+      return 0;
+    }
+    this->IndexParts(fileName, realTimeStep, NODE_PARTS, 6);
     this->ReadLine(line);
     while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
     {
       this->ReadLine(line);
     }
   }
+  else
+  {
+    this->IndexParts(fileName, 0, NODE_PARTS, 6);
+  }
 
   this->ReadLine(line); // skip the description line
   lineRead = this->ReadLine(line);
 
   while (lineRead && strncmp(line, "part", 4) == 0)
   {
+    this->SharePart();
     this->ReadPartId(&partId);
     partId--; // EnSight starts #ing with 1.
     realId = this->InsertNewPartId(partId);
@@ -1798,37 +2671,41 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerNode(const char* fileName, const
       this->ReadLine(line); // "coordinates" or "block"
       tensors->SetNumberOfComponents(6);
       tensors->SetNumberOfTuples(this->GetPointIds(realId)->GetLocalNumberOfIds());
-      comp1 = new float[numPts];
-      comp2 = new float[numPts];
-      comp3 = new float[numPts];
-      comp4 = new float[numPts];
-      comp5 = new float[numPts];
-      comp6 = new float[numPts];
-      this->ReadFloatArray(comp1, numPts);
-      this->ReadFloatArray(comp2, numPts);
-      this->ReadFloatArray(comp3, numPts);
-      this->ReadFloatArray(comp4, numPts);
-      this->ReadFloatArray(comp6, numPts);
-      this->ReadFloatArray(comp5, numPts);
-      for (i = 0; i < numPts; i++)
-      {
-        tuple[0] = comp1[i];
-        tuple[1] = comp2[i];
-        tuple[2] = comp3[i];
-        tuple[3] = comp4[i];
-        tuple[4] = comp5[i];
-        tuple[5] = comp6[i];
-        this->InsertVariableComponent(tensors, i, -1, tuple, realId, 0, TENSOR_SYMM_PER_NODE);
+      // a process that has no point of the part seeks straight to the next one.
+      if (this->GetPointIds(realId)->GetLocalNumberOfIds() > 0 || !this->SkipPart())
+      {
+        comp1 = new float[numPts];
+        comp2 = new float[numPts];
+        comp3 = new float[numPts];
+        comp4 = new float[numPts];
+        comp5 = new float[numPts];
+        comp6 = new float[numPts];
+        this->ReadFloatArray(comp1, numPts);
+        this->ReadFloatArray(comp2, numPts);
+        this->ReadFloatArray(comp3, numPts);
+        this->ReadFloatArray(comp4, numPts);
+        this->ReadFloatArray(comp6, numPts);
+        this->ReadFloatArray(comp5, numPts);
+        for (i = 0; i < numPts; i++)
+        {
+          tuple[0] = comp1[i];
+          tuple[1] = comp2[i];
+          tuple[2] = comp3[i];
+          tuple[3] = comp4[i];
+          tuple[4] = comp5[i];
+          tuple[5] = comp6[i];
+          this->InsertVariableComponent(tensors, i, -1, tuple, realId, 0, TENSOR_SYMM_PER_NODE);
+        }
+        delete[] comp1;
+        delete[] comp2;
+        delete[] comp3;
+        delete[] comp4;
+        delete[] comp5;
+        delete[] comp6;
       }
       tensors->SetName(description);
       output->GetPointData()->AddArray(tensors);
       tensors->Delete();
-      delete[] comp1;
-      delete[] comp2;
-      delete[] comp3;
-      delete[] comp4;
-      delete[] comp5;
-      delete[] comp6;
     }
 
     this->IFile->peek();
@@ -1891,17 +2768,8 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
   {
     int realTimeStep = timeStep - 1;
     // Try to find the nearest time step for which we know the offset
-    int j = 0;
-    for (i = realTimeStep; i >= 0; i--)
-    {
-      if (this->FileOffsets.find(fileName) != this->FileOffsets.end() &&
-        this->FileOffsets[fileName].find(i) != this->FileOffsets[fileName].end())
-      {
-        this->IFile->seekg(this->FileOffsets[fileName][i], ios::beg);
-        j = i;
-        break;
-      }
-    }
+    bool shareOffsets = false;
+    int j = this->SeekFileOffset(fileName, realTimeStep, shareOffsets);
 
     // Hopefully we are not very far from the timestep we want to use
     // Find it (and cache any timestep we find on the way...)
@@ -1960,25 +2828,31 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
           lineRead = this->ReadLine(line);
         }
       } // end while
-      if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
-      {
-        std::map<int, long> tsMap;
-        this->FileOffsets[fileName] = tsMap;
-      }
       this->FileOffsets[fileName][j] = this->IFile->tellg();
+    }
+    if (!this->ShareFileOffsets(fileName, realTimeStep, shareOffsets))
+    {
+      vtkErrorMacro("Could not find time step " << timeStep << " in " << fileName);
+      return 0;
     } // end for
+    this->IndexParts(fileName, realTimeStep, ELEMENT_PARTS);
     this->ReadLine(line);
     while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
     {
       this->ReadLine(line);
     }
   }
+  else
+  {
+    this->IndexParts(fileName, 0, ELEMENT_PARTS);
+  }
 
   this->ReadLine(line);            // skip the description line
   lineRead = this->ReadLine(line); // "part"
 
   while (lineRead && strncmp(line, "part", 4) == 0)
   {
+    this->SharePart();
     this->ReadPartId(&partId);
     partId--; // EnSight starts #ing with 1.
     realId = this->InsertNewPartId(partId);
@@ -1998,9 +2872,23 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
         scalars = (vtkFloatArray*)(output->GetCellData()->GetArray(description));
       }
 
-      // need to find out from CellIds how many cells we have of this element
-      // type (and what their ids are) -- IF THIS IS NOT A BLOCK SECTION
-      if (strncmp(line, "block", 5) == 0)
+      // a process that has no element of the part seeks straight to the next
+      // one. Otherwise, need to find out from CellIds how many cells we have
+      // of this element type (and what their ids are) -- IF THIS IS NOT A
+      // BLOCK SECTION
+      if (this->GetLocalTotalNumberOfCellIds(realId) == 0 && this->SkipPart())
+      {
+        this->IFile->peek();
+        if (this->IFile->eof())
+        {
+          lineRead = 0;
+        }
+        else
+        {
+          lineRead = this->ReadLine(line);
+        }
+      }
+      else if (strncmp(line, "block", 5) == 0)
       {
         scalarsRead = new float[numCells];
         this->ReadFloatArray(scalarsRead, numCells);
@@ -2137,17 +3025,8 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
   {
     int realTimeStep = timeStep - 1;
     // Try to find the nearest time step for which we know the offset
-    int j = 0;
-    for (i = realTimeStep; i >= 0; i--)
-    {
-      if (this->FileOffsets.find(fileName) != this->FileOffsets.end() &&
-        this->FileOffsets[fileName].find(i) != this->FileOffsets[fileName].end())
-      {
-        this->IFile->seekg(this->FileOffsets[fileName][i], ios::beg);
-        j = i;
-        break;
-      }
-    }
+    bool shareOffsets = false;
+    int j = this->SeekFileOffset(fileName, realTimeStep, shareOffsets);
 
     // Hopefully we are not very far from the timestep we want to use
     // Find it (and cache any timestep we find on the way...)
@@ -2207,25 +3086,31 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
           lineRead = this->ReadLine(line);
         }
       }
-      if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
-      {
-        std::map<int, long> tsMap;
-        this->FileOffsets[fileName] = tsMap;
-      }
       this->FileOffsets[fileName][j] = this->IFile->tellg();
     }
+    if (!this->ShareFileOffsets(fileName, realTimeStep, shareOffsets))
+    {
+      vtkErrorMacro("Could not find time step " << timeStep << " in " << fileName);
+      return 0;
+    }
+    this->IndexParts(fileName, realTimeStep, ELEMENT_PARTS, 3);
     this->ReadLine(line);
     while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
     {
       this->ReadLine(line);
     }
   }
+  else
+  {
+    this->IndexParts(fileName, 0, ELEMENT_PARTS, 3);
+  }
 
   this->ReadLine(line);            // skip the description line
   lineRead = this->ReadLine(line); // "part"
 
   while (lineRead && strncmp(line, "part", 4) == 0)
   {
+    this->SharePart();
     this->ReadPartId(&partId);
     partId--; // EnSight starts #ing with 1.
     realId = this->InsertNewPartId(partId);
@@ -2237,9 +3122,23 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
       this->ReadLine(line); // element type or "block"
       vectors->SetNumberOfComponents(3);
       vectors->SetNumberOfTuples(this->GetLocalTotalNumberOfCellIds(realId));
-      // need to find out from CellIds how many cells we have of this element
-      // type (and what their ids are) -- IF THIS IS NOT A BLOCK SECTION
-      if (strncmp(line, "block", 5) == 0)
+      // a process that has no element of the part seeks straight to the next
+      // one. Otherwise, need to find out from CellIds how many cells we have
+      // of this element type (and what their ids are) -- IF THIS IS NOT A
+      // BLOCK SECTION
+      if (this->GetLocalTotalNumberOfCellIds(realId) == 0 && this->SkipPart())
+      {
+        this->IFile->peek();
+        if (this->IFile->eof())
+        {
+          lineRead = 0;
+        }
+        else
+        {
+          lineRead = this->ReadLine(line);
+        }
+      }
+      else if (strncmp(line, "block", 5) == 0)
       {
         comp1 = new float[numCells];
         comp2 = new float[numCells];
@@ -2383,17 +3282,8 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
   {
     int realTimeStep = timeStep - 1;
     // Try to find the nearest time step for which we know the offset
-    int j = 0;
-    for (i = realTimeStep; i >= 0; i--)
-    {
-      if (this->FileOffsets.find(fileName) != this->FileOffsets.end() &&
-        this->FileOffsets[fileName].find(i) != this->FileOffsets[fileName].end())
-      {
-        this->IFile->seekg(this->FileOffsets[fileName][i], ios::beg);
-        j = i;
-        break;
-      }
-    }
+    bool shareOffsets = false;
+    int j = this->SeekFileOffset(fileName, realTimeStep, shareOffsets);
 
     // Hopefully we are not very far from the timestep we want to use
     // Find it (and cache any timestep we find on the way...)
@@ -2453,25 +3343,31 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
           lineRead = this->ReadLine(line);
         }
       }
-      if (this->FileOffsets.find(fileName) == this->FileOffsets.end())
-      {
-        std::map<int, long> tsMap;
-        this->FileOffsets[fileName] = tsMap;
-      }
       this->FileOffsets[fileName][j] = this->IFile->tellg();
     }
+    if (!this->ShareFileOffsets(fileName, realTimeStep, shareOffsets))
+    {
+      vtkErrorMacro("Could not find time step " << timeStep << " in " << fileName);
+      return 0;
+    }
+    this->IndexParts(fileName, realTimeStep, ELEMENT_PARTS, 6);
     this->ReadLine(line);
     while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
     {
       this->ReadLine(line);
     }
   }
+  else
+  {
+    this->IndexParts(fileName, 0, ELEMENT_PARTS, 6);
+  }
 
   this->ReadLine(line);            // skip the description line
   lineRead = this->ReadLine(line); // "part"
 
   while (lineRead && strncmp(line, "part", 4) == 0)
   {
+    this->SharePart();
     this->ReadPartId(&partId);
     partId--; // EnSight starts #ing with 1.
     realId = this->InsertNewPartId(partId);
@@ -2484,9 +3380,23 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
       tensors->SetNumberOfComponents(6);
       tensors->SetNumberOfTuples(this->GetLocalTotalNumberOfCellIds(realId));
 
-      // need to find out from CellIds how many cells we have of this element
-      // type (and what their ids are) -- IF THIS IS NOT A BLOCK SECTION
-      if (strncmp(line, "block", 5) == 0)
+      // a process that has no element of the part seeks straight to the next
+      // one. Otherwise, need to find out from CellIds how many cells we have
+      // of this element type (and what their ids are) -- IF THIS IS NOT A
+      // BLOCK SECTION
+      if (this->GetLocalTotalNumberOfCellIds(realId) == 0 && this->SkipPart())
+      {
+        this->IFile->peek();
+        if (this->IFile->eof())
+        {
+          lineRead = 0;
+        }
+        else
+        {
+          lineRead = this->ReadLine(line);
+        }
+      }
+      else if (strncmp(line, "block", 5) == 0)
       {
         comp1 = new float[numCells];
         comp2 = new float[numCells];
@@ -35,6 +35,11 @@
 #include "vtkPEnSightReader.h"
 #include "vtkPVVTKExtensionsIOEnSightModule.h" //needed for exports
 
+#include <map>    // for std::map
+#include <set>    // for std::set
+#include <string> // for std::string
+#include <vector> // for std::vector
+
 class vtkMultiBlockDataSet;
 class vtkUnstructuredGrid;
 class vtkPoints;
@@ -53,10 +58,162 @@ protected:
   // Returns 1 if successful.  Sets file size as a side action.
   int OpenFile(const char* filename);
 
+  /**
+   * Does the work of OpenFile(), which makes the processes agree on the
+   * result when they go on with collective calls, see
+   * CollectiveFileAccess().
+   */
+  int OpenFileInternal(const char* filename);
+
+  /**
+   * Returns true when the processes go on with collective calls after
+   * opening a file: when reading file sets, as SeekFileOffset() does, or with
+   * UseCollectiveReads.
+   */
+  bool CollectiveFileAccess() { return this->UseFileSets || this->UseCollectiveReads; }
+
+  /**
+   * Returns true when UseCollectiveReads is on and there are several
+   * processes: only process 0 reads the files, and sends the other
+   * processes the ranges of the files they parse.
+   */
+  bool ReadsCollectively();
+
+  /**
+   * Used by OpenFile() when ReadsCollectively() is true: process 0 opens the
+   * file, and IFile reads, on the other processes, the ranges of the file
+   * ShareFileRange() and SharePart() send them, starting with the first
+   * line. Returns false on all processes if process 0 could not open the
+   * file. Must be called on all processes.
+   */
+  bool OpenFileCollectively(const char* filename);
+
+  /**
+   * Sends the bytes of the open file from begin to end to the processes
+   * that do not read it, replacing the ranges they had. Must be called on
+   * all processes, at the same position in the file.
+   */
+  void ShareFileRange(long begin, long end);
+
+  /**
+   * Reads data.size() bytes of the open file from begin, leaving the file
+   * position as is.
+   */
+  void ReadFileRange(long begin, std::vector<char>& data);
+
   // Returns 1 if successful.  Handles constructing the filename, opening the file and checking
   // if it's binary
   int InitializeFile(const char* filename);
 
+  /**
+   * Returns 1 if the open file is a binary EnSight file. Used by
+   * InitializeFile().
+   */
+  int CheckFileHeader();
+
+  /**
+   * Returns the path of a data file, relative to FilePath.
+   */
+  std::string GetFullFileName(const char* fileName);
+
+  /**
+   * The first time a file is read, process 0 loads its offset index file, if
+   * UseOffsetIndexFiles is on, and shares the time step and part offsets it
+   * holds with the other processes. Must be called on all processes.
+   */
+  void LoadOffsetIndex(const char* fileName);
+
+  /**
+   * Positions the open file set at the start of a time step, or at the
+   * nearest time step before it whose offset is known, and returns that time
+   * step. The caller scans from there to timeStep and then calls
+   * ShareFileOffsets() with share. Only process 0 scans: the other processes
+   * return timeStep right away and are positioned by ShareFileOffsets().
+   * Must be called on all processes.
+   */
+  int SeekFileOffset(const char* fileName, int timeStep, bool& share);
+
+  /**
+   * Shares the offsets process 0 found while scanning to timeStep with the
+   * other processes, positions them at timeStep, and saves the offset index
+   * file if UseOffsetIndexFiles is on. Does nothing unless share is set.
+   * Returns false if timeStep could not be found. Must be called on all
+   * processes.
+   */
+  bool ShareFileOffsets(const char* fileName, int timeStep, bool share);
+
+  /**
+   * What the parts of a time step indexed by IndexParts() hold.
+   */
+  enum PartsTypes
+  {
+    GEOMETRY_PARTS,
+    MEASURED_GEOMETRY,
+    NODE_PARTS,
+    ELEMENT_PARTS,
+    MEASURED_NODES
+  };
+
+  /**
+   * Sets CurrentPartOffsets to the offsets of the parts of a time step of the
+   * open file, found in PartOffsets. The file must be positioned at the
+   * start of the time step: where the search for "BEGIN TIME STEP" starts
+   * with file sets, right after the header otherwise. If the offsets are not
+   * known yet, process 0 finds them with SkipParts(), shares them and saves
+   * them in the offset index file if UseOffsetIndexFiles is on. Variable
+   * files are indexed when CollectiveFileAccess() is true, for SkipPart().
+   * Geometry and measured files are only indexed when ReadsCollectively()
+   * is true. In that case, process 0 also sends the other processes what
+   * comes before the first part, and SharePart() sends them the parts. The
+   * other processes read a time step that cannot be indexed from the file
+   * themselves. Must be called on all processes.
+   */
+  void IndexParts(
+    const char* fileName, int timeStep, int partsType, int numberOfComponents = 1);
+
+  /**
+   * Reads past the time step the file is positioned at, as IndexParts()
+   * expects, and appends where its parts start to partOffsets, followed by
+   * where the last one ends. Variable parts hold numberOfComponents arrays.
+   * Returns 0 if the time step could not be read, or does not end with the
+   * file or "END TIME STEP".
+   */
+  int SkipParts(int partsType, int numberOfComponents, std::vector<long>& partOffsets);
+
+  /**
+   * Used by SkipParts() for variable files. Each part holds
+   * numberOfComponents arrays of one value per node or, when perElement is
+   * set, per element.
+   */
+  int SkipVariableParts(int numberOfComponents, int perElement, std::vector<long>& partOffsets);
+
+  /**
+   * Used by SkipParts() for measured geometry and variable files, which have
+   * no parts: only appends where the data ends.
+   */
+  int SkipMeasuredData(int partsType, int numberOfComponents, std::vector<long>& partOffsets);
+
+  /**
+   * When ReadsCollectively() is true, sends the other processes the part
+   * whose "part" line was just read, and the line that follows it. Only the
+   * processes that hold a piece of a variable part get all of it, the others
+   * get what they read before SkipPart(). Must be called on all processes.
+   */
+  void SharePart();
+
+  /**
+   * Positions the file at the end of the part being read, found in
+   * CurrentPartOffsets. Returns 0, leaving the file as is, if the offsets of
+   * the parts of the time step are not known.
+   */
+  int SkipPart();
+
+  /**
+   * Returns where the line just read starts in the file, or the size of the
+   * file if lineRead is 0.
+   */
+  long GetLastLineOffset(int lineRead);
+
   /**
    * Read the geometry file.  If an error occurred, 0 is returned; otherwise 1.
    */
@@ -189,6 +346,14 @@ protected:
    */
   int CountTimeSteps();
 
+  /**
+   * Reads past the parts of a time step of the geometry file, after "BEGIN
+   * TIME STEP" with file sets, and appends where they start to
+   * partOffsets, followed by where the last one ends. Returns -1 on the
+   * errors SkipTimeStep() deletes the file for.
+   */
+  int SkipGeometryParts(std::vector<long>& partOffsets);
+
   //@{
   /**
    * Read to the next time step in the geometry file.
@@ -223,6 +388,18 @@ protected:
   // Total number of vectors;
   vtkIdType FloatBufferNumberOfVectors;
 
+  // Files whose offset index has been loaded.
+  std::set<std::string> LoadedOffsetIndices;
+
+  // For each file and time step, where the parts of the time step start, in
+  // the order of the file, followed by where the last one ends.
+  std::map<std::string, std::map<int, std::vector<long> > > PartOffsets;
+
+  // The part offsets of the time step being read, empty when not known.
+  std::vector<long> CurrentPartOffsets;
+  // What the parts of the time step being read hold, see PartsTypes.
+  int CurrentPartsType;
+
 private:
   vtkPEnSightGoldBinaryReader(const vtkPEnSightGoldBinaryReader&) = delete;
   void operator=(const vtkPEnSightGoldBinaryReader&) = delete;
@@ -251,7 +251,8 @@ int vtkPEnSightReader::RequestData(vtkInformation* vtkNotUsed(request),
   char* fileName;
   int filenameNum;
 
-  if (!this->CaseFileRead)
+  // with collective reads, the processes must agree before reading the files.
+  if (!this->AllProcessesSucceeded(this->CaseFileRead, this->UseCollectiveReads))
   {
     vtkErrorMacro("error reading case file");
     return 0;
@@ -333,7 +334,9 @@ int vtkPEnSightReader::RequestData(vtkInformation* vtkNotUsed(request),
       }
     }
 
-    int readGeom = this->ReadGeometryFile(fileName, timeStepInFile, output);
+    int readGeom =
+      this->AllProcessesSucceeded(this->ReadGeometryFile(fileName, timeStepInFile, output),
+        this->UseFileSets || this->UseCollectiveReads);
     if (!readGeom)
     {
       vtkErrorMacro("error reading geometry file " << fileName << " " << readGeom);
@@ -416,7 +419,9 @@ int vtkPEnSightReader::RequestData(vtkInformation* vtkNotUsed(request),
         }
       }
     }
-    if (!this->ReadMeasuredGeometryFile(fileName, timeStepInFile, output))
+    if (!this->AllProcessesSucceeded(
+          this->ReadMeasuredGeometryFile(fileName, timeStepInFile, output),
+          this->UseFileSets || this->UseCollectiveReads))
     {
       vtkErrorMacro("error reading measured geometry file");
       delete[] fileName;
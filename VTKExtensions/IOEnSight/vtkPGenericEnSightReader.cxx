@@ -15,6 +15,7 @@
 #include "vtkPGenericEnSightReader.h"
 
 #include "vtkCallbackCommand.h"
+#include "vtkCommunicator.h"
 #include "vtkCompositeDataPipeline.h"
 #include "vtkDataArrayCollection.h"
 #include "vtkDataArraySelection.h"
@@ -44,6 +45,8 @@ vtkPGenericEnSightReader::vtkPGenericEnSightReader()
   // -2 is the default starting value
   this->MultiProcessLocalProcessId = -2;
   this->MultiProcessNumberOfProcesses = -2;
+  this->UseOffsetIndexFiles = false;
+  this->UseCollectiveReads = false;
 }
 
 //----------------------------------------------------------------------------
@@ -51,9 +54,37 @@ vtkPGenericEnSightReader::~vtkPGenericEnSightReader()
 {
 }
 
+//----------------------------------------------------------------------------
+int vtkPGenericEnSightReader::AllProcessesSucceeded(int success, bool collective)
+{
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  if (!collective || !controller || controller->GetNumberOfProcesses() <= 1)
+  {
+    return success;
+  }
+  int local = success ? 1 : 0;
+  int global = 0;
+  controller->AllReduce(&local, &global, 1, vtkCommunicator::MIN_OP);
+  if (local && !global)
+  {
+    vtkErrorMacro("The EnSight files could not be read on another process.");
+  }
+  return global;
+}
+
 //----------------------------------------------------------------------------
 int vtkPGenericEnSightReader::RequestInformation(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  // with collective reads, a process that could not read the case file must
+  // not skip RequestData() alone.
+  return this->AllProcessesSucceeded(
+    this->RequestLocalInformation(request, inputVector, outputVector), this->UseCollectiveReads);
+}
+
+//----------------------------------------------------------------------------
+int vtkPGenericEnSightReader::RequestLocalInformation(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
   int version = this->DetermineEnSightVersion();
   int createReader = 1;
@@ -139,6 +170,8 @@ int vtkPGenericEnSightReader::RequestInformation(
   if (reader)
   {
     // this dynamic cast never should fail
+    reader->SetUseOffsetIndexFiles(this->UseOffsetIndexFiles);
+    reader->SetUseCollectiveReads(this->UseCollectiveReads);
     reader->RequestInformation(request, inputVector, outputVector);
   }
   this->Reader->SetParticleCoordinatesByIndex(this->ParticleCoordinatesByIndex);
@@ -203,4 +236,6 @@ void vtkPGenericEnSightReader::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "MultiProcessLocalProcessId: " << this->MultiProcessLocalProcessId << endl;
   os << indent << "MultiProcessNumberOfProcesses: " << this->MultiProcessNumberOfProcesses << endl;
+  os << indent << "UseOffsetIndexFiles: " << this->UseOffsetIndexFiles << endl;
+  os << indent << "UseCollectiveReads: " << this->UseCollectiveReads << endl;
 }
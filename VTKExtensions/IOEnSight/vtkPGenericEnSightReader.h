@@ -38,12 +38,56 @@ public:
   vtkTypeMacro(vtkPGenericEnSightReader, vtkGenericEnSightReader);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  //@{
+  /**
+   * When on, the offsets of the time steps found in EnSight Gold binary file
+   * sets, and of the parts of the time steps read from variable files, or
+   * from any file with UseCollectiveReads, are saved next to each data file,
+   * in a file named after it with a ".pvoffsets" suffix. Later readers, in
+   * this session or another, then seek to any time step and part directly.
+   * The index is ignored once the data file changes. Default is off.
+   */
+  vtkSetMacro(UseOffsetIndexFiles, bool);
+  vtkGetMacro(UseOffsetIndexFiles, bool);
+  vtkBooleanMacro(UseOffsetIndexFiles, bool);
+  //@}
+
+  //@{
+  /**
+   * When on, only the first process opens and reads the EnSight Gold binary
+   * files, and sends the other processes one part at a time, instead of
+   * every process opening and reading them. The amount of data read from the
+   * file system then no longer depends on the number of processes, and each
+   * process only holds the part it is parsing. A process that holds no piece
+   * of a variable part only gets its first lines. The parts of each time
+   * step are indexed first, see UseOffsetIndexFiles. Default is off.
+   */
+  vtkSetMacro(UseCollectiveReads, bool);
+  vtkGetMacro(UseCollectiveReads, bool);
+  vtkBooleanMacro(UseCollectiveReads, bool);
+  //@}
+
 protected:
   vtkPGenericEnSightReader();
   ~vtkPGenericEnSightReader() override;
 
   int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  /**
+   * Does the work of RequestInformation(), which makes the processes agree
+   * on the result when UseCollectiveReads is on.
+   */
+  int RequestLocalInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector*);
+
+  /**
+   * When collective is set, returns 1 only if success is set on all
+   * processes, and success otherwise. Used before the processes go on with
+   * collective calls, so that a process that failed, for instance because a
+   * file is not visible on its node, does not return alone and leave the
+   * others waiting. Must be called on all processes when collective is set.
+   */
+  int AllProcessesSucceeded(int success, bool collective);
+
   /**
    * Multi Process cache. Will be read a lot of times.
    */
@@ -56,6 +100,9 @@ protected:
   int MultiProcessLocalProcessId;
   int MultiProcessNumberOfProcesses;
 
+  bool UseOffsetIndexFiles;
+  bool UseCollectiveReads;
+
 private:
   vtkPGenericEnSightReader(const vtkPGenericEnSightReader&) = delete;
   void operator=(const vtkPGenericEnSightReader&) = delete;
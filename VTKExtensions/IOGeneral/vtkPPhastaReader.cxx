@@ -25,6 +25,7 @@
 #include "vtkPVXMLParser.h"
 #include "vtkPhastaReader.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnstructuredGrid.h"
@@ -33,6 +34,7 @@
 
 #include <map>
 #include <sstream>
+#include <vector>
 
 struct vtkPPhastaReaderInternal
 {
@@ -54,6 +56,13 @@ struct vtkPPhastaReaderInternal
   TimeStepInfoMapType TimeStepInfoMap;
   typedef std::map<int, vtkSmartPointer<vtkUnstructuredGrid> > CachedGridsMapType;
   CachedGridsMapType CachedGrids;
+
+  struct PieceToLoad
+  {
+    int Index;
+    vtkSmartPointer<vtkPhastaReader> Reader;
+    vtkSmartPointer<vtkUnstructuredGrid> Output;
+  };
 };
 
 //----------------------------------------------------------------------------
@@ -66,6 +75,7 @@ vtkPPhastaReader::vtkPPhastaReader()
 
   this->TimeStepIndex = 0;
   this->ActualTimeStep = 0;
+  this->ReadPiecesConcurrently = true;
 
   this->Reader = vtkPhastaReader::New();
 
@@ -210,7 +220,8 @@ int vtkPPhastaReader::RequestData(
   char* geom_name = new char[strlen(geometryPattern) + 60];
   char* field_name = new char[strlen(fieldPattern) + 60];
 
-  // now loop over all of the files that I should load
+  // first set up a reader for each of the files that I should load
+  std::vector<vtkPPhastaReaderInternal::PieceToLoad> pieces;
   for (int loadingPiece = piece; loadingPiece < numPieces; loadingPiece += numProcPieces)
   {
     if (geomHasTime && geomHasPiece)
@@ -248,9 +259,15 @@ int vtkPPhastaReader::RequestData(
     }
     else
     {
-      strcpy(geom_name, fieldPattern);
+      strcpy(field_name, fieldPattern);
     }
 
+    vtkPPhastaReaderInternal::PieceToLoad toLoad;
+    toLoad.Index = loadingPiece;
+    toLoad.Reader = vtkSmartPointer<vtkPhastaReader>::New();
+    toLoad.Reader->CopyFieldInfo(this->Reader);
+    toLoad.Output = vtkSmartPointer<vtkUnstructuredGrid>::New();
+
     std::ostringstream geomFName;
     std::string gpath = vtksys::SystemTools::GetFilenamePath(geom_name);
     if (gpath.empty() || !vtksys::SystemTools::FileIsFullPath(gpath.c_str()))
@@ -262,7 +279,7 @@ int vtkPPhastaReader::RequestData(
       }
     }
     geomFName << geom_name << ends;
-    this->Reader->SetGeometryFileName(geomFName.str().c_str());
+    toLoad.Reader->SetGeometryFileName(geomFName.str().c_str());
 
     std::ostringstream fieldFName;
     std::string fpath = vtksys::SystemTools::GetFilenamePath(field_name);
@@ -275,7 +292,7 @@ int vtkPPhastaReader::RequestData(
       }
     }
     fieldFName << field_name << ends;
-    this->Reader->SetFieldFileName(fieldFName.str().c_str());
+    toLoad.Reader->SetFieldFileName(fieldFName.str().c_str());
 
     vtkPPhastaReaderInternal::CachedGridsMapType::iterator CachedCopy =
       this->Internal->CachedGrids.find(loadingPiece);
@@ -283,28 +300,44 @@ int vtkPPhastaReader::RequestData(
     // if there is a cached copy, use that
     if (CachedCopy != this->Internal->CachedGrids.end())
     {
-      this->Reader->SetCachedGrid(CachedCopy->second);
+      toLoad.Reader->SetCachedGrid(CachedCopy->second);
     }
+    pieces.push_back(toLoad);
+  }
 
-    this->Reader->Update();
+  delete[] geom_name;
+  delete[] field_name;
 
-    if (CachedCopy == this->Internal->CachedGrids.end())
+  // then read the pieces, each reader only touches its own files and output
+  auto readPieces = [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      pieces[cc].Reader->ReadPiece(pieces[cc].Output);
+    }
+  };
+  if (this->ReadPiecesConcurrently)
+  {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(pieces.size()), 1, readPieces);
+  }
+  else
+  {
+    readPieces(0, static_cast<vtkIdType>(pieces.size()));
+  }
+
+  for (auto& toLoad : pieces)
+  {
+    if (this->Internal->CachedGrids.find(toLoad.Index) == this->Internal->CachedGrids.end())
     {
       vtkSmartPointer<vtkUnstructuredGrid> cached = vtkSmartPointer<vtkUnstructuredGrid>::New();
-      cached->ShallowCopy(this->Reader->GetOutput());
+      cached->ShallowCopy(toLoad.Output);
       cached->GetPointData()->Initialize();
       cached->GetCellData()->Initialize();
       cached->GetFieldData()->Initialize();
-      this->Internal->CachedGrids[loadingPiece] = cached;
+      this->Internal->CachedGrids[toLoad.Index] = cached;
     }
-    vtkSmartPointer<vtkUnstructuredGrid> copy = vtkSmartPointer<vtkUnstructuredGrid>::New();
-    copy->ShallowCopy(this->Reader->GetOutput());
-    MultiPieceDataSet->SetPiece(loadingPiece, copy);
+    MultiPieceDataSet->SetPiece(toLoad.Index, toLoad.Output);
   }
 
-  delete[] geom_name;
-  delete[] field_name;
-
   if (steps)
   {
     output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), steps[this->ActualTimeStep]);
@@ -594,4 +627,5 @@ void vtkPPhastaReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "TimeStepIndex: " << this->TimeStepIndex << endl;
   os << indent << "TimeStepRange: " << this->TimeStepRange[0] << " " << this->TimeStepRange[1]
      << endl;
+  os << indent << "ReadPiecesConcurrently: " << this->ReadPiecesConcurrently << endl;
 }
@@ -157,6 +157,17 @@ public:
   vtkGetVector2Macro(TimeStepRange, int);
   //@}
 
+  //@{
+  /**
+   * When on (default), the pieces assigned to this process are read
+   * concurrently with vtkSMPTools, so the number of threads follows the SMP
+   * backend configuration.
+   */
+  vtkSetMacro(ReadPiecesConcurrently, bool);
+  vtkGetMacro(ReadPiecesConcurrently, bool);
+  vtkBooleanMacro(ReadPiecesConcurrently, bool);
+  //@}
+
   static int CanReadFile(const char* filename);
 
 protected:
@@ -181,6 +192,7 @@ protected:
   vtkPVXMLParser* Parser;
 
   int ActualTimeStep;
+  bool ReadPiecesConcurrently;
 
 private:
   vtkPPhastaReaderInternal* Internal;
@@ -33,6 +33,9 @@ vtkStandardNewMacro(vtkPhastaReader);
 
 vtkCxxSetObjectMacro(vtkPhastaReader, CachedGrid, vtkUnstructuredGrid);
 
+#include <vtksys/FStream.hxx>
+
+#include <algorithm>
 #include <map>
 #include <sstream>
 #include <string>
@@ -62,46 +65,18 @@ struct vtkPhastaReaderInternal
   FieldInfoMapType FieldInfoMap;
 };
 
-// Begin of copy from phastaIO
-
-#define swap_char(A, B)                                                                            \
-  {                                                                                                \
-    ucTmp = A;                                                                                     \
-    A = B;                                                                                         \
-    B = ucTmp;                                                                                     \
-  }
-
-std::map<int, char*> LastHeaderKey;
-std::vector<FILE*> fileArray;
-std::vector<int> byte_order;
-std::vector<int> header_type;
-int DataSize = 0;
-int LastHeaderNotFound = 0;
-int Wrong_Endian = 0;
-int Strict_Error = 0;
-int binary_format = 0;
-
-// the caller has the responsibility to delete the returned string
-char* vtkPhastaReader::StringStripper(const char istring[])
+namespace
 {
-  size_t length = strlen(istring);
-  char* dest = new char[length + 1];
-  strcpy(dest, istring);
-  dest[length] = '\0';
+// Size of the stream buffer used while indexing the headers of a file. Data
+// blocks larger than this are read straight into the destination array.
+const std::streamsize HeaderBufferSize = 1 << 20;
 
-  if (char* p = strpbrk(dest, " "))
-  {
-    *p = '\0';
-  }
-
-  return dest;
-}
-
-int vtkPhastaReader::cscompare(const char teststring[], const char targetstring[])
+// Compares the first characters of teststring to targetstring ignoring case
+// and spaces. '?' in either string matches the remaining characters.
+int cscompare(const char teststring[], const char targetstring[])
 {
-
-  char* s1 = const_cast<char*>(teststring);
-  char* s2 = const_cast<char*>(targetstring);
+  const char* s1 = teststring;
+  const char* s2 = targetstring;
 
   while (*s1 == ' ')
   {
@@ -124,369 +99,198 @@ int vtkPhastaReader::cscompare(const char teststring[], const char targetstring[
       s2++;
     }
   }
-  if (!(*s1) || (*s1 == '?'))
-  {
-    return 1;
-  }
-  else
-  {
-    return 0;
-  }
-}
-
-void vtkPhastaReader::isBinary(const char iotype[])
-{
-  char* fname = StringStripper(iotype);
-  if (cscompare(fname, "binary"))
-  {
-    binary_format = 1;
-  }
-  else
-  {
-    binary_format = 0;
-  }
-  delete[] fname;
+  return (!(*s1) || (*s1 == '?')) ? 1 : 0;
 }
 
-size_t vtkPhastaReader::typeSize(const char typestring[])
+size_t typeSize(const char typestring[])
 {
-  char* ts1 = StringStripper(typestring);
-
-  if (cscompare("integer", ts1))
+  if (cscompare("integer", typestring))
   {
-    delete[] ts1;
     return sizeof(int);
   }
-  else if (cscompare("double", ts1))
+  else if (cscompare("double", typestring))
   {
-    delete[] ts1;
     return sizeof(double);
   }
-  else if (cscompare("float", ts1))
+  else if (cscompare("float", typestring))
   {
-    delete[] ts1;
     return sizeof(float);
   }
-  else
-  {
-    vtkGenericWarningMacro(<< "unknown type : " << ts1 << endl);
-    delete[] ts1;
-    return 0;
-  }
+  vtkGenericWarningMacro(<< "unknown type : " << typestring << endl);
+  return 0;
 }
 
-namespace
-{
-void xfgets(char* str, int num, FILE* stream)
+// Splits the text of a header line following the key into its integer values.
+std::vector<int> ParseHeaderValues(const std::string& text)
 {
-  if (fgets(str, num, stream) == NULL)
+  std::vector<int> values;
+  const char* delimiters = " ,;<>";
+  std::string::size_type start = text.find_first_not_of(delimiters);
+  while (start != std::string::npos)
   {
-    vtkGenericWarningMacro(<< "Could not read or end of file" << endl);
+    std::string::size_type end = text.find_first_of(delimiters, start);
+    values.push_back(atoi(text.substr(start, end - start).c_str()));
+    start = end == std::string::npos ? end : text.find_first_not_of(delimiters, end);
   }
+  return values;
 }
 
-void xfread(void* ptr, size_t size, size_t count, FILE* stream)
+// A binary Phasta file opened for reading. The headers are indexed once when
+// the file is opened, so looking up a block is a search in memory followed by
+// a single seek and read. All the state of the file is held by the instance,
+// which lets several files be read concurrently.
+class vtkPhastaFile
 {
-  if (fread(ptr, size, count, stream) != count)
+public:
+  bool Open(const char* fileName);
+
+  // Looks for the next header matching key, wrapping around to the beginning
+  // of the file, and copies expect of its values into params.
+  bool ReadHeader(const char* key, int* params, int expect);
+
+  // Reads the data block of the header found by the last call to ReadHeader.
+  bool ReadDataBlock(const char* key, void* values, size_t count, const char* datatype);
+
+private:
+  struct Header
   {
-    vtkGenericWarningMacro(<< "Could not read or end of file" << endl);
-  }
-}
+    std::string Key;
+    std::streamoff Offset;
+    std::streamoff Size;
+    std::vector<int> Values;
+  };
 
-template <typename... Args>
-void xfscanf(FILE* stream, const char* format, Args... args)
-{
-  int ret = fscanf(stream, format, args...);
-  (void)ret;
-}
-}
+  vtksys::ifstream Stream;
+  std::vector<char> Buffer;
+  std::vector<Header> Headers;
+  size_t NextHeader = 0;
+  const Header* CurrentHeader = nullptr;
+  std::string CurrentKey;
+  bool WrongEndian = false;
+};
 
-int vtkPhastaReader::readHeader(FILE* fileObject, const char phrase[], int* params, int expect)
+//----------------------------------------------------------------------------
+bool vtkPhastaFile::Open(const char* fileName)
 {
-  char* text_header;
-  char* token;
-  char Line[1024];
-  char junk;
-  int FOUND = 0;
-  size_t real_length;
-  int skip_size, integer_value;
-  int rewind_count = 0;
-
-  if (!fgets(Line, 1024, fileObject) && feof(fileObject))
+  this->Buffer.resize(HeaderBufferSize);
+  this->Stream.rdbuf()->pubsetbuf(this->Buffer.data(), HeaderBufferSize);
+  this->Stream.open(fileName, ios::in | ios::binary);
+  if (!this->Stream)
   {
-    rewind(fileObject);
-    clearerr(fileObject);
-    rewind_count++;
-
-    xfgets(Line, 1024, fileObject);
+    vtkGenericWarningMacro(<< "unable to open file : " << fileName << endl);
+    return false;
   }
 
-  while (!FOUND && (rewind_count < 2))
+  std::string line;
+  while (std::getline(this->Stream, line))
   {
-    if ((Line[0] != '\n') && (real_length = strcspn(Line, "#")))
+    // Everything following a '#' is a comment.
+    std::string text = line.substr(0, line.find('#'));
+    if (text.empty())
     {
-      text_header = new char[real_length + 1];
-      strncpy(text_header, Line, real_length);
-      text_header[real_length] = static_cast<char>(NULL);
-      token = strtok(text_header, ":");
-      if (cscompare(phrase, token))
-      {
-        FOUND = 1;
-        token = strtok(NULL, " ,;<>");
-        skip_size = atoi(token);
-        int i;
-        for (i = 0; i < expect && (token = strtok(NULL, " ,;<>")); i++)
-        {
-          params[i] = atoi(token);
-        }
-        if (i < expect)
-        {
-          vtkGenericWarningMacro(<< "Expected # of ints not found for: " << phrase << endl);
-        }
-      }
-      else if (cscompare(token, "byteorder magic number"))
-      {
-        if (binary_format)
-        {
-          xfread((void*)&integer_value, sizeof(int), 1, fileObject);
-          xfread(&junk, sizeof(char), 1, fileObject);
-          if (362436 != integer_value)
-          {
-            Wrong_Endian = 1;
-          }
-        }
-        else
-        {
-          xfscanf(fileObject, "%d\n", &integer_value);
-        }
-      }
-      else
-      {
-        /* some other header, so just skip over */
-        token = strtok(NULL, " ,;<>");
-        skip_size = atoi(token);
-        if (binary_format)
-        {
-          fseek(fileObject, skip_size, SEEK_CUR);
-        }
-        else
-        {
-          for (int gama = 0; gama < skip_size; gama++)
-          {
-            xfgets(Line, 1024, fileObject);
-          }
-        }
-      }
-      delete[] text_header;
+      continue;
     }
-
-    if (!FOUND)
+    std::string::size_type colon = text.find(':');
+    Header header;
+    header.Key = text.substr(0, colon);
+    std::vector<int> values =
+      ParseHeaderValues(colon == std::string::npos ? std::string() : text.substr(colon + 1));
+    if (cscompare(header.Key.c_str(), "byteorder magic number"))
     {
-      if (!fgets(Line, 1024, fileObject) && feof(fileObject))
-      {
-        rewind(fileObject);
-        clearerr(fileObject);
-        rewind_count++;
-        xfgets(Line, 1024, fileObject);
-      }
+      int magicNumber = 0;
+      char newline;
+      this->Stream.read(reinterpret_cast<char*>(&magicNumber), sizeof(int));
+      this->Stream.read(&newline, 1);
+      this->WrongEndian = magicNumber != 362436;
+      continue;
     }
-  }
-
-  if (!FOUND)
-  {
-    vtkGenericWarningMacro(<< "Could not find: " << phrase << endl);
-    return 1;
-  }
-  return 0;
-}
-
-void vtkPhastaReader::SwapArrayByteOrder(void* array, int nbytes, int nItems)
-{
-  /* This swaps the byte order for the array of nItems each
-     of size nbytes , This will be called only locally  */
-  int i, j;
-  unsigned char ucTmp;
-  unsigned char* ucDst = (unsigned char*)array;
-
-  for (i = 0; i < nItems; i++)
-  {
-    for (j = 0; j < (nbytes / 2); j++)
+    // The first value is the size of the data block following the header.
+    header.Size = values.empty() ? 0 : std::max(values[0], 0);
+    header.Offset = this->Stream.tellg();
+    if (!values.empty())
     {
-      swap_char(ucDst[j], ucDst[(nbytes - 1) - j]);
+      header.Values.assign(values.begin() + 1, values.end());
     }
-    ucDst += nbytes;
-  }
-}
-
-void vtkPhastaReader::openfile(const char filename[], const char mode[], int* fileDescriptor)
-{
-  FILE* file = NULL;
-  *fileDescriptor = 0;
-  // Stripping a filename is not correct, since
-  // filenames can certainly have spaces.
-  // char* fname = StringStripper( filename );
-  const char* fname = filename;
-  char* imode = StringStripper(mode);
-
-  if (cscompare("read", imode))
-  {
-    file = fopen(fname, "rb");
-  }
-  else if (cscompare("write", imode))
-  {
-    file = fopen(fname, "wb");
-  }
-  else if (cscompare("append", imode))
-  {
-    file = fopen(fname, "ab");
-  }
-
-  if (!file)
-  {
-    vtkGenericWarningMacro(<< "unable to open file : " << fname << endl);
-  }
-  else
-  {
-    fileArray.push_back(file);
-    byte_order.push_back(0);
-    header_type.push_back(sizeof(int));
-    *fileDescriptor = static_cast<int>(fileArray.size());
-  }
-  delete[] imode;
-}
-
-void vtkPhastaReader::closefile(int* fileDescriptor, const char mode[])
-{
-  char* imode = StringStripper(mode);
-
-  if (cscompare("write", imode) || cscompare("append", imode))
-  {
-    fflush(fileArray[*fileDescriptor - 1]);
+    this->Headers.push_back(header);
+    this->Stream.seekg(header.Size, ios::cur);
   }
-
-  fclose(fileArray[*fileDescriptor - 1]);
-  delete[] imode;
+  this->Stream.clear();
+  return true;
 }
 
-void vtkPhastaReader::readheader(int* fileDescriptor, const char keyphrase[], void* valueArray,
-  int* nItems, const char datatype[], const char iotype[])
+//----------------------------------------------------------------------------
+bool vtkPhastaFile::ReadHeader(const char* key, int* params, int expect)
 {
-  int filePtr = *fileDescriptor - 1;
-  FILE* fileObject;
-  int* valueListInt;
-
-  if (*fileDescriptor < 1 || *fileDescriptor > (int)fileArray.size())
+  this->CurrentKey = key;
+  this->CurrentHeader = nullptr;
+  const size_t numHeaders = this->Headers.size();
+  for (size_t cc = 0; cc < numHeaders; ++cc)
   {
-    vtkGenericWarningMacro(<< "No file associated with Descriptor " << *fileDescriptor << "\n"
-                           << "openfile function has to be called before \n"
-                           << "accessing the file\n "
-                           << "fatal error: cannot continue, returning out of call\n");
-    return;
-  }
-
-  LastHeaderKey[filePtr] = const_cast<char*>(keyphrase);
-  LastHeaderNotFound = 0;
-
-  fileObject = fileArray[filePtr];
-  Wrong_Endian = byte_order[filePtr];
-
-  isBinary(iotype);
-  typeSize(datatype); // redundant call, just avoid a compiler warning.
-
-  // right now we are making the assumption that we will only write integers
-  // on the header line.
-
-  valueListInt = static_cast<int*>(valueArray);
-  int ierr = readHeader(fileObject, keyphrase, valueListInt, *nItems);
-
-  byte_order[filePtr] = Wrong_Endian;
-
-  if (ierr)
-  {
-    LastHeaderNotFound = 1;
+    const size_t index = (this->NextHeader + cc) % numHeaders;
+    const Header& header = this->Headers[index];
+    if (cscompare(key, header.Key.c_str()))
+    {
+      this->CurrentHeader = &header;
+      this->NextHeader = index + 1;
+      int i;
+      for (i = 0; i < expect && i < static_cast<int>(header.Values.size()); i++)
+      {
+        params[i] = header.Values[i];
+      }
+      if (i < expect)
+      {
+        vtkGenericWarningMacro(<< "Expected # of ints not found for: " << key << endl);
+      }
+      return true;
+    }
   }
-
-  return;
+  vtkGenericWarningMacro(<< "Could not find: " << key << endl);
+  return false;
 }
 
-void vtkPhastaReader::readdatablock(int* fileDescriptor, const char keyphrase[], void* valueArray,
-  int* nItems, const char datatype[], const char iotype[])
+//----------------------------------------------------------------------------
+bool vtkPhastaFile::ReadDataBlock(
+  const char* key, void* values, size_t count, const char* datatype)
 {
-  int filePtr = *fileDescriptor - 1;
-  FILE* fileObject;
-  char junk;
-
-  if (*fileDescriptor < 1 || *fileDescriptor > (int)fileArray.size())
-  {
-    vtkGenericWarningMacro(<< "No file associated with Descriptor " << *fileDescriptor << "\n"
-                           << "openfile function has to be called before \n"
-                           << "accessing the file\n "
-                           << "fatal error: cannot continue, returning out of call\n");
-    return;
-  }
-
-  // error check..
   // since we require that a consistent header always precede the data block
   // let us check to see that it is actually the case.
-
-  if (!cscompare(LastHeaderKey[filePtr], keyphrase))
+  if (!cscompare(this->CurrentKey.c_str(), key))
   {
     vtkGenericWarningMacro(<< "Header not consistent with data block\n"
-                           << "Header: " << LastHeaderKey[filePtr] << "\n"
-                           << "DataBlock: " << keyphrase << "\n"
+                           << "Header: " << this->CurrentKey << "\n"
+                           << "DataBlock: " << key << "\n"
                            << "Please recheck read sequence \n");
-    if (Strict_Error)
-    {
-      vtkGenericWarningMacro(<< "fatal error: cannot continue, returning out of call\n");
-      return;
-    }
   }
-
-  if (LastHeaderNotFound)
+  if (!this->CurrentHeader)
   {
-    return;
+    return false;
   }
 
-  fileObject = fileArray[filePtr];
-  Wrong_Endian = byte_order[filePtr];
-
-  size_t type_size = typeSize(datatype);
-  int nUnits = *nItems;
-  isBinary(iotype);
+  const size_t type_size = typeSize(datatype);
+  const std::streamsize bytes = static_cast<std::streamsize>(type_size * count);
+  if (bytes > this->CurrentHeader->Size)
+  {
+    vtkGenericWarningMacro(<< "Data block of " << this->CurrentHeader->Key << " holds "
+                           << this->CurrentHeader->Size << " bytes, " << bytes
+                           << " were requested" << endl);
+    return false;
+  }
 
-  if (binary_format)
+  this->Stream.seekg(this->CurrentHeader->Offset);
+  this->Stream.read(static_cast<char*>(values), bytes);
+  if (this->Stream.gcount() != bytes)
   {
-    xfread(valueArray, type_size, nUnits, fileObject);
-    xfread(&junk, sizeof(char), 1, fileObject);
-    if (Wrong_Endian)
-    {
-      SwapArrayByteOrder(valueArray, static_cast<int>(type_size), nUnits);
-    }
+    vtkGenericWarningMacro(<< "Could not read or end of file" << endl);
+    this->Stream.clear();
+    return false;
   }
-  else
+  if (this->WrongEndian)
   {
-    char* ts1 = StringStripper(datatype);
-    if (cscompare("integer", ts1))
-    {
-      for (int n = 0; n < nUnits; n++)
-      {
-        xfscanf(fileObject, "%d\n", (int*)((int*)valueArray + n));
-      }
-    }
-    else if (cscompare("double", ts1))
-    {
-      for (int n = 0; n < nUnits; n++)
-      {
-        xfscanf(fileObject, "%lf\n", (double*)((double*)valueArray + n));
-      }
-    }
-    delete[] ts1;
+    vtkByteSwap::SwapVoidRange(values, count, type_size);
   }
-
-  return;
+  return true;
+}
 }
-
-// End of copy from phastaIO
 
 vtkPhastaReader::vtkPhastaReader()
 {
@@ -528,19 +332,29 @@ void vtkPhastaReader::SetFieldInfo(const char* paraviewFieldTag, const char* pha
   info.DataType = dataType;
 }
 
+void vtkPhastaReader::CopyFieldInfo(vtkPhastaReader* source)
+{
+  this->Internal->FieldInfoMap = source->Internal->FieldInfoMap;
+}
+
 int vtkPhastaReader::RequestData(
   vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
 {
-  int firstVertexNo = 0;
-  int fvn = 0;
-  int noOfNodes, noOfCells, noOfDatas;
-
   // get the data object
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
 
   vtkUnstructuredGrid* output =
     vtkUnstructuredGrid::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
+  return this->ReadPiece(output);
+}
+
+int vtkPhastaReader::ReadPiece(vtkUnstructuredGrid* output)
+{
+  int firstVertexNo = 0;
+  int fvn = 0;
+  int noOfNodes, noOfCells, noOfDatas;
+
   if (this->GetCachedGrid())
   {
     // shallow the cached grid that was previously set...
@@ -549,12 +363,6 @@ int vtkPhastaReader::RequestData(
   }
   else
   {
-    vtkPoints* points;
-
-    output->Allocate(10000, 2100);
-
-    points = vtkPoints::New();
-
     vtkDebugMacro(<< "Reading Phasta file...");
 
     if (!this->GeometryFileName || !this->FieldFileName)
@@ -562,12 +370,18 @@ int vtkPhastaReader::RequestData(
       vtkErrorMacro(<< "All input parameters not set.");
       return 0;
     }
+
+    output->Allocate(10000, 2100);
+
+    vtkPoints* points = vtkPoints::New();
+
     vtkDebugMacro(<< "Updating ensa with ....");
     vtkDebugMacro(<< "Geom File : " << this->GeometryFileName);
     vtkDebugMacro(<< "Field File : " << this->FieldFileName);
 
     fvn = firstVertexNo;
-    this->ReadGeomFile(this->GeometryFileName, firstVertexNo, points, noOfNodes, noOfCells);
+    this->ReadGeomFile(
+      this->GeometryFileName, firstVertexNo, output, points, noOfNodes, noOfCells);
     /* set the points over here, this is because vtkUnStructuredGrid
        only insert points once, next insertion overwrites the previous one */
     // acbauer is not sure why the above comment is about...
@@ -616,12 +430,11 @@ int vtkPhastaReader::RequestData(
    them into one, ReadGeomfile can then be called repeatedly from Execute with
    firstVertexNo forming consecutive series of vertex numbers */
 
-void vtkPhastaReader::ReadGeomFile(
-  char* geomFileName, int& firstVertexNo, vtkPoints* points, int& num_nodes, int& num_cells)
+void vtkPhastaReader::ReadGeomFile(char* geomFileName, int& firstVertexNo,
+  vtkUnstructuredGrid* output, vtkPoints* points, int& num_nodes, int& num_cells)
 {
 
   /* variables for vtk */
-  vtkUnstructuredGrid* output = this->GetOutput();
   double* coordinates;
   vtkIdType* nodes;
   int cell_type;
@@ -640,34 +453,31 @@ void vtkPhastaReader::ReadGeomFile(
   int* connectivity = NULL;
 
   /* misc variables*/
-  int i, j, k, item;
-  int geomfile;
-
-  openfile(geomFileName, "read", &geomfile);
-  // geomfile = fopen(GeometryFileName,"rb");
+  int i, j, k;
+  vtkPhastaFile geomfile;
 
-  if (!geomfile)
+  if (!geomfile.Open(geomFileName))
   {
     vtkErrorMacro(<< "Cannot open file " << geomFileName);
     return;
   }
 
   int expect;
-  int array[10];
+  int array[10] = { 0 };
   expect = 1;
 
   /* read number of nodes */
 
-  readheader(&geomfile, "number of nodes", array, &expect, "integer", "binary");
+  geomfile.ReadHeader("number of nodes", array, expect);
   num_nodes = array[0];
 
   /* read number of elements */
-  readheader(&geomfile, "number of interior elements", array, &expect, "integer", "binary");
+  geomfile.ReadHeader("number of interior elements", array, expect);
   num_elems = array[0];
   num_cells = array[0];
 
   /* read number of interior */
-  readheader(&geomfile, "number of interior tpblocks", array, &expect, "integer", "binary");
+  geomfile.ReadHeader("number of interior tpblocks", array, expect);
   num_int_blocks = array[0];
 
   vtkDebugMacro(<< "Nodes: " << num_nodes << "Elements: " << num_elems
@@ -675,7 +485,7 @@ void vtkPhastaReader::ReadGeomFile(
 
   /* read coordinates */
   expect = 2;
-  readheader(&geomfile, "co-ordinates", array, &expect, "double", "binary");
+  geomfile.ReadHeader("co-ordinates", array, expect);
   // TEST *******************
   num_nodes = array[0];
   // TEST *******************
@@ -705,8 +515,14 @@ void vtkPhastaReader::ReadGeomFile(
     return;
   }
 
-  item = num_nodes * dim;
-  readdatablock(&geomfile, "co-ordinates", pos, &item, "double", "binary");
+  if (!geomfile.ReadDataBlock(
+        "co-ordinates", pos, static_cast<size_t>(num_nodes) * dim, "double"))
+  {
+    vtkErrorMacro(<< "Cannot read the co-ordinates of " << geomFileName);
+    delete[] coordinates;
+    delete[] pos;
+    return;
+  }
 
   for (i = 0; i < num_nodes; i++)
   {
@@ -736,12 +552,13 @@ void vtkPhastaReader::ReadGeomFile(
 
   for (k = 0; k < num_int_blocks; k++)
   {
-    readheader(&geomfile, "connectivity interior", array, &expect, "integer", "binary");
+    geomfile.ReadHeader("connectivity interior", array, expect);
 
     /* read information about the block*/
     num_elems = array[0];
     num_vertices = array[1];
     num_per_line = array[3];
+    delete[] connectivity;
     connectivity = new int[num_elems * num_per_line];
 
     if (connectivity == NULL)
@@ -750,8 +567,12 @@ void vtkPhastaReader::ReadGeomFile(
       return;
     }
 
-    item = num_elems * num_per_line;
-    readdatablock(&geomfile, "connectivity interior", connectivity, &item, "integer", "binary");
+    if (!geomfile.ReadDataBlock("connectivity interior", connectivity,
+          static_cast<size_t>(num_elems) * num_per_line, "integer"))
+    {
+      vtkErrorMacro(<< "Cannot read the connectivity of " << geomFileName);
+      break;
+    }
 
     /* insert cells */
     for (i = 0; i < num_elems; i++)
@@ -798,7 +619,6 @@ void vtkPhastaReader::ReadGeomFile(
   firstVertexNo = firstVertexNo + num_nodes;
 
   // clean up
-  closefile(&geomfile, "read");
   delete[] coordinates;
   delete[] pos;
   delete[] connectivity;
@@ -809,19 +629,17 @@ void vtkPhastaReader::ReadFieldFile(
 {
 
   int i, j;
-  int item;
+  size_t item;
   double* data;
-  int fieldfile;
-
-  openfile(fieldFileName, "read", &fieldfile);
-  // fieldfile = fopen(FieldFileName,"rb");
+  vtkPhastaFile fieldfile;
 
-  if (!fieldfile)
+  if (!fieldfile.Open(fieldFileName))
   {
     vtkErrorMacro(<< "Cannot open file " << FieldFileName);
     return;
   }
-  int array[10], expect;
+  int array[10] = { 0 };
+  int expect;
 
   /* read the solution */
   vtkDoubleArray* pressure = vtkDoubleArray::New();
@@ -833,7 +651,7 @@ void vtkPhastaReader::ReadFieldFile(
   temperature->SetName("temperature");
 
   expect = 3;
-  readheader(&fieldfile, "solution", array, &expect, "double", "binary");
+  fieldfile.ReadHeader("solution", array, expect);
   noOfNodes = array[0];
   this->NumberOfVariables = array[1];
 
@@ -842,7 +660,7 @@ void vtkPhastaReader::ReadFieldFile(
   {
     sArrays[i] = 0;
   }
-  item = noOfNodes * this->NumberOfVariables;
+  item = static_cast<size_t>(noOfNodes) * this->NumberOfVariables;
   data = new double[item];
   if (data == NULL)
   {
@@ -850,7 +668,15 @@ void vtkPhastaReader::ReadFieldFile(
     return;
   }
 
-  readdatablock(&fieldfile, "solution", data, &item, "double", "binary");
+  if (!fieldfile.ReadDataBlock("solution", data, item, "double"))
+  {
+    vtkErrorMacro(<< "Cannot read the solution of " << fieldFileName);
+    pressure->Delete();
+    velocity->Delete();
+    temperature->Delete();
+    delete[] data;
+    return;
+  }
 
   for (i = 5; i < this->NumberOfVariables; i++)
   {
@@ -893,7 +719,6 @@ void vtkPhastaReader::ReadFieldFile(
   }
 
   // clean up
-  closefile(&fieldfile, "read");
   delete[] data;
 
 } // closes ReadFieldFile
@@ -903,18 +728,16 @@ void vtkPhastaReader::ReadFieldFile(
 {
 
   int i, j, numOfVars;
-  int item;
-  int fieldfile;
+  size_t item;
+  vtkPhastaFile fieldfile;
 
-  openfile(fieldFileName, "read", &fieldfile);
-  // fieldfile = fopen(FieldFileName,"rb");
-
-  if (!fieldfile)
+  if (!fieldfile.Open(fieldFileName))
   {
     vtkErrorMacro(<< "Cannot open file " << FieldFileName);
     return;
   }
-  int array[10], expect;
+  int array[10] = { 0 };
+  int expect;
 
   int activeScalars = 0, activeTensors = 0;
 
@@ -959,7 +782,11 @@ void vtkPhastaReader::ReadFieldFile(
     dataArray->SetNumberOfComponents(numOfComps);
 
     expect = 3;
-    readheader(&fieldfile, phastaFieldTag, array, &expect, dataType, "binary");
+    if (!fieldfile.ReadHeader(phastaFieldTag, array, expect))
+    {
+      dataArray->Delete();
+      continue;
+    }
     noOfDatas = array[0];
     this->NumberOfVariables = array[1];
     numOfVars = array[1];
@@ -986,7 +813,7 @@ void vtkPhastaReader::ReadFieldFile(
       continue;
     }
 
-    item = numOfVars * noOfDatas;
+    item = static_cast<size_t>(numOfVars) * noOfDatas;
     if (dtype == 0)
     { // data is type double
 
@@ -1001,7 +828,13 @@ void vtkPhastaReader::ReadFieldFile(
         continue;
       }
 
-      readdatablock(&fieldfile, phastaFieldTag, data, &item, dataType, "binary");
+      if (!fieldfile.ReadDataBlock(phastaFieldTag, data, item, dataType))
+      {
+        vtkErrorMacro(<< "Cannot read " << phastaFieldTag << " from " << fieldFileName);
+        dataArray->Delete();
+        delete[] data;
+        continue;
+      }
 
       switch (numOfComps)
       {
@@ -1078,7 +911,13 @@ void vtkPhastaReader::ReadFieldFile(
         continue;
       }
 
-      readdatablock(&fieldfile, phastaFieldTag, data, &item, dataType, "binary");
+      if (!fieldfile.ReadDataBlock(phastaFieldTag, data, item, dataType))
+      {
+        vtkErrorMacro(<< "Cannot read " << phastaFieldTag << " from " << fieldFileName);
+        dataArray->Delete();
+        delete[] data;
+        continue;
+      }
 
       switch (numOfComps)
       {
@@ -1174,9 +1013,6 @@ void vtkPhastaReader::ReadFieldFile(
     // delete [] data;
   }
 
-  // close up
-  closefile(&fieldfile, "read");
-
 } // closes ReadFieldFile
 
 void vtkPhastaReader::PrintSelf(ostream& os, vtkIndent indent)
@@ -67,9 +67,21 @@ public:
     int numOfComps, int dataDependency, const char* dataType);
   //@}
 
+  /**
+   * Copy the field info set with SetFieldInfo() from another reader.
+   */
+  void CopyFieldInfo(vtkPhastaReader* source);
+
   void SetCachedGrid(vtkUnstructuredGrid*);
   vtkGetObjectMacro(CachedGrid, vtkUnstructuredGrid);
 
+  /**
+   * Read the geometry and field files into output without going through the
+   * pipeline. All the state of the files being read is held by the instance,
+   * so distinct instances can read concurrently. Returns 0 on failure.
+   */
+  int ReadPiece(vtkUnstructuredGrid* output);
+
 protected:
   vtkPhastaReader();
   ~vtkPhastaReader() override;
@@ -77,8 +89,8 @@ protected:
   int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
 
-  void ReadGeomFile(
-    char* GeomFileName, int& firstVertexNo, vtkPoints* points, int& noOfNodes, int& noOfCells);
+  void ReadGeomFile(char* GeomFileName, int& firstVertexNo, vtkUnstructuredGrid* output,
+    vtkPoints* points, int& noOfNodes, int& noOfCells);
   void ReadFieldFile(
     char* fieldFileName, int firstVertexNo, vtkDataSetAttributes* field, int& noOfNodes);
   void ReadFieldFile(
@@ -91,20 +103,6 @@ private:
 
   int NumberOfVariables; // number of variable in the field file
 
-  static char* StringStripper(const char istring[]);
-  static int cscompare(const char teststring[], const char targetstring[]);
-  static void isBinary(const char iotype[]);
-  static size_t typeSize(const char typestring[]);
-  static int readHeader(FILE* fileObject, const char phrase[], int* params, int expect);
-  static void SwapArrayByteOrder(void* array, int nbytes, int nItems);
-  static void openfile(const char filename[], const char mode[], int* fileDescriptor);
-  static void closefile(int* fileDescriptor, const char mode[]);
-  static void readheader(int* fileDescriptor, const char keyphrase[], void* valueArray, int* nItems,
-    const char datatype[], const char iotype[]);
-  static void readdatablock(int* fileDescriptor, const char keyphrase[], void* valueArray,
-    int* nItems, const char datatype[], const char iotype[]);
-
-private:
   vtkPhastaReaderInternal* Internal;
 
   vtkPhastaReader(const vtkPhastaReader&) = delete;
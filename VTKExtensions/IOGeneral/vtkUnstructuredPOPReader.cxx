@@ -46,6 +46,8 @@ PURPOSE.  See the above copyright notice for more information.
 
 #include <algorithm>
 #include <iterator>
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -191,6 +193,29 @@ void ComputeDirectionCosines(const double point[3], double directionCosines[3][3
   vtkMath::Perpendiculars(directionCosines[0], directionCosines[1], directionCosines[2], 0);
 }
 
+//-----------------------------------------------------------------------------
+// The grid file that maps the tripolar logical coordinates to lat-lon
+// coordinates. It lives in the same directory as the data files.
+std::string GetGridFileName(const char* fileName)
+{
+  return vtksys::SystemTools::GetFilenamePath(fileName) + "/GRID.nc";
+}
+
+//-----------------------------------------------------------------------------
+// Unit vector from the start to the end lat-lon location, both in degrees.
+void ComputeUnitDirection(double startLon, double startLat, double endLon, double endLat,
+  double direction[3])
+{
+  startLon = vtkMath::RadiansFromDegrees(startLon);
+  startLat = vtkMath::RadiansFromDegrees(startLat);
+  endLon = vtkMath::RadiansFromDegrees(endLon);
+  endLat = vtkMath::RadiansFromDegrees(endLat);
+  direction[0] = cos(endLat) * cos(endLon) - cos(startLat) * cos(startLon);
+  direction[1] = cos(endLat) * sin(endLon) - cos(startLat) * sin(startLon);
+  direction[2] = sin(endLat) - sin(startLat);
+  vtkMath::Normalize(direction);
+}
+
 } // end anonymous namespace
 
 vtkStandardNewMacro(vtkUnstructuredPOPReader);
@@ -214,10 +239,57 @@ public:
   // a mapping from the list of all variables to the list of available
   // point-based variables
   std::vector<int> VariableMap;
+
+  // The POP grid does not change over a run, so everything that only depends
+  // on GRID.nc and on the extent being read is kept between time steps. The
+  // data file of each time step only provides the extents.
+  struct GridKey
+  {
+    std::string GridFileName;
+    long GridFileTime;
+    // whole extent, sub extent, stride, vector grid, piece, number of pieces,
+    // number of ghost levels and wrapping
+    std::vector<int> Extents;
+    double Radius;
+
+    bool operator==(const GridKey& other) const
+    {
+      return this->GridFileName == other.GridFileName &&
+        this->GridFileTime == other.GridFileTime && this->Extents == other.Extents &&
+        this->Radius == other.Radius;
+    }
+  };
+  GridKey CachedGridKey;
+
+  // the transformed points, the cells and the ghost arrays
+  vtkSmartPointer<vtkUnstructuredGrid> CachedGrid;
+
+  // for each column of points, the unit vectors in the logical x and y
+  // directions used to transform the horizontal vector components
+  std::vector<double> ColumnBases;
+
+  // the depth structure of the ocean used to compute the vertical velocity
+  std::unique_ptr<VTKPointIterator> PointIterator;
+  std::vector<float> WDep;
+
+  // which processes exchange integrated vertical velocities, and for which
+  // columns
+  struct VerticalVelocityExchange
+  {
+    bool Initialized = false;
+    std::map<int, int> Receives;
+    std::map<vtkIdType, std::vector<int> > SendIndices;
+    std::map<vtkIdType, std::vector<vtkIdType> > SendPointIds;
+  };
+  VerticalVelocityExchange Exchange;
+
   vtkUnstructuredPOPReaderInternal()
   {
     this->VariableArraySelection = vtkSmartPointer<vtkDataArraySelection>::New();
   }
+  ~vtkUnstructuredPOPReaderInternal();
+
+  void ClearGridCache();
 };
 
 //----------------------------------------------------------------------------
@@ -501,8 +573,39 @@ int vtkUnstructuredPOPReader::ProcessGrid(
   ptrdiff_t rStride[3] = { (ptrdiff_t) this->Stride[2], (ptrdiff_t) this->Stride[1],
     (ptrdiff_t) this->Stride[0] };
 
-  // initialize memory (raw data space, x y z axis space) and rectilinear grid
-  bool firstPass = true;
+  // the geometry only depends on GRID.nc and on the extents, so it is only
+  // built when one of them changes
+  vtkUnstructuredPOPReaderInternal::GridKey key;
+  key.GridFileName = GetGridFileName(this->FileName);
+  key.GridFileTime = vtksys::SystemTools::ModifiedTime(key.GridFileName);
+  key.Extents.insert(key.Extents.end(), wholeExtent, wholeExtent + 6);
+  key.Extents.insert(key.Extents.end(), subExtent, subExtent + 6);
+  key.Extents.insert(key.Extents.end(), this->Stride, this->Stride + 3);
+  key.Extents.push_back(this->VectorGrid);
+  key.Extents.push_back(piece);
+  key.Extents.push_back(numberOfPieces);
+  key.Extents.push_back(numberOfGhostLevels);
+  key.Extents.push_back(wrapped);
+  key.Radius = this->Radius;
+  if (!this->Internals->CachedGrid || !(key == this->Internals->CachedGridKey))
+  {
+    this->Internals->ClearGridCache();
+    vtkNew<vtkUnstructuredGrid> cachedGrid;
+    if (!this->BuildGrid(cachedGrid.GetPointer(), start, count, wholeExtent, subExtent,
+          numberOfGhostLevels, wrapped, piece, numberOfPieces))
+    {
+      if (netCDFFD != -1)
+      {
+        nc_close(netCDFFD);
+      }
+      return 0;
+    }
+    this->Internals->CachedGrid = cachedGrid.GetPointer();
+    this->Internals->CachedGridKey = key;
+  }
+  grid->ShallowCopy(this->Internals->CachedGrid);
+
+  // only the variables are read for each time step
   for (size_t i = 0; i < this->Internals->VariableMap.size(); i++)
   {
     if (this->Internals->VariableMap[i] != -1 &&
@@ -515,110 +618,6 @@ int vtkUnstructuredPOPReader::ProcessGrid(
         this->Internals->VariableArraySelection->GetArrayName(this->Internals->VariableMap[i]),
         &varidp);
 
-      if (firstPass == true)
-      {
-        int dimidsp[3];
-        nc_inq_vardimid(this->NCDFFD, varidp, dimidsp);
-        firstPass = false;
-        std::vector<float> z(count[0]);
-        std::vector<float> y(count[1]);
-        std::vector<float> x(count[2]);
-        // gets data from x,y,z axis (spacing)
-        nc_get_vars_float(this->NCDFFD, dimidsp[0], start, count, rStride, &(z[0]));
-        nc_get_vars_float(this->NCDFFD, dimidsp[1], start + 1, count + 1, rStride + 1, &(y[0]));
-        nc_get_vars_float(this->NCDFFD, dimidsp[2], start + 2, count + 2, rStride + 2, &(x[0]));
-
-        vtkNew<vtkPoints> points;
-        grid->SetPoints(points.GetPointer());
-        points->SetDataTypeToFloat();
-        points->SetNumberOfPoints(count[0] * count[1] * count[2]);
-        float point[3];
-        vtkIntArray* indexArray = vtkIntArray::New();
-        indexArray->SetNumberOfComponents(2);
-        indexArray->SetNumberOfTuples(points->GetNumberOfPoints());
-        indexArray->SetName("indices");
-        int ind[2];
-        for (size_t iz = 0; iz < count[0]; iz++)
-        {
-          point[2] = -z[iz];
-          for (size_t iy = 0; iy < count[1]; iy++)
-          {
-            point[1] = y[iy];
-            ind[1] = static_cast<int>(iy);
-            for (size_t ix = 0; ix < count[2]; ix++)
-            {
-              point[0] = x[ix];
-              ind[0] = static_cast<int>(ix);
-              vtkIdType id = ix + iy * count[2] + iz * count[2] * count[1];
-              indexArray->SetTypedTuple(id, ind);
-              points->SetPoint(id, point);
-            }
-          }
-        }
-        grid->GetPointData()->AddArray(indexArray);
-        indexArray->Delete();
-
-        // need to create the cells
-        vtkIdType pointIds[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-        // we make sure that value is at least 1 so that we can do both quads and hexes
-        size_t count2Plus = std::max(count[2], static_cast<size_t>(1));
-        size_t count1Plus = std::max(count[1], static_cast<size_t>(1));
-        grid->Allocate(std::max(count[0] - 1, static_cast<size_t>(1)) *
-          std::max(count[1] - 1, static_cast<size_t>(1)) *
-          std::max(count[2] - 1 + wrapped, static_cast<size_t>(1)));
-        size_t iz = 0;
-        do // make sure we loop through iz once
-        {
-          size_t iy = 0;
-          do // make sure we loop through iy once
-          {
-            size_t ix = 0;
-            do // make sure we loop through ix once
-            {
-              pointIds[0] = ix + iy * count2Plus + (1 + iz) * count2Plus * count1Plus;
-              pointIds[1] = 1 + ix + iy * count2Plus + (1 + iz) * count2Plus * count1Plus;
-              pointIds[2] = 1 + ix + (1 + iy) * count2Plus + (1 + iz) * count2Plus * count1Plus;
-              pointIds[3] = ix + (1 + iy) * count2Plus + (1 + iz) * count2Plus * count1Plus;
-              pointIds[4] = ix + iy * count2Plus + iz * count2Plus * count1Plus;
-              pointIds[5] = 1 + ix + iy * count2Plus + iz * count2Plus * count1Plus;
-              pointIds[6] = 1 + ix + (1 + iy) * count2Plus + iz * count2Plus * count1Plus;
-              pointIds[7] = ix + (1 + iy) * count2Plus + iz * count2Plus * count1Plus;
-
-              if (wrapped && ix == count[2] - 1)
-              {
-                pointIds[1] = iy * count2Plus + (1 + iz) * count2Plus * count1Plus;
-                pointIds[2] = (1 + iy) * count2Plus + (1 + iz) * count2Plus * count1Plus;
-                pointIds[5] = iy * count2Plus + iz * count2Plus * count1Plus;
-                pointIds[6] = (1 + iy) * count2Plus + iz * count2Plus * count1Plus;
-              }
-
-              if (count[0] < 2)
-              { // constant depth/logical z
-                grid->InsertNextCell(VTK_QUAD, 4, pointIds + 4);
-              }
-              else if (count[1] < 2)
-              { // constant latitude/logical y
-                pointIds[6] = pointIds[1];
-                pointIds[7] = pointIds[0];
-                grid->InsertNextCell(VTK_QUAD, 4, pointIds + 4);
-              }
-              else if (count[2] < 2)
-              { // constant longitude/logical x
-                pointIds[6] = pointIds[0];
-                pointIds[7] = pointIds[1];
-                grid->InsertNextCell(VTK_QUAD, 4, pointIds + 4);
-              }
-              else
-              {
-                grid->InsertNextCell(VTK_HEXAHEDRON, 8, pointIds);
-              }
-              ix++;
-            } while (ix < count[2] - 1 + wrapped);
-            iy++;
-          } while (iy < count[1] - 1);
-          iz++;
-        } while (iz < count[0] - 1);
-      } // done creating the points and cells
       // create vtkFloatArray and get the scalars into it
       this->LoadPointData(grid, this->NCDFFD, varidp, start, count, rStride,
         this->Internals->VariableArraySelection->GetArrayName(this->Internals->VariableMap[i]));
@@ -642,10 +641,9 @@ int vtkUnstructuredPOPReader::ProcessGrid(
     nc_close(netCDFFD);
   }
 
-  // transform from logical tripolar coordinates to a sphere.  also transforms
-  // any vector quantities
-  this->Transform(grid, start, count, wholeExtent, subExtent, numberOfGhostLevels, wrapped, piece,
-    numberOfPieces);
+  // transform any vector quantities from logical tripolar coordinates to the
+  // sphere
+  this->Transform(grid, count, wholeExtent, subExtent, numberOfGhostLevels);
 
   return 1;
 }
@@ -702,24 +700,24 @@ void vtkUnstructuredPOPReader::SetVariableArrayStatus(const char* name, int stat
 }
 
 //-----------------------------------------------------------------------------
-bool vtkUnstructuredPOPReader::Transform(vtkUnstructuredGrid* grid, size_t* start, size_t* count,
+bool vtkUnstructuredPOPReader::BuildGrid(vtkUnstructuredGrid* grid, size_t* start, size_t* count,
   int* wholeExtent, int* subExtent, int numberOfGhostLevels, int wrapped, int piece,
   int numberOfPieces)
 {
   if (this->VectorGrid != 1 && this->VectorGrid != 2)
   {
     vtkErrorMacro("Don't know if this should be a scalar or vector field grid.");
-    return 0;
+    return false;
   }
 
   int latlonFileId = 0;
-  std::string gridFileName = vtksys::SystemTools::GetFilenamePath(this->FileName) + "/GRID.nc";
+  std::string gridFileName = GetGridFileName(this->FileName);
   int retval = nc_open(gridFileName.c_str(), NC_NOWRITE, &latlonFileId);
   if (retval != NC_NOERR) // checks if read file error
   {
     // we don't need to close the file if there was an error opening the file
     vtkErrorMacro(<< "Can't read file " << nc_strerror(retval));
-    return 0;
+    return false;
   }
 
   int varidp;
@@ -761,134 +759,175 @@ bool vtkUnstructuredPOPReader::Transform(vtkUnstructuredGrid* grid, size_t* star
   std::vector<float> realHeight(dimensions[2]);
   ptrdiff_t stride = static_cast<ptrdiff_t>(this->Stride[2]);
   nc_get_vars_float(latlonFileId, varidp, start, count, &stride, &(realHeight[0]));
-
-  // the vector arrays that need to be manipulated
-  std::vector<vtkFloatArray*> vectorArrays;
-  for (int i = 0; i < grid->GetPointData()->GetNumberOfArrays(); i++)
-  {
-    if (vtkFloatArray* array = vtkFloatArray::SafeDownCast(grid->GetPointData()->GetArray(i)))
-    {
-      if (array->GetNumberOfComponents() == 3)
-      {
-        vectorArrays.push_back(array);
-      }
-    }
-  }
+  nc_close(latlonFileId);
 
   size_t rStride[2] = { (size_t) this->Stride[1], (size_t) this->Stride[0] };
 
-  vtkPoints* points = grid->GetPoints();
+  vtkNew<vtkPoints> points;
+  grid->SetPoints(points.GetPointer());
+  points->SetDataTypeToFloat();
+  points->SetNumberOfPoints(count[0] * count[1] * count[2]);
+  vtkIntArray* indexArray = vtkIntArray::New();
+  indexArray->SetNumberOfComponents(2);
+  indexArray->SetNumberOfTuples(points->GetNumberOfPoints());
+  indexArray->SetName("indices");
+  std::vector<double>& bases = this->Internals->ColumnBases;
+  bases.resize(count[1] * count[2] * 6);
 
   for (size_t j = 0; j < count[1]; j++) // y index
   {
-    for (size_t k = 0; k < count[0]; k++) // z index
+    for (size_t i = 0; i < count[2]; i++) // x index
     {
-      for (size_t i = 0; i < count[2]; i++) // x index
+      size_t latlonIndex = GetPOPIndexFromGridIndices(
+        2, dimensions, start + 1, rStride, static_cast<int>(i), static_cast<int>(j), 0);
+      if (latlonIndex >= dimensions[0] * dimensions[1])
+      {
+        vtkErrorMacro("Bad lat-lon index.");
+        continue;
+      }
+      double lonRadians = vtkMath::RadiansFromDegrees(realLongitude[latlonIndex]);
+      double latRadians = vtkMath::RadiansFromDegrees(realLatitude[latlonIndex]);
+      int ind[2] = { static_cast<int>(i), static_cast<int>(j) };
+      for (size_t k = 0; k < count[0]; k++) // z index
       {
         vtkIdType index = i + j * count[2] + k * count[2] * count[1];
-        if (index >= points->GetNumberOfPoints())
-        {
-          vtkErrorMacro("doooh");
-        }
-        size_t latlonIndex = GetPOPIndexFromGridIndices(2, dimensions, start + 1, rStride,
-          static_cast<int>(i), static_cast<int>(j), static_cast<int>(k));
-        if (latlonIndex >= dimensions[0] * dimensions[1])
-        {
-          vtkErrorMacro("Bad lat-lon index.");
-        }
-        double point[3];
-        points->GetPoint(index, point);
-        point[0] = realLongitude[latlonIndex];
-        point[1] = realLatitude[latlonIndex];
-
         // convert to spherical
         double radius = this->Radius - realHeight[k];
-        double lonRadians = vtkMath::RadiansFromDegrees(point[0]);
-        double latRadians = vtkMath::RadiansFromDegrees(point[1]);
-        bool sphere = true;
-        if (sphere)
+        points->SetPoint(index, radius * cos(latRadians) * cos(lonRadians),
+          radius * cos(latRadians) * sin(lonRadians), radius * sin(latRadians));
+        indexArray->SetTypedTuple(index, ind);
+      }
+
+      // the directions of the logical x and y axes at this column, the same
+      // at all depths
+      double* basis = &bases[(i + j * count[2]) * 6];
+      size_t startIndex = latlonIndex;
+      size_t endIndex = latlonIndex + 1;
+      if (start[2] + i * rStride[1] >= dimensions[1] - 2)
+      {
+        startIndex = latlonIndex - 1;
+        endIndex = latlonIndex;
+      }
+      ComputeUnitDirection(realLongitude[startIndex], realLatitude[startIndex],
+        realLongitude[endIndex], realLatitude[endIndex], basis);
+
+      startIndex = latlonIndex;
+      endIndex = latlonIndex + dimensions[1];
+      if (start[1] + j * rStride[0] >= dimensions[0] - 2)
+      {
+        startIndex = latlonIndex - dimensions[1];
+        endIndex = latlonIndex;
+      }
+      ComputeUnitDirection(realLongitude[startIndex], realLatitude[startIndex],
+        realLongitude[endIndex], realLatitude[endIndex], basis + 3);
+    }
+  }
+  grid->GetPointData()->AddArray(indexArray);
+  indexArray->Delete();
+
+  // need to create the cells
+  vtkIdType pointIds[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+  // we make sure that value is at least 1 so that we can do both quads and hexes
+  size_t count2Plus = std::max(count[2], static_cast<size_t>(1));
+  size_t count1Plus = std::max(count[1], static_cast<size_t>(1));
+  grid->Allocate(std::max(count[0] - 1, static_cast<size_t>(1)) *
+    std::max(count[1] - 1, static_cast<size_t>(1)) *
+    std::max(count[2] - 1 + wrapped, static_cast<size_t>(1)));
+  size_t iz = 0;
+  do // make sure we loop through iz once
+  {
+    size_t iy = 0;
+    do // make sure we loop through iy once
+    {
+      size_t ix = 0;
+      do // make sure we loop through ix once
+      {
+        pointIds[0] = ix + iy * count2Plus + (1 + iz) * count2Plus * count1Plus;
+        pointIds[1] = 1 + ix + iy * count2Plus + (1 + iz) * count2Plus * count1Plus;
+        pointIds[2] = 1 + ix + (1 + iy) * count2Plus + (1 + iz) * count2Plus * count1Plus;
+        pointIds[3] = ix + (1 + iy) * count2Plus + (1 + iz) * count2Plus * count1Plus;
+        pointIds[4] = ix + iy * count2Plus + iz * count2Plus * count1Plus;
+        pointIds[5] = 1 + ix + iy * count2Plus + iz * count2Plus * count1Plus;
+        pointIds[6] = 1 + ix + (1 + iy) * count2Plus + iz * count2Plus * count1Plus;
+        pointIds[7] = ix + (1 + iy) * count2Plus + iz * count2Plus * count1Plus;
+
+        if (wrapped && ix == count[2] - 1)
         {
-          point[0] = radius * cos(latRadians) * cos(lonRadians);
-          point[1] = radius * cos(latRadians) * sin(lonRadians);
-          point[2] = radius * sin(latRadians);
+          pointIds[1] = iy * count2Plus + (1 + iz) * count2Plus * count1Plus;
+          pointIds[2] = (1 + iy) * count2Plus + (1 + iz) * count2Plus * count1Plus;
+          pointIds[5] = iy * count2Plus + iz * count2Plus * count1Plus;
+          pointIds[6] = (1 + iy) * count2Plus + iz * count2Plus * count1Plus;
         }
-        points->SetPoint(index, point);
 
-        for (std::vector<vtkFloatArray*>::iterator vit = vectorArrays.begin();
-             vit != vectorArrays.end(); vit++)
+        if (count[0] < 2)
+        { // constant depth/logical z
+          grid->InsertNextCell(VTK_QUAD, 4, pointIds + 4);
+        }
+        else if (count[1] < 2)
+        { // constant latitude/logical y
+          pointIds[6] = pointIds[1];
+          pointIds[7] = pointIds[0];
+          grid->InsertNextCell(VTK_QUAD, 4, pointIds + 4);
+        }
+        else if (count[2] < 2)
+        { // constant longitude/logical x
+          pointIds[6] = pointIds[0];
+          pointIds[7] = pointIds[1];
+          grid->InsertNextCell(VTK_QUAD, 4, pointIds + 4);
+        }
+        else
         {
-          float values[3];
-          (*vit)->GetTypedTuple(index, values);
-
-          size_t startIndex = latlonIndex;
-          size_t endIndex = latlonIndex + 1;
-          if (start[2] + i * rStride[1] >= dimensions[1] - 2)
-          {
-            startIndex = latlonIndex - 1;
-            endIndex = latlonIndex;
-          }
-          float vals[3];
-
-          double startLon = vtkMath::RadiansFromDegrees(realLongitude[startIndex]);
-          double startLat = vtkMath::RadiansFromDegrees(realLatitude[startIndex]);
-
-          double startPos[3] = { radius * cos(startLat) * cos(startLon),
-            radius * cos(startLat) * sin(startLon), radius * sin(startLat) };
-
-          double endLon = vtkMath::RadiansFromDegrees(realLongitude[endIndex]);
-          double endLat = vtkMath::RadiansFromDegrees(realLatitude[endIndex]);
-
-          double endPos[3] = { radius * cos(endLat) * cos(endLon),
-            radius * cos(endLat) * sin(endLon), radius * sin(endLat) };
-
-          double norm = sqrt((endPos[0] - startPos[0]) * (endPos[0] - startPos[0]) +
-            (endPos[1] - startPos[1]) * (endPos[1] - startPos[1]) +
-            (endPos[2] - startPos[2]) * (endPos[2] - startPos[2]));
-
-          vals[0] = values[0] * (endPos[0] - startPos[0]) / norm;
-          vals[1] = values[0] * (endPos[1] - startPos[1]) / norm;
-          vals[2] = values[0] * (endPos[2] - startPos[2]) / norm;
-
-          startIndex = latlonIndex;
-          endIndex = latlonIndex + dimensions[1];
-          if (start[1] + j * rStride[0] >= dimensions[0] - 2)
-          {
-            startIndex = latlonIndex - dimensions[1];
-            endIndex = latlonIndex;
-          }
-          startLon = vtkMath::RadiansFromDegrees(realLongitude[startIndex]);
-          startLat = vtkMath::RadiansFromDegrees(realLatitude[startIndex]);
-
-          startPos[0] = radius * cos(startLat) * cos(startLon);
-          startPos[1] = radius * cos(startLat) * sin(startLon);
-          startPos[2] = radius * sin(startLat);
-
-          endLon = vtkMath::RadiansFromDegrees(realLongitude[endIndex]);
-          endLat = vtkMath::RadiansFromDegrees(realLatitude[endIndex]);
-
-          endPos[0] = radius * cos(endLat) * cos(endLon);
-          endPos[1] = radius * cos(endLat) * sin(endLon);
-          endPos[2] = radius * sin(endLat);
-
-          norm = sqrt((endPos[0] - startPos[0]) * (endPos[0] - startPos[0]) +
-            (endPos[1] - startPos[1]) * (endPos[1] - startPos[1]) +
-            (endPos[2] - startPos[2]) * (endPos[2] - startPos[2]));
+          grid->InsertNextCell(VTK_HEXAHEDRON, 8, pointIds);
+        }
+        ix++;
+      } while (ix < count[2] - 1 + wrapped);
+      iy++;
+    } while (iy < count[1] - 1);
+    iz++;
+  } while (iz < count[0] - 1);
+
+  return this->BuildGhostInformation(
+    grid, numberOfGhostLevels, wholeExtent, subExtent, wrapped, piece, numberOfPieces);
+}
 
-          vals[0] += values[1] * (endPos[0] - startPos[0]) / norm;
-          vals[1] += values[1] * (endPos[1] - startPos[1]) / norm;
-          vals[2] += values[1] * (endPos[2] - startPos[2]) / norm;
+//-----------------------------------------------------------------------------
+bool vtkUnstructuredPOPReader::Transform(vtkUnstructuredGrid* grid, size_t* count,
+  int* wholeExtent, int* subExtent, int numberOfGhostLevels)
+{
+  // the vector arrays that need to be manipulated
+  std::vector<vtkFloatArray*> vectorArrays;
+  for (int i = 0; i < grid->GetPointData()->GetNumberOfArrays(); i++)
+  {
+    if (vtkFloatArray* array = vtkFloatArray::SafeDownCast(grid->GetPointData()->GetArray(i)))
+    {
+      if (array->GetNumberOfComponents() == 3)
+      {
+        vectorArrays.push_back(array);
+      }
+    }
+  }
 
-          (*vit)->SetTypedTuple(index, vals);
-        }
+  const std::vector<double>& bases = this->Internals->ColumnBases;
+  const vtkIdType numberOfColumns = static_cast<vtkIdType>(count[1] * count[2]);
+  for (std::vector<vtkFloatArray*>::iterator vit = vectorArrays.begin();
+       vit != vectorArrays.end(); vit++)
+  {
+    float* values = (*vit)->GetPointer(0);
+    for (vtkIdType index = 0; index < (*vit)->GetNumberOfTuples(); index++, values += 3)
+    {
+      const double* basis = &bases[(index % numberOfColumns) * 6];
+      float vals[3];
+      for (int c = 0; c < 3; c++)
+      {
+        vals[c] = static_cast<float>(values[0] * basis[c] + values[1] * basis[3 + c]);
       }
+      std::copy(vals, vals + 3, values);
     }
   }
 
-  bool retVal = this->BuildGhostInformation(
-    grid, numberOfGhostLevels, wholeExtent, subExtent, wrapped, piece, numberOfPieces);
   if (this->VectorGrid && this->VerticalVelocity && this->ReducedHeightResolution == false)
   {
-    this->ComputeVerticalVelocity(grid, wholeExtent, subExtent, numberOfGhostLevels, latlonFileId);
+    this->ComputeVerticalVelocity(grid, wholeExtent, subExtent, numberOfGhostLevels);
     if (vtkMultiProcessController::GetGlobalController()->GetNumberOfProcesses() > 1)
     {
       // the last layer of ghost cells was added in order to do the vertical velocity calculation.
@@ -899,8 +938,7 @@ bool vtkUnstructuredPOPReader::Transform(vtkUnstructuredGrid* grid, size_t* star
     }
   }
 
-  nc_close(latlonFileId);
-  return retVal;
+  return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -1104,6 +1142,19 @@ private:
   size_t HorizontalDimensions[2];
 };
 
+//-----------------------------------------------------------------------------
+vtkUnstructuredPOPReaderInternal::~vtkUnstructuredPOPReaderInternal() = default;
+
+//-----------------------------------------------------------------------------
+void vtkUnstructuredPOPReaderInternal::ClearGridCache()
+{
+  this->CachedGrid = nullptr;
+  this->ColumnBases.clear();
+  this->PointIterator.reset();
+  this->WDep.clear();
+  this->Exchange = VerticalVelocityExchange();
+}
+
 //-----------------------------------------------------------------------------
 void vtkUnstructuredPOPReader::LoadPointData(vtkUnstructuredGrid* grid, int netCDFFD, int varidp,
   size_t* start, size_t* count, ptrdiff_t* rStride, const char* arrayName)
@@ -1136,9 +1187,35 @@ void vtkUnstructuredPOPReader::LoadPointData(vtkUnstructuredGrid* grid, int netC
 }
 
 //-----------------------------------------------------------------------------
-void vtkUnstructuredPOPReader::ComputeVerticalVelocity(vtkUnstructuredGrid* grid, int* wholeExtent,
-  int* subExtent, int numberOfGhostLevels, int latlonFileId)
+void vtkUnstructuredPOPReader::ComputeVerticalVelocity(
+  vtkUnstructuredGrid* grid, int* wholeExtent, int* subExtent, int numberOfGhostLevels)
 {
+  if (!this->Internals->PointIterator)
+  {
+    // the depth structure of the ocean is read once and kept with the grid
+    int latlonFileId = 0;
+    std::string gridFileName = GetGridFileName(this->FileName);
+    int retval = nc_open(gridFileName.c_str(), NC_NOWRITE, &latlonFileId);
+    if (retval != NC_NOERR)
+    {
+      vtkErrorMacro(<< "Can't read file " << nc_strerror(retval));
+      return;
+    }
+    this->Internals->PointIterator.reset(
+      new VTKPointIterator(wholeExtent, subExtent, this->Stride, latlonFileId));
+
+    int varidp;
+    nc_inq_varid(latlonFileId, "w_dep", &varidp);
+    int dimensionId;
+    nc_inq_vardimid(latlonFileId, varidp, &dimensionId);
+    size_t zero = 0;
+    size_t w_depDimension;
+    nc_inq_dimlen(latlonFileId, dimensionId, &w_depDimension);
+    this->Internals->WDep.resize(w_depDimension);
+    nc_get_vara_float(latlonFileId, varidp, &zero, &w_depDimension, &(this->Internals->WDep[0]));
+    nc_close(latlonFileId);
+  }
+
   vtkNew<vtkUnstructuredGrid> tempGrid;
   tempGrid->ShallowCopy(grid);
   vtkNew<vtkGradientFilter> gradientFilter;
@@ -1148,7 +1225,7 @@ void vtkUnstructuredPOPReader::ComputeVerticalVelocity(vtkUnstructuredGrid* grid
   grid->ShallowCopy(gradientFilter->GetOutput());
 
   std::vector<double> dwdr(grid->GetNumberOfPoints()); // change in velocity in the radial direction
-  VTKPointIterator pointIterator(wholeExtent, subExtent, this->Stride, latlonFileId);
+  VTKPointIterator& pointIterator = *this->Internals->PointIterator;
   for (vtkIdType column = pointIterator.BeginColumn(); column != pointIterator.EndColumn();
        column = pointIterator.NextColumn())
   {
@@ -1184,9 +1261,8 @@ void vtkUnstructuredPOPReader::ComputeVerticalVelocity(vtkUnstructuredGrid* grid
   // to integrate locally.  If this is in parallel, I'll go back later and
   // add in the values from integrations on other procs
 
-  // an array to keep track of the depth.  we only populate it if we need it
-  // since it requires file IO
-  std::vector<float> w_dep;
+  // an array to keep track of the depth
+  const std::vector<float>& w_dep = this->Internals->WDep;
 
   double dZero = 0;
   std::vector<double> w(grid->GetNumberOfPoints(), dZero); // vertical velocity
@@ -1214,18 +1290,6 @@ void vtkUnstructuredPOPReader::ComputeVerticalVelocity(vtkUnstructuredGrid* grid
     double lastdwdr = dwdr[pointId];
     if (pointIterator.ColumnPieceHasBottomPoint(true) == true)
     {
-      if (w_dep.size() == 0)
-      { // this process needs this array so we read it in now
-        int varidp;
-        nc_inq_varid(latlonFileId, "w_dep", &varidp);
-        int dimensionId;
-        nc_inq_vardimid(latlonFileId, varidp, &dimensionId);
-        size_t zero = 0;
-        size_t w_depDimension;
-        nc_inq_dimlen(latlonFileId, dimensionId, &w_depDimension);
-        w_dep.resize(w_depDimension);
-        nc_get_vara_float(latlonFileId, varidp, &zero, &w_depDimension, &(w_dep[0]));
-      }
       // assuming no partial cell depths, the bottom cell is only integrated
       // over half of the distance.
       float length =
@@ -1294,99 +1358,112 @@ void vtkUnstructuredPOPReader::CommunicateParallelVerticalVelocity(int* wholeExt
   vtkMPIController* controller =
     vtkMPIController::SafeDownCast(vtkMultiProcessController::GetGlobalController());
 
-  if (subExtent[5] != wholeExtent[5])
-  { // process needs to receive data in order to finish its computation.
-    // first determine which procs to receive data from
-    std::map<int, int> sendingProcesses;
-    for (vtkIdType column = pointIterator.BeginColumn(); column != pointIterator.EndColumn();
-         column = pointIterator.NextColumn())
-    {
-      if (pointIterator.IsColumnAReaderGhost() == false &&
-        pointIterator.ColumnPieceHasBottomPoint(true) == false &&
-        pointIterator.GetColumnTopPointExtentIndex(true) <
-          pointIterator.GetColumnOceanBottomExtentIndex())
+  // which columns are exchanged with which processes only depends on the
+  // grid so it is computed once and kept with it
+  vtkUnstructuredPOPReaderInternal::VerticalVelocityExchange& exchange =
+    this->Internals->Exchange;
+  if (!exchange.Initialized)
+  {
+    if (subExtent[5] != wholeExtent[5])
+    { // process needs to receive data in order to finish its computation.
+      // determine which procs to receive data from
+      for (vtkIdType column = pointIterator.BeginColumn(); column != pointIterator.EndColumn();
+           column = pointIterator.NextColumn())
       {
-        int iIndex = 0, jIndex = 0;
-        pointIterator.GetCurrentColumnExtentIndices(iIndex, jIndex);
-        int kIndex = pointIterator.GetColumnBottomPointExtentIndex(false);
-        int sendingProc = this->GetPointOwnerPiece(iIndex, jIndex, kIndex,
-          controller->GetNumberOfProcesses(), numberOfGhostLevels, wholeExtent);
-        sendingProcesses[sendingProc]++;
+        if (pointIterator.IsColumnAReaderGhost() == false &&
+          pointIterator.ColumnPieceHasBottomPoint(true) == false &&
+          pointIterator.GetColumnTopPointExtentIndex(true) <
+            pointIterator.GetColumnOceanBottomExtentIndex())
+        {
+          int iIndex = 0, jIndex = 0;
+          pointIterator.GetCurrentColumnExtentIndices(iIndex, jIndex);
+          int kIndex = pointIterator.GetColumnBottomPointExtentIndex(false);
+          int sendingProc = this->GetPointOwnerPiece(iIndex, jIndex, kIndex,
+            controller->GetNumberOfProcesses(), numberOfGhostLevels, wholeExtent);
+          exchange.Receives[sendingProc]++;
+        }
       }
     }
-    // now receive and process the data
-    for (std::map<int, int>::iterator it = sendingProcesses.begin(); it != sendingProcesses.end();
-         it++)
-    {
-      std::vector<int> iData(it->second * 3);
-      std::vector<float> fData(it->second);
-      vtkMPICommunicator::Request iRequest, fRequest;
-      controller->NoBlockReceive(&iData[0], it->second * 3, it->first, 4837, iRequest);
-      controller->NoBlockReceive(&fData[0], it->second, it->first, 4838, fRequest);
-      iRequest.Wait();
-      fRequest.Wait();
-      for (int i = 0; i < it->second; i++)
+    if (subExtent[4] != wholeExtent[4])
+    { // other processes are depending on information from this process.
+      // determine which points each of them needs
+      vtkNew<vtkIdList> pieceIds;
+      int numberOfPieces = controller->GetNumberOfProcesses();
+      for (vtkIdType column = pointIterator.BeginColumn(); column != pointIterator.EndColumn();
+           column = pointIterator.NextColumn())
       {
-        pointIterator.SetColumn(iData[i * 3], iData[i * 3 + 1]);
-        for (int k = iData[i * 3 + 2]; k >= pointIterator.GetColumnTopPointExtentIndex(false); k--)
+        if (pointIterator.IsColumnAReaderGhost() == false)
         {
-          vtkIdType pointId = pointIterator.GetPointId(k);
-          w[pointId] += fData[i];
+          int iIndex = 0, jIndex = 0;
+          pointIterator.GetCurrentColumnExtentIndices(iIndex, jIndex);
+          int kIndex = pointIterator.GetColumnTopPointExtentIndex(true);
+          kIndex += 2 * numberOfGhostLevels - 1;
+          vtkIdType pointId = pointIterator.GetPointId(kIndex);
+          this->GetPiecesNeedingPoint(iIndex, jIndex, kIndex, numberOfPieces,
+            numberOfGhostLevels, wholeExtent, pieceIds.GetPointer());
+          for (vtkIdType i = 0; i < pieceIds->GetNumberOfIds(); i++)
+          { // don't need to send to myself or if this column is all land
+            if (pieceIds->GetId(i) != controller->GetLocalProcessId() &&
+              kIndex < pointIterator.GetColumnOceanBottomExtentIndex() &&
+              this->GetPointOwnerPiece(iIndex, jIndex, kIndex, controller->GetNumberOfProcesses(),
+                numberOfGhostLevels, wholeExtent) == controller->GetLocalProcessId())
+            {
+              int indices[3] = { iIndex, jIndex, kIndex };
+              std::copy(
+                indices, indices + 3, std::back_inserter(exchange.SendIndices[pieceIds->GetId(i)]));
+              exchange.SendPointIds[pieceIds->GetId(i)].push_back(pointId);
+            }
+          }
         }
       }
     }
+    exchange.Initialized = true;
   }
 
-  if (subExtent[4] != wholeExtent[4])
-  { // other processes are depending on information from this process
-    // a map from piece number/processId to information to be sent.
-    // this needs to be done after this process has fully updated it's information
-    std::map<vtkIdType, std::vector<int> > sendIndexInfo;
-    std::map<vtkIdType, std::vector<float> > sendValueInfo;
-    vtkNew<vtkIdList> pieceIds;
-    int numberOfPieces = controller->GetNumberOfProcesses();
-    for (vtkIdType column = pointIterator.BeginColumn(); column != pointIterator.EndColumn();
-         column = pointIterator.NextColumn())
+  // now receive and process the data
+  for (std::map<int, int>::iterator it = exchange.Receives.begin(); it != exchange.Receives.end();
+       it++)
+  {
+    std::vector<int> iData(it->second * 3);
+    std::vector<float> fData(it->second);
+    vtkMPICommunicator::Request iRequest, fRequest;
+    controller->NoBlockReceive(&iData[0], it->second * 3, it->first, 4837, iRequest);
+    controller->NoBlockReceive(&fData[0], it->second, it->first, 4838, fRequest);
+    iRequest.Wait();
+    fRequest.Wait();
+    for (int i = 0; i < it->second; i++)
     {
-      if (pointIterator.IsColumnAReaderGhost() == false)
+      pointIterator.SetColumn(iData[i * 3], iData[i * 3 + 1]);
+      for (int k = iData[i * 3 + 2]; k >= pointIterator.GetColumnTopPointExtentIndex(false); k--)
       {
-        int iIndex = 0, jIndex = 0;
-        pointIterator.GetCurrentColumnExtentIndices(iIndex, jIndex);
-        int kIndex = pointIterator.GetColumnTopPointExtentIndex(true);
-        kIndex += 2 * numberOfGhostLevels - 1;
-        vtkIdType pointId = pointIterator.GetPointId(kIndex);
-        this->GetPiecesNeedingPoint(iIndex, jIndex, kIndex, numberOfPieces, numberOfGhostLevels,
-          wholeExtent, pieceIds.GetPointer());
-        for (vtkIdType i = 0; i < pieceIds->GetNumberOfIds(); i++)
-        { // don't need to send to myself or if this column is all land
-          if (pieceIds->GetId(i) != controller->GetLocalProcessId() &&
-            kIndex < pointIterator.GetColumnOceanBottomExtentIndex() &&
-            this->GetPointOwnerPiece(iIndex, jIndex, kIndex, controller->GetNumberOfProcesses(),
-              numberOfGhostLevels, wholeExtent) == controller->GetLocalProcessId())
-          {
-            int indices[3] = { iIndex, jIndex, kIndex };
-            std::copy(indices, indices + 3, std::back_inserter(sendIndexInfo[pieceIds->GetId(i)]));
-            sendValueInfo[pieceIds->GetId(i)].push_back(w[pointId]);
-          }
-        }
+        vtkIdType pointId = pointIterator.GetPointId(k);
+        w[pointId] += fData[i];
       }
     }
-    std::vector<vtkMPICommunicator::Request> requests;
-    for (std::map<vtkIdType, std::vector<int> >::iterator it = sendIndexInfo.begin();
-         it != sendIndexInfo.end(); it++)
-    {
-      requests.push_back(vtkMPICommunicator::Request());
-      controller->NoBlockSend(&(it->second[0]), static_cast<int>(it->second.size()),
-        static_cast<int>(it->first), 4837, requests.back());
-      controller->NoBlockSend(&(sendValueInfo[it->first][0]),
-        static_cast<int>(it->second.size() / 3), static_cast<int>(it->first), 4838,
-        requests.back());
-    }
-    for (std::vector<vtkMPICommunicator::Request>::iterator it = requests.begin();
-         it != requests.end(); it++)
+  }
+
+  // this needs to be done after this process has fully updated it's information
+  std::map<vtkIdType, std::vector<float> > sendValueInfo;
+  std::vector<vtkMPICommunicator::Request> requests(2 * exchange.SendIndices.size());
+  size_t requestIndex = 0;
+  for (std::map<vtkIdType, std::vector<int> >::iterator it = exchange.SendIndices.begin();
+       it != exchange.SendIndices.end(); it++)
+  {
+    const std::vector<vtkIdType>& pointIds = exchange.SendPointIds[it->first];
+    std::vector<float>& values = sendValueInfo[it->first];
+    for (size_t i = 0; i < pointIds.size(); i++)
     {
-      it->Wait();
+      values.push_back(w[pointIds[i]]);
     }
+    controller->NoBlockSend(&(it->second[0]), static_cast<int>(it->second.size()),
+      static_cast<int>(it->first), 4837, requests[requestIndex++]);
+    controller->NoBlockSend(&(values[0]), static_cast<int>(values.size()),
+      static_cast<int>(it->first), 4838, requests[requestIndex++]);
+  }
+  for (std::vector<vtkMPICommunicator::Request>::iterator it = requests.begin();
+       it != requests.end(); it++)
+  {
+    it->Wait();
   }
 }
 #else
@@ -190,13 +190,22 @@ protected:
   bool VerticalVelocity;
 
   /**
-   * Transform the grid from a topologically structured grid to a sphere
-   * shaped grid and do any vector transformations on field data that
-   * is needed.
+   * Build the sphere shaped grid, with its ghost information, for the
+   * topologically structured sub-extent read by this piece. The grid only
+   * depends on GRID.nc and on the extents, so it is built once and reused
+   * for all the time steps.
    */
-  bool Transform(vtkUnstructuredGrid* grid, size_t* start, size_t* count, int* wholeExtent,
+  bool BuildGrid(vtkUnstructuredGrid* grid, size_t* start, size_t* count, int* wholeExtent,
     int* subExtent, int numberOfGhostLevels, int wrapped, int piece, int numberOfPieces);
 
+  /**
+   * Do any vector transformations on field data that is needed to go from
+   * the topologically structured grid to the sphere shaped grid built by
+   * BuildGrid(), and compute the vertical velocity if requested.
+   */
+  bool Transform(vtkUnstructuredGrid* grid, size_t* count, int* wholeExtent, int* subExtent,
+    int numberOfGhostLevels);
+
   /**
    * Given the meta data about the grid partitioning, read in the
    * data from the file and create the unstructured grid.
@@ -226,13 +235,14 @@ protected:
    * Compute the vertical velocity component and add it into
    * the velocity field.
    */
-  void ComputeVerticalVelocity(vtkUnstructuredGrid* grid, int* wholeExtent, int* subExtent,
-    int numberOfGhostLevels, int latlonFileId);
+  void ComputeVerticalVelocity(
+    vtkUnstructuredGrid* grid, int* wholeExtent, int* subExtent, int numberOfGhostLevels);
 
   /**
    * If the reader is being run in parallel, do the necessary
    * communication to finish the vertical velocity integration
-   * on each process.
+   * on each process. Which processes exchange which columns is
+   * only computed for the first time step.
    */
   void CommunicateParallelVerticalVelocity(int* wholeExtent, int* subExtent,
     int numberOfGhostLevels, VTKPointIterator& pointIterator, double* w);
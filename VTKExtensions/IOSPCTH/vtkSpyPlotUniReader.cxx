@@ -5,13 +5,24 @@
 #include "vtkFloatArray.h"
 #include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSpyPlotBlock.h"
 #include "vtkSpyPlotIStream.h"
 #include "vtkUnsignedCharArray.h"
 
+#include "vtksys/Encoding.hxx"
 #include "vtksys/FStream.hxx"
 #include "vtksys/RegularExpression.hxx"
 
+#if defined(_WIN32)
+#include "vtkWindows.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <sstream>
 #include <vector>
 
@@ -41,6 +52,111 @@ inline ostream& operator<<(ostream& os, const vtkSpyPlotWriteString& c)
   return os;
 }
 
+//=============================================================================
+// Read-only access to a SpyPlot file. The file is memory mapped when
+// possible, otherwise the requested ranges are read into a buffer.
+class vtkSpyPlotMappedFile
+{
+public:
+  vtkSpyPlotMappedFile(const char* filename)
+    : FileName(filename)
+  {
+#if defined(_WIN32)
+    HANDLE file = CreateFileW(vtksys::Encoding::ToWide(this->FileName).c_str(), GENERIC_READ,
+      FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+      return;
+    }
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+    {
+      this->Mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (this->Mapping)
+      {
+        this->Data =
+          static_cast<const unsigned char*>(MapViewOfFile(this->Mapping, FILE_MAP_READ, 0, 0, 0));
+        this->Size = this->Data ? size.QuadPart : 0;
+      }
+    }
+    CloseHandle(file);
+#else
+    int fd = open(this->FileName.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      return;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0)
+    {
+      void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data != MAP_FAILED)
+      {
+        this->Data = static_cast<const unsigned char*>(data);
+        this->Size = info.st_size;
+      }
+    }
+    close(fd);
+#endif
+  }
+
+  ~vtkSpyPlotMappedFile()
+  {
+#if defined(_WIN32)
+    if (this->Data)
+    {
+      UnmapViewOfFile(this->Data);
+    }
+    if (this->Mapping)
+    {
+      CloseHandle(this->Mapping);
+    }
+#else
+    if (this->Data)
+    {
+      munmap(const_cast<unsigned char*>(this->Data), static_cast<size_t>(this->Size));
+    }
+#endif
+  }
+
+  // Returns a pointer to the `length` bytes at `offset` or nullptr if they
+  // cannot be read. When the file is not mapped, the pointer is only valid
+  // until the next call.
+  const unsigned char* GetRange(vtkTypeInt64 offset, vtkTypeInt64 length)
+  {
+    if (offset < 0 || length < 0)
+    {
+      return nullptr;
+    }
+    if (this->Data)
+    {
+      return offset + length <= this->Size ? this->Data + offset : nullptr;
+    }
+
+    if (!this->Stream.is_open())
+    {
+      this->Stream.open(this->FileName.c_str(), ios::binary | ios::in);
+    }
+    this->Buffer.resize(static_cast<size_t>(length));
+    this->Stream.clear();
+    this->Stream.seekg(offset);
+    this->Stream.read(reinterpret_cast<char*>(this->Buffer.data()), length);
+    return this->Stream.gcount() == length ? this->Buffer.data() : nullptr;
+  }
+
+private:
+  std::string FileName;
+  const unsigned char* Data = nullptr;
+  vtkTypeInt64 Size = 0;
+#if defined(_WIN32)
+  HANDLE Mapping = nullptr;
+#endif
+
+  // Used when the file could not be mapped.
+  vtksys::ifstream Stream;
+  std::vector<unsigned char> Buffer;
+};
+
 //-----------------------------------------------------------------------------
 vtkSpyPlotUniReader::vtkSpyPlotUniReader()
 {
@@ -70,6 +186,7 @@ vtkSpyPlotUniReader::vtkSpyPlotUniReader()
 
   this->DataDumps = 0;
   this->Blocks = 0;
+  this->MappedFile = 0;
 
   this->CellArraySelection = 0;
 
@@ -134,11 +251,13 @@ vtkSpyPlotUniReader::~vtkSpyPlotUniReader()
         delete[] cv->DataBlocks;
         delete[] cv->GhostCellsFixed;
       }
+      delete[] cv->BlockOffsets;
     }
     delete[] dp->Variables;
   }
   delete[] this->DataDumps;
   delete[] this->Blocks;
+  delete this->MappedFile;
   this->SetFileName(0);
   this->SetCellArraySelection(0);
 
@@ -218,6 +337,10 @@ int vtkSpyPlotUniReader::MakeCurrent()
   vtksys::ifstream ifs(this->FileName, ios::binary | ios::in);
   vtkSpyPlotIStream spis;
   spis.SetStream(&ifs);
+  if (!this->MappedFile)
+  {
+    this->MappedFile = new vtkSpyPlotMappedFile(this->FileName);
+  }
   int dump;
   vtkSpyPlotUniReader::DataDump* dp;
   int blocksUpdated = 0;
@@ -328,6 +451,7 @@ int vtkSpyPlotUniReader::MakeCurrent()
   dump = this->CurrentTimeStep;
   dp = this->DataDumps + dump;
 
+  vtkTypeInt64 lastVariableEnd = -1;
   for (int fieldCnt = 0; fieldCnt < dp->NumVars; ++fieldCnt)
   {
     vtkSpyPlotUniReader::Variable* var = dp->Variables + fieldCnt;
@@ -386,92 +510,20 @@ int vtkSpyPlotUniReader::MakeCurrent()
       continue;
     }
 
-    // vtkDebugMacro( "  Field: " << fieldCnt << " / " << dp->NumVars
-    // << " [" << var->Name << "]" );
-    // vtkDebugMacro( "    Jump to: " << dp->SavedVariableOffsets[fieldCnt] );
-    spis.Seek(dp->SavedVariableOffsets[fieldCnt]);
-    int numBytes;
-    int block;
-    int actualBlockId = 0;
-    for (block = 0; block < dp->NumberOfBlocks; ++block)
+    if (!this->ReadVariableBlocks(dp, var))
     {
-      vtkSpyPlotBlock* bk = this->Blocks + block;
-      if (bk->IsAllocated())
-      {
-        vtkFloatArray* floatArray = 0;
-        vtkUnsignedCharArray* unsignedCharArray = 0;
-        vtkDataArray* dataArray = 0;
-        if (this->CellArraySelection->ArrayIsEnabled(var->Name) && !var->DataBlocks[actualBlockId])
-        {
-          if (this->DownConvertVolumeFraction && this->IsVolumeFraction(var))
-          {
-            unsignedCharArray = vtkUnsignedCharArray::New();
-            dataArray = unsignedCharArray;
-          }
-          else
-          {
-            floatArray = vtkFloatArray::New();
-            dataArray = floatArray;
-          }
-          dataArray->SetNumberOfComponents(1);
-          dataArray->SetNumberOfTuples(
-            bk->GetDimension(0) * bk->GetDimension(1) * bk->GetDimension(2));
-          dataArray->SetName(var->Name);
-          // vtkDebugMacro( "*** Create data array: "
-          // << dataArray->GetNumberOfTuples() );
-        }
-        int zax;
-        int bdims[3];
-        bk->GetDimensions(bdims);
-        for (zax = 0; zax < bdims[2]; ++zax)
-        {
-          int planeSize = bdims[0] * bdims[1];
-          if (!spis.ReadInt32s(&numBytes, 1))
-          {
-            vtkErrorMacro("Problem reading the number of bytes");
-            return 0;
-          }
-          if (static_cast<int>(arrayBuffer.size()) < numBytes)
-          {
-            arrayBuffer.resize(numBytes);
-          }
-          if (!spis.ReadString(&*arrayBuffer.begin(), numBytes))
-          {
-            vtkErrorMacro("Problem reading the bytes");
-            return 0;
-          }
-          if (floatArray)
-          {
-            float* ptr = floatArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
-            {
-              vtkErrorMacro("Problem RLD decoding float data array");
-              return 0;
-            }
-          }
-          if (unsignedCharArray)
-          {
-            unsigned char* ptr = unsignedCharArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
-            {
-              vtkErrorMacro("Problem RLD decoding unsigned char data array");
-              return 0;
-            }
-          }
-        }
-        if (dataArray)
-        {
-          var->DataBlocks[actualBlockId] = dataArray;
-          var->GhostCellsFixed[actualBlockId] = 0;
-          vtkDebugMacro(" " << dataArray << " initialized: " << dataArray->GetName());
-          actualBlockId++;
-        }
-      }
+      return 0;
     }
+    lastVariableEnd = var->BlockOffsets[dp->ActualNumberOfBlocks];
   }
 
   if (blocksUpdated && needMarkers)
   {
+    // The markers follow the last variable that was read.
+    if (lastVariableEnd >= 0)
+    {
+      spis.Seek(lastVariableEnd);
+    }
     if (this->ReadMarkerDumps(&spis) == 0)
     {
       vtkErrorMacro("Problem reading marker data");
@@ -483,6 +535,144 @@ int vtkSpyPlotUniReader::MakeCurrent()
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+int vtkSpyPlotUniReader::BuildBlockOffsets(DataDump* dp, Variable* var, vtkTypeInt64 offset)
+{
+  // Every plane of every allocated block is stored as its size in bytes
+  // followed by the run length encoded values.
+  vtkTypeInt64* offsets = new vtkTypeInt64[dp->ActualNumberOfBlocks + 1];
+  int actualBlockId = 0;
+  for (int block = 0; block < dp->NumberOfBlocks; ++block)
+  {
+    vtkSpyPlotBlock* bk = this->Blocks + block;
+    if (!bk->IsAllocated())
+    {
+      continue;
+    }
+    if (actualBlockId >= dp->ActualNumberOfBlocks)
+    {
+      vtkErrorMacro("Too many allocated blocks for variable: " << var->Name);
+      delete[] offsets;
+      return 0;
+    }
+    offsets[actualBlockId++] = offset;
+    int bdims[3];
+    bk->GetDimensions(bdims);
+    for (int zax = 0; zax < bdims[2]; ++zax)
+    {
+      const unsigned char* ptr = this->MappedFile->GetRange(offset, 4);
+      int numBytes = -1;
+      if (ptr)
+      {
+        memcpy(&numBytes, ptr, 4);
+        vtkByteSwap::SwapBE(&numBytes);
+      }
+      if (numBytes < 0)
+      {
+        vtkErrorMacro("Problem reading the number of bytes");
+        delete[] offsets;
+        return 0;
+      }
+      offset += 4 + numBytes;
+    }
+  }
+  for (; actualBlockId <= dp->ActualNumberOfBlocks; ++actualBlockId)
+  {
+    offsets[actualBlockId] = offset;
+  }
+  var->BlockOffsets = offsets;
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+int vtkSpyPlotUniReader::ReadVariableBlocks(DataDump* dp, Variable* var)
+{
+  const int numBlocks = dp->ActualNumberOfBlocks;
+  if (!var->BlockOffsets &&
+    !this->BuildBlockOffsets(dp, var, dp->SavedVariableOffsets[var - dp->Variables]))
+  {
+    return 0;
+  }
+  const vtkTypeInt64 start = var->BlockOffsets[0];
+  const unsigned char* data =
+    this->MappedFile->GetRange(start, var->BlockOffsets[numBlocks] - start);
+  if (!data)
+  {
+    vtkErrorMacro("Problem reading the bytes");
+    return 0;
+  }
+
+  // Arrays are allocated up front, the blocks are then decoded concurrently.
+  const bool downConvert = this->DownConvertVolumeFraction && this->IsVolumeFraction(var);
+  std::vector<vtkSpyPlotBlock*> blocks;
+  blocks.reserve(numBlocks);
+  for (int block = 0; block < dp->NumberOfBlocks; ++block)
+  {
+    vtkSpyPlotBlock* bk = this->Blocks + block;
+    if (bk->IsAllocated())
+    {
+      const int actualBlockId = static_cast<int>(blocks.size());
+      vtkDataArray* dataArray = nullptr;
+      if (downConvert)
+      {
+        dataArray = vtkUnsignedCharArray::New();
+      }
+      else
+      {
+        dataArray = vtkFloatArray::New();
+      }
+      dataArray->SetNumberOfComponents(1);
+      dataArray->SetNumberOfTuples(
+        bk->GetDimension(0) * bk->GetDimension(1) * bk->GetDimension(2));
+      dataArray->SetName(var->Name);
+      var->DataBlocks[actualBlockId] = dataArray;
+      var->GhostCellsFixed[actualBlockId] = 0;
+      blocks.push_back(bk);
+    }
+  }
+
+  std::vector<unsigned char> status(blocks.size(), 1);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(blocks.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType actualBlockId = begin; actualBlockId < end; ++actualBlockId)
+    {
+      int bdims[3];
+      blocks[actualBlockId]->GetDimensions(bdims);
+      const int planeSize = bdims[0] * bdims[1];
+      const unsigned char* ptr = data + (var->BlockOffsets[actualBlockId] - start);
+      vtkDataArray* dataArray = var->DataBlocks[actualBlockId];
+      for (int zax = 0; zax < bdims[2]; ++zax)
+      {
+        int numBytes;
+        memcpy(&numBytes, ptr, 4);
+        vtkByteSwap::SwapBE(&numBytes);
+        ptr += 4;
+        const int decoded = downConvert
+          ? this->RunLengthDataDecode(ptr, numBytes,
+              static_cast<vtkUnsignedCharArray*>(dataArray)->GetPointer(zax * planeSize), planeSize)
+          : this->RunLengthDataDecode(ptr, numBytes,
+              static_cast<vtkFloatArray*>(dataArray)->GetPointer(zax * planeSize), planeSize);
+        if (!decoded)
+        {
+          status[actualBlockId] = 0;
+          break;
+        }
+        ptr += numBytes;
+      }
+    }
+  });
+
+  for (size_t actualBlockId = 0; actualBlockId < status.size(); ++actualBlockId)
+  {
+    if (!status[actualBlockId])
+    {
+      vtkErrorMacro("Problem RLD decoding block " << actualBlockId << " of data array "
+                                                   << var->Name);
+      return 0;
+    }
+  }
+  return 1;
+}
+
 //-----------------------------------------------------------------------------
 void vtkSpyPlotUniReader::PrintMemoryUsage()
 {
@@ -1550,6 +1740,7 @@ int vtkSpyPlotUniReader::ReadDataDumps(vtkSpyPlotIStream* spis)
       variable->Material = -1;
       variable->Index = -1;
       variable->DataBlocks = 0;
+      variable->BlockOffsets = 0;
       int var = dh->SavedVariables[fieldCnt];
       if (var >= this->NumberOfPossibleCellFields)
       {
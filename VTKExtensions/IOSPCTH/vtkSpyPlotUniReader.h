@@ -43,6 +43,7 @@ class vtkFloatArray;
 class vtkIntArray;
 class vtkUnsignedCharArray;
 class vtkSpyPlotIStream;
+class vtkSpyPlotMappedFile;
 
 class VTKPVVTKEXTENSIONSIOSPCTH_EXPORT vtkSpyPlotUniReader : public vtkObject
 {
@@ -180,6 +181,10 @@ public:
     CellMaterialField* MaterialField;
     vtkDataArray** DataBlocks;
     int* GhostCellsFixed;
+    // File offsets of the data of each allocated block, followed by the
+    // offset of the end of the data of the last block. Built the first time
+    // the variable is read.
+    vtkTypeInt64* BlockOffsets;
   };
   struct DataDump
   {
@@ -248,6 +253,8 @@ private:
   int ReadGroupHeaderInformation(vtkSpyPlotIStream* spis);
   int ReadDataDumps(vtkSpyPlotIStream* spis);
   int ReadMarkerDumps(vtkSpyPlotIStream* spis);
+  int BuildBlockOffsets(DataDump* dp, Variable* var, vtkTypeInt64 offset);
+  int ReadVariableBlocks(DataDump* dp, Variable* var);
 
   vtkDataArray* GetMaterialField(const int& block, const int& materialIndex, const char* Id);
 
@@ -287,6 +294,9 @@ private:
   // File name
   char* FileName;
 
+  // Memory mapped file used to decode the cell fields
+  vtkSpyPlotMappedFile* MappedFile;
+
   // Was information read
   int HaveInformation;
 